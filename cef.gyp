@@ -401,6 +401,13 @@
         'tests/cefclient/client_switches.h',
         'tests/cefclient/resource_util.h',
         'tests/cefclient/res/osr_test.html',
+        # Internal OSR pixel kernels are compiled in directly for testing.
+        'libcef/browser/backing_store_osr_util.cc',
+        'libcef/browser/backing_store_osr_util.h',
+        # Internal tracker classes are compiled in directly for testing.
+        'libcef/common/tracker.cc',
+        'libcef/common/tracker.h',
+        'tests/unittests/backing_store_osr_unittest.cc',
         'tests/unittests/browser_info_map_unittest.cc',
         'tests/unittests/command_line_unittest.cc',
         'tests/unittests/cookie_unittest.cc',
@@ -434,6 +441,7 @@
         'tests/unittests/test_util.cc',
         'tests/unittests/test_util.h',
         'tests/unittests/tracing_unittest.cc',
+        'tests/unittests/tracker_unittest.cc',
         'tests/unittests/url_unittest.cc',
         'tests/unittests/urlrequest_unittest.cc',
         'tests/unittests/v8_unittest.cc',
@@ -877,6 +885,8 @@
         '<@(includes_common)',
         'libcef/browser/backing_store_osr.cc',
         'libcef/browser/backing_store_osr.h',
+        'libcef/browser/backing_store_osr_util.cc',
+        'libcef/browser/backing_store_osr_util.h',
         'libcef/browser/browser_context.h',
         'libcef/browser/browser_context_impl.cc',
         'libcef/browser/browser_context_impl.h',
@@ -1007,6 +1017,8 @@
         'libcef/common/main_delegate.h',
         'libcef/common/net_resource_provider.cc',
         'libcef/common/net_resource_provider.h',
+        'libcef/common/packed_values_impl.cc',
+        'libcef/common/packed_values_impl.h',
         'libcef/common/process_message_impl.cc',
         'libcef/common/process_message_impl.h',
         'libcef/common/request_impl.cc',
@@ -1128,6 +1140,8 @@
             'libcef/browser/application_mac.mm',
             'libcef/browser/backing_store_osr.cc',
             'libcef/browser/backing_store_osr.h',
+            'libcef/browser/backing_store_osr_util.cc',
+            'libcef/browser/backing_store_osr_util.h',
             'libcef/browser/browser_host_impl_mac.mm',
             'libcef/browser/browser_main_mac.mm',
             'libcef/browser/javascript_dialog_mac.mm',
@@ -174,11 +174,26 @@ typedef struct _cef_browser_t {
 
   //
   // Send a message to the specified |target_process|. Returns true (1) if the
-  // message was sent successfully.
+  // message was sent successfully. In the browser process a message sent from a
+  // thread other than the UI thread is delivered asynchronously and true (1) is
+  // returned if the message is valid.
   ///
   int (CEF_CALLBACK *send_process_message)(struct _cef_browser_t* self,
       cef_process_id_t target_process,
       struct _cef_process_message_t* message);
+
+  ///
+  // Send multiple messages to the specified |target_process| using a single IPC
+  // message. The messages are delivered to OnProcessMessageReceived in order as
+  // if they had been sent individually with SendProcessMessage. Messages with a
+  // shared memory segment or packed arguments are sent individually, still in
+  // order, so that the segment can be transferred and the arguments stay
+  // packed. Returns true (1) if all messages were sent successfully. No
+  // messages are sent if any message is invalid.
+  ///
+  int (CEF_CALLBACK *send_process_messages)(struct _cef_browser_t* self,
+      cef_process_id_t target_process, size_t messagesCount,
+      struct _cef_process_message_t* const* messages);
 } cef_browser_t;
 
 
@@ -391,6 +406,41 @@ typedef struct _cef_browser_host_t {
   void (CEF_CALLBACK *invalidate)(struct _cef_browser_host_t* self,
       const cef_rect_t* dirtyRect, cef_paint_element_type_t type);
 
+  ///
+  // Returns the total number of pixel bytes delivered to
+  // cef_render_handler_t::OnPaint and cef_render_handler_t::OnPaintSpan. When
+  // OnPaint is used the full buffer size is counted for each call. This
+  // function is only used when window rendering is disabled.
+  ///
+  int64 (CEF_CALLBACK *get_paint_delivered_bytes)(
+      struct _cef_browser_host_t* self);
+
+  ///
+  // Returns the total number of pixel bytes that would have been delivered if
+  // every paint had included the whole view. Compare with
+  // GetPaintDeliveredBytes to measure the savings of OnPaintSpan delivery. This
+  // function is only used when window rendering is disabled.
+  ///
+  int64 (CEF_CALLBACK *get_paint_view_bytes)(struct _cef_browser_host_t* self);
+
+  ///
+  // Limit the rate at which cef_render_handler_t::OnPaint (or OnPaintSpan) will
+  // be called to at most |frame_rate| times per second. Dirty regions that
+  // arrive between frames are combined and delivered together on the next
+  // frame. Specify a value <= 0 to deliver each update immediately (the
+  // default). This function is only used when window rendering is disabled.
+  ///
+  void (CEF_CALLBACK *set_windowless_frame_rate)(
+      struct _cef_browser_host_t* self, int frame_rate);
+
+  ///
+  // Immediately deliver any dirty regions that are being held back by the frame
+  // rate set via SetWindowlessFrameRate. Call this after forwarding interactive
+  // input to avoid waiting for the next frame. This function is only used when
+  // window rendering is disabled.
+  ///
+  void (CEF_CALLBACK *flush_windowless_paint)(struct _cef_browser_host_t* self);
+
   ///
   // Send a key event to the browser.
   ///
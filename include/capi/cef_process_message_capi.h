@@ -85,6 +85,60 @@ typedef struct _cef_process_message_t {
   ///
   struct _cef_list_value_t* (CEF_CALLBACK *get_argument_list)(
       struct _cef_process_message_t* self);
+
+  ///
+  // Set whether the argument list is sent in the packed format. The packed
+  // format stores all arguments in a single contiguous buffer with shared
+  // dictionary keys and avoids copying the argument list when the message is
+  // sent. The receiver reads values directly from the buffer via a read-only
+  // argument list. This is recommended for messages with large or deeply nested
+  // arguments. Sending fails if packed arguments are nested more than 100
+  // levels deep.
+  ///
+  void (CEF_CALLBACK *set_argument_list_packed)(
+      struct _cef_process_message_t* self, int packed);
+
+  ///
+  // Returns true (1) if the argument list is sent or was received in the packed
+  // format.
+  ///
+  int (CEF_CALLBACK *is_argument_list_packed)(
+      struct _cef_process_message_t* self);
+
+  ///
+  // Create a shared memory segment of |size| bytes and attach it to this
+  // message, replacing any existing segment. Returns a pointer to the writable
+  // memory or NULL on failure. When the message is sent the segment is handed
+  // to the target process without copying or serialization and is no longer
+  // attached to this message. If the message cannot be sent the segment is
+  // released. Segments are not included by copy().
+  ///
+  void* (CEF_CALLBACK *create_shared_memory)(
+      struct _cef_process_message_t* self, size_t size);
+
+  ///
+  // Returns the attached shared memory segment or NULL if no segment is
+  // attached. The segment of a received message is released after
+  // OnProcessMessageReceived returns unless it is moved to another message
+  // using MoveSharedMemory.
+  ///
+  void* (CEF_CALLBACK *get_shared_memory)(struct _cef_process_message_t* self);
+
+  ///
+  // Returns the size of the attached shared memory segment in bytes or 0 if no
+  // segment is attached.
+  ///
+  size_t (CEF_CALLBACK *get_shared_memory_size)(
+      struct _cef_process_message_t* self);
+
+  ///
+  // Move the attached shared memory segment to |target|, replacing any segment
+  // attached to |target|. The memory is not copied and pointers returned by
+  // GetSharedMemory remain valid. |target| must be writable but this message
+  // may be read-only. Returns true (1) on success.
+  ///
+  int (CEF_CALLBACK *move_shared_memory)(struct _cef_process_message_t* self,
+      struct _cef_process_message_t* target);
 } cef_process_message_t;
 
 
@@ -104,18 +104,90 @@ typedef struct _cef_render_handler_t {
   void (CEF_CALLBACK *on_popup_size)(struct _cef_render_handler_t* self,
       struct _cef_browser_t* browser, const cef_rect_t* rect);
 
+  ///
+  // Called to optionally provide the pixel buffer that an element will be
+  // rasterized into. |type| indicates whether the element is the view or the
+  // popup widget. Return a pointer to |width|*|height|*4 bytes of writable
+  // memory (for example, a mapped shared memory segment or a texture staging
+  // area) to have the browser paint directly into it, or NULL to use internally
+  // allocated memory. The same pointer will then be passed as the |buffer|
+  // argument to OnPaint so no intermediate copy is required. The buffer must
+  // remain valid until OnPaintBufferReleased is called for it. This function
+  // will be called again each time the element size or scale factor changes.
+  ///
+  void* (CEF_CALLBACK *get_paint_buffer)(struct _cef_render_handler_t* self,
+      struct _cef_browser_t* browser, cef_paint_element_type_t type, int width,
+      int height);
+
+  ///
+  // Called when the browser no longer references a |buffer| previously returned
+  // from GetPaintBuffer. The client may free or reuse the memory after this
+  // function returns. All buffers are released before the browser is destroyed.
+  ///
+  void (CEF_CALLBACK *on_paint_buffer_released)(
+      struct _cef_render_handler_t* self, struct _cef_browser_t* browser,
+      cef_paint_element_type_t type, void* buffer);
+
   ///
   // Called when an element should be painted. |type| indicates whether the
   // element is the view or the popup widget. |buffer| contains the pixel data
   // for the whole image. |dirtyRects| contains the set of rectangles that need
   // to be repainted. On Windows |buffer| will be |width|*|height|*4 bytes in
-  // size and represents a BGRA image with an upper-left origin.
+  // size and represents a BGRA image with an upper-left origin. If
+  // GetPaintBuffer returned a non-NULL value |buffer| will be that memory.
   ///
   void (CEF_CALLBACK *on_paint)(struct _cef_render_handler_t* self,
       struct _cef_browser_t* browser, cef_paint_element_type_t type,
       size_t dirtyRectsCount, cef_rect_t const* dirtyRects, const void* buffer,
       int width, int height);
 
+  ///
+  // Called to determine whether dirty regions should be delivered using
+  // OnPaintSpan instead of OnPaint. Return a value >= 0 to enable span
+  // delivery. The value is the maximum percentage of undamaged area that may be
+  // added when two dirty rectangles are merged into one; larger values produce
+  // fewer, larger spans. Return a negative value to use OnPaint.
+  ///
+  int (CEF_CALLBACK *get_paint_span_merge_threshold)(
+      struct _cef_render_handler_t* self, struct _cef_browser_t* browser);
+
+  ///
+  // Called to retrieve the tile size for the windowless backing store. Return a
+  // value > 0 to divide the backing store into square tiles of that many pixels
+  // that are only allocated when first painted and are released when the
+  // browser has been hidden for a short time. Painting will then be delivered
+  // to OnPaintSpan once per dirty tile and OnPaint, GetPaintBuffer and
+  // GetPaintSpanMergeThreshold will not be called. Return 0 to use a single
+  // buffer for the whole view.
+  ///
+  int (CEF_CALLBACK *get_paint_tile_size)(struct _cef_render_handler_t* self,
+      struct _cef_browser_t* browser);
+
+  ///
+  // Called when the browser is hidden to retrieve the delay in milliseconds
+  // before the tiles of the windowless backing store are released. Only called
+  // when GetPaintTileSize returns a value > 0. Return 0 to use the default
+  // delay of 5 seconds.
+  ///
+  int (CEF_CALLBACK *get_paint_tile_discard_delay)(
+      struct _cef_render_handler_t* self, struct _cef_browser_t* browser);
+
+  ///
+  // Called instead of OnPaint for each dirty rectangle when
+  // GetPaintSpanMergeThreshold returns a value >= 0 or GetPaintTileSize returns
+  // a value > 0. |type| indicates whether the element is the view or the popup
+  // widget. |rect| is the dirty area in pixel coordinates (view coordinates
+  // multiplied by the device scale factor) clipped to the element bounds.
+  // |buffer| contains the pixel data for |rect| as BGRA rows with an upper-left
+  // origin and |stride| is the number of bytes per row. With span delivery the
+  // rows are tightly packed (|stride| is |rect.width|*4). With tile delivery
+  // |buffer| points into the tile and |stride| is the tile row size. |buffer|
+  // is only valid for the duration of this call.
+  ///
+  void (CEF_CALLBACK *on_paint_span)(struct _cef_render_handler_t* self,
+      struct _cef_browser_t* browser, cef_paint_element_type_t type,
+      const cef_rect_t* rect, const void* buffer, int stride);
+
   ///
   // Called when the browser window's cursor has changed.
   ///
@@ -145,6 +145,17 @@ typedef struct _cef_render_process_handler_t {
       struct _cef_v8context_t* context, struct _cef_v8exception_t* exception,
       struct _cef_v8stack_trace_t* stackTrace);
 
+  ///
+  // Called when the wrapper budget set with
+  // cef_v8context_t::cef_v8context_set_wrapper_budget() is still exceeded after
+  // a garbage collection. |statistics| has the format described in
+  // cef_v8context_t::get_statistics() without the "context" dictionary. This
+  // function will not be called again until usage drops below the budget.
+  ///
+  void (CEF_CALLBACK *on_v8wrapper_budget_exceeded)(
+      struct _cef_render_process_handler_t* self,
+      struct _cef_dictionary_value_t* statistics);
+
   ///
   // Called when a new node in the the browser gets focus. The |node| value may
   // be NULL if no specific node has gained focus. The node object passed to
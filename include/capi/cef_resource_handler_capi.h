@@ -44,6 +44,7 @@
 #include "include/capi/cef_cookie_capi.h"
 #include "include/capi/cef_request_capi.h"
 #include "include/capi/cef_response_capi.h"
+#include "include/capi/cef_values_capi.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -84,6 +85,19 @@ typedef struct _cef_resource_handler_t {
       struct _cef_resource_handler_t* self, struct _cef_response_t* response,
       int64* response_length, cef_string_t* redirectUrl);
 
+  ///
+  // Optionally return the response data as a read-only binary value instead of
+  // copying it in read_response(). This allows handlers that already hold the
+  // complete response (for example, in a cache) to share the same value between
+  // requests. This function is called after get_response_headers() and again
+  // each time the previously returned value has been read completely, so the
+  // response may be provided as a sequence of values. Return NULL to indicate
+  // completion of the response. If NULL is returned from the first call
+  // read_response() will be used instead.
+  ///
+  struct _cef_binary_value_t* (CEF_CALLBACK *get_response_data)(
+      struct _cef_resource_handler_t* self);
+
   ///
   // Read response data. If data is available immediately copy up to
   // |bytes_to_read| bytes into |data_out|, set |bytes_read| to the number of
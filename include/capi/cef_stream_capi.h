@@ -126,6 +126,22 @@ typedef struct _cef_stream_reader_t {
   // the reader from.
   ///
   int (CEF_CALLBACK *may_block)(struct _cef_stream_reader_t* self);
+
+  ///
+  // Returns a read-only pointer to the beginning of the stream data if this
+  // reader was created using CreateForData or CreateForMappedFile, or NULL
+  // otherwise. The pointer remains valid for the lifespan of this reader and
+  // can be used together with get_data_size(), tell() and seek() to consume the
+  // data without copying it. If may_block() returns true (1) accessing the data
+  // may block so it should only be accessed on threads that allow blocking.
+  ///
+  const void* (CEF_CALLBACK *get_data)(struct _cef_stream_reader_t* self);
+
+  ///
+  // Returns the size in bytes of the data returned by get_data(), or 0 if
+  // get_data() returns NULL.
+  ///
+  size_t (CEF_CALLBACK *get_data_size)(struct _cef_stream_reader_t* self);
 } cef_stream_reader_t;
 
 
@@ -135,6 +151,19 @@ typedef struct _cef_stream_reader_t {
 CEF_EXPORT cef_stream_reader_t* cef_stream_reader_create_for_file(
     const cef_string_t* fileName);
 
+///
+// Create a new cef_stream_reader_t object from a file that is mapped into
+// memory instead of being read with buffered file IO. Reads may fault in pages
+// from disk so may_block() returns true (1). Returns NULL if the file cannot be
+// opened or mapped or if the file has a size of zero. Only use this function
+// for trusted files that the application controls. The file must not be
+// truncated while the reader exists because accessing the mapping beyond the
+// new end of the file terminates the process (SIGBUS on POSIX systems). The
+// same applies to the mapping returned by get_data().
+///
+CEF_EXPORT cef_stream_reader_t* cef_stream_reader_create_for_mapped_file(
+    const cef_string_t* fileName);
+
 ///
 // Create a new cef_stream_reader_t object from data.
 ///
@@ -166,6 +166,32 @@ typedef struct _cef_urlrequest_client_t {
       struct _cef_urlrequest_t* request, const void* data,
       size_t data_length);
 
+  ///
+  // Return the maximum number of response bytes that may be waiting for
+  // delivery to on_download_data() before reading from the network is paused.
+  // Data received while previous data is still waiting for delivery may be
+  // combined into a single on_download_data() call. Return 0 to use the default
+  // size or 1 to deliver each chunk of data before the next chunk is read. This
+  // function is called once when the request is started and is only used for
+  // requests initiated from the browser process.
+  ///
+  size_t (CEF_CALLBACK *get_download_window_size)(
+      struct _cef_urlrequest_client_t* self);
+
+  ///
+  // Return a file path to write the response data directly to that file on the
+  // FILE thread instead of delivering it to on_download_data(). Any existing
+  // file at the path will be replaced and the file will be deleted if the
+  // request does not succeed. on_download_progress() will still be called.
+  // Return a zero-length string to receive on_download_data() callbacks
+  // instead. This function is called once when the request is started, is not
+  // called if the UR_FLAG_NO_DOWNLOAD_DATA flag is set on the request and is
+  // only used for requests initiated from the browser process.
+  ///
+  // The resulting string must be freed by calling cef_string_userfree_free().
+  cef_string_userfree_t (CEF_CALLBACK *get_download_file_path)(
+      struct _cef_urlrequest_client_t* self);
+
   ///
   // Called on the IO thread when the browser needs credentials from the user.
   // |isProxy| indicates whether the host is a proxy server. |host| contains the
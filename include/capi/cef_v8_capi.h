@@ -42,12 +42,14 @@
 #include "include/capi/cef_browser_capi.h"
 #include "include/capi/cef_frame_capi.h"
 #include "include/capi/cef_task_capi.h"
+#include "include/capi/cef_values_capi.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 struct _cef_v8exception_t;
+struct _cef_v8fast_handler_t;
 struct _cef_v8handler_t;
 struct _cef_v8stack_frame_t;
 struct _cef_v8value_t;
@@ -131,6 +133,24 @@ typedef struct _cef_v8context_t {
   int (CEF_CALLBACK *eval)(struct _cef_v8context_t* self,
       const cef_string_t* code, struct _cef_v8value_t** retval,
       struct _cef_v8exception_t** exception);
+
+  ///
+  // Returns statistics for the V8 wrappers of this context and of the thread
+  // that owns it. The "context" dictionary contains the number of live
+  // cef_v8value_t objects ("values"), cef_v8context_t objects ("contexts"), V8
+  // handles kept alive by cef_v8value_t objects ("persistent_handles") and
+  // objects tracked for cleanup when the context is released
+  // ("tracked_objects"). The "isolate" dictionary contains the same counts for
+  // the whole thread and the number of bytes of externally allocated memory
+  // owned by wrappers ("tracked_bytes"), the number of scripts compiled with
+  // cef_v8context_precompile_script() ("precompiled_scripts") and the number of
+  // times they have been run ("precompiled_script_runs"). The "heap" dictionary
+  // contains the V8 heap statistics of the thread ("total_heap_size",
+  // "total_heap_size_executable", "total_physical_size", "used_heap_size" and
+  // "heap_size_limit"). Byte counts are stored as double values.
+  ///
+  struct _cef_dictionary_value_t* (CEF_CALLBACK *get_statistics)(
+      struct _cef_v8context_t* self);
 } cef_v8context_t;
 
 
@@ -149,6 +169,43 @@ CEF_EXPORT cef_v8context_t* cef_v8context_get_entered_context();
 ///
 CEF_EXPORT int cef_v8context_in_context();
 
+///
+// Compile |code| and add it to the compiled script cache of the current thread.
+// Later calls to cef_frame_t::execute_java_script() for frames of this thread
+// with the same |code|, |script_url| and |start_line| will run the cached
+// script in the frame instead of parsing |code| again. Use this function for
+// scripts that are injected into many frames. |cached_data| is optional data
+// returned by cef_v8context_get_script_cache_data() for the same |code|,
+// possibly in a previous run of the application, that is used to speed up
+// compilation. Returns true (1) if |code| was compiled successfully. This
+// function must be called while a context is entered, for example from
+// cef_render_process_handler_t::on_context_created().
+///
+CEF_EXPORT int cef_v8context_precompile_script(const cef_string_t* code,
+    const cef_string_t* script_url, int start_line,
+    struct _cef_binary_value_t* cached_data);
+
+///
+// Returns data for |code| that can be persisted, for example to disk, and
+// passed to cef_v8context_precompile_script() in a later run of the application
+// to speed up compilation. Returns NULL if |code| contains syntax errors.
+///
+CEF_EXPORT struct _cef_binary_value_t* cef_v8context_get_script_cache_data(
+    const cef_string_t* code);
+
+///
+// Set the soft budget for V8 wrappers on the current thread.
+// |persistent_handle_limit| is the maximum number of V8 handles kept alive by
+// cef_v8value_t objects and |tracked_memory_limit| is the maximum number of
+// bytes of user data owned by cef_v8value_t objects. A value of 0 disables the
+// corresponding limit. Both limits are disabled by default. When a limit is
+// exceeded a garbage collection is requested. If the limit is still exceeded on
+// the render process main thread
+// cef_render_process_handler_t::on_v8wrapper_budget_exceeded() will be called.
+///
+CEF_EXPORT void cef_v8context_set_wrapper_budget(int persistent_handle_limit,
+    int64 tracked_memory_limit);
+
 
 ///
 // Structure that should be implemented to handle V8 function calls. The
@@ -175,6 +232,59 @@ typedef struct _cef_v8handler_t {
 } cef_v8handler_t;
 
 
+///
+// Structure that should be implemented to handle V8 function calls with a fixed
+// signature. Use cef_v8value_t::cef_v8value_create_fast_function() to create a
+// function that calls this structure. The signature is retrieved once when the
+// function is created. Arguments are converted to the declared types and passed
+// by value so that no cef_v8value_t objects are created for each call.
+// Arguments are still copied when passed to the client so a call allocates
+// memory for its number arguments and for each of its string arguments. The
+// functions of this structure will be called on the thread associated with the
+// V8 function.
+///
+typedef struct _cef_v8fast_handler_t {
+  ///
+  // Base structure.
+  ///
+  cef_base_t base;
+
+  ///
+  // Return the number of arguments accepted by the function. Additional
+  // arguments passed from JavaScript will be ignored and missing arguments will
+  // be passed as 0 or an NULL string.
+  ///
+  int (CEF_CALLBACK *get_argument_count)(struct _cef_v8fast_handler_t* self);
+
+  ///
+  // Return the type of the argument at the specified 0-based |index|. Must not
+  // be V8_FAST_TYPE_VOID.
+  ///
+  cef_v8_fast_type_t (CEF_CALLBACK *get_argument_type)(
+      struct _cef_v8fast_handler_t* self, int index);
+
+  ///
+  // Return the type of the function return value.
+  ///
+  cef_v8_fast_type_t (CEF_CALLBACK *get_return_type)(
+      struct _cef_v8fast_handler_t* self);
+
+  ///
+  // Handle execution of the function identified by |name|. Arguments of type
+  // bool, int and double are passed in order of declaration in |numbers| and
+  // arguments of type string are passed in order of declaration in |strings|.
+  // If execution succeeds set |number_retval| or |string_retval|, depending on
+  // the declared return type, to the function return value. If execution fails
+  // set |exception| to the exception that will be thrown. Return true (1) if
+  // execution was handled.
+  ///
+  int (CEF_CALLBACK *execute)(struct _cef_v8fast_handler_t* self,
+      const cef_string_t* name, size_t numbersCount, double const* numbers,
+      cef_string_list_t strings, double* number_retval,
+      cef_string_t* string_retval, cef_string_t* exception);
+} cef_v8fast_handler_t;
+
+
 ///
 // Structure that should be implemented to handle V8 accessor calls. Accessor
 // identifiers are registered by calling cef_v8value_t::set_value_byaccessor().
@@ -350,6 +460,16 @@ typedef struct _cef_v8value_t {
   ///
   int (CEF_CALLBACK *is_function)(struct _cef_v8value_t* self);
 
+  ///
+  // True if the value type is ArrayBuffer.
+  ///
+  int (CEF_CALLBACK *is_array_buffer)(struct _cef_v8value_t* self);
+
+  ///
+  // True if the value type is a typed array such as Uint8Array or Float32Array.
+  ///
+  int (CEF_CALLBACK *is_typed_array)(struct _cef_v8value_t* self);
+
   ///
   // Returns true (1) if this object is pointing to the same handle as |that|
   // object.
@@ -519,6 +639,30 @@ typedef struct _cef_v8value_t {
   int (CEF_CALLBACK *get_keys)(struct _cef_v8value_t* self,
       cef_string_list_t keys);
 
+  ///
+  // Returns a new dictionary containing a deep copy of this object's own
+  // enumerable properties. Nested arrays and objects are converted to lists and
+  // dictionaries, Date values to the number of milliseconds since the epoch and
+  // ArrayBuffer and typed array contents to binary values. Functions and
+  // undefined properties are skipped. Objects that are already being converted
+  // (cycles) or that are nested more than 100 levels deep are converted to
+  // null. Returns NULL if this value is an array or an exception is thrown,
+  // including by a property getter. Use get_exception() to retrieve the
+  // exception.
+  ///
+  struct _cef_dictionary_value_t* (CEF_CALLBACK *to_dictionary)(
+      struct _cef_v8value_t* self);
+
+  ///
+  // Returns a new list containing a deep copy of this array's elements. Values
+  // are converted as described for to_dictionary() except that functions and
+  // undefined elements are converted to null so that indexes are preserved.
+  // Returns NULL if this value is not an array or an exception is thrown,
+  // including by an element getter.
+  ///
+  struct _cef_list_value_t* (CEF_CALLBACK *to_list)(
+      struct _cef_v8value_t* self);
+
   ///
   // Sets the user data for this object and returns true (1) on success. Returns
   // false (0) if this function is called incorrectly. This function can only be
@@ -563,6 +707,24 @@ typedef struct _cef_v8value_t {
   int (CEF_CALLBACK *get_array_length)(struct _cef_v8value_t* self);
 
 
+  // ARRAY BUFFER METHODS - These functions are only available on ArrayBuffers
+  // and typed arrays.
+
+  ///
+  // Returns a pointer to the first byte of the data. For a typed array this is
+  // the first byte of the view into its ArrayBuffer. The data may be read and
+  // written directly and remains valid while a reference to the JavaScript
+  // object exists. Returns NULL if the data has a length of 0.
+  ///
+  void* (CEF_CALLBACK *get_array_buffer_data)(struct _cef_v8value_t* self);
+
+  ///
+  // Returns the length of the data in bytes.
+  ///
+  size_t (CEF_CALLBACK *get_array_buffer_byte_length)(
+      struct _cef_v8value_t* self);
+
+
   // FUNCTION METHODS - These functions are only available on functions.
 
   ///
@@ -678,6 +840,53 @@ CEF_EXPORT cef_v8value_t* cef_v8value_create_array(int length);
 CEF_EXPORT cef_v8value_t* cef_v8value_create_function(const cef_string_t* name,
     cef_v8handler_t* handler);
 
+///
+// Create a new cef_v8value_t object of type function that calls |handler| with
+// arguments converted to the signature declared by |handler|. The receiver
+// ('this' object) is not passed to |handler| and get_function_handler() will
+// return NULL for the function. This function should only be called from within
+// the scope of a cef_v8context_tHandler, cef_v8handler_t or cef_v8accessor_t
+// callback, or in combination with calling enter() and exit() on a stored
+// cef_v8context_t reference.
+///
+CEF_EXPORT cef_v8value_t* cef_v8value_create_fast_function(
+    const cef_string_t* name, cef_v8fast_handler_t* handler);
+
+///
+// Create a new cef_v8value_t object of type ArrayBuffer with zero-filled
+// contents of |length| bytes. Fill the contents in place using the pointer
+// returned by get_array_buffer_data() to avoid copying the data. The contents
+// are owned by JavaScript so the ArrayBuffer may be passed to any DOM function.
+// |length| may not exceed 2^31 - 1 bytes. This function should only be called
+// from within the scope of a cef_v8context_tHandler, cef_v8handler_t or
+// cef_v8accessor_t callback, or in combination with calling enter() and exit()
+// on a stored cef_v8context_t reference.
+///
+CEF_EXPORT cef_v8value_t* cef_v8value_create_array_buffer(size_t length);
+
+///
+// Create a new cef_v8value_t object of type object from the contents of
+// |value|. Nested dictionaries and lists are converted to objects and arrays
+// and binary values are copied into new ArrayBuffers. Returns NULL if |value|
+// is invalid. This function should only be called from within the scope of a
+// cef_v8context_tHandler, cef_v8handler_t or cef_v8accessor_t callback, or in
+// combination with calling enter() and exit() on a stored cef_v8context_t
+// reference.
+///
+CEF_EXPORT cef_v8value_t* cef_v8value_create_from_dictionary(
+    struct _cef_dictionary_value_t* value);
+
+///
+// Create a new cef_v8value_t object of type array from the contents of |value|.
+// Values are converted as described for cef_v8value_create_from_dictionary().
+// Returns NULL if |value| is invalid. This function should only be called from
+// within the scope of a cef_v8context_tHandler, cef_v8handler_t or
+// cef_v8accessor_t callback, or in combination with calling enter() and exit()
+// on a stored cef_v8context_t reference.
+///
+CEF_EXPORT cef_v8value_t* cef_v8value_create_from_list(
+    struct _cef_list_value_t* value);
+
 
 ///
 // Structure representing a V8 stack trace handle. V8 handles can only be
@@ -129,6 +129,15 @@ typedef struct _cef_dictionary_value_t {
   struct _cef_dictionary_value_t* (CEF_CALLBACK *copy)(
       struct _cef_dictionary_value_t* self, int exclude_empty_children);
 
+  ///
+  // Returns a read-only snapshot of this object. The snapshot and any values
+  // returned by it are immutable and can be read concurrently from any thread
+  // without locking. Use a snapshot when large values are read frequently or
+  // from multiple threads.
+  ///
+  struct _cef_dictionary_value_t* (CEF_CALLBACK *create_snapshot)(
+      struct _cef_dictionary_value_t* self);
+
   ///
   // Returns the number of values.
   ///
@@ -158,6 +167,36 @@ typedef struct _cef_dictionary_value_t {
   int (CEF_CALLBACK *remove)(struct _cef_dictionary_value_t* self,
       const cef_string_t* key);
 
+  ///
+  // Removes the binary value at the specified key and returns it without
+  // copying. The returned value is not owned by any other object. Returns NULL
+  // if the value at the specified key is not of type binary.
+  ///
+  struct _cef_binary_value_t* (CEF_CALLBACK *detach_binary)(
+      struct _cef_dictionary_value_t* self, const cef_string_t* key);
+
+  ///
+  // Removes the dictionary value at the specified key and returns it without
+  // copying. The returned value is writable and not owned by any other object
+  // so it can be moved into another value or a process message argument list
+  // without copying. Existing references to the removed value or its children
+  // will be invalidated. Returns NULL if the value at the specified key is not
+  // of type dict.
+  ///
+  struct _cef_dictionary_value_t* (CEF_CALLBACK *detach_dictionary)(
+      struct _cef_dictionary_value_t* self, const cef_string_t* key);
+
+  ///
+  // Removes the list value at the specified key and returns it without copying.
+  // The returned value is writable and not owned by any other object so it can
+  // be moved into another value or a process message argument list without
+  // copying. Existing references to the removed value or its children will be
+  // invalidated. Returns NULL if the value at the specified key is not of type
+  // list.
+  ///
+  struct _cef_list_value_t* (CEF_CALLBACK *detach_list)(
+      struct _cef_dictionary_value_t* self, const cef_string_t* key);
+
   ///
   // Returns the value type for the specified key.
   ///
@@ -258,7 +297,9 @@ typedef struct _cef_dictionary_value_t {
   // will no longer be valid. If |value| is currently owned by another object
   // then the value will be copied and the |value| reference will not change.
   // Otherwise, ownership will be transferred to this object and the |value|
-  // reference will be invalidated.
+  // reference will be invalidated. No copy is made when ownership is
+  // transferred and existing references to values contained in |value| remain
+  // valid.
   ///
   int (CEF_CALLBACK *set_dictionary)(struct _cef_dictionary_value_t* self,
       const cef_string_t* key, struct _cef_dictionary_value_t* value);
@@ -269,7 +310,9 @@ typedef struct _cef_dictionary_value_t {
   // will no longer be valid. If |value| is currently owned by another object
   // then the value will be copied and the |value| reference will not change.
   // Otherwise, ownership will be transferred to this object and the |value|
-  // reference will be invalidated.
+  // reference will be invalidated. No copy is made when ownership is
+  // transferred and existing references to values contained in |value| remain
+  // valid.
   ///
   int (CEF_CALLBACK *set_list)(struct _cef_dictionary_value_t* self,
       const cef_string_t* key, struct _cef_list_value_t* value);
@@ -314,6 +357,15 @@ typedef struct _cef_list_value_t {
   struct _cef_list_value_t* (CEF_CALLBACK *copy)(
       struct _cef_list_value_t* self);
 
+  ///
+  // Returns a read-only snapshot of this object. The snapshot and any values
+  // returned by it are immutable and can be read concurrently from any thread
+  // without locking. Use a snapshot when large values are read frequently or
+  // from multiple threads.
+  ///
+  struct _cef_list_value_t* (CEF_CALLBACK *create_snapshot)(
+      struct _cef_list_value_t* self);
+
   ///
   // Sets the number of values. If the number of values is expanded all new
   // value slots will default to type null. Returns true (1) on success.
@@ -335,6 +387,36 @@ typedef struct _cef_list_value_t {
   ///
   int (CEF_CALLBACK *remove)(struct _cef_list_value_t* self, int index);
 
+  ///
+  // Removes the binary value at the specified index and returns it without
+  // copying. The returned value is not owned by any other object. Returns NULL
+  // if the value at the specified index is not of type binary.
+  ///
+  struct _cef_binary_value_t* (CEF_CALLBACK *detach_binary)(
+      struct _cef_list_value_t* self, int index);
+
+  ///
+  // Removes the dictionary value at the specified index and returns it without
+  // copying. The returned value is writable and not owned by any other object
+  // so it can be moved into another value or a process message argument list
+  // without copying. Existing references to the removed value or its children
+  // will be invalidated. Returns NULL if the value at the specified index is
+  // not of type dict.
+  ///
+  struct _cef_dictionary_value_t* (CEF_CALLBACK *detach_dictionary)(
+      struct _cef_list_value_t* self, int index);
+
+  ///
+  // Removes the list value at the specified index and returns it without
+  // copying. The returned value is writable and not owned by any other object
+  // so it can be moved into another value or a process message argument list
+  // without copying. Existing references to the removed value or its children
+  // will be invalidated. Returns NULL if the value at the specified index is
+  // not of type list.
+  ///
+  struct _cef_list_value_t* (CEF_CALLBACK *detach_list)(
+      struct _cef_list_value_t* self, int index);
+
   ///
   // Returns the value type at the specified index.
   ///
@@ -432,7 +514,9 @@ typedef struct _cef_list_value_t {
   // will no longer be valid. If |value| is currently owned by another object
   // then the value will be copied and the |value| reference will not change.
   // Otherwise, ownership will be transferred to this object and the |value|
-  // reference will be invalidated.
+  // reference will be invalidated. No copy is made when ownership is
+  // transferred and existing references to values contained in |value| remain
+  // valid.
   ///
   int (CEF_CALLBACK *set_dictionary)(struct _cef_list_value_t* self, int index,
       struct _cef_dictionary_value_t* value);
@@ -443,7 +527,9 @@ typedef struct _cef_list_value_t {
   // will no longer be valid. If |value| is currently owned by another object
   // then the value will be copied and the |value| reference will not change.
   // Otherwise, ownership will be transferred to this object and the |value|
-  // reference will be invalidated.
+  // reference will be invalidated. No copy is made when ownership is
+  // transferred and existing references to values contained in |value| remain
+  // valid.
   ///
   int (CEF_CALLBACK *set_list)(struct _cef_list_value_t* self, int index,
       struct _cef_list_value_t* value);
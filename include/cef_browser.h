@@ -181,11 +181,27 @@ class CefBrowser : public virtual CefBase {
 
   //
   // Send a message to the specified |target_process|. Returns true if the
-  // message was sent successfully.
+  // message was sent successfully. In the browser process a message sent from
+  // a thread other than the UI thread is delivered asynchronously and true is
+  // returned if the message is valid.
   ///
   /*--cef()--*/
   virtual bool SendProcessMessage(CefProcessId target_process,
                                   CefRefPtr<CefProcessMessage> message) =0;
+
+  ///
+  // Send multiple messages to the specified |target_process| using a single
+  // IPC message. The messages are delivered to OnProcessMessageReceived in
+  // order as if they had been sent individually with SendProcessMessage.
+  // Messages with a shared memory segment or packed arguments are sent
+  // individually, still in order, so that the segment can be transferred and
+  // the arguments stay packed. Returns true if all messages were sent
+  // successfully. No messages are sent if any message is invalid.
+  ///
+  /*--cef()--*/
+  virtual bool SendProcessMessages(
+      CefProcessId target_process,
+      const std::vector<CefRefPtr<CefProcessMessage> >& messages) =0;
 };
 
 
@@ -438,6 +454,43 @@ class CefBrowserHost : public virtual CefBase {
   /*--cef()--*/
   virtual void Invalidate(const CefRect& dirtyRect, PaintElementType type) =0;
 
+  ///
+  // Returns the total number of pixel bytes delivered to
+  // CefRenderHandler::OnPaint and CefRenderHandler::OnPaintSpan. When OnPaint
+  // is used the full buffer size is counted for each call. This method is only
+  // used when window rendering is disabled.
+  ///
+  /*--cef()--*/
+  virtual int64 GetPaintDeliveredBytes() =0;
+
+  ///
+  // Returns the total number of pixel bytes that would have been delivered if
+  // every paint had included the whole view. Compare with
+  // GetPaintDeliveredBytes to measure the savings of OnPaintSpan delivery.
+  // This method is only used when window rendering is disabled.
+  ///
+  /*--cef()--*/
+  virtual int64 GetPaintViewBytes() =0;
+
+  ///
+  // Limit the rate at which CefRenderHandler::OnPaint (or OnPaintSpan) will be
+  // called to at most |frame_rate| times per second. Dirty regions that arrive
+  // between frames are combined and delivered together on the next frame.
+  // Specify a value <= 0 to deliver each update immediately (the default).
+  // This method is only used when window rendering is disabled.
+  ///
+  /*--cef()--*/
+  virtual void SetWindowlessFrameRate(int frame_rate) =0;
+
+  ///
+  // Immediately deliver any dirty regions that are being held back by the
+  // frame rate set via SetWindowlessFrameRate. Call this after forwarding
+  // interactive input to avoid waiting for the next frame. This method is only
+  // used when window rendering is disabled.
+  ///
+  /*--cef()--*/
+  virtual void FlushWindowlessPaint() =0;
+
   ///
   // Send a key event to the browser.
   ///
@@ -86,6 +86,61 @@ class CefProcessMessage : public virtual CefBase {
   ///
   /*--cef()--*/
   virtual CefRefPtr<CefListValue> GetArgumentList() =0;
+
+  ///
+  // Set whether the argument list is sent in the packed format. The packed
+  // format stores all arguments in a single contiguous buffer with shared
+  // dictionary keys and avoids copying the argument list when the message is
+  // sent. The receiver reads values directly from the buffer via a read-only
+  // argument list. This is recommended for messages with large or deeply
+  // nested arguments. Sending fails if packed arguments are nested more than
+  // 100 levels deep.
+  ///
+  /*--cef()--*/
+  virtual void SetArgumentListPacked(bool packed) =0;
+
+  ///
+  // Returns true if the argument list is sent or was received in the packed
+  // format.
+  ///
+  /*--cef()--*/
+  virtual bool IsArgumentListPacked() =0;
+
+  ///
+  // Create a shared memory segment of |size| bytes and attach it to this
+  // message, replacing any existing segment. Returns a pointer to the writable
+  // memory or NULL on failure. When the message is sent the segment is handed
+  // to the target process without copying or serialization and is no longer
+  // attached to this message. If the message cannot be sent the segment is
+  // released. Segments are not included by Copy().
+  ///
+  /*--cef()--*/
+  virtual void* CreateSharedMemory(size_t size) =0;
+
+  ///
+  // Returns the attached shared memory segment or NULL if no segment is
+  // attached. The segment of a received message is released after
+  // OnProcessMessageReceived returns unless it is moved to another message
+  // using MoveSharedMemory.
+  ///
+  /*--cef()--*/
+  virtual void* GetSharedMemory() =0;
+
+  ///
+  // Returns the size of the attached shared memory segment in bytes or 0 if no
+  // segment is attached.
+  ///
+  /*--cef()--*/
+  virtual size_t GetSharedMemorySize() =0;
+
+  ///
+  // Move the attached shared memory segment to |target|, replacing any segment
+  // attached to |target|. The memory is not copied and pointers returned by
+  // GetSharedMemory remain valid. |target| must be writable but this message
+  // may be read-only. Returns true on success.
+  ///
+  /*--cef()--*/
+  virtual bool MoveSharedMemory(CefRefPtr<CefProcessMessage> target) =0;
 };
 
 #endif  // CEF_INCLUDE_CEF_MESSAGE_H_
@@ -139,6 +139,17 @@ class CefRenderProcessHandler : public virtual CefBase {
                                    CefRefPtr<CefV8Exception> exception,
                                    CefRefPtr<CefV8StackTrace> stackTrace) {}
 
+  ///
+  // Called when the wrapper budget set with CefV8Context::SetWrapperBudget() is
+  // still exceeded after a garbage collection. |statistics| has the format
+  // described in CefV8Context::GetStatistics() without the "context"
+  // dictionary. This method will not be called again until usage drops below
+  // the budget.
+  ///
+  /*--cef()--*/
+  virtual void OnV8WrapperBudgetExceeded(
+      CefRefPtr<CefDictionaryValue> statistics) {}
+
   ///
   // Called when a new node in the the browser gets focus. The |node| value may
   // be empty if no specific node has gained focus. The node object passed to
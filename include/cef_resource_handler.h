@@ -44,6 +44,7 @@
 #include "include/cef_cookie.h"
 #include "include/cef_request.h"
 #include "include/cef_response.h"
+#include "include/cef_values.h"
 
 ///
 // Class used to implement a custom request handler interface. The methods of
@@ -78,6 +79,19 @@ class CefResourceHandler : public virtual CefBase {
                                   int64& response_length,
                                   CefString& redirectUrl) =0;
 
+  ///
+  // Optionally return the response data as a read-only binary value instead of
+  // copying it in ReadResponse(). This allows handlers that already hold the
+  // complete response (for example, in a cache) to share the same value between
+  // requests. This method is called after GetResponseHeaders() and again each
+  // time the previously returned value has been read completely, so the
+  // response may be provided as a sequence of values. Return NULL to indicate
+  // completion of the response. If NULL is returned from the first call
+  // ReadResponse() will be used instead.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefBinaryValue> GetResponseData() { return NULL; }
+
   ///
   // Read response data. If data is available immediately copy up to
   // |bytes_to_read| bytes into |data_out|, set |bytes_read| to the number of
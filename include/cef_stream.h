@@ -95,6 +95,19 @@ class CefStreamReader : public virtual CefBase {
   /*--cef()--*/
   static CefRefPtr<CefStreamReader> CreateForFile(const CefString& fileName);
   ///
+  // Create a new CefStreamReader object from a file that is mapped into memory
+  // instead of being read with buffered file IO. Reads may fault in pages from
+  // disk so MayBlock() returns true. Returns NULL if the file cannot be opened
+  // or mapped or if the file has a size of zero. Only use this method for
+  // trusted files that the application controls. The file must not be
+  // truncated while the reader exists because accessing the mapping beyond
+  // the new end of the file terminates the process (SIGBUS on POSIX systems).
+  // The same applies to the mapping returned by GetData().
+  ///
+  /*--cef()--*/
+  static CefRefPtr<CefStreamReader> CreateForMappedFile(
+      const CefString& fileName);
+  ///
   // Create a new CefStreamReader object from data.
   ///
   /*--cef()--*/
@@ -139,6 +152,24 @@ class CefStreamReader : public virtual CefBase {
   ///
   /*--cef()--*/
   virtual bool MayBlock() =0;
+
+  ///
+  // Returns a read-only pointer to the beginning of the stream data if this
+  // reader was created using CreateForData or CreateForMappedFile, or NULL
+  // otherwise. The pointer remains valid for the lifespan of this reader and
+  // can be used together with GetDataSize(), Tell() and Seek() to consume the
+  // data without copying it. If MayBlock() returns true accessing the data may
+  // block so it should only be accessed on threads that allow blocking.
+  ///
+  /*--cef()--*/
+  virtual const void* GetData() =0;
+
+  ///
+  // Returns the size in bytes of the data returned by GetData(), or 0 if
+  // GetData() returns NULL.
+  ///
+  /*--cef()--*/
+  virtual size_t GetDataSize() =0;
 };
 
 
@@ -163,6 +163,31 @@ class CefURLRequestClient : public virtual CefBase {
                               const void* data,
                               size_t data_length) =0;
 
+  ///
+  // Return the maximum number of response bytes that may be waiting for
+  // delivery to OnDownloadData() before reading from the network is paused.
+  // Data received while previous data is still waiting for delivery may be
+  // combined into a single OnDownloadData() call. Return 0 to use the default
+  // size or 1 to deliver each chunk of data before the next chunk is read.
+  // This method is called once when the request is started and is only used
+  // for requests initiated from the browser process.
+  ///
+  /*--cef()--*/
+  virtual size_t GetDownloadWindowSize() { return 0; }
+
+  ///
+  // Return a file path to write the response data directly to that file on the
+  // FILE thread instead of delivering it to OnDownloadData(). Any existing file
+  // at the path will be replaced and the file will be deleted if the request
+  // does not succeed. OnDownloadProgress() will still be called. Return a
+  // zero-length string to receive OnDownloadData() callbacks instead. This
+  // method is called once when the request is started, is not called if the
+  // UR_FLAG_NO_DOWNLOAD_DATA flag is set on the request and is only used for
+  // requests initiated from the browser process.
+  ///
+  /*--cef()--*/
+  virtual CefString GetDownloadFilePath() { return CefString(); }
+
   ///
   // Called on the IO thread when the browser needs credentials from the user.
   // |isProxy| indicates whether the host is a proxy server. |host| contains the
@@ -43,9 +43,11 @@
 #include "include/cef_browser.h"
 #include "include/cef_frame.h"
 #include "include/cef_task.h"
+#include "include/cef_values.h"
 #include <vector>
 
 class CefV8Exception;
+class CefV8FastHandler;
 class CefV8Handler;
 class CefV8StackFrame;
 class CefV8Value;
@@ -144,6 +146,46 @@ class CefV8Context : public virtual CefBase {
   /*--cef()--*/
   static bool InContext();
 
+  ///
+  // Compile |code| and add it to the compiled script cache of the current
+  // thread. Later calls to CefFrame::ExecuteJavaScript() for frames of this
+  // thread with the same |code|, |script_url| and |start_line| will run the
+  // cached script in the frame instead of parsing |code| again. Use this
+  // method for scripts that are injected into many frames. |cached_data| is
+  // optional data returned by GetScriptCacheData() for the same |code|,
+  // possibly in a previous run of the application, that is used to speed up
+  // compilation. Returns true if |code| was compiled successfully. This method
+  // must be called while a context is entered, for example from
+  // CefRenderProcessHandler::OnContextCreated().
+  ///
+  /*--cef(optional_param=script_url,optional_param=cached_data)--*/
+  static bool PrecompileScript(const CefString& code,
+                               const CefString& script_url,
+                               int start_line,
+                               CefRefPtr<CefBinaryValue> cached_data);
+
+  ///
+  // Returns data for |code| that can be persisted, for example to disk, and
+  // passed to PrecompileScript() in a later run of the application to speed up
+  // compilation. Returns NULL if |code| contains syntax errors.
+  ///
+  /*--cef()--*/
+  static CefRefPtr<CefBinaryValue> GetScriptCacheData(const CefString& code);
+
+  ///
+  // Set the soft budget for V8 wrappers on the current thread.
+  // |persistent_handle_limit| is the maximum number of V8 handles kept alive by
+  // CefV8Value objects and |tracked_memory_limit| is the maximum number of
+  // bytes of user data owned by CefV8Value objects.
+  // A value of 0 disables the corresponding limit. Both limits are disabled by
+  // default. When a limit is exceeded a garbage collection is requested. If the
+  // limit is still exceeded on the render process main thread
+  // CefRenderProcessHandler::OnV8WrapperBudgetExceeded() will be called.
+  ///
+  /*--cef()--*/
+  static void SetWrapperBudget(int persistent_handle_limit,
+                               int64 tracked_memory_limit);
+
   ///
   // Returns the task runner associated with this context. V8 handles can only
   // be accessed from the thread on which they are created. This method can be
@@ -215,6 +257,24 @@ class CefV8Context : public virtual CefBase {
   virtual bool Eval(const CefString& code,
                     CefRefPtr<CefV8Value>& retval,
                     CefRefPtr<CefV8Exception>& exception) =0;
+
+  ///
+  // Returns statistics for the V8 wrappers of this context and of the thread
+  // that owns it. The "context" dictionary contains the number of live
+  // CefV8Value objects ("values"), CefV8Context objects ("contexts"), V8
+  // handles kept alive by CefV8Value objects ("persistent_handles") and
+  // objects tracked for cleanup when the context is released
+  // ("tracked_objects"). The "isolate" dictionary contains the same counts for
+  // the whole thread and the number of bytes of externally allocated memory
+  // owned by wrappers ("tracked_bytes"), the number of scripts compiled with
+  // PrecompileScript() ("precompiled_scripts") and the number of times they
+  // have been run ("precompiled_script_runs"). The "heap" dictionary contains
+  // the V8 heap statistics of the thread ("total_heap_size",
+  // "total_heap_size_executable", "total_physical_size", "used_heap_size" and
+  // "heap_size_limit"). Byte counts are stored as double values.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefDictionaryValue> GetStatistics() =0;
 };
 
 
@@ -242,6 +302,60 @@ class CefV8Handler : public virtual CefBase {
                        CefString& exception) =0;
 };
 
+///
+// Interface that should be implemented to handle V8 function calls with a
+// fixed signature. Use CefV8Value::CreateFastFunction() to create a function
+// that calls this interface. The signature is retrieved once when the function
+// is created. Arguments are converted to the declared types and passed by
+// value so that no CefV8Value objects are created for each call. Arguments are
+// still copied when passed to the client so a call allocates memory for its
+// number arguments and for each of its string arguments. The methods of this
+// class will be called on the thread associated with the V8 function.
+///
+/*--cef(source=client)--*/
+class CefV8FastHandler : public virtual CefBase {
+ public:
+  typedef cef_v8_fast_type_t Type;
+
+  ///
+  // Return the number of arguments accepted by the function. Additional
+  // arguments passed from JavaScript will be ignored and missing arguments
+  // will be passed as 0 or an empty string.
+  ///
+  /*--cef()--*/
+  virtual int GetArgumentCount() =0;
+
+  ///
+  // Return the type of the argument at the specified 0-based |index|. Must not
+  // be V8_FAST_TYPE_VOID.
+  ///
+  /*--cef(default_retval=V8_FAST_TYPE_VOID)--*/
+  virtual Type GetArgumentType(int index) =0;
+
+  ///
+  // Return the type of the function return value.
+  ///
+  /*--cef(default_retval=V8_FAST_TYPE_VOID)--*/
+  virtual Type GetReturnType() =0;
+
+  ///
+  // Handle execution of the function identified by |name|. Arguments of type
+  // bool, int and double are passed in order of declaration in |numbers| and
+  // arguments of type string are passed in order of declaration in |strings|.
+  // If execution succeeds set |number_retval| or |string_retval|, depending on
+  // the declared return type, to the function return value. If execution fails
+  // set |exception| to the exception that will be thrown. Return true if
+  // execution was handled.
+  ///
+  /*--cef()--*/
+  virtual bool Execute(const CefString& name,
+                       const std::vector<double>& numbers,
+                       const std::vector<CefString>& strings,
+                       double& number_retval,
+                       CefString& string_retval,
+                       CefString& exception) =0;
+};
+
 ///
 // Interface that should be implemented to handle V8 accessor calls. Accessor
 // identifiers are registered by calling CefV8Value::SetValue(). The methods
@@ -433,6 +547,57 @@ class CefV8Value : public virtual CefBase {
   static CefRefPtr<CefV8Value> CreateFunction(const CefString& name,
                                               CefRefPtr<CefV8Handler> handler);
 
+  ///
+  // Create a new CefV8Value object of type function that calls |handler| with
+  // arguments converted to the signature declared by |handler|. The receiver
+  // ('this' object) is not passed to |handler| and GetFunctionHandler() will
+  // return NULL for the function. This method should only be called from
+  // within the scope of a CefV8ContextHandler, CefV8Handler or CefV8Accessor
+  // callback, or in combination with calling Enter() and Exit() on a stored
+  // CefV8Context reference.
+  ///
+  /*--cef()--*/
+  static CefRefPtr<CefV8Value> CreateFastFunction(
+      const CefString& name,
+      CefRefPtr<CefV8FastHandler> handler);
+
+  ///
+  // Create a new CefV8Value object of type ArrayBuffer with zero-filled
+  // contents of |length| bytes. Fill the contents in place using the pointer
+  // returned by GetArrayBufferData() to avoid copying the data. The contents
+  // are owned by JavaScript so the ArrayBuffer may be passed to any DOM
+  // method. |length| may not exceed 2^31 - 1 bytes. This method should only be
+  // called from within the scope of a CefV8ContextHandler, CefV8Handler or
+  // CefV8Accessor callback, or in combination with calling Enter() and Exit()
+  // on a stored CefV8Context reference.
+  ///
+  /*--cef()--*/
+  static CefRefPtr<CefV8Value> CreateArrayBuffer(size_t length);
+
+  ///
+  // Create a new CefV8Value object of type object from the contents of
+  // |value|. Nested dictionaries and lists are converted to objects and arrays
+  // and binary values are copied into new ArrayBuffers. Returns NULL if |value|
+  // is invalid. This method should only be called from within the scope of a
+  // CefV8ContextHandler, CefV8Handler or CefV8Accessor callback, or in
+  // combination with calling Enter() and Exit() on a stored CefV8Context
+  // reference.
+  ///
+  /*--cef()--*/
+  static CefRefPtr<CefV8Value> CreateFromDictionary(
+      CefRefPtr<CefDictionaryValue> value);
+
+  ///
+  // Create a new CefV8Value object of type array from the contents of |value|.
+  // Values are converted as described for CreateFromDictionary(). Returns NULL
+  // if |value| is invalid. This method should only be called from within the
+  // scope of a CefV8ContextHandler, CefV8Handler or CefV8Accessor callback, or
+  // in combination with calling Enter() and Exit() on a stored CefV8Context
+  // reference.
+  ///
+  /*--cef()--*/
+  static CefRefPtr<CefV8Value> CreateFromList(CefRefPtr<CefListValue> value);
+
   ///
   // Returns true if the underlying handle is valid and it can be accessed on
   // the current thread. Do not call any other methods if this method returns
@@ -507,6 +672,19 @@ class CefV8Value : public virtual CefBase {
   /*--cef()--*/
   virtual bool IsFunction() =0;
 
+  ///
+  // True if the value type is ArrayBuffer.
+  ///
+  /*--cef()--*/
+  virtual bool IsArrayBuffer() =0;
+
+  ///
+  // True if the value type is a typed array such as Uint8Array or
+  // Float32Array.
+  ///
+  /*--cef()--*/
+  virtual bool IsTypedArray() =0;
+
   ///
   // Returns true if this object is pointing to the same handle as |that|
   // object.
@@ -685,6 +863,30 @@ class CefV8Value : public virtual CefBase {
   /*--cef()--*/
   virtual bool GetKeys(std::vector<CefString>& keys) =0;
 
+  ///
+  // Returns a new dictionary containing a deep copy of this object's own
+  // enumerable properties. Nested arrays and objects are converted to lists and
+  // dictionaries, Date values to the number of milliseconds since the epoch and
+  // ArrayBuffer and typed array contents to binary values. Functions and
+  // undefined properties are skipped. Objects that are already being converted
+  // (cycles) or that are nested more than 100 levels deep are converted to
+  // null. Returns NULL if this value is an array or an exception is thrown,
+  // including by a property getter. Use GetException() to retrieve the
+  // exception.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefDictionaryValue> ToDictionary() =0;
+
+  ///
+  // Returns a new list containing a deep copy of this array's elements. Values
+  // are converted as described for ToDictionary() except that functions and
+  // undefined elements are converted to null so that indexes are preserved.
+  // Returns NULL if this value is not an array or an exception is thrown,
+  // including by an element getter.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefListValue> ToList() =0;
+
   ///
   // Sets the user data for this object and returns true on success. Returns
   // false if this method is called incorrectly. This method can only be called
@@ -730,6 +932,25 @@ class CefV8Value : public virtual CefBase {
   virtual int GetArrayLength() =0;
 
 
+  // ARRAY BUFFER METHODS - These methods are only available on ArrayBuffers
+  // and typed arrays.
+
+  ///
+  // Returns a pointer to the first byte of the data. For a typed array this is
+  // the first byte of the view into its ArrayBuffer. The data may be read and
+  // written directly and remains valid while a reference to the JavaScript
+  // object exists. Returns NULL if the data has a length of 0.
+  ///
+  /*--cef()--*/
+  virtual void* GetArrayBufferData() =0;
+
+  ///
+  // Returns the length of the data in bytes.
+  ///
+  /*--cef()--*/
+  virtual size_t GetArrayBufferByteLength() =0;
+
+
   // FUNCTION METHODS - These methods are only available on functions.
 
   ///
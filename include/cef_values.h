@@ -137,6 +137,15 @@ class CefDictionaryValue : public virtual CefBase {
   /*--cef()--*/
   virtual CefRefPtr<CefDictionaryValue> Copy(bool exclude_empty_children) =0;
 
+  ///
+  // Returns a read-only snapshot of this object. The snapshot and any values
+  // returned by it are immutable and can be read concurrently from any thread
+  // without locking. Use a snapshot when large values are read frequently or
+  // from multiple threads.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefDictionaryValue> CreateSnapshot() =0;
+
   ///
   // Returns the number of values.
   ///
@@ -168,6 +177,37 @@ class CefDictionaryValue : public virtual CefBase {
   /*--cef()--*/
   virtual bool Remove(const CefString& key) =0;
 
+  ///
+  // Removes the binary value at the specified key and returns it without
+  // copying. The returned value is not owned by any other object. Returns NULL
+  // if the value at the specified key is not of type binary.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefBinaryValue> DetachBinary(const CefString& key) =0;
+
+  ///
+  // Removes the dictionary value at the specified key and returns it without
+  // copying. The returned value is writable and not owned by any other object
+  // so it can be moved into another value or a process message argument list
+  // without copying. Existing references to the removed value or its children
+  // will be invalidated. Returns NULL if the value at the specified key is not
+  // of type dict.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefDictionaryValue> DetachDictionary(
+      const CefString& key) =0;
+
+  ///
+  // Removes the list value at the specified key and returns it without
+  // copying. The returned value is writable and not owned by any other object
+  // so it can be moved into another value or a process message argument list
+  // without copying. Existing references to the removed value or its children
+  // will be invalidated. Returns NULL if the value at the specified key is not
+  // of type list.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefListValue> DetachList(const CefString& key) =0;
+
   ///
   // Returns the value type for the specified key.
   ///
@@ -269,6 +309,8 @@ class CefDictionaryValue : public virtual CefBase {
   // then the value will be copied and the |value| reference will not change.
   // Otherwise, ownership will be transferred to this object and the |value|
   // reference will be invalidated.
+  // No copy is made when ownership is transferred and existing references to
+  // values contained in |value| remain valid.
   ///
   /*--cef()--*/
   virtual bool SetDictionary(const CefString& key,
@@ -281,6 +323,8 @@ class CefDictionaryValue : public virtual CefBase {
   // then the value will be copied and the |value| reference will not change.
   // Otherwise, ownership will be transferred to this object and the |value|
   // reference will be invalidated.
+  // No copy is made when ownership is transferred and existing references to
+  // values contained in |value| remain valid.
   ///
   /*--cef()--*/
   virtual bool SetList(const CefString& key,
@@ -326,6 +370,15 @@ class CefListValue : public virtual CefBase {
   /*--cef()--*/
   virtual CefRefPtr<CefListValue> Copy() =0;
 
+  ///
+  // Returns a read-only snapshot of this object. The snapshot and any values
+  // returned by it are immutable and can be read concurrently from any thread
+  // without locking. Use a snapshot when large values are read frequently or
+  // from multiple threads.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefListValue> CreateSnapshot() =0;
+
   ///
   // Sets the number of values. If the number of values is expanded all
   // new value slots will default to type null. Returns true on success.
@@ -351,6 +404,36 @@ class CefListValue : public virtual CefBase {
   /*--cef(index_param=index)--*/
   virtual bool Remove(int index) =0;
 
+  ///
+  // Removes the binary value at the specified index and returns it without
+  // copying. The returned value is not owned by any other object. Returns NULL
+  // if the value at the specified index is not of type binary.
+  ///
+  /*--cef(index_param=index)--*/
+  virtual CefRefPtr<CefBinaryValue> DetachBinary(int index) =0;
+
+  ///
+  // Removes the dictionary value at the specified index and returns it without
+  // copying. The returned value is writable and not owned by any other object
+  // so it can be moved into another value or a process message argument list
+  // without copying. Existing references to the removed value or its children
+  // will be invalidated. Returns NULL if the value at the specified index is
+  // not of type dict.
+  ///
+  /*--cef(index_param=index)--*/
+  virtual CefRefPtr<CefDictionaryValue> DetachDictionary(int index) =0;
+
+  ///
+  // Removes the list value at the specified index and returns it without
+  // copying. The returned value is writable and not owned by any other object
+  // so it can be moved into another value or a process message argument list
+  // without copying. Existing references to the removed value or its children
+  // will be invalidated. Returns NULL if the value at the specified index is
+  // not of type list.
+  ///
+  /*--cef(index_param=index)--*/
+  virtual CefRefPtr<CefListValue> DetachList(int index) =0;
+
   ///
   // Returns the value type at the specified index.
   ///
@@ -452,6 +535,8 @@ class CefListValue : public virtual CefBase {
   // then the value will be copied and the |value| reference will not change.
   // Otherwise, ownership will be transferred to this object and the |value|
   // reference will be invalidated.
+  // No copy is made when ownership is transferred and existing references to
+  // values contained in |value| remain valid.
   ///
   /*--cef(index_param=index)--*/
   virtual bool SetDictionary(int index, CefRefPtr<CefDictionaryValue> value) =0;
@@ -463,6 +548,8 @@ class CefListValue : public virtual CefBase {
   // then the value will be copied and the |value| reference will not change.
   // Otherwise, ownership will be transferred to this object and the |value|
   // reference will be invalidated.
+  // No copy is made when ownership is transferred and existing references to
+  // values contained in |value| remain valid.
   ///
   /*--cef(index_param=index)--*/
   virtual bool SetList(int index, CefRefPtr<CefListValue> value) =0;
@@ -834,6 +834,22 @@ typedef enum {
   V8_PROPERTY_ATTRIBUTE_DONTDELETE = 1 << 2   // Not configurable
 } cef_v8_propertyattribute_t;
 
+///
+// V8 fast function argument and return value types. See CefV8FastHandler.
+///
+typedef enum {
+  // Only valid as a return type. The function returns undefined.
+  V8_FAST_TYPE_VOID = 0,
+  // Passed as a number that is either 0 or 1.
+  V8_FAST_TYPE_BOOL,
+  // Passed as a number holding a 32-bit signed integer.
+  V8_FAST_TYPE_INT,
+  // Passed as a number.
+  V8_FAST_TYPE_DOUBLE,
+  // Passed as a string.
+  V8_FAST_TYPE_STRING,
+} cef_v8_fast_type_t;
+
 ///
 // Post data elements may represent either bytes or files.
 ///
@@ -40,7 +40,9 @@
 #include "include/cef_base.h"
 #include "include/cef_browser.h"
 #include "include/cef_process_message.h"
+#include "include/cef_task.h"
 #include "include/cef_v8.h"
+#include "include/cef_values.h"
 
 // The below classes implement support for routing aynchronous messages between
 // JavaScript running in the renderer process and C++ running in the browser
@@ -76,6 +78,14 @@
 // canceled and the associated JavaScript onFailure callback will be executed
 // with an error code of -1.
 //
+// The |request| member may also be an ArrayBuffer, typed array, array or
+// object. Such requests are converted directly to binary, list and dictionary
+// values and delivered to Handler::OnQueryValue instead of Handler::OnQuery. A
+// Handler can likewise respond with Callback::SuccessValue, in which case the
+// onSuccess callback receives an ArrayBuffer, array, object or primitive value
+// instead of a string. This avoids encoding structured data as JSON on one side
+// and parsing it on the other.
+//
 // Queries can be either persistent or non-persistent. If the query is
 // persistent than the callbacks will remain registered until one of the
 // following conditions are met:
@@ -86,6 +96,16 @@
 // C. The context associated with the query is released due to browser
 //    destruction, navigation or renderer process termination.
 //
+// A persistent query may optionally coalesce responses by specifying
+// |coalesce: 'latest'| or |coalesce: 'batch'| in the cefQuery object. The
+// browser then only sends a limited number of responses before the renderer
+// acknowledges that it has executed the onSuccess callback for them. Responses
+// sent by the Handler in the meantime are held in the browser process. With
+// 'latest' only the most recent held response is kept. With 'batch' all held
+// responses are delivered together and onSuccess always receives an array of
+// responses. Callback::IsThrottled returns true while responses are being held
+// so that the Handler can reduce the rate at which it produces responses.
+//
 // If the query is non-persistent then the registration will be removed after
 // the JavaScript callback is executed a single time. If a query is canceled for
 // a reason other than Callback::Failure being executed then the associated
@@ -205,6 +225,11 @@ struct CefMessageRouterConfig {
   // Name of the JavaScript function that will be added to the 'window' object
   // for canceling a pending query. The default value is "cefQueryCancel".
   CefString js_cancel_function;
+
+  // Character that separates the route from the rest of a request string. See
+  // CefMessageRouterBrowserSide::AddHandler. Only used by the browser-side
+  // router. The default value is ':'.
+  char route_delimiter;
 };
 
 ///
@@ -229,21 +254,58 @@ class CefMessageRouterBrowserSide : public CefBase {
     ///
     virtual void Success(const CefString& response) =0;
 
+    ///
+    // Notify the associated JavaScript onSuccess callback that the query has
+    // completed successfully with the value at index 0 of |response|. Binary
+    // values are delivered as an ArrayBuffer, lists as an array, dictionaries
+    // as an object and other types as the equivalent primitive value. Binary,
+    // dictionary and list values are moved out of |response| without copying
+    // so index 0 of |response| is consumed by this method. Values of read-only
+    // lists are copied.
+    ///
+    virtual void SuccessValue(CefRefPtr<CefListValue> response) =0;
+
+    ///
+    // Returns true if the query coalesces responses and the renderer has not
+    // yet consumed the responses already sent. Responses sent while this
+    // method returns true are held and coalesced until the renderer catches
+    // up. Always returns false for queries that don't coalesce responses.
+    ///
+    virtual bool IsThrottled() =0;
+
     ///
     // Notify the associated JavaScript onFailure callback that the query has
-    // failed with the specified |error_code| and |error_message|.
+    // failed with the specified |error_code| and |error_message|. Responses
+    // that are being held for a coalescing query are discarded.
     ///
     virtual void Failure(int error_code, const CefString& error_message) =0;
   };
 
   ///
-  // Implement this interface to handle queries. All methods will be executed on
-  // the browser process UI thread.
+  // Implement this interface to handle queries. OnQuery and OnQueryCanceled
+  // will be executed on the browser process thread returned by GetThreadId.
   ///
   class Handler {
    public:
     typedef CefMessageRouterBrowserSide::Callback Callback;
 
+    ///
+    // Returns the browser process thread that OnQuery and OnQueryCanceled will
+    // be executed on. Called on the browser process UI thread each time the
+    // handler is added. AddHandler will fail if this method returns a thread
+    // that doesn't exist in the browser process or a different thread than
+    // when the handler was previously added. Return a thread other than TID_UI
+    // for handlers that perform blocking work such as file access so that slow
+    // queries don't delay other queries or the browser UI. Queries are offered
+    // to handlers in order so a query declined on one thread will be offered
+    // to the next handler on that handler's thread. If the thread is no longer
+    // running the query is treated as if the handler declined it. A handler
+    // that does not execute on the UI thread may still be executing OnQuery or
+    // OnQueryCanceled when RemoveHandler returns so it should be deleted by a
+    // task posted to its thread.
+    ///
+    virtual CefThreadId GetThreadId() { return TID_UI; }
+
     ///
     // Executed when a new query is received. |query_id| uniquely identifies the
     // query for the life span of the router. Return true to handle the query
@@ -263,6 +325,23 @@ class CefMessageRouterBrowserSide : public CefBase {
       return false;
     }
 
+    ///
+    // Executed when a new query is received with a request that is not a
+    // string. |request| contains a single value at index 0 that is a binary
+    // value for an ArrayBuffer or typed array, a list for an array or a
+    // dictionary for any other object. Queries with a non-string request are
+    // only offered to handlers added without a route. Otherwise behaves the
+    // same as OnQuery.
+    ///
+    virtual bool OnQueryValue(CefRefPtr<CefBrowser> browser,
+                              CefRefPtr<CefFrame> frame,
+                              int64 query_id,
+                              CefRefPtr<CefListValue> request,
+                              bool persistent,
+                              CefRefPtr<Callback> callback) {
+      return false;
+    }
+
     ///
     // Executed when a query has been canceled either explicitly using the
     // JavaScript cancel function or implicitly due to browser destruction,
@@ -289,18 +368,40 @@ class CefMessageRouterBrowserSide : public CefBase {
   // Add a new query handler. If |first| is true it will be added as the first
   // handler, otherwise it will be added as the last handler. Returns true if
   // the handler is added successfully or false if the handler has already been
-  // added. Must be called on the browser process UI thread. The Handler object
-  // must either outlive the router or be removed before deletion.
+  // added or Handler::GetThreadId returns an invalid thread. Must be called on
+  // the browser process UI thread. The Handler object must either outlive the
+  // router or be removed before deletion.
   ///
   virtual bool AddHandler(Handler* handler, bool first) =0;
 
   ///
-  // Remove an existing query handler. Any pending queries associated with the
-  // handler will be canceled. Handler::OnQueryCanceled will be called and the
-  // associated JavaScript onFailure callback will be executed with an error
-  // code of -1. Returns true if the handler is removed successfully or false
-  // if the handler is not found. Must be called on the browser process UI
-  // thread.
+  // Add a new query handler that only receives queries for |route|. The route
+  // of a query is the part of its request string before the first
+  // CefMessageRouterConfig::route_delimiter character, or the whole request
+  // string if it doesn't contain the delimiter. For example, with the default
+  // delimiter the request "getUser:42" has the route "getUser". Queries are
+  // offered to the handlers for their route before the handlers added without
+  // a route. The route is found with a single map lookup so routing is more
+  // efficient than testing the request in each handler when many handlers are
+  // registered. A handler may be added for multiple routes. If |first| is true
+  // it will be added as the first handler for |route|, otherwise it will be
+  // added as the last handler. Returns true if the handler is added
+  // successfully or false if |route| is empty, the handler has already been
+  // added for |route| or Handler::GetThreadId returns an invalid thread. Must
+  // be called on the browser process UI thread. The Handler object must either
+  // outlive the router or be removed before deletion.
+  ///
+  virtual bool AddHandler(Handler* handler,
+                          bool first,
+                          const CefString& route) =0;
+
+  ///
+  // Remove an existing query handler, including all of its routes. Any pending
+  // queries associated with the handler will be canceled.
+  // Handler::OnQueryCanceled will be called and the associated JavaScript
+  // onFailure callback will be executed with an error code of -1. Returns true
+  // if the handler is removed successfully or false if the handler is not
+  // found. Must be called on the browser process UI thread.
   ///
   virtual bool RemoveHandler(Handler* handler) =0;
 
@@ -316,12 +417,25 @@ class CefMessageRouterBrowserSide : public CefBase {
 
   ///
   // Returns the number of queries currently pending for the specified |browser|
-  // and/or |handler|. Either or both values may be empty. Must be called on the
-  // browser process UI thread.
+  // and/or |handler|. Either or both values may be empty.
   ///
   virtual int GetPendingCount(CefRefPtr<CefBrowser> browser,
                               Handler* handler) =0;
 
+  ///
+  // Returns query statistics keyed by route. Queries that don't match a route
+  // added with AddHandler are reported with an empty key. Each value is a
+  // dictionary containing the number of queries received ("query_count"),
+  // the number of queries that no handler accepted ("unhandled_count"), the
+  // number of queries currently pending ("pending_count") and the number of
+  // queries completed via the Callback ("completed_count"). For completed
+  // queries it also contains the total and maximum time in milliseconds
+  // between the query being received and completed ("total_latency_ms" and
+  // "max_latency_ms"). A persistent query completes when Callback::Failure is
+  // executed.
+  ///
+  virtual CefRefPtr<CefDictionaryValue> GetRouteStatistics() =0;
+
 
   // The below methods should be called from other CEF handlers. They must be
   // called exactly as documented for the router to function correctly.
@@ -37,6 +37,9 @@
 #define CEF_INCLUDE_WRAPPER_CEF_STREAM_RESOURCE_HANDLER_H_
 #pragma once
 
+#include <deque>
+#include <string>
+
 #include "include/cef_base.h"
 #include "include/cef_resource_handler.h"
 #include "include/cef_response.h"
@@ -45,6 +48,13 @@ class CefStreamReader;
 
 ///
 // Implementation of the CefResourceHandler class for reading from a CefStream.
+// If the stream may block it is read on the FILE thread into a small set of
+// buffers ahead of ReadResponse() calls. If the stream provides direct access
+// to its data (see CefStreamReader::GetData) the data is copied from memory
+// without reading through the stream and the response length is reported.
+// Requests with a single byte range "Range" header
+// receive a 206 response when the stream supports seeking and the default
+// 200 status code is used.
 ///
 class CefStreamResourceHandler : public CefResourceHandler {
  public:
@@ -77,8 +87,28 @@ class CefStreamResourceHandler : public CefResourceHandler {
   virtual void Cancel() OVERRIDE;
 
  private:
-  void ReadOnFileThread(int bytes_to_read,
-                        CefRefPtr<CefCallback> callback);
+  class Buffer;
+  typedef std::deque<Buffer*> BufferQueue;
+
+  void InitData();
+
+  // Apply the byte range from the "Range" header |value| by seeking the
+  // stream.
+  void ApplyRange(const std::string& value);
+  void ApplyRangeOnFileThread(const std::string& value,
+                              CefRefPtr<CefCallback> callback);
+
+  // Copy from |data_| into |data_out| and advance |data_offset_|.
+  int ReadFromData(char* data_out, int bytes_to_read);
+
+  // Read from |data_|, if available, or from |stream_| into |data_out|
+  // respecting |read_remaining_|.
+  int ReadFromStream(char* data_out, int bytes_to_read);
+
+  // Post a task to fill free buffers on the FILE thread if necessary. Must be
+  // called with the lock held.
+  void StartReadAheadLocked();
+  void ReadAheadOnFileThread();
 
   const int status_code_;
   const CefString status_text_;
@@ -87,15 +117,34 @@ class CefStreamResourceHandler : public CefResourceHandler {
   const CefRefPtr<CefStreamReader> stream_;
   bool read_on_file_thread_;
 
-  class Buffer;
-  Buffer* buffer_;
-#ifndef NDEBUG
-  // Used in debug builds to verify that |buffer_| isn't being accessed on
-  // multiple threads at the same time.
-  bool buffer_owned_by_file_thread_;
-#endif
+  // Direct view of the stream data, if available, and the current read
+  // position within it. The data is only read on the FILE thread if
+  // |read_on_file_thread_| is true.
+  const char* data_;
+  int64 data_size_;
+  int64 data_offset_;
+
+  // Byte range state. |read_remaining_| is the number of bytes left to read
+  // from |stream_| or -1 if unlimited.
+  bool has_range_;
+  bool range_satisfiable_;
+  int64 range_start_;
+  int64 range_end_;
+  int64 total_length_;
+  int64 read_remaining_;
+
+  // Read-ahead state used if |read_on_file_thread_| is true. Protected by the
+  // lock. Buffers in |filled_buffers_| are consumed in order on the IO thread
+  // and buffers in |free_buffers_| are filled on the FILE thread.
+  BufferQueue filled_buffers_;
+  BufferQueue free_buffers_;
+  bool read_ahead_pending_;
+  bool read_complete_;
+  bool canceled_;
+  CefRefPtr<CefCallback> read_callback_;
 
   IMPLEMENT_REFCOUNTING(CefStreamResourceHandler);
+  IMPLEMENT_LOCKING(CefStreamResourceHandler);
 };
 
 #endif  // CEF_INCLUDE_WRAPPER_CEF_STREAM_RESOURCE_HANDLER_H_
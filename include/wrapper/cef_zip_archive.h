@@ -89,6 +89,9 @@ class CefZipArchive : public CefBase {
   // If the zip archive requires a password then provide it via |password|.
   // If |overwriteExisting| is true then any files in this object that also
   // exist in the specified archive will be replaced with the new files.
+  // The archive is read through |stream| so if the stream may block (see
+  // CefStreamReader::MayBlock), for example a stream created using
+  // CefStreamReader::CreateForMappedFile, call this method on the FILE thread.
   // Returns the number of files successfully loaded.
   ///
   size_t Load(CefRefPtr<CefStreamReader> stream,
@@ -6,6 +6,8 @@
 
 #include <algorithm>
 
+#include "libcef/browser/backing_store_osr_util.h"
+
 #include "content/browser/renderer_host/dip_util.h"
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_widget_host.h"
@@ -24,57 +26,138 @@ static const int kMaxVideoLayerSize = 23170;
 
 BackingStoreOSR::BackingStoreOSR(content::RenderWidgetHost* widget,
                                  const gfx::Size& size,
-                                 float scale_factor)
+                                 float scale_factor,
+                                 CefRefPtr<CefBrowserHostImpl> browser,
+                                 CefBrowserHost::PaintElementType type,
+                                 int tile_size)
     : content::BackingStore(widget, size),
-      device_scale_factor_(scale_factor) {
-  gfx::Size pixel_size = gfx::ToFlooredSize(
-      gfx::ScaleSize(size, device_scale_factor_));
-  device_.reset(new SkBitmapDevice(SkBitmap::kARGB_8888_Config,
-                                   pixel_size.width(),
-                                   pixel_size.height(),
-                                   true));
+      device_scale_factor_(scale_factor),
+      browser_(browser),
+      type_(type),
+      client_buffer_(NULL),
+      tile_size_(std::max(tile_size, 0)),
+      tile_columns_(0) {
+  if (is_tiled()) {
+    // Tiles are allocated and cleared when first painted.
+    ResetTiles();
+    return;
+  }
+
+  device_.reset(CreateDevice(GetPixelSize(), &client_buffer_));
   canvas_.reset(new SkCanvas(device_.get()));
 
   canvas_->drawColor(SK_ColorWHITE);
 }
 
+BackingStoreOSR::~BackingStoreOSR() {
+  // Destroy the device before notifying the client that the memory it
+  // references may be freed.
+  canvas_.reset();
+  device_.reset();
+  ReleaseClientBuffer(client_buffer_);
+}
+
 void BackingStoreOSR::ScaleFactorChanged(float scale_factor) {
   if (scale_factor == device_scale_factor_)
     return;
 
-  gfx::Size old_pixel_size = gfx::ToFlooredSize(
-      gfx::ScaleSize(size(), device_scale_factor_));
+  gfx::Size old_pixel_size = GetPixelSize();
   device_scale_factor_ = scale_factor;
 
-  gfx::Size pixel_size = gfx::ToFlooredSize(
-      gfx::ScaleSize(size(), device_scale_factor_));
+  if (is_tiled()) {
+    // The renderer will repaint at the new scale factor so there is no need
+    // to resample the existing tiles.
+    ResetTiles();
+    return;
+  }
+
+  gfx::Size pixel_size = GetPixelSize();
 
+  void* new_client_buffer = NULL;
   scoped_ptr<SkBaseDevice> new_device(
-      new SkBitmapDevice(SkBitmap::kARGB_8888_Config,
-                         pixel_size.width(),
-                         pixel_size.height(),
-                         true));
+      CreateDevice(pixel_size, &new_client_buffer));
 
   scoped_ptr<SkCanvas> new_canvas(new SkCanvas(new_device.get()));
 
   // Copy old contents; a low-res flash is better than a black flash.
-  SkPaint copy_paint;
-  copy_paint.setXfermodeMode(SkXfermode::kSrc_Mode);
-  SkIRect src_rect = SkIRect::MakeWH(old_pixel_size.width(),
-                                     old_pixel_size.height());
-  SkRect dst_rect = SkRect::MakeWH(pixel_size.width(), pixel_size.height());
-  new_canvas.get()->drawBitmapRect(device_->accessBitmap(false), &src_rect,
-                                   dst_rect, &copy_paint);
+  const SkBitmap& src_bitmap = device_->accessBitmap(false);
+  SkBitmap& dst_bitmap = new_device->accessBitmap(true);
+  SkAutoLockPixels src_lock(src_bitmap);
+  SkAutoLockPixels dst_lock(dst_bitmap);
+
+  if (pixel_size.width() == old_pixel_size.width() * 2 &&
+      pixel_size.height() == old_pixel_size.height() * 2) {
+    // Common HiDPI transition; use the fast 2x kernel.
+    backing_store_osr_util::Upscale2x(
+        static_cast<const uint8*>(src_bitmap.getPixels()),
+        src_bitmap.rowBytes(), old_pixel_size.width(),
+        old_pixel_size.height(), static_cast<uint8*>(dst_bitmap.getPixels()),
+        dst_bitmap.rowBytes());
+    dst_bitmap.notifyPixelsChanged();
+  } else if (old_pixel_size.width() == pixel_size.width() * 2 &&
+             old_pixel_size.height() == pixel_size.height() * 2) {
+    backing_store_osr_util::Downscale2x(
+        static_cast<const uint8*>(src_bitmap.getPixels()),
+        src_bitmap.rowBytes(), pixel_size.width(), pixel_size.height(),
+        static_cast<uint8*>(dst_bitmap.getPixels()), dst_bitmap.rowBytes());
+    dst_bitmap.notifyPixelsChanged();
+  } else {
+    SkPaint copy_paint;
+    copy_paint.setXfermodeMode(SkXfermode::kSrc_Mode);
+    SkIRect src_rect = SkIRect::MakeWH(old_pixel_size.width(),
+                                       old_pixel_size.height());
+    SkRect dst_rect = SkRect::MakeWH(pixel_size.width(), pixel_size.height());
+    new_canvas.get()->drawBitmapRect(src_bitmap, &src_rect, dst_rect,
+                                     &copy_paint);
+  }
 
   canvas_.swap(new_canvas);
   device_.swap(new_device);
+
+  // The old device must be destroyed before its memory is released.
+  new_canvas.reset();
+  new_device.reset();
+  ReleaseClientBuffer(client_buffer_);
+  client_buffer_ = new_client_buffer;
+}
+
+void BackingStoreOSR::DetachBrowser() {
+  if (client_buffer_) {
+    DCHECK(!is_tiled());
+    const gfx::Size pixel_size = GetPixelSize();
+    scoped_ptr<SkBaseDevice> new_device(
+        new SkBitmapDevice(SkBitmap::kARGB_8888_Config, pixel_size.width(),
+                           pixel_size.height(), true));
+    scoped_ptr<SkCanvas> new_canvas(new SkCanvas(new_device.get()));
+
+    SkPaint copy_paint;
+    copy_paint.setXfermodeMode(SkXfermode::kSrc_Mode);
+    new_canvas->drawBitmap(device_->accessBitmap(false), 0, 0, &copy_paint);
+
+    canvas_.swap(new_canvas);
+    device_.swap(new_device);
+
+    // The old device must be destroyed before its memory is released.
+    new_canvas.reset();
+    new_device.reset();
+    ReleaseClientBuffer(client_buffer_);
+    client_buffer_ = NULL;
+  }
+
+  browser_ = NULL;
 }
 
 size_t BackingStoreOSR::MemorySize() {
+  if (is_tiled()) {
+    size_t size = 0;
+    for (size_t i = 0; i < tiles_.size(); ++i)
+      size += tiles_[i].getSize();
+    return size;
+  }
+
   // NOTE: The computation may be different when the canvas is a subrectangle of
   // a larger bitmap.
-  return gfx::ToFlooredSize(
-      gfx::ScaleSize(size(), device_scale_factor_)).GetArea() * 4;
+  return GetPixelSize().GetArea() * 4;
 }
 
 void BackingStoreOSR::PaintToBackingStore(
@@ -108,9 +191,6 @@ void BackingStoreOSR::PaintToBackingStore(
   src_bitmap.setConfig(SkBitmap::kARGB_8888_Config, width, height);
   src_bitmap.setPixels(dib->memory());
 
-  SkPaint copy_paint;
-  copy_paint.setXfermodeMode(SkXfermode::kSrc_Mode);
-
   for (size_t i = 0; i < copy_rects.size(); i++) {
     const gfx::Rect pixel_copy_rect = gfx::ToEnclosingRect(
         gfx::ScaleRect(copy_rects[i], scale_factor));
@@ -126,7 +206,7 @@ void BackingStoreOSR::PaintToBackingStore(
                                          pixel_copy_dst_rect.y(),
                                          pixel_copy_dst_rect.width(),
                                          pixel_copy_dst_rect.height());
-    canvas_->drawBitmapRect(src_bitmap, &src_rect, paint_rect, &copy_paint);
+    DrawBitmapRect(src_bitmap, src_rect, paint_rect);
   }
   src_bitmap.setPixels(0);
 }
@@ -145,7 +225,10 @@ bool BackingStoreOSR::CopyFromBackingStore(const gfx::Rect& rect,
 
   SkCanvas canvas(output->GetBitmap());
   canvas.drawColor(SK_ColorWHITE);
-  canvas.drawBitmap(device_->accessBitmap(false), 0, 0, &copy_paint);
+  if (is_tiled())
+    DrawTiles(gfx::Rect(width, height), &canvas, 0, 0);
+  else
+    canvas.drawBitmap(device_->accessBitmap(false), 0, 0, &copy_paint);
   return true;
 }
 
@@ -157,18 +240,285 @@ void BackingStoreOSR::ScrollBackingStore(const gfx::Vector2d& delta,
   gfx::Vector2d pixel_delta = gfx::ToFlooredVector2d(
       gfx::ScaleVector2d(delta, device_scale_factor_));
 
+  if (is_tiled()) {
+    // Content moves from |src_rect| to |dst_rect| inside the clip rect.
+    gfx::Rect dst_rect = gfx::IntersectRects(pixel_rect,
+                                             gfx::Rect(GetPixelSize()));
+    gfx::Rect src_rect = dst_rect - pixel_delta;
+    src_rect.Intersect(dst_rect);
+    dst_rect = src_rect + pixel_delta;
+    if (src_rect.IsEmpty())
+      return;
+
+    // Move the content one destination tile at a time. Tiles are visited in
+    // the direction opposite to the movement so that each source tile is read
+    // before it is overwritten. A tile-sized temporary holds the source pixels
+    // because the source may overlap the destination tile itself.
+    int first_column, last_column, first_row, last_row;
+    GetTileRange(dst_rect, &first_column, &last_column, &first_row,
+                 &last_row);
+
+    SkBitmap temp;
+    SkPaint copy_paint;
+    copy_paint.setXfermodeMode(SkXfermode::kSrc_Mode);
+
+    for (int i = 0; i <= last_row - first_row; ++i) {
+      const int row = pixel_delta.y() > 0 ? last_row - i : first_row + i;
+      for (int j = 0; j <= last_column - first_column; ++j) {
+        const int column =
+            pixel_delta.x() > 0 ? last_column - j : first_column + j;
+        const int index = row * tile_columns_ + column;
+        const gfx::Rect tile_rect = GetTileRect(index);
+        const gfx::Rect piece = gfx::IntersectRects(dst_rect, tile_rect);
+        if (piece.IsEmpty())
+          continue;
+
+        const gfx::Rect src_piece = piece - pixel_delta;
+        if (!HasAllocatedTiles(src_piece)) {
+          // The source has never been painted. Leave unallocated tiles alone
+          // and clear the moved area of allocated tiles.
+          if (!tiles_[index].isNull()) {
+            tiles_[index].eraseArea(
+                SkIRect::MakeXYWH(piece.x() - tile_rect.x(),
+                                  piece.y() - tile_rect.y(),
+                                  piece.width(), piece.height()),
+                SK_ColorWHITE);
+          }
+          continue;
+        }
+
+        SkBitmap* tile = AllocateTile(index);
+        if (!tile)
+          continue;
+
+        if (temp.isNull()) {
+          temp.setConfig(SkBitmap::kARGB_8888_Config, tile_size_, tile_size_);
+          if (!temp.allocPixels())
+            return;
+        }
+        SkCanvas temp_canvas(temp);
+        temp_canvas.drawColor(SK_ColorWHITE);
+        DrawTiles(src_piece, &temp_canvas, 0, 0);
+
+        SkCanvas tile_canvas(*tile);
+        const SkIRect temp_rect =
+            SkIRect::MakeWH(piece.width(), piece.height());
+        tile_canvas.drawBitmapRect(
+            temp, &temp_rect,
+            SkRect::MakeXYWH(piece.x() - tile_rect.x(),
+                             piece.y() - tile_rect.y(),
+                             piece.width(), piece.height()),
+            &copy_paint);
+      }
+    }
+    return;
+  }
+
   int x = std::min(pixel_rect.x(), pixel_rect.x() - pixel_delta.x());
   int y = std::min(pixel_rect.y(), pixel_rect.y() - pixel_delta.y());
   int w = pixel_rect.width() + abs(pixel_delta.x());
   int h = pixel_rect.height() + abs(pixel_delta.y());
   SkIRect rect = SkIRect::MakeXYWH(x, y, w, h);
 
-  device_->accessBitmap(true).scrollRect(&rect,
-                                         pixel_delta.x(),
-                                         pixel_delta.y());
+  SkBitmap& bitmap = device_->accessBitmap(true);
+  if (!rect.intersect(SkIRect::MakeWH(bitmap.width(), bitmap.height())))
+    return;
+
+  SkAutoLockPixels lock(bitmap);
+  backing_store_osr_util::ScrollRect(
+      static_cast<uint8*>(bitmap.getPixels()), bitmap.rowBytes(),
+      rect.x(), rect.y(), rect.width(), rect.height(),
+      pixel_delta.x(), pixel_delta.y());
+  bitmap.notifyPixelsChanged();
 }
 
 const void* BackingStoreOSR::getPixels() const {
-  return const_cast<BackingStoreOSR*>(this)->device_->
-      accessBitmap(false).getPixels();
+  return getBitmap().getPixels();
+}
+
+const SkBitmap& BackingStoreOSR::getBitmap() const {
+  DCHECK(!is_tiled());
+  return const_cast<BackingStoreOSR*>(this)->device_->accessBitmap(false);
+}
+
+gfx::Rect BackingStoreOSR::GetTileRect(int index) const {
+  DCHECK(is_tiled());
+  DCHECK(index >= 0 && index < tile_count());
+  const gfx::Size pixel_size = GetPixelSize();
+  const int x = (index % tile_columns_) * tile_size_;
+  const int y = (index / tile_columns_) * tile_size_;
+  return gfx::Rect(x, y,
+                   std::min(tile_size_, pixel_size.width() - x),
+                   std::min(tile_size_, pixel_size.height() - y));
+}
+
+const SkBitmap* BackingStoreOSR::GetTile(int index) const {
+  DCHECK(index >= 0 && index < tile_count());
+  if (tiles_[index].isNull())
+    return NULL;
+  return &tiles_[index];
+}
+
+void BackingStoreOSR::GetTileRange(const gfx::Rect& pixel_rect,
+                                   int* first_column, int* last_column,
+                                   int* first_row, int* last_row) const {
+  DCHECK(is_tiled());
+  const gfx::Rect rect =
+      gfx::IntersectRects(pixel_rect, gfx::Rect(GetPixelSize()));
+  if (rect.IsEmpty()) {
+    // Produce an empty range.
+    *first_column = *first_row = 0;
+    *last_column = *last_row = -1;
+    return;
+  }
+  *first_column = rect.x() / tile_size_;
+  *last_column = (rect.right() - 1) / tile_size_;
+  *first_row = rect.y() / tile_size_;
+  *last_row = (rect.bottom() - 1) / tile_size_;
+}
+
+SkBaseDevice* BackingStoreOSR::CreateDevice(const gfx::Size& pixel_size,
+                                            void** client_buffer) {
+  *client_buffer = NULL;
+
+  if (browser_.get() && !pixel_size.IsEmpty()) {
+    CefRefPtr<CefRenderHandler> handler =
+        browser_->GetClient()->GetRenderHandler();
+    if (handler.get()) {
+      *client_buffer = handler->GetPaintBuffer(browser_->GetBrowser(), type_,
+                                               pixel_size.width(),
+                                               pixel_size.height());
+    }
+  }
+
+  if (*client_buffer) {
+    // Rasterize directly into the client-provided memory.
+    SkBitmap bitmap;
+    bitmap.setConfig(SkBitmap::kARGB_8888_Config,
+                     pixel_size.width(),
+                     pixel_size.height());
+    bitmap.setIsOpaque(true);
+    bitmap.setPixels(*client_buffer);
+    return new SkBitmapDevice(bitmap);
+  }
+
+  return new SkBitmapDevice(SkBitmap::kARGB_8888_Config,
+                            pixel_size.width(),
+                            pixel_size.height(),
+                            true);
+}
+
+void BackingStoreOSR::ReleaseClientBuffer(void* client_buffer) {
+  if (!client_buffer || !browser_.get())
+    return;
+
+  CefRefPtr<CefRenderHandler> handler =
+      browser_->GetClient()->GetRenderHandler();
+  if (handler.get())
+    handler->OnPaintBufferReleased(browser_->GetBrowser(), type_,
+                                   client_buffer);
+}
+
+void BackingStoreOSR::DrawBitmapRect(const SkBitmap& bitmap,
+                                     const SkIRect& src_rect,
+                                     const SkRect& dst_rect) {
+  SkPaint copy_paint;
+  copy_paint.setXfermodeMode(SkXfermode::kSrc_Mode);
+
+  if (!is_tiled()) {
+    canvas_->drawBitmapRect(bitmap, &src_rect, dst_rect, &copy_paint);
+    return;
+  }
+
+  SkIRect dst_irect;
+  dst_rect.roundOut(&dst_irect);
+  int first_column, last_column, first_row, last_row;
+  GetTileRange(gfx::Rect(dst_irect.x(), dst_irect.y(),
+                         dst_irect.width(), dst_irect.height()),
+               &first_column, &last_column, &first_row, &last_row);
+
+  for (int row = first_row; row <= last_row; ++row) {
+    for (int column = first_column; column <= last_column; ++column) {
+      const int index = row * tile_columns_ + column;
+      const gfx::Rect tile_rect = GetTileRect(index);
+      SkBitmap* tile = AllocateTile(index);
+      if (!tile)
+        continue;
+
+      // The canvas clips drawing to the tile bounds.
+      SkCanvas canvas(*tile);
+      canvas.translate(SkIntToScalar(-tile_rect.x()),
+                       SkIntToScalar(-tile_rect.y()));
+      canvas.drawBitmapRect(bitmap, &src_rect, dst_rect, &copy_paint);
+    }
+  }
+}
+
+void BackingStoreOSR::ResetTiles() {
+  DCHECK(is_tiled());
+  const gfx::Size pixel_size = GetPixelSize();
+  tile_columns_ = (pixel_size.width() + tile_size_ - 1) / tile_size_;
+  const int tile_rows = (pixel_size.height() + tile_size_ - 1) / tile_size_;
+  tiles_.clear();
+  tiles_.resize(tile_columns_ * tile_rows);
+}
+
+SkBitmap* BackingStoreOSR::AllocateTile(int index) {
+  SkBitmap* tile = &tiles_[index];
+  if (tile->isNull()) {
+    const gfx::Rect tile_rect = GetTileRect(index);
+    tile->setConfig(SkBitmap::kARGB_8888_Config, tile_rect.width(),
+                    tile_rect.height());
+    if (!tile->allocPixels()) {
+      tile->reset();
+      return NULL;
+    }
+    tile->eraseColor(SK_ColorWHITE);
+  }
+  return tile;
+}
+
+bool BackingStoreOSR::HasAllocatedTiles(const gfx::Rect& pixel_rect) const {
+  int first_column, last_column, first_row, last_row;
+  GetTileRange(pixel_rect, &first_column, &last_column, &first_row,
+               &last_row);
+  for (int row = first_row; row <= last_row; ++row) {
+    for (int column = first_column; column <= last_column; ++column) {
+      if (!tiles_[row * tile_columns_ + column].isNull())
+        return true;
+    }
+  }
+  return false;
+}
+
+void BackingStoreOSR::DrawTiles(const gfx::Rect& pixel_rect,
+                                SkCanvas* output, int x, int y) {
+  SkPaint copy_paint;
+  copy_paint.setXfermodeMode(SkXfermode::kSrc_Mode);
+
+  int first_column, last_column, first_row, last_row;
+  GetTileRange(pixel_rect, &first_column, &last_column, &first_row,
+               &last_row);
+
+  output->save();
+  output->clipRect(SkRect::MakeXYWH(x, y, pixel_rect.width(),
+                                    pixel_rect.height()));
+  for (int row = first_row; row <= last_row; ++row) {
+    for (int column = first_column; column <= last_column; ++column) {
+      const int index = row * tile_columns_ + column;
+      const SkBitmap* tile = GetTile(index);
+      if (!tile)
+        continue;
+      const gfx::Rect tile_rect = GetTileRect(index);
+      output->drawBitmap(*tile,
+                         SkIntToScalar(x + tile_rect.x() - pixel_rect.x()),
+                         SkIntToScalar(y + tile_rect.y() - pixel_rect.y()),
+                         &copy_paint);
+    }
+  }
+  output->restore();
+}
+
+gfx::Size BackingStoreOSR::GetPixelSize() const {
+  return gfx::ToFlooredSize(gfx::ScaleSize(size(), device_scale_factor_));
 }
@@ -7,6 +7,8 @@
 
 #include <vector>
 
+#include "libcef/browser/browser_host_impl.h"
+
 #include "content/browser/renderer_host/backing_store.h"
 #include "ui/gfx/canvas.h"
 
@@ -36,21 +38,99 @@ class BackingStoreOSR : public content::BackingStore {
 
   void ScaleFactorChanged(float scale_factor);
 
+  // Stop referencing the browser. Contents held in client-provided memory are
+  // moved to internally allocated memory and the client buffer is released.
+  // Called when the owning view is destroyed because the backing store may be
+  // cached beyond the lifespan of the browser.
+  void DetachBrowser();
+
+  // Pixel accessors. Only valid when is_tiled() returns false.
   const void* getPixels() const;
+  const SkBitmap& getBitmap() const;
+
+  float device_scale_factor() const { return device_scale_factor_; }
+
+  // Returns true if the backing store is divided into tiles that are allocated
+  // when first painted instead of a single bitmap.
+  bool is_tiled() const { return tile_size_ > 0; }
+
+  // Tile accessors. Only valid when is_tiled() returns true. Tiles are indexed
+  // in row-major order and their bounds are in pixel coordinates. GetTile
+  // returns NULL if the tile has not been painted.
+  int tile_count() const { return static_cast<int>(tiles_.size()); }
+  gfx::Rect GetTileRect(int index) const;
+  const SkBitmap* GetTile(int index) const;
+
+  // Returns the indices of the tiles that intersect |pixel_rect|.
+  void GetTileRange(const gfx::Rect& pixel_rect,
+                    int* first_column, int* last_column,
+                    int* first_row, int* last_row) const;
+  int tile_columns() const { return tile_columns_; }
 
  private:
   // Can be instantiated only within CefRenderWidgetHostViewOSR.
   friend class CefRenderWidgetHostViewOSR;
 
-  explicit BackingStoreOSR(content::RenderWidgetHost* widget,
-      const gfx::Size& size, float scale_factor);
-  virtual ~BackingStoreOSR() {}
+  // If |browser| is non-NULL the client's CefRenderHandler will be given the
+  // opportunity to provide the pixel memory via GetPaintBuffer.
+  // If |tile_size| is > 0 the backing store will be tiled and GetPaintBuffer
+  // will not be called.
+  BackingStoreOSR(content::RenderWidgetHost* widget,
+                  const gfx::Size& size,
+                  float scale_factor,
+                  CefRefPtr<CefBrowserHostImpl> browser,
+                  CefBrowserHost::PaintElementType type,
+                  int tile_size);
+  virtual ~BackingStoreOSR();
+
+  // Create a new device of |pixel_size|. The device will draw into
+  // client-provided memory if available. |client_buffer| will be set to the
+  // client-provided memory or NULL.
+  SkBaseDevice* CreateDevice(const gfx::Size& pixel_size,
+                             void** client_buffer);
+
+  // Notify the client that |client_buffer| is no longer referenced.
+  void ReleaseClientBuffer(void* client_buffer);
+
+  // Draw |src_rect| of |bitmap| to |dst_rect| of the backing store, replacing
+  // the existing contents.
+  void DrawBitmapRect(const SkBitmap& bitmap,
+                      const SkIRect& src_rect,
+                      const SkRect& dst_rect);
+
+  // Discard all tiles and size the tile grid for the current pixel size.
+  void ResetTiles();
+
+  // Returns the tile at |index|, allocating it if necessary.
+  SkBitmap* AllocateTile(int index);
+
+  // Returns true if any tile that intersects |pixel_rect| is allocated.
+  bool HasAllocatedTiles(const gfx::Rect& pixel_rect) const;
+
+  // Copy |pixel_rect| of the tiled backing store to |output| at (|x|, |y|).
+  // Unallocated tiles are left untouched in |output|.
+  void DrawTiles(const gfx::Rect& pixel_rect, SkCanvas* output, int x, int y);
+
+  gfx::Size GetPixelSize() const;
 
   scoped_ptr<SkBaseDevice> device_;
   scoped_ptr<SkCanvas> canvas_;
 
   float device_scale_factor_;
 
+  CefRefPtr<CefBrowserHostImpl> browser_;
+  CefBrowserHost::PaintElementType type_;
+
+  // Client-provided memory that |device_| draws into, or NULL if the memory is
+  // owned by |device_|.
+  void* client_buffer_;
+
+  // Tile edge length in pixels, or 0 if the backing store is not tiled. When
+  // tiled |device_| and |canvas_| are NULL.
+  int tile_size_;
+  int tile_columns_;
+  std::vector<SkBitmap> tiles_;
+
   DISALLOW_COPY_AND_ASSIGN(BackingStoreOSR);
 };
 
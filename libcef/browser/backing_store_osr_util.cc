@@ -0,0 +1,210 @@
+// Copyright (c) 2014 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "libcef/browser/backing_store_osr_util.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "base/cpu.h"
+#include "base/lazy_instance.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+namespace backing_store_osr_util {
+
+namespace {
+
+const int kBytesPerPixel = 4;
+
+struct CPUFeatures {
+  CPUFeatures() : has_sse2(false) {
+#if defined(ARCH_CPU_X86_FAMILY)
+    base::CPU cpu;
+    has_sse2 = cpu.has_sse2();
+#endif
+  }
+
+  bool has_sse2;
+};
+
+base::LazyInstance<CPUFeatures>::Leaky g_cpu_features =
+    LAZY_INSTANCE_INITIALIZER;
+
+bool g_force_scalar = false;
+
+bool UseSSE2() {
+  return !g_force_scalar && HasSSE2();
+}
+
+// Scalar implementations.
+
+void Upscale2xRowScalar(const uint8* src, int src_width,
+                        uint8* dst0, uint8* dst1) {
+  const uint32* s = reinterpret_cast<const uint32*>(src);
+  uint32* d0 = reinterpret_cast<uint32*>(dst0);
+  uint32* d1 = reinterpret_cast<uint32*>(dst1);
+  for (int x = 0; x < src_width; ++x) {
+    const uint32 pixel = s[x];
+    d0[x * 2] = d0[x * 2 + 1] = pixel;
+    d1[x * 2] = d1[x * 2 + 1] = pixel;
+  }
+}
+
+inline uint8 Average(uint8 a, uint8 b) {
+  return static_cast<uint8>((a + b + 1) >> 1);
+}
+
+void Downscale2xRowScalar(const uint8* src0, const uint8* src1,
+                          int dst_width, uint8* dst) {
+  for (int x = 0; x < dst_width; ++x) {
+    const uint8* s0 = src0 + x * 2 * kBytesPerPixel;
+    const uint8* s1 = src1 + x * 2 * kBytesPerPixel;
+    uint8* d = dst + x * kBytesPerPixel;
+    for (int c = 0; c < kBytesPerPixel; ++c) {
+      d[c] = Average(Average(s0[c], s1[c]),
+                     Average(s0[c + kBytesPerPixel], s1[c + kBytesPerPixel]));
+    }
+  }
+}
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+// SSE2 implementations. Unaligned loads and stores are used throughout
+// because rows in the backing store are not guaranteed to be 16-byte aligned.
+
+void Upscale2xRowSSE2(const uint8* src, int src_width,
+                      uint8* dst0, uint8* dst1) {
+  int x = 0;
+  for (; x + 4 <= src_width; x += 4) {
+    __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(src + x * kBytesPerPixel));
+    // |lo| = p0 p0 p1 p1, |hi| = p2 p2 p3 p3.
+    __m128i lo = _mm_unpacklo_epi32(v, v);
+    __m128i hi = _mm_unpackhi_epi32(v, v);
+    __m128i* d0 = reinterpret_cast<__m128i*>(dst0 + x * 2 * kBytesPerPixel);
+    __m128i* d1 = reinterpret_cast<__m128i*>(dst1 + x * 2 * kBytesPerPixel);
+    _mm_storeu_si128(d0, lo);
+    _mm_storeu_si128(d0 + 1, hi);
+    _mm_storeu_si128(d1, lo);
+    _mm_storeu_si128(d1 + 1, hi);
+  }
+  if (x < src_width) {
+    Upscale2xRowScalar(src + x * kBytesPerPixel, src_width - x,
+                       dst0 + x * 2 * kBytesPerPixel,
+                       dst1 + x * 2 * kBytesPerPixel);
+  }
+}
+
+void Downscale2xRowSSE2(const uint8* src0, const uint8* src1,
+                        int dst_width, uint8* dst) {
+  int x = 0;
+  for (; x + 4 <= dst_width; x += 4) {
+    const __m128i* s0 =
+        reinterpret_cast<const __m128i*>(src0 + x * 2 * kBytesPerPixel);
+    const __m128i* s1 =
+        reinterpret_cast<const __m128i*>(src1 + x * 2 * kBytesPerPixel);
+    // Vertical average of source pixels 0-3 and 4-7.
+    __m128i a = _mm_avg_epu8(_mm_loadu_si128(s0), _mm_loadu_si128(s1));
+    __m128i b = _mm_avg_epu8(_mm_loadu_si128(s0 + 1),
+                             _mm_loadu_si128(s1 + 1));
+    // Separate the even and odd pixels and average them horizontally.
+    __m128i even = _mm_castps_si128(_mm_shuffle_ps(
+        _mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+    __m128i odd = _mm_castps_si128(_mm_shuffle_ps(
+        _mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(3, 1, 3, 1)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * kBytesPerPixel),
+                     _mm_avg_epu8(even, odd));
+  }
+  if (x < dst_width) {
+    Downscale2xRowScalar(src0 + x * 2 * kBytesPerPixel,
+                         src1 + x * 2 * kBytesPerPixel,
+                         dst_width - x, dst + x * kBytesPerPixel);
+  }
+}
+
+#endif  // defined(ARCH_CPU_X86_FAMILY)
+
+}  // namespace
+
+bool HasSSE2() {
+  return g_cpu_features.Get().has_sse2;
+}
+
+void SetForceScalar(bool force_scalar) {
+  g_force_scalar = force_scalar;
+}
+
+void ScrollRect(uint8* pixels, size_t row_bytes,
+                int x, int y, int width, int height,
+                int dx, int dy) {
+  if (width <= 0 || height <= 0 || abs(dx) >= width || abs(dy) >= height)
+    return;
+  if (dx == 0 && dy == 0)
+    return;
+
+  // Destination columns that receive moved content.
+  const int dst_x = x + std::max(dx, 0);
+  const int src_x = dst_x - dx;
+  const size_t copy_bytes = (width - abs(dx)) * kBytesPerPixel;
+  const int rows = height - abs(dy);
+
+  if (dy > 0) {
+    // Moving down; start with the bottom row so that source rows are read
+    // before they are overwritten.
+    for (int row = rows - 1; row >= 0; --row) {
+      const int src_y = y + row;
+      memmove(pixels + (src_y + dy) * row_bytes + dst_x * kBytesPerPixel,
+              pixels + src_y * row_bytes + src_x * kBytesPerPixel,
+              copy_bytes);
+    }
+  } else {
+    for (int row = 0; row < rows; ++row) {
+      const int src_y = y - dy + row;
+      memmove(pixels + (src_y + dy) * row_bytes + dst_x * kBytesPerPixel,
+              pixels + src_y * row_bytes + src_x * kBytesPerPixel,
+              copy_bytes);
+    }
+  }
+}
+
+void Upscale2x(const uint8* src, size_t src_row_bytes,
+               int src_width, int src_height,
+               uint8* dst, size_t dst_row_bytes) {
+  for (int y = 0; y < src_height; ++y) {
+    const uint8* s = src + y * src_row_bytes;
+    uint8* d0 = dst + y * 2 * dst_row_bytes;
+    uint8* d1 = d0 + dst_row_bytes;
+#if defined(ARCH_CPU_X86_FAMILY)
+    if (UseSSE2()) {
+      Upscale2xRowSSE2(s, src_width, d0, d1);
+      continue;
+    }
+#endif
+    Upscale2xRowScalar(s, src_width, d0, d1);
+  }
+}
+
+void Downscale2x(const uint8* src, size_t src_row_bytes,
+                 int dst_width, int dst_height,
+                 uint8* dst, size_t dst_row_bytes) {
+  for (int y = 0; y < dst_height; ++y) {
+    const uint8* s0 = src + y * 2 * src_row_bytes;
+    const uint8* s1 = s0 + src_row_bytes;
+    uint8* d = dst + y * dst_row_bytes;
+#if defined(ARCH_CPU_X86_FAMILY)
+    if (UseSSE2()) {
+      Downscale2xRowSSE2(s0, s1, dst_width, d);
+      continue;
+    }
+#endif
+    Downscale2xRowScalar(s0, s1, dst_width, d);
+  }
+}
+
+}  // namespace backing_store_osr_util
@@ -0,0 +1,51 @@
+// Copyright (c) 2014 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef CEF_LIBCEF_BROWSER_BACKING_STORE_OSR_UTIL_H_
+#define CEF_LIBCEF_BROWSER_BACKING_STORE_OSR_UTIL_H_
+#pragma once
+
+#include <stddef.h>
+
+#include "base/basictypes.h"
+
+// Pixel kernels for the 32bpp OSR backing store. The scale functions have a
+// portable scalar implementation and, on x86, an SSE2 implementation that is
+// selected at runtime. The SSE2 and scalar implementations produce identical
+// results. Scrolling moves rows with memmove, which the C runtime already
+// vectorizes.
+namespace backing_store_osr_util {
+
+// Returns true if the SSE2 implementations are being used.
+bool HasSSE2();
+
+// Force use of the scalar implementations. Only intended for testing and
+// benchmarking.
+void SetForceScalar(bool force_scalar);
+
+// Scroll the pixels inside the rectangle (|x|, |y|, |width|, |height|) of
+// |pixels| by (|dx|, |dy|). Pixels that move outside of the rectangle are
+// discarded and pixels inside the rectangle that are not covered by the moved
+// content keep their previous value. |row_bytes| is the distance between rows
+// of |pixels| in bytes.
+void ScrollRect(uint8* pixels, size_t row_bytes,
+                int x, int y, int width, int height,
+                int dx, int dy);
+
+// Write a |src_width|x|src_height| image into a destination of twice the
+// size, duplicating each source pixel into a 2x2 block.
+void Upscale2x(const uint8* src, size_t src_row_bytes,
+               int src_width, int src_height,
+               uint8* dst, size_t dst_row_bytes);
+
+// Write a |dst_width|x|dst_height| image from a source of twice the size using
+// a 2x2 box filter. Each output channel is the rounded average of the
+// rounded vertical averages of the corresponding source pixels.
+void Downscale2x(const uint8* src, size_t src_row_bytes,
+                 int dst_width, int dst_height,
+                 uint8* dst, size_t dst_row_bytes);
+
+}  // namespace backing_store_osr_util
+
+#endif  // CEF_LIBCEF_BROWSER_BACKING_STORE_OSR_UTIL_H_
@@ -925,15 +925,16 @@ void CefBrowserHostImpl::WasHidden(bool hidden) {
   if (!web_contents())
     return;
 
-  content::RenderWidgetHostImpl* widget =
-      content::RenderWidgetHostImpl::From(web_contents()->GetRenderViewHost());
-  if (!widget)
+  CefRenderWidgetHostViewOSR* view =
+      static_cast<CefRenderWidgetHostViewOSR*>(
+          web_contents()->GetRenderViewHost()->GetView());
+  if (!view)
     return;
 
-  if (hidden) 
-    widget->WasHidden();
+  if (hidden)
+    view->WasHidden();
   else
-    widget->WasShown();
+    view->WasShown();
 }
 
 void CefBrowserHostImpl::NotifyScreenInfoChanged() {
@@ -990,6 +991,60 @@ void CefBrowserHostImpl::Invalidate(const CefRect& dirtyRect,
   }
 }
 
+int64 CefBrowserHostImpl::GetPaintDeliveredBytes() {
+  base::AutoLock lock_scope(state_lock_);
+  return paint_delivered_bytes_;
+}
+
+int64 CefBrowserHostImpl::GetPaintViewBytes() {
+  base::AutoLock lock_scope(state_lock_);
+  return paint_view_bytes_;
+}
+
+void CefBrowserHostImpl::SetWindowlessFrameRate(int frame_rate) {
+  if (!IsWindowRenderingDisabled()) {
+    NOTREACHED() << "Window rendering is not disabled";
+    return;
+  }
+
+  if (!CEF_CURRENTLY_ON_UIT()) {
+    CEF_POST_TASK(CEF_UIT,
+        base::Bind(&CefBrowserHostImpl::SetWindowlessFrameRate, this,
+                   frame_rate));
+    return;
+  }
+
+  windowless_frame_rate_ = frame_rate;
+
+  // Deliver anything that was waiting on the previous frame rate.
+  if (frame_rate <= 0)
+    FlushWindowlessPaint();
+}
+
+void CefBrowserHostImpl::FlushWindowlessPaint() {
+  if (!IsWindowRenderingDisabled()) {
+    NOTREACHED() << "Window rendering is not disabled";
+    return;
+  }
+
+  if (!CEF_CURRENTLY_ON_UIT()) {
+    CEF_POST_TASK(CEF_UIT,
+        base::Bind(&CefBrowserHostImpl::FlushWindowlessPaint, this));
+    return;
+  }
+
+  if (!web_contents())
+    return;
+
+  content::RenderWidgetHostView* view =
+      web_contents()->GetRenderViewHost()->GetView();
+  CefRenderWidgetHostViewOSR* orview =
+      static_cast<CefRenderWidgetHostViewOSR*>(view);
+
+  if (orview)
+    orview->FlushPaint();
+}
+
 void CefBrowserHostImpl::SendKeyEvent(const CefKeyEvent& event) {
   if (!CEF_CURRENTLY_ON_UIT()) {
     CEF_POST_TASK(CEF_UIT,
@@ -1338,13 +1393,59 @@ bool CefBrowserHostImpl::SendProcessMessage(
   CefProcessMessageImpl* impl =
       static_cast<CefProcessMessageImpl*>(message.get());
   if (impl->CopyTo(params)) {
+    uint32 shared_memory_size = 0;
+    scoped_ptr<base::SharedMemory> shared_memory =
+        impl->PassSharedMemory(&shared_memory_size);
     return SendProcessMessage(target_process, params.name, &params.arguments,
-                              true);
+                              &params.packed_arguments, shared_memory.Pass(),
+                              shared_memory_size, true);
   }
 
   return false;
 }
 
+bool CefBrowserHostImpl::SendProcessMessages(
+    CefProcessId target_process,
+    const std::vector<CefRefPtr<CefProcessMessage> >& messages) {
+  DCHECK_EQ(PID_RENDERER, target_process);
+
+  for (size_t i = 0; i < messages.size(); ++i) {
+    if (!messages[i].get() || !messages[i]->IsValid())
+      return false;
+  }
+
+  bool success = true;
+  Cef_RequestBatch_Params batch;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    CefProcessMessageImpl* impl =
+        static_cast<CefProcessMessageImpl*>(messages[i].get());
+    if (impl->GetSharedMemorySize() == 0 && !impl->IsArgumentListPacked()) {
+      if (!impl->AppendTo(batch))
+        success = false;
+      continue;
+    }
+
+    // Shared memory segments are sent individually to bound the number of
+    // handles per IPC message and packed arguments are sent individually to
+    // keep them packed. Send the pending batch first to preserve ordering.
+    if (!batch.names.empty()) {
+      if (!Send(new CefMsg_RequestBatch(routing_id(), batch)))
+        success = false;
+      batch.names.clear();
+      batch.arguments.Clear();
+    }
+    if (!SendProcessMessage(target_process, messages[i]))
+      success = false;
+  }
+
+  if (!batch.names.empty()) {
+    if (!Send(new CefMsg_RequestBatch(routing_id(), batch)))
+      success = false;
+  }
+
+  return success;
+}
+
 
 // CefBrowserHostImpl public methods.
 // -----------------------------------------------------------------------------
@@ -1373,6 +1474,9 @@ void CefBrowserHostImpl::DestroyBrowser() {
     delete queued_messages_.front();
     queued_messages_.pop();
   }
+  // Destroying the pending requests releases their shared memory segments.
+  while (!queued_shared_memory_requests_.empty())
+    queued_shared_memory_requests_.pop();
 
   registrar_.reset(NULL);
   response_manager_.reset(NULL);
@@ -1530,6 +1634,8 @@ void CefBrowserHostImpl::LoadString(int64 frame_id, const std::string& string,
   params.user_initiated = false;
   params.request_id = -1;
   params.expect_response = false;
+  params.shared_memory_handle = base::SharedMemory::NULLHandle();
+  params.shared_memory_size = 0;
 
   params.arguments.Append(base::Value::CreateStringValue(string));
   params.arguments.Append(base::Value::CreateStringValue(url));
@@ -1564,6 +1670,8 @@ void CefBrowserHostImpl::SendCommand(
     }
 
     params.arguments.Append(base::Value::CreateStringValue(command));
+    params.shared_memory_handle = base::SharedMemory::NULLHandle();
+    params.shared_memory_size = 0;
 
     Send(new CefMsg_Request(routing_id(), params));
   } else {
@@ -1607,6 +1715,8 @@ void CefBrowserHostImpl::SendCode(
     params.arguments.Append(base::Value::CreateStringValue(code));
     params.arguments.Append(base::Value::CreateStringValue(script_url));
     params.arguments.Append(base::Value::CreateIntegerValue(script_start_line));
+    params.shared_memory_handle = base::SharedMemory::NULLHandle();
+    params.shared_memory_size = 0;
 
     Send(new CefMsg_Request(routing_id(), params));
   } else {
@@ -1616,23 +1726,87 @@ void CefBrowserHostImpl::SendCode(
   }
 }
 
-bool CefBrowserHostImpl::SendProcessMessage(CefProcessId target_process,
-                                            const std::string& name,
-                                            base::ListValue* arguments,
-                                            bool user_initiated) {
+bool CefBrowserHostImpl::SendProcessMessage(
+    CefProcessId target_process,
+    const std::string& name,
+    base::ListValue* arguments,
+    std::string* packed_arguments,
+    scoped_ptr<base::SharedMemory> shared_memory,
+    uint32 shared_memory_size,
+    bool user_initiated) {
   DCHECK_EQ(PID_RENDERER, target_process);
   DCHECK(!name.empty());
 
-  Cef_Request_Params params;
-  params.name = name;
+  scoped_ptr<Cef_Request_Params> params(new Cef_Request_Params());
+  params->name = name;
   if (arguments)
-    params.arguments.Swap(arguments);
-  params.frame_id = -1;
-  params.user_initiated = user_initiated;
-  params.request_id = -1;
-  params.expect_response = false;
+    params->arguments.Swap(arguments);
+  if (packed_arguments)
+    params->packed_arguments.swap(*packed_arguments);
+  params->frame_id = -1;
+  params->user_initiated = user_initiated;
+  params->request_id = -1;
+  params->expect_response = false;
+
+  if (!shared_memory.get()) {
+    params->shared_memory_handle = base::SharedMemory::NULLHandle();
+    params->shared_memory_size = 0;
+    return Send(new CefMsg_Request(routing_id(), *params));
+  }
+
+  // The renderer process handle is only available on the UI thread. As with
+  // Send() the result of a request posted from another thread is not known.
+  if (!CEF_CURRENTLY_ON_UIT()) {
+    CEF_POST_TASK(CEF_UIT,
+        base::Bind(
+            base::IgnoreResult(&CefBrowserHostImpl::SendSharedMemoryRequest),
+            this, base::Passed(&params), base::Passed(&shared_memory),
+            shared_memory_size));
+    return true;
+  }
 
-  return Send(new CefMsg_Request(routing_id(), params));
+  return SendSharedMemoryRequest(params.Pass(), shared_memory.Pass(),
+                                 shared_memory_size);
+}
+
+bool CefBrowserHostImpl::SendSharedMemoryRequest(
+    scoped_ptr<Cef_Request_Params> params,
+    scoped_ptr<base::SharedMemory> shared_memory,
+    uint32 shared_memory_size) {
+  CEF_REQUIRE_UIT();
+
+  if (!web_contents())
+    return false;
+
+  if (queue_messages_) {
+    // Keep the segment until the request is actually sent. The NULL entry
+    // marks the position of the request in |queued_messages_|.
+    queued_messages_.push(NULL);
+    queued_shared_memory_requests_.push(
+        base::Bind(
+            base::IgnoreResult(&CefBrowserHostImpl::SendSharedMemoryRequest),
+            base::Unretained(this), base::Passed(&params),
+            base::Passed(&shared_memory), shared_memory_size));
+    return true;
+  }
+
+  // Only give the segment to the renderer once the message is about to be
+  // sent so that the handle is not leaked in the renderer process.
+  base::ProcessHandle process =
+      web_contents()->GetRenderProcessHost()->GetHandle();
+  if (process == base::kNullProcessHandle ||
+      !CefProcessMessageImpl::GiveSharedMemory(shared_memory.Pass(),
+                                               shared_memory_size, process,
+                                               *params)) {
+    return false;
+  }
+
+  if (!content::WebContentsObserver::Send(
+          new CefMsg_Request(routing_id(), *params))) {
+    CefProcessMessageImpl::CloseGivenSharedMemory(*params, process);
+    return false;
+  }
+  return true;
 }
 
 bool CefBrowserHostImpl::ViewText(const std::string& text) {
@@ -1666,6 +1840,13 @@ GURL CefBrowserHostImpl::GetLoadingURL() {
   return loading_url_;
 }
 
+void CefBrowserHostImpl::OnPaintDelivered(int64 delivered_bytes,
+                                          int64 view_bytes) {
+  base::AutoLock lock_scope(state_lock_);
+  paint_delivered_bytes_ += delivered_bytes;
+  paint_view_bytes_ += view_bytes;
+}
+
 void CefBrowserHostImpl::OnSetFocus(cef_focus_source_t source) {
   if (CEF_CURRENTLY_ON_UIT()) {
     // SetFocus() might be called while inside the OnSetFocus() callback. If so,
@@ -2109,7 +2290,12 @@ void CefBrowserHostImpl::RenderViewReady() {
   // Send the queued messages.
   queue_messages_ = false;
   while (!queued_messages_.empty()) {
-    Send(queued_messages_.front());
+    if (queued_messages_.front()) {
+      Send(queued_messages_.front());
+    } else {
+      queued_shared_memory_requests_.front().Run();
+      queued_shared_memory_requests_.pop();
+    }
     queued_messages_.pop();
   }
 }
@@ -2203,6 +2389,7 @@ bool CefBrowserHostImpl::OnMessageReceived(const IPC::Message& message) {
     IPC_MESSAGE_HANDLER(CefHostMsg_DidFinishLoad, OnDidFinishLoad)
     IPC_MESSAGE_HANDLER(CefHostMsg_LoadingURLChange, OnLoadingURLChange)
     IPC_MESSAGE_HANDLER(CefHostMsg_Request, OnRequest)
+    IPC_MESSAGE_HANDLER(CefHostMsg_RequestBatch, OnRequestBatch)
     IPC_MESSAGE_HANDLER(CefHostMsg_Response, OnResponse)
     IPC_MESSAGE_HANDLER(CefHostMsg_ResponseAck, OnResponseAck)
     IPC_MESSAGE_UNHANDLED(handled = false)
@@ -2261,14 +2448,32 @@ void CefBrowserHostImpl::OnRequest(const Cef_Request_Params& params) {
   std::string response;
   bool expect_response_ack = false;
 
+  // Take ownership of the shared memory segment, if any, so that it is released
+  // even if the request is not handled.
+  scoped_ptr<base::SharedMemory> shared_memory;
+  if (params.shared_memory_size > 0 && web_contents()) {
+    shared_memory = CefProcessMessageImpl::TakeSharedMemory(
+        params, web_contents()->GetRenderProcessHost()->GetHandle());
+  }
+
   if (params.user_initiated) {
     // Give the user a chance to handle the request.
     if (client_.get()) {
       CefRefPtr<CefProcessMessageImpl> message(
           new CefProcessMessageImpl(const_cast<Cef_Request_Params*>(&params),
                                     false, true));
-      success = client_->OnProcessMessageReceived(this, PID_RENDERER,
-                                                  message.get());
+      message->SetSharedMemory(shared_memory.Pass(),
+                               params.shared_memory_size);
+      // Drop messages with invalid packed arguments instead of delivering an
+      // argument list that does not match what was sent.
+      if (params.packed_arguments.empty() ||
+          message->SetPackedArguments(
+              const_cast<std::string*>(&params.packed_arguments))) {
+        success = client_->OnProcessMessageReceived(this, PID_RENDERER,
+                                                    message.get());
+      }
+      // Release any shared memory segment that was not moved elsewhere.
+      message->SetSharedMemory(scoped_ptr<base::SharedMemory>(), 0);
       message->Detach(NULL);
     }
   } else {
@@ -2289,6 +2494,20 @@ void CefBrowserHostImpl::OnRequest(const Cef_Request_Params& params) {
   }
 }
 
+void CefBrowserHostImpl::OnRequestBatch(
+    const Cef_RequestBatch_Params& params) {
+  // The arguments are moved out of |params| as each request is dispatched.
+  Cef_RequestBatch_Params& batch =
+      const_cast<Cef_RequestBatch_Params&>(params);
+  DCHECK_EQ(batch.names.size(), batch.arguments.GetSize());
+
+  for (size_t i = 0; i < batch.names.size(); ++i) {
+    Cef_Request_Params request;
+    CefProcessMessageImpl::TakeFromBatch(batch, i, request);
+    OnRequest(request);
+  }
+}
+
 void CefBrowserHostImpl::OnResponse(const Cef_Response_Params& params) {
   response_manager_->RunHandler(params);
   if (params.expect_response_ack)
@@ -2361,6 +2580,8 @@ CefBrowserHostImpl::CefBrowserHostImpl(
       can_go_back_(false),
       can_go_forward_(false),
       has_document_(false),
+      paint_delivered_bytes_(0),
+      paint_view_bytes_(0),
       queue_messages_(true),
       main_frame_id_(CefFrameHostImpl::kInvalidFrameId),
       focused_frame_id_(CefFrameHostImpl::kInvalidFrameId),
@@ -2369,6 +2590,7 @@ CefBrowserHostImpl::CefBrowserHostImpl(
       is_in_onsetfocus_(false),
       focus_on_editable_field_(false),
       mouse_cursor_change_disabled_(false),
+      windowless_frame_rate_(0),
       devtools_frontend_(NULL),
       file_chooser_pending_(false) {
 #if defined(USE_AURA)
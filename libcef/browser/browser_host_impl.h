@@ -20,6 +20,7 @@
 #include "libcef/browser/menu_creator.h"
 #include "libcef/common/response_manager.h"
 
+#include "base/callback.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/strings/string16.h"
 #include "base/synchronization/lock.h"
@@ -35,6 +36,10 @@
 #include "ui/base/cursor/cursor.h"
 #endif
 
+namespace base {
+class SharedMemory;
+}
+
 namespace content {
 struct NativeWebKeyboardEvent;
 }
@@ -56,6 +61,7 @@ class Widget;
 #endif
 
 struct Cef_Request_Params;
+struct Cef_RequestBatch_Params;
 struct Cef_Response_Params;
 class CefBrowserInfo;
 class CefDevToolsFrontend;
@@ -156,6 +162,10 @@ class CefBrowserHostImpl : public CefBrowserHost,
   virtual void NotifyScreenInfoChanged() OVERRIDE;
   virtual void Invalidate(const CefRect& dirtyRect,
                           PaintElementType type) OVERRIDE;
+  virtual int64 GetPaintDeliveredBytes() OVERRIDE;
+  virtual int64 GetPaintViewBytes() OVERRIDE;
+  virtual void SetWindowlessFrameRate(int frame_rate) OVERRIDE;
+  virtual void FlushWindowlessPaint() OVERRIDE;
   virtual void SendKeyEvent(const CefKeyEvent& event) OVERRIDE;
   virtual void SendMouseClickEvent(const CefMouseEvent& event,
                                    MouseButtonType type,
@@ -196,6 +206,9 @@ class CefBrowserHostImpl : public CefBrowserHost,
   virtual bool SendProcessMessage(
       CefProcessId target_process,
       CefRefPtr<CefProcessMessage> message) OVERRIDE;
+  virtual bool SendProcessMessages(
+      CefProcessId target_process,
+      const std::vector<CefRefPtr<CefProcessMessage> >& messages) OVERRIDE;
 
   // Called when the OS window hosting the browser is destroyed.
   void WindowDestroyed();
@@ -239,10 +252,22 @@ class CefBrowserHostImpl : public CefBrowserHost,
                 const std::string& script_url, int script_start_line,
                 CefRefPtr<CefResponseManager::Handler> responseHandler);
 
+  // |packed_arguments| is optional and replaces |arguments| when non-empty.
+  // |shared_memory| is optional and will be transferred to the renderer
+  // process without copying.
   bool SendProcessMessage(CefProcessId target_process,
                           const std::string& name,
                           base::ListValue* arguments,
+                          std::string* packed_arguments,
+                          scoped_ptr<base::SharedMemory> shared_memory,
+                          uint32 shared_memory_size,
                           bool user_initiated);
+  // Sends a request with a shared memory segment on the UI thread. Returns
+  // false if the request could not be sent, in which case the segment is
+  // released.
+  bool SendSharedMemoryRequest(scoped_ptr<Cef_Request_Params> params,
+                               scoped_ptr<base::SharedMemory> shared_memory,
+                               uint32 shared_memory_size);
 
   // Open the specified text in the default text editor.
   bool ViewText(const std::string& text);
@@ -260,6 +285,14 @@ class CefBrowserHostImpl : public CefBrowserHost,
 
   bool IsTransparent();
 
+  // Called by the OSR view after pixel data has been delivered to the
+  // CefRenderHandler to update the paint statistics.
+  void OnPaintDelivered(int64 delivered_bytes, int64 view_bytes);
+
+  // Maximum number of OSR paint notifications per second, or <= 0 for no
+  // limit. Only accessed on the UI thread.
+  int windowless_frame_rate() const { return windowless_frame_rate_; }
+
 #if defined(OS_WIN)
   static void RegisterWindowClass();
 #endif
@@ -422,6 +455,7 @@ class CefBrowserHostImpl : public CefBrowserHost,
       int http_status_code);
   void OnLoadingURLChange(const GURL& pending_url);
   void OnRequest(const Cef_Request_Params& params);
+  void OnRequestBatch(const Cef_RequestBatch_Params& params);
   void OnResponse(const Cef_Response_Params& params);
   void OnResponseAck(int request_id);
 
@@ -545,6 +579,8 @@ class CefBrowserHostImpl : public CefBrowserHost,
   bool can_go_forward_;
   bool has_document_;
   GURL loading_url_;
+  int64 paint_delivered_bytes_;
+  int64 paint_view_bytes_;
 
   // Messages we queue while waiting for the RenderView to be ready. We queue
   // them here instead of in the RenderProcessHost to ensure that they're sent
@@ -552,6 +588,10 @@ class CefBrowserHostImpl : public CefBrowserHost,
   std::queue<IPC::Message*> queued_messages_;
   bool queue_messages_;
 
+  // Shared memory requests queued while waiting for the RenderView to be ready.
+  // Each has a NULL entry in |queued_messages_| to preserve ordering.
+  std::queue<base::Closure> queued_shared_memory_requests_;
+
   // Map of unique frame ids to CefFrameHostImpl references.
   typedef std::map<int64, CefRefPtr<CefFrameHostImpl> > FrameMap;
   FrameMap frames_;
@@ -581,6 +621,10 @@ class CefBrowserHostImpl : public CefBrowserHost,
   // True if mouse cursor change is disabled.
   bool mouse_cursor_change_disabled_;
 
+  // Frame rate limit for OSR paint notifications. Only accessed on the UI
+  // thread.
+  int windowless_frame_rate_;
+
   // Used for managing notification subscriptions.
   scoped_ptr<content::NotificationRegistrar> registrar_;
 
@@ -17,6 +17,7 @@
 #include "base/logging.h"
 #include "base/message_loop/message_loop.h"
 #include "base/strings/string_util.h"
+#include "base/synchronization/lock.h"
 #include "content/public/common/url_fetcher.h"
 #include "net/base/io_buffer.h"
 #include "net/base/load_flags.h"
@@ -50,16 +51,25 @@ class CefURLFetcherDelegate : public net::URLFetcherDelegate {
   int request_flags_;
 };
 
+// Default maximum number of bytes waiting for delivery to the client.
+const size_t kDefaultDownloadWindowSize = 512 * 1024;
+
+// Data waiting to be sent to the client is posted once it reaches this size.
+const size_t kDownloadChunkSize = 64 * 1024;
+
 class NET_EXPORT CefURLFetcherResponseWriter :
     public net::URLFetcherResponseWriter {
  public:
   CefURLFetcherResponseWriter(
       CefRefPtr<CefBrowserURLRequest> url_request,
-      scoped_refptr<base::MessageLoopProxy> message_loop_proxy)
-      : url_request_(url_request),
-        message_loop_proxy_(message_loop_proxy) {
+      scoped_refptr<base::MessageLoopProxy> message_loop_proxy,
+      size_t window_size) {
+    if (url_request)
+      core_ = new Core(url_request, message_loop_proxy, window_size);
   }
   virtual ~CefURLFetcherResponseWriter() {
+    if (core_)
+      core_->Detach();
   }
 
   // net::URLFetcherResponseWriter methods.
@@ -70,47 +80,139 @@ class NET_EXPORT CefURLFetcherResponseWriter :
   virtual int Write(net::IOBuffer* buffer,
                     int num_bytes,
                     const net::CompletionCallback& callback) OVERRIDE {
-    if (url_request_) {
-      message_loop_proxy_->PostTask(FROM_HERE,
-          base::Bind(&CefURLFetcherResponseWriter::WriteOnClientThread,
-                     url_request_, scoped_refptr<net::IOBuffer>(buffer),
-                     num_bytes, callback,
-                     base::MessageLoop::current()->message_loop_proxy()));
-      return net::ERR_IO_PENDING;
-    }
+    if (core_)
+      return core_->Write(buffer->data(), num_bytes, callback);
     return num_bytes;
   }
 
   virtual int Finish(const net::CompletionCallback& callback) OVERRIDE {
-    if (url_request_)
-      url_request_ = NULL;
+    if (core_)
+      core_->Finish();
     return net::OK;
   }
 
  private:
-  static void WriteOnClientThread(
-      CefRefPtr<CefBrowserURLRequest> url_request,
-      scoped_refptr<net::IOBuffer> buffer,
-      int num_bytes,
-      const net::CompletionCallback& callback,
-      scoped_refptr<base::MessageLoopProxy> source_message_loop_proxy) {
-    CefRefPtr<CefURLRequestClient> client = url_request->GetClient();
-    if (client)
-      client->OnDownloadData(url_request.get(), buffer->data(), num_bytes);
-
-    source_message_loop_proxy->PostTask(FROM_HERE,
-        base::Bind(&CefURLFetcherResponseWriter::ContinueOnSourceThread,
-                   num_bytes, callback));
-  }
+  // Queues response data for delivery to the client thread. Up to
+  // |window_size_| bytes may be waiting for delivery before Write() returns
+  // ERR_IO_PENDING. Data written while other data is waiting is combined into
+  // larger chunks. Accessed on the source and client threads.
+  class Core : public base::RefCountedThreadSafe<Core> {
+   public:
+    Core(CefRefPtr<CefBrowserURLRequest> url_request,
+         scoped_refptr<base::MessageLoopProxy> message_loop_proxy,
+         size_t window_size)
+        : url_request_(url_request),
+          message_loop_proxy_(message_loop_proxy),
+          window_size_(window_size > 0 ? window_size :
+                                         kDefaultDownloadWindowSize),
+          pending_bytes_(0),
+          pending_write_size_(0) {
+    }
 
-  static void ContinueOnSourceThread(
-      int num_bytes,
-      const net::CompletionCallback& callback) {
-    callback.Run(num_bytes);
-  }
+    int Write(const char* data,
+              int num_bytes,
+              const net::CompletionCallback& callback) {
+      base::AutoLock lock_scope(lock_);
+      DCHECK(pending_callback_.is_null());
 
-  CefRefPtr<CefBrowserURLRequest> url_request_;
-  scoped_refptr<base::MessageLoopProxy> message_loop_proxy_;
+      if (!url_request_)
+        return num_bytes;
+
+      buffer_.append(data, num_bytes);
+
+      // Send the data immediately if the client is idle.
+      if (pending_bytes_ == 0 || buffer_.size() >= kDownloadChunkSize)
+        PostData();
+
+      if (pending_bytes_ + buffer_.size() >= window_size_) {
+        // Wait for the client to catch up.
+        pending_callback_ = callback;
+        pending_write_size_ = num_bytes;
+        source_message_loop_proxy_ =
+            base::MessageLoop::current()->message_loop_proxy();
+        return net::ERR_IO_PENDING;
+      }
+
+      return num_bytes;
+    }
+
+    void Finish() {
+      base::AutoLock lock_scope(lock_);
+      if (url_request_) {
+        PostData();
+        url_request_ = NULL;
+      }
+    }
+
+    void Detach() {
+      base::AutoLock lock_scope(lock_);
+      url_request_ = NULL;
+      pending_callback_.Reset();
+    }
+
+   private:
+    friend class base::RefCountedThreadSafe<Core>;
+
+    ~Core() {}
+
+    // Post the buffered data to the client thread.
+    void PostData() {
+      lock_.AssertAcquired();
+      if (buffer_.empty() || !url_request_)
+        return;
+
+      scoped_ptr<std::string> data(new std::string());
+      data->swap(buffer_);
+      pending_bytes_ += data->size();
+
+      message_loop_proxy_->PostTask(FROM_HERE,
+          base::Bind(&Core::WriteOnClientThread, this, url_request_,
+                     base::Passed(&data)));
+    }
+
+    void WriteOnClientThread(CefRefPtr<CefBrowserURLRequest> url_request,
+                             scoped_ptr<std::string> data) {
+      // Don't deliver data after the request has been canceled.
+      if (url_request->GetRequestStatus() == UR_IO_PENDING) {
+        CefRefPtr<CefURLRequestClient> client = url_request->GetClient();
+        if (client)
+          client->OnDownloadData(url_request.get(), data->data(), data->size());
+      }
+
+      base::AutoLock lock_scope(lock_);
+      DCHECK_GE(pending_bytes_, data->size());
+      pending_bytes_ -= data->size();
+
+      if (pending_bytes_ == 0)
+        PostData();
+
+      if (!pending_callback_.is_null() &&
+          pending_bytes_ + buffer_.size() < window_size_) {
+        // Continue reading from the network.
+        source_message_loop_proxy_->PostTask(FROM_HERE,
+            base::Bind(pending_callback_, pending_write_size_));
+        pending_callback_.Reset();
+        pending_write_size_ = 0;
+      }
+    }
+
+    base::Lock lock_;
+    CefRefPtr<CefBrowserURLRequest> url_request_;
+    scoped_refptr<base::MessageLoopProxy> message_loop_proxy_;
+    scoped_refptr<base::MessageLoopProxy> source_message_loop_proxy_;
+    const size_t window_size_;
+
+    // Data that has not yet been posted to the client thread.
+    std::string buffer_;
+    // Number of bytes posted to the client thread but not yet delivered.
+    size_t pending_bytes_;
+
+    // Completion callback for a Write() that returned ERR_IO_PENDING.
+    net::CompletionCallback pending_callback_;
+    int pending_write_size_;
+  };
+
+  scoped_refptr<Core> core_;
 
   DISALLOW_COPY_AND_ASSIGN(CefURLFetcherResponseWriter);
 };
@@ -138,7 +240,8 @@ class CefBrowserURLRequest::Context
     status_(UR_IO_PENDING),
     error_code_(ERR_NONE),
     upload_data_size_(0),
-    got_upload_progress_complete_(false) {
+    got_upload_progress_complete_(false),
+    download_to_file_(false) {
     // Mark the request as read-only.
     static_cast<CefRequestImpl*>(request_.get())->SetReadOnly(true);
   }
@@ -297,14 +400,28 @@ class CefBrowserURLRequest::Context
         CefURLRequestUserData::kUserDataKey,
         base::Bind(&CreateURLRequestUserData, client_));
 
-    scoped_ptr<net::URLFetcherResponseWriter> response_writer;
-    if (cef_flags & UR_FLAG_NO_DOWNLOAD_DATA) {
-      response_writer.reset(new CefURLFetcherResponseWriter(NULL, NULL));
+    CefString download_file_path;
+    if (!(cef_flags & UR_FLAG_NO_DOWNLOAD_DATA))
+      download_file_path = client_->GetDownloadFilePath();
+
+    if (!download_file_path.empty()) {
+      // Write the response data directly to the file on the FILE thread.
+      download_to_file_ = true;
+      fetcher_->SaveResponseToFileAtPath(
+          base::FilePath(download_file_path),
+          content::BrowserThread::GetMessageLoopProxyForThread(
+              content::BrowserThread::FILE));
     } else {
-      response_writer.reset(
-          new CefURLFetcherResponseWriter(url_request_, message_loop_proxy_));
+      scoped_ptr<net::URLFetcherResponseWriter> response_writer;
+      if (cef_flags & UR_FLAG_NO_DOWNLOAD_DATA) {
+        response_writer.reset(new CefURLFetcherResponseWriter(NULL, NULL, 0));
+      } else {
+        response_writer.reset(
+            new CefURLFetcherResponseWriter(url_request_, message_loop_proxy_,
+                                            client_->GetDownloadWindowSize()));
+      }
+      fetcher_->SaveResponseWithWriter(response_writer.Pass());
     }
-    fetcher_->SaveResponseWithWriter(response_writer.Pass());
 
     fetcher_->Start();
 
@@ -352,6 +469,12 @@ class CefBrowserURLRequest::Context
 
       error_code_ = static_cast<CefURLRequest::ErrorCode>(status.error());
 
+      if (download_to_file_ && status_ == UR_SUCCESS) {
+        // Keep the file. Otherwise it will be deleted with the fetcher.
+        base::FilePath file_path;
+        fetcher_->GetResponseAsFilePath(true, &file_path);
+      }
+
       if(!response_.get())
         OnResponse();
     }
@@ -441,6 +564,7 @@ class CefBrowserURLRequest::Context
   CefRefPtr<CefResponse> response_;
   int64 upload_data_size_;
   bool got_upload_progress_complete_;
+  bool download_to_file_;
 };
 
 
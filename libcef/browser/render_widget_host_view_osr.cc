@@ -8,10 +8,12 @@
 #include "libcef/browser/render_widget_host_view_osr.h"
 
 #include "base/message_loop/message_loop.h"
+#include "content/browser/renderer_host/backing_store_manager.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
 #include "content/public/browser/content_browser_client.h"
 #include "content/public/browser/render_view_host.h"
 #include "third_party/WebKit/public/platform/WebScreenInfo.h"
+#include "ui/gfx/rect_conversions.h"
 #include "ui/gfx/size_conversions.h"
 #include "webkit/common/cursors/webcursor.h"
 
@@ -19,6 +21,10 @@ namespace {
 
 const float kDefaultScaleFactor = 1.0;
 
+// Default delay before the tiled backing store is released after the view is
+// hidden.
+const int kDefaultTileDiscardDelayMs = 5000;
+
 static blink::WebScreenInfo webScreenInfoFrom(const CefScreenInfo& src) {
   blink::WebScreenInfo webScreenInfo;
   webScreenInfo.deviceScaleFactor = src.device_scale_factor;
@@ -35,6 +41,33 @@ static blink::WebScreenInfo webScreenInfoFrom(const CefScreenInfo& src) {
   return webScreenInfo;
 }
 
+// Merge rectangles in |rects| while the union of two rectangles adds no more
+// than |threshold| percent of undamaged area to their combined area.
+void MergePaintRects(std::vector<gfx::Rect>* rects, int threshold) {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t i = 0; i < rects->size() && !merged; ++i) {
+      for (size_t j = i + 1; j < rects->size(); ++j) {
+        const gfx::Rect& a = (*rects)[i];
+        const gfx::Rect& b = (*rects)[j];
+        const gfx::Rect union_rect = gfx::UnionRects(a, b);
+        const int64 area =
+            static_cast<int64>(a.width()) * a.height() +
+            static_cast<int64>(b.width()) * b.height();
+        const int64 union_area =
+            static_cast<int64>(union_rect.width()) * union_rect.height();
+        if (union_area * 100 <= area * (100 + threshold)) {
+          (*rects)[i] = union_rect;
+          rects->erase(rects->begin() + j);
+          merged = true;
+          break;
+        }
+      }
+    }
+  }
+}
+
 }  // namespace
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -160,13 +193,33 @@ void CefRenderWidgetHostViewOSR::InitAsFullscreen(
 }
 
 void CefRenderWidgetHostViewOSR::WasShown() {
+  tile_discard_timer_.Stop();
   if (render_widget_host_)
     render_widget_host_->WasShown();
 }
 
 void CefRenderWidgetHostViewOSR::WasHidden() {
-  if (render_widget_host_)
+  if (render_widget_host_) {
     render_widget_host_->WasHidden();
+
+    // Release the tiles if the view stays hidden. Tiles are only kept for a
+    // short time so that quickly toggling visibility does not force a full
+    // repaint.
+    BackingStoreOSR* backing_store =
+        BackingStoreOSR::From(render_widget_host_->GetBackingStore(false));
+    if (backing_store && backing_store->is_tiled()) {
+      int delay_ms = 0;
+      if (browser_impl_.get()) {
+        delay_ms = browser_impl_->GetClient()->GetRenderHandler()->
+            GetPaintTileDiscardDelay(browser_impl_->GetBrowser());
+      }
+      if (delay_ms <= 0)
+        delay_ms = kDefaultTileDiscardDelayMs;
+      tile_discard_timer_.Start(FROM_HERE,
+          base::TimeDelta::FromMilliseconds(delay_ms), this,
+          &CefRenderWidgetHostViewOSR::DiscardTiles);
+    }
+  }
 }
 
 void CefRenderWidgetHostViewOSR::MovePluginWindows(
@@ -241,9 +294,9 @@ void CefRenderWidgetHostViewOSR::DidUpdateBackingStore(
   if (!scroll_rect.IsEmpty()) {
     std::vector<gfx::Rect> dirty_rects(copy_rects);
     dirty_rects.push_back(scroll_rect);
-    Paint(dirty_rects);
+    SchedulePaint(dirty_rects);
   } else {
-    Paint(copy_rects);
+    SchedulePaint(copy_rects);
   }
 }
 
@@ -325,6 +378,8 @@ void CefRenderWidgetHostViewOSR::CreateBrowserAccessibilityManagerIfNeeded() {
 }
 
 void CefRenderWidgetHostViewOSR::Destroy() {
+  DetachBackingStore();
+
   if (IsPopupWidget()) {
     if (parent_host_view_)
       parent_host_view_->CancelWidget();
@@ -361,9 +416,17 @@ void CefRenderWidgetHostViewOSR::ScrollOffsetChanged() {
 
 content::BackingStore* CefRenderWidgetHostViewOSR::AllocBackingStore(
     const gfx::Size& size) {
-  return render_widget_host_ ?
-      new BackingStoreOSR(render_widget_host_, size, GetDeviceScaleFactor()) :
-      NULL;
+  if (!render_widget_host_)
+    return NULL;
+  int tile_size = 0;
+  if (browser_impl_.get()) {
+    tile_size = browser_impl_->GetClient()->GetRenderHandler()->
+        GetPaintTileSize(browser_impl_->GetBrowser());
+  }
+  return new BackingStoreOSR(render_widget_host_, size, GetDeviceScaleFactor(),
+                             browser_impl_,
+                             IsPopupWidget() ? PET_POPUP : PET_VIEW,
+                             tile_size);
 }
 
 void CefRenderWidgetHostViewOSR::CopyFromCompositingSurface(
@@ -455,6 +518,41 @@ void CefRenderWidgetHostViewOSR::Invalidate(const gfx::Rect& rect,
   Paint(dirtyRects);
 }
 
+void CefRenderWidgetHostViewOSR::SchedulePaint(
+    const std::vector<gfx::Rect>& copy_rects) {
+  const int frame_rate =
+      browser_impl_.get() ? browser_impl_->windowless_frame_rate() : 0;
+  if (frame_rate <= 0) {
+    Paint(copy_rects);
+    return;
+  }
+
+  pending_update_rects_.insert(pending_update_rects_.end(),
+      copy_rects.begin(), copy_rects.end());
+  if (paint_timer_.IsRunning())
+    return;
+
+  // Wait until a full frame interval has elapsed since the last paint.
+  const base::TimeDelta interval = base::TimeDelta::FromMicroseconds(
+      base::Time::kMicrosecondsPerSecond / frame_rate);
+  base::TimeDelta delay =
+      last_paint_time_ + interval - base::TimeTicks::Now();
+  if (delay < base::TimeDelta())
+    delay = base::TimeDelta();
+
+  paint_timer_.Start(FROM_HERE, delay, this,
+                     &CefRenderWidgetHostViewOSR::FlushPaint);
+}
+
+void CefRenderWidgetHostViewOSR::FlushPaint() {
+  paint_timer_.Stop();
+  if (!pending_update_rects_.empty())
+    Paint(std::vector<gfx::Rect>());
+
+  if (!IsPopupWidget() && popup_host_view_)
+    popup_host_view_->FlushPaint();
+}
+
 void CefRenderWidgetHostViewOSR::Paint(
     const std::vector<gfx::Rect>& copy_rects) {
   TRACE_EVENT1("libcef", "CefRenderWidgetHostViewOSR::Paint", "rects", copy_rects.size()); 
@@ -502,14 +600,156 @@ void CefRenderWidgetHostViewOSR::Paint(
     if (rcList.size() == 0)
       return;
 
-    browser_impl_->GetClient()->GetRenderHandler()->OnPaint(
-        browser_impl_->GetBrowser(),
-        IsPopupWidget() ? PET_POPUP : PET_VIEW,
-        rcList,
-        backing_store->getPixels(),
-        client_rect.width(),
-        client_rect.height());
+    last_paint_time_ = base::TimeTicks::Now();
+
+    CefRefPtr<CefRenderHandler> handler =
+        browser_impl_->GetClient()->GetRenderHandler();
+    const CefBrowserHost::PaintElementType type =
+        IsPopupWidget() ? PET_POPUP : PET_VIEW;
+    // Delivered bytes are counted in device pixels so the full view size must
+    // be as well.
+    const gfx::Size pixel_size = backing_store->GetPixelSize();
+    const int64 view_bytes =
+        static_cast<int64>(pixel_size.width()) * pixel_size.height() * 4;
+
+    if (backing_store->is_tiled()) {
+      PaintTiles(backing_store, type, rcList, view_bytes);
+      return;
+    }
+
+    const int merge_threshold =
+        handler->GetPaintSpanMergeThreshold(browser_impl_->GetBrowser());
+    if (merge_threshold < 0) {
+      handler->OnPaint(browser_impl_->GetBrowser(), type, rcList,
+                       backing_store->getPixels(), client_rect.width(),
+                       client_rect.height());
+      browser_impl_->OnPaintDelivered(view_bytes, view_bytes);
+      return;
+    }
+
+    PaintSpans(backing_store, type, rcList, merge_threshold, view_bytes);
+  }
+}
+
+void CefRenderWidgetHostViewOSR::PaintSpans(
+    BackingStoreOSR* backing_store,
+    CefBrowserHost::PaintElementType type,
+    const CefRenderHandler::RectList& dirty_rects,
+    int merge_threshold,
+    int64 view_bytes) {
+  std::vector<gfx::Rect> span_rects;
+  for (size_t i = 0; i < dirty_rects.size(); ++i) {
+    span_rects.push_back(gfx::Rect(dirty_rects[i].x, dirty_rects[i].y,
+                                   dirty_rects[i].width,
+                                   dirty_rects[i].height));
+  }
+  MergePaintRects(&span_rects, merge_threshold);
+
+  const SkBitmap& bitmap = backing_store->getBitmap();
+  const gfx::Rect bitmap_rect(bitmap.width(), bitmap.height());
+  const float scale_factor = backing_store->device_scale_factor();
+  const uint8* pixels = static_cast<const uint8*>(bitmap.getPixels());
+  const size_t row_bytes = bitmap.rowBytes();
+
+  CefRefPtr<CefRenderHandler> handler =
+      browser_impl_->GetClient()->GetRenderHandler();
+  int64 delivered_bytes = 0;
+
+  for (size_t i = 0; i < span_rects.size(); ++i) {
+    gfx::Rect pixel_rect = gfx::ToEnclosingRect(
+        gfx::ScaleRect(span_rects[i], scale_factor));
+    pixel_rect.Intersect(bitmap_rect);
+    if (pixel_rect.IsEmpty())
+      continue;
+
+    // Pack the rows of |pixel_rect| contiguously so that the client can
+    // upload them without knowledge of the backing store layout.
+    const int stride = pixel_rect.width() * 4;
+    const size_t span_size = static_cast<size_t>(stride) * pixel_rect.height();
+    if (span_buffer_.size() < span_size)
+      span_buffer_.resize(span_size);
+
+    const uint8* src = pixels + pixel_rect.y() * row_bytes + pixel_rect.x() * 4;
+    uint8* dst = &span_buffer_[0];
+    for (int row = 0; row < pixel_rect.height(); ++row) {
+      memcpy(dst, src, stride);
+      src += row_bytes;
+      dst += stride;
+    }
+
+    handler->OnPaintSpan(browser_impl_->GetBrowser(), type,
+                         CefRect(pixel_rect.x(), pixel_rect.y(),
+                                 pixel_rect.width(), pixel_rect.height()),
+                         &span_buffer_[0], stride);
+    delivered_bytes += span_size;
+  }
+
+  browser_impl_->OnPaintDelivered(delivered_bytes, view_bytes);
+}
+
+void CefRenderWidgetHostViewOSR::PaintTiles(
+    BackingStoreOSR* backing_store,
+    CefBrowserHost::PaintElementType type,
+    const CefRenderHandler::RectList& dirty_rects,
+    int64 view_bytes) {
+  const float scale_factor = backing_store->device_scale_factor();
+
+  CefRefPtr<CefRenderHandler> handler =
+      browser_impl_->GetClient()->GetRenderHandler();
+  int64 delivered_bytes = 0;
+
+  for (size_t i = 0; i < dirty_rects.size(); ++i) {
+    const gfx::Rect pixel_rect = gfx::ToEnclosingRect(gfx::ScaleRect(
+        gfx::Rect(dirty_rects[i].x, dirty_rects[i].y, dirty_rects[i].width,
+                  dirty_rects[i].height),
+        scale_factor));
+
+    int first_column, last_column, first_row, last_row;
+    backing_store->GetTileRange(pixel_rect, &first_column, &last_column,
+                                &first_row, &last_row);
+
+    for (int row = first_row; row <= last_row; ++row) {
+      for (int column = first_column; column <= last_column; ++column) {
+        const int index = row * backing_store->tile_columns() + column;
+        const SkBitmap* tile = backing_store->GetTile(index);
+        if (!tile)
+          continue;
+
+        // Deliver the part of the dirty rect that falls inside this tile
+        // directly from the tile memory.
+        const gfx::Rect tile_rect = backing_store->GetTileRect(index);
+        const gfx::Rect piece = gfx::IntersectRects(pixel_rect, tile_rect);
+        if (piece.IsEmpty())
+          continue;
+
+        const uint8* pixels = static_cast<const uint8*>(tile->getPixels()) +
+            (piece.y() - tile_rect.y()) * tile->rowBytes() +
+            (piece.x() - tile_rect.x()) * 4;
+        handler->OnPaintSpan(browser_impl_->GetBrowser(), type,
+                             CefRect(piece.x(), piece.y(), piece.width(),
+                                     piece.height()),
+                             pixels, static_cast<int>(tile->rowBytes()));
+        delivered_bytes += static_cast<int64>(piece.width()) *
+                           piece.height() * 4;
+      }
+    }
   }
+
+  browser_impl_->OnPaintDelivered(delivered_bytes, view_bytes);
+}
+
+void CefRenderWidgetHostViewOSR::DiscardTiles() {
+  if (render_widget_host_)
+    content::BackingStoreManager::RemoveBackingStore(render_widget_host_);
+}
+
+void CefRenderWidgetHostViewOSR::DetachBackingStore() {
+  if (!render_widget_host_)
+    return;
+  BackingStoreOSR* backing_store = BackingStoreOSR::From(
+      content::BackingStoreManager::Lookup(render_widget_host_));
+  if (backing_store)
+    backing_store->DetachBrowser();
 }
 
 bool CefRenderWidgetHostViewOSR::InstallTransparency() {
@@ -531,6 +771,7 @@ void CefRenderWidgetHostViewOSR::CancelWidget() {
 
     if (browser_impl_.get()) {
       NotifyHideWidget();
+      DetachBackingStore();
       browser_impl_ = NULL;
     }
 
@@ -11,8 +11,11 @@
 
 #include "include/cef_base.h"
 #include "include/cef_browser.h"
+#include "include/cef_render_handler.h"
 
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/browser/renderer_host/render_widget_host_view_base.h"
 
 namespace content {
@@ -20,6 +23,7 @@ namespace content {
   class BackingStore;
 }
 
+class BackingStoreOSR;
 class CefBrowserHostImpl;
 class CefWebContentsViewOSR;
 
@@ -202,6 +206,13 @@ class CefRenderWidgetHostViewOSR : public content::RenderWidgetHostViewBase {
   void Invalidate(const gfx::Rect& rect,
                   CefBrowserHost::PaintElementType type);
   void Paint(const std::vector<gfx::Rect>& copy_rects);
+
+  // Paint |copy_rects| now or, if a windowless frame rate is set, at the next
+  // frame.
+  void SchedulePaint(const std::vector<gfx::Rect>& copy_rects);
+
+  // Immediately paint any updates held back by SchedulePaint.
+  void FlushPaint();
   bool InstallTransparency();
 
   void OnScreenInfoChanged();
@@ -232,6 +243,28 @@ class CefRenderWidgetHostViewOSR : public content::RenderWidgetHostViewBase {
   // After calling this function, object gets deleted
   void ShutdownHost();
 
+  // Deliver |dirty_rects| from |backing_store| via CefRenderHandler::
+  // OnPaintSpan after merging them according to |merge_threshold|.
+  void PaintSpans(BackingStoreOSR* backing_store,
+                  CefBrowserHost::PaintElementType type,
+                  const CefRenderHandler::RectList& dirty_rects,
+                  int merge_threshold,
+                  int64 view_bytes);
+
+  // Deliver |dirty_rects| from the tiled |backing_store| via CefRenderHandler::
+  // OnPaintSpan with one call per dirty tile.
+  void PaintTiles(BackingStoreOSR* backing_store,
+                  CefBrowserHost::PaintElementType type,
+                  const CefRenderHandler::RectList& dirty_rects,
+                  int64 view_bytes);
+
+  // Release the tiled backing store after the view has been hidden.
+  void DiscardTiles();
+
+  // Stop the cached backing store from referencing the browser and return any
+  // client-provided paint buffer.
+  void DetachBackingStore();
+
   // Factory used to safely scope delayed calls to ShutdownHost().
   base::WeakPtrFactory<CefRenderWidgetHostViewOSR> weak_factory_;
 
@@ -247,8 +280,18 @@ class CefRenderWidgetHostViewOSR : public content::RenderWidgetHostViewBase {
   bool about_to_validate_and_paint_;
   std::vector<gfx::Rect> pending_update_rects_;
 
+  // Used to deliver updates held back by SchedulePaint.
+  base::OneShotTimer<CefRenderWidgetHostViewOSR> paint_timer_;
+  base::TimeTicks last_paint_time_;
+
+  // Used to release the tiled backing store while hidden.
+  base::OneShotTimer<CefRenderWidgetHostViewOSR> tile_discard_timer_;
+
   gfx::Rect popup_position_;
 
+  // Scratch memory used to pack the pixels passed to OnPaintSpan.
+  std::vector<uint8> span_buffer_;
+
 #if defined(OS_MACOSX)
   NSTextInputContext* text_input_context_osr_mac_;
 #endif  // defined(OS_MACOSX)
@@ -154,6 +154,9 @@ CefResourceRequestJob::CefResourceRequestJob(
       handler_(handler),
       done_(false),
       remaining_bytes_(0),
+      use_response_data_(false),
+      response_data_size_(0),
+      response_data_offset_(0),
       response_cookies_save_index_(0),
       weak_factory_(this) {
 }
@@ -244,6 +247,9 @@ bool CefResourceRequestJob::ReadRawData(net::IOBuffer* dest, int dest_size,
     dest_size = static_cast<int>(remaining_bytes_);
   }
 
+  if (use_response_data_)
+    return ReadResponseData(dest, dest_size, bytes_read);
+
   if (!callback_.get()) {
     // Create the bytes available callback that will be used until the request
     // is completed.
@@ -357,10 +363,48 @@ void CefResourceRequestJob::SendHeaders() {
   if (remaining_bytes_ > 0)
     set_expected_content_size(remaining_bytes_);
 
+  // Check if the handler provides the response data directly.
+  response_data_ = handler_->GetResponseData();
+  if (response_data_.get()) {
+    use_response_data_ = true;
+    response_data_size_ = response_data_->GetSize();
+    response_data_offset_ = 0;
+  }
+
   // Continue processing the request.
   SaveCookiesAndNotifyHeadersComplete();
 }
 
+bool CefResourceRequestJob::ReadResponseData(net::IOBuffer* dest,
+                                             int dest_size,
+                                             int* bytes_read) {
+  // Move to the next value when the current value has been read completely.
+  while (response_data_.get() &&
+         response_data_offset_ >= response_data_size_) {
+    response_data_ = handler_->GetResponseData();
+    response_data_size_ = response_data_.get() ? response_data_->GetSize() : 0;
+    response_data_offset_ = 0;
+  }
+
+  if (!response_data_.get()) {
+    // The handler has indicated completion of the request.
+    *bytes_read = 0;
+    done_ = true;
+    return true;
+  }
+
+  // Copy directly from the shared value into the destination buffer.
+  *bytes_read = static_cast<int>(
+      response_data_->GetData(dest->data(), dest_size, response_data_offset_));
+  response_data_offset_ += *bytes_read;
+
+  if (remaining_bytes_ > 0)
+    remaining_bytes_ -= *bytes_read;
+
+  // Continue calling this method.
+  return true;
+}
+
 void CefResourceRequestJob::AddCookieHeaderAndStart() {
   // No matter what, we want to report our status as IO pending since we will
   // be notifying our consumer asynchronously via OnStartCompleted.
@@ -43,6 +43,9 @@ class CefResourceRequestJob : public net::URLRequestJob {
 
   void SendHeaders();
 
+  // Read from the response data provided by the handler.
+  bool ReadResponseData(net::IOBuffer* dest, int dest_size, int* bytes_read);
+
   // Used for sending cookies with the request.
   void AddCookieHeaderAndStart();
   void DoLoadCookies();
@@ -64,6 +67,11 @@ class CefResourceRequestJob : public net::URLRequestJob {
   CefRefPtr<CefResponse> response_;
   GURL redirect_url_;
   int64 remaining_bytes_;
+  // Response data provided by CefResourceHandler::GetResponseData.
+  bool use_response_data_;
+  CefRefPtr<CefBinaryValue> response_data_;
+  size_t response_data_size_;
+  size_t response_data_offset_;
   CefRefPtr<CefRequest> cef_request_;
   CefRefPtr<CefResourceRequestJobCallback> callback_;
   scoped_refptr<net::HttpResponseHeaders> response_headers_;
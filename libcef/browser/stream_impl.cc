@@ -5,6 +5,7 @@
 #include "libcef/browser/stream_impl.h"
 #include <stdlib.h>
 #include "base/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
 #include "base/threading/thread_restrictions.h"
 
@@ -24,6 +25,20 @@ CefRefPtr<CefStreamReader> CefStreamReader::CreateForFile(
   return reader;
 }
 
+CefRefPtr<CefStreamReader> CefStreamReader::CreateForMappedFile(
+    const CefString& fileName) {
+  DCHECK(!fileName.empty());
+
+  // TODO(cef): Do not allow file IO on all threads (issue #1187).
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+
+  CefRefPtr<CefStreamReader> reader;
+  scoped_ptr<base::MemoryMappedFile> file(new base::MemoryMappedFile());
+  if (file->Initialize(base::FilePath(fileName)) && file->length() > 0)
+    reader = new CefMappedFileReader(file.Pass());
+  return reader;
+}
+
 CefRefPtr<CefStreamReader> CefStreamReader::CreateForData(void* data,
                                                           size_t size) {
   DCHECK(data != NULL);
@@ -204,6 +219,16 @@ int CefBytesReader::Eof() {
   return (offset_ >= datasize_);
 }
 
+const void* CefBytesReader::GetData() {
+  AutoLock lock_scope(this);
+  return data_;
+}
+
+size_t CefBytesReader::GetDataSize() {
+  AutoLock lock_scope(this);
+  return static_cast<size_t>(datasize_);
+}
+
 void CefBytesReader::SetData(void* data, int64 datasize, bool copy) {
   AutoLock lock_scope(this);
   if (copy_)
@@ -224,6 +249,21 @@ void CefBytesReader::SetData(void* data, int64 datasize, bool copy) {
 }
 
 
+// CefMappedFileReader
+
+CefMappedFileReader::CefMappedFileReader(
+    scoped_ptr<base::MemoryMappedFile> file)
+  : CefBytesReader(NULL, 0, false),
+    file_(file.Pass()) {
+  SetData(const_cast<uint8*>(file_->data()), file_->length(), false);
+}
+
+CefMappedFileReader::~CefMappedFileReader() {
+  // Release the data before the mapping is closed.
+  SetData(NULL, 0, false);
+}
+
+
 // CefBytesWriter
 
 CefBytesWriter::CefBytesWriter(size_t grow)
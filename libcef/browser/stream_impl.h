@@ -9,6 +9,11 @@
 #include <stdio.h>
 #include <string>
 #include "include/cef_stream.h"
+#include "base/memory/scoped_ptr.h"
+
+namespace base {
+class MemoryMappedFile;
+}
 
 // Implementation of CefStreamReader for files.
 class CefFileReader : public CefStreamReader {
@@ -21,6 +26,8 @@ class CefFileReader : public CefStreamReader {
   virtual int64 Tell() OVERRIDE;
   virtual int Eof() OVERRIDE;
   virtual bool MayBlock() OVERRIDE { return true; }
+  virtual const void* GetData() OVERRIDE { return NULL; }
+  virtual size_t GetDataSize() OVERRIDE { return 0; }
 
  protected:
   bool close_;
@@ -61,12 +68,11 @@ class CefBytesReader : public CefStreamReader {
   virtual int64 Tell() OVERRIDE;
   virtual int Eof() OVERRIDE;
   virtual bool MayBlock() OVERRIDE { return false; }
+  virtual const void* GetData() OVERRIDE;
+  virtual size_t GetDataSize() OVERRIDE;
 
   void SetData(void* data, int64 datasize, bool copy);
 
-  void* GetData() { return data_; }
-  size_t GetDataSize() { return offset_; }
-
  protected:
   void* data_;
   int64 datasize_;
@@ -77,6 +83,20 @@ class CefBytesReader : public CefStreamReader {
   IMPLEMENT_LOCKING(CefBytesReader);
 };
 
+// Implementation of CefStreamReader for memory-mapped files. Accessing the
+// mapping, either through Read() or GetData(), may fault in pages from disk so
+// the reader is considered blocking.
+class CefMappedFileReader : public CefBytesReader {
+ public:
+  explicit CefMappedFileReader(scoped_ptr<base::MemoryMappedFile> file);
+  virtual ~CefMappedFileReader();
+
+  virtual bool MayBlock() OVERRIDE { return true; }
+
+ private:
+  scoped_ptr<base::MemoryMappedFile> file_;
+};
+
 // Implementation of CefStreamWriter for byte buffers.
 class CefBytesWriter : public CefStreamWriter {
  public:
@@ -126,6 +146,8 @@ class CefHandlerReader : public CefStreamReader {
   virtual bool MayBlock() OVERRIDE {
     return handler_->MayBlock();
   }
+  virtual const void* GetData() OVERRIDE { return NULL; }
+  virtual size_t GetDataSize() OVERRIDE { return 0; }
 
  protected:
   CefRefPtr<CefReadHandler> handler_;
@@ -42,6 +42,26 @@ IPC_STRUCT_BEGIN(Cef_Request_Params)
 
   // List of message arguments.
   IPC_STRUCT_MEMBER(base::ListValue, arguments)
+
+  // Message arguments in the CefPackedValueBuffer format. If non-empty
+  // |arguments| will be empty.
+  IPC_STRUCT_MEMBER(std::string, packed_arguments)
+
+  // Optional shared memory segment that is transferred with the message
+  // instead of being serialized. |shared_memory_size| is 0 if no segment is
+  // attached.
+  IPC_STRUCT_MEMBER(base::SharedMemoryHandle, shared_memory_handle)
+  IPC_STRUCT_MEMBER(uint32, shared_memory_size)
+IPC_STRUCT_END()
+
+// Parameters structure for a batch of user-initiated requests that do not
+// expect a response.
+IPC_STRUCT_BEGIN(Cef_RequestBatch_Params)
+  // Message names in delivery order.
+  IPC_STRUCT_MEMBER(std::vector<std::string>, names)
+
+  // List containing one list of message arguments for each name.
+  IPC_STRUCT_MEMBER(base::ListValue, arguments)
 IPC_STRUCT_END()
 
 // Parameters structure for a response.
@@ -114,6 +134,11 @@ IPC_MESSAGE_ROUTED1(CefMsg_LoadRequest,
 IPC_MESSAGE_ROUTED1(CefMsg_Request,
                     Cef_Request_Params)
 
+// Sent when the browser has multiple requests for the renderer. Each request
+// is handled as if it had been sent with CefMsg_Request.
+IPC_MESSAGE_ROUTED1(CefMsg_RequestBatch,
+                    Cef_RequestBatch_Params)
+
 // Optional message sent in response to a CefHostMsg_Request.
 IPC_MESSAGE_ROUTED1(CefMsg_Response,
                     Cef_Response_Params)
@@ -192,6 +217,11 @@ IPC_MESSAGE_ROUTED1(CefHostMsg_LoadingURLChange,
 IPC_MESSAGE_ROUTED1(CefHostMsg_Request,
                     Cef_Request_Params)
 
+// Sent when the renderer has multiple requests for the browser. Each request
+// is handled as if it had been sent with CefHostMsg_Request.
+IPC_MESSAGE_ROUTED1(CefHostMsg_RequestBatch,
+                    Cef_RequestBatch_Params)
+
 // Optional message sent in response to a CefMsg_Request.
 IPC_MESSAGE_ROUTED1(CefHostMsg_Response,
                     Cef_Response_Params)
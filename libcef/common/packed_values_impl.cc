@@ -0,0 +1,870 @@
+// Copyright (c) 2014 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "libcef/common/packed_values_impl.h"
+
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+
+namespace {
+
+const uint32 kPackedMagic = 0x43465056;  // "CFPV"
+
+// Header is magic, key table offset and root node offset.
+const uint32 kHeaderSize = 3 * sizeof(uint32);
+const uint32 kKeyTableOffsetPos = sizeof(uint32);
+const uint32 kRootOffsetPos = 2 * sizeof(uint32);
+
+// Maximum nesting depth accepted when validating a received buffer. Buffers
+// that will be sent are limited to the same depth when packed.
+const int kMaxDepth = 100;
+
+class Packer {
+ public:
+  // Values nested deeper than |max_depth| fail to pack. Specify -1 for no
+  // limit.
+  Packer(std::string* output, int max_depth)
+      : output_(output),
+        max_depth_(max_depth),
+        too_deep_(false) {
+  }
+
+  bool Pack(const base::Value& value) {
+    DCHECK(value.IsType(base::Value::TYPE_LIST) ||
+           value.IsType(base::Value::TYPE_DICTIONARY));
+    output_->clear();
+    AppendUInt32(kPackedMagic);
+    AppendUInt32(0);  // Key table offset.
+    AppendUInt32(0);  // Root node offset.
+
+    SetUInt32(kRootOffsetPos, WriteNode(value, 0));
+    if (too_deep_) {
+      output_->clear();
+      return false;
+    }
+    SetUInt32(kKeyTableOffsetPos, Size());
+    WriteKeyTable();
+    return true;
+  }
+
+ private:
+  uint32 Size() const {
+    return static_cast<uint32>(output_->size());
+  }
+
+  void AppendUInt32(uint32 value) {
+    output_->append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void SetUInt32(uint32 offset, uint32 value) {
+    memcpy(&(*output_)[offset], &value, sizeof(value));
+  }
+
+  void AppendBytes(const char* data, size_t size) {
+    AppendUInt32(static_cast<uint32>(size));
+    output_->append(data, size);
+  }
+
+  uint32 InternKey(const std::string& key) {
+    KeyMap::const_iterator it = key_map_.find(key);
+    if (it != key_map_.end())
+      return it->second;
+    uint32 index = static_cast<uint32>(keys_.size());
+    key_map_.insert(std::make_pair(key, index));
+    keys_.push_back(key);
+    return index;
+  }
+
+  // Writes |value| followed by all of its children and returns the node
+  // offset. Children are written contiguously in order after the container
+  // entries so the layout can be verified in a single pass. |depth| matches
+  // the depth checked by CefPackedValueBuffer::ValidateNode.
+  uint32 WriteNode(const base::Value& value, int depth) {
+    const uint32 node = Size();
+    if (max_depth_ >= 0 && depth > max_depth_) {
+      too_deep_ = true;
+      return node;
+    }
+
+    switch (value.GetType()) {
+      case base::Value::TYPE_NULL:
+        output_->push_back(static_cast<char>(VTYPE_NULL));
+        break;
+      case base::Value::TYPE_BOOLEAN: {
+        bool ret_value = false;
+        value.GetAsBoolean(&ret_value);
+        output_->push_back(static_cast<char>(VTYPE_BOOL));
+        output_->push_back(ret_value ? 1 : 0);
+        break;
+      }
+      case base::Value::TYPE_INTEGER: {
+        int ret_value = 0;
+        value.GetAsInteger(&ret_value);
+        output_->push_back(static_cast<char>(VTYPE_INT));
+        output_->append(reinterpret_cast<const char*>(&ret_value),
+                        sizeof(ret_value));
+        break;
+      }
+      case base::Value::TYPE_DOUBLE: {
+        double ret_value = 0;
+        value.GetAsDouble(&ret_value);
+        output_->push_back(static_cast<char>(VTYPE_DOUBLE));
+        output_->append(reinterpret_cast<const char*>(&ret_value),
+                        sizeof(ret_value));
+        break;
+      }
+      case base::Value::TYPE_STRING: {
+        std::string ret_value;
+        value.GetAsString(&ret_value);
+        output_->push_back(static_cast<char>(VTYPE_STRING));
+        AppendBytes(ret_value.data(), ret_value.size());
+        break;
+      }
+      case base::Value::TYPE_BINARY: {
+        const base::BinaryValue& binary_value =
+            static_cast<const base::BinaryValue&>(value);
+        output_->push_back(static_cast<char>(VTYPE_BINARY));
+        AppendBytes(binary_value.GetBuffer(), binary_value.GetSize());
+        break;
+      }
+      case base::Value::TYPE_DICTIONARY:
+        WriteDictionary(static_cast<const base::DictionaryValue&>(value),
+                        depth);
+        break;
+      case base::Value::TYPE_LIST:
+        WriteList(static_cast<const base::ListValue&>(value), depth);
+        break;
+    }
+
+    return node;
+  }
+
+  void WriteList(const base::ListValue& list, int depth) {
+    const uint32 count = static_cast<uint32>(list.GetSize());
+    output_->push_back(static_cast<char>(VTYPE_LIST));
+    AppendUInt32(count);
+
+    uint32 entry = Size();
+    output_->resize(output_->size() + count * sizeof(uint32));
+
+    base::ListValue::const_iterator it = list.begin();
+    for (; it != list.end() && !too_deep_; ++it, entry += sizeof(uint32))
+      SetUInt32(entry, WriteNode(**it, depth + 1));
+  }
+
+  void WriteDictionary(const base::DictionaryValue& dict, int depth) {
+    // DictionaryValue iterates in key order which matches the binary search
+    // in CefPackedValueBuffer::FindDictionaryItem.
+    const uint32 count = static_cast<uint32>(dict.size());
+    output_->push_back(static_cast<char>(VTYPE_DICTIONARY));
+    AppendUInt32(count);
+
+    uint32 entry = Size();
+    output_->resize(output_->size() + count * 2 * sizeof(uint32));
+
+    for (base::DictionaryValue::Iterator it(dict);
+         !it.IsAtEnd() && !too_deep_;
+         it.Advance(), entry += 2 * sizeof(uint32)) {
+      SetUInt32(entry, InternKey(it.key()));
+      SetUInt32(entry + sizeof(uint32), WriteNode(it.value(), depth + 1));
+    }
+  }
+
+  void WriteKeyTable() {
+    const uint32 count = static_cast<uint32>(keys_.size());
+    AppendUInt32(count);
+
+    uint32 entry = Size();
+    output_->resize(output_->size() + count * sizeof(uint32));
+
+    for (size_t i = 0; i < keys_.size(); ++i, entry += sizeof(uint32)) {
+      SetUInt32(entry, Size());
+      AppendBytes(keys_[i].data(), keys_[i].size());
+    }
+  }
+
+  typedef std::map<std::string, uint32> KeyMap;
+
+  std::string* output_;
+  const int max_depth_;
+  bool too_deep_;
+  KeyMap key_map_;
+  std::vector<std::string> keys_;
+
+  DISALLOW_COPY_AND_ASSIGN(Packer);
+};
+
+}  // namespace
+
+
+// CefPackedValueBuffer implementation.
+
+// static
+bool CefPackedValueBuffer::Pack(const base::Value& value,
+                                std::string* output) {
+  Packer packer(output, kMaxDepth);
+  return packer.Pack(value);
+}
+
+// static
+scoped_refptr<CefPackedValueBuffer> CefPackedValueBuffer::Create(
+    std::string* data) {
+  scoped_refptr<CefPackedValueBuffer> buffer = new CefPackedValueBuffer();
+  buffer->data_.swap(*data);
+  if (!buffer->Validate()) {
+    LOG(ERROR) << "Invalid packed value buffer";
+    return NULL;
+  }
+  return buffer;
+}
+
+// static
+scoped_refptr<CefPackedValueBuffer> CefPackedValueBuffer::CreateFromValue(
+    const base::Value& value) {
+  // Locally packed buffers are trusted and not validated so the nesting depth
+  // is not limited.
+  scoped_refptr<CefPackedValueBuffer> buffer = new CefPackedValueBuffer();
+  Packer packer(&buffer->data_, -1);
+  packer.Pack(value);
+  return buffer;
+}
+
+CefPackedValueBuffer::CefPackedValueBuffer() {
+}
+
+CefPackedValueBuffer::~CefPackedValueBuffer() {
+}
+
+uint32 CefPackedValueBuffer::root() const {
+  return ReadUInt32(kRootOffsetPos);
+}
+
+CefValueType CefPackedValueBuffer::GetType(uint32 node) const {
+  return static_cast<CefValueType>(static_cast<uint8>(data_[node]));
+}
+
+bool CefPackedValueBuffer::GetBool(uint32 node) const {
+  if (GetType(node) != VTYPE_BOOL)
+    return false;
+  return data_[node + 1] != 0;
+}
+
+int CefPackedValueBuffer::GetInt(uint32 node) const {
+  if (GetType(node) != VTYPE_INT)
+    return 0;
+  int ret_value;
+  memcpy(&ret_value, data_.data() + node + 1, sizeof(ret_value));
+  return ret_value;
+}
+
+double CefPackedValueBuffer::GetDouble(uint32 node) const {
+  // Match base::Value::GetAsDouble which also converts integers.
+  CefValueType type = GetType(node);
+  if (type == VTYPE_INT)
+    return GetInt(node);
+  if (type != VTYPE_DOUBLE)
+    return 0;
+  double ret_value;
+  memcpy(&ret_value, data_.data() + node + 1, sizeof(ret_value));
+  return ret_value;
+}
+
+std::string CefPackedValueBuffer::GetString(uint32 node) const {
+  if (GetType(node) != VTYPE_STRING)
+    return std::string();
+  uint32 size = ReadUInt32(node + 1);
+  return std::string(data_.data() + node + 1 + sizeof(uint32), size);
+}
+
+const char* CefPackedValueBuffer::GetBinary(uint32 node, uint32* size) const {
+  *size = 0;
+  if (GetType(node) != VTYPE_BINARY)
+    return NULL;
+  *size = ReadUInt32(node + 1);
+  return data_.data() + node + 1 + sizeof(uint32);
+}
+
+uint32 CefPackedValueBuffer::GetSize(uint32 container) const {
+  CefValueType type = GetType(container);
+  if (type != VTYPE_LIST && type != VTYPE_DICTIONARY)
+    return 0;
+  return ReadUInt32(container + 1);
+}
+
+uint32 CefPackedValueBuffer::GetListItem(uint32 list, uint32 index) const {
+  if (GetType(list) != VTYPE_LIST || index >= GetSize(list))
+    return 0;
+  return ReadUInt32(list + 1 + sizeof(uint32) * (index + 1));
+}
+
+uint32 CefPackedValueBuffer::FindDictionaryItem(
+    uint32 dictionary,
+    const std::string& key) const {
+  if (GetType(dictionary) != VTYPE_DICTIONARY)
+    return 0;
+
+  const uint32 entries = dictionary + 1 + sizeof(uint32);
+  uint32 low = 0;
+  uint32 high = GetSize(dictionary);
+  while (low < high) {
+    const uint32 mid = low + (high - low) / 2;
+    const uint32 entry = entries + mid * 2 * sizeof(uint32);
+
+    uint32 key_size;
+    const char* key_data = GetKey(ReadUInt32(entry), &key_size);
+    int result = memcmp(key_data, key.data(),
+                        std::min(static_cast<size_t>(key_size), key.size()));
+    if (result == 0 && key_size != key.size())
+      result = key_size < key.size() ? -1 : 1;
+
+    if (result == 0)
+      return ReadUInt32(entry + sizeof(uint32));
+    if (result < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return 0;
+}
+
+std::string CefPackedValueBuffer::GetDictionaryKey(uint32 dictionary,
+                                                   uint32 index) const {
+  if (GetType(dictionary) != VTYPE_DICTIONARY || index >= GetSize(dictionary))
+    return std::string();
+  uint32 key_size;
+  const char* key_data = GetKey(
+      ReadUInt32(dictionary + 1 + sizeof(uint32) * (2 * index + 1)),
+      &key_size);
+  return std::string(key_data, key_size);
+}
+
+base::Value* CefPackedValueBuffer::CreateValue(uint32 node) const {
+  switch (GetType(node)) {
+    case VTYPE_BOOL:
+      return new base::FundamentalValue(GetBool(node));
+    case VTYPE_INT:
+      return new base::FundamentalValue(GetInt(node));
+    case VTYPE_DOUBLE:
+      return new base::FundamentalValue(GetDouble(node));
+    case VTYPE_STRING:
+      return new base::StringValue(GetString(node));
+    case VTYPE_BINARY: {
+      uint32 size;
+      const char* data = GetBinary(node, &size);
+      return base::BinaryValue::CreateWithCopiedBuffer(data, size);
+    }
+    case VTYPE_DICTIONARY: {
+      base::DictionaryValue* dict = new base::DictionaryValue();
+      const uint32 count = GetSize(node);
+      for (uint32 i = 0; i < count; ++i) {
+        const uint32 entry = node + 1 + sizeof(uint32) * (2 * i + 1);
+        uint32 key_size;
+        const char* key_data = GetKey(ReadUInt32(entry), &key_size);
+        dict->SetWithoutPathExpansion(
+            std::string(key_data, key_size),
+            CreateValue(ReadUInt32(entry + sizeof(uint32))));
+      }
+      return dict;
+    }
+    case VTYPE_LIST: {
+      base::ListValue* list = new base::ListValue();
+      const uint32 count = GetSize(node);
+      for (uint32 i = 0; i < count; ++i)
+        list->Append(CreateValue(GetListItem(node, i)));
+      return list;
+    }
+    default:
+      break;
+  }
+
+  return base::Value::CreateNullValue();
+}
+
+bool CefPackedValueBuffer::Validate() const {
+  const size_t size = data_.size();
+  if (size < kHeaderSize || size > kuint32max ||
+      ReadUInt32(0) != kPackedMagic ||
+      ReadUInt32(kRootOffsetPos) != kHeaderSize) {
+    return false;
+  }
+
+  // Validate the key table. Keys follow the offset table in order.
+  const uint32 key_table = ReadUInt32(kKeyTableOffsetPos);
+  if (key_table < kHeaderSize || key_table > size - sizeof(uint32))
+    return false;
+  const uint32 key_count = ReadUInt32(key_table);
+  uint32 pos = key_table + sizeof(uint32);
+  if (key_count > (size - pos) / sizeof(uint32))
+    return false;
+  pos += key_count * sizeof(uint32);
+  for (uint32 i = 0; i < key_count; ++i) {
+    if (ReadUInt32(key_table + sizeof(uint32) * (i + 1)) != pos ||
+        pos > size - sizeof(uint32)) {
+      return false;
+    }
+    const uint32 key_size = ReadUInt32(pos);
+    pos += sizeof(uint32);
+    if (key_size > size - pos)
+      return false;
+    pos += key_size;
+  }
+  if (pos != size)
+    return false;
+
+  // Validate the node tree. The root must be a container and the tree must
+  // exactly fill the space before the key table.
+  if (key_table == kHeaderSize ||
+      (GetType(kHeaderSize) != VTYPE_LIST &&
+       GetType(kHeaderSize) != VTYPE_DICTIONARY)) {
+    return false;
+  }
+  return ValidateNode(kHeaderSize, 0) == key_table;
+}
+
+// Returns the offset following the node tree rooted at |node|, or 0 if the
+// tree is invalid. Each byte is visited once so validation is linear in the
+// buffer size.
+uint32 CefPackedValueBuffer::ValidateNode(uint32 node, int depth) const {
+  const uint32 key_table = ReadUInt32(kKeyTableOffsetPos);
+  if (depth > kMaxDepth || node >= key_table)
+    return 0;
+
+  const uint32 available = key_table - node - 1;
+  const uint32 payload = node + 1;
+
+  switch (GetType(node)) {
+    case VTYPE_NULL:
+      return payload;
+    case VTYPE_BOOL:
+      return available >= 1 ? payload + 1 : 0;
+    case VTYPE_INT:
+      return available >= sizeof(int) ? payload + sizeof(int) : 0;
+    case VTYPE_DOUBLE:
+      return available >= sizeof(double) ? payload + sizeof(double) : 0;
+    case VTYPE_STRING:
+    case VTYPE_BINARY: {
+      if (available < sizeof(uint32))
+        return 0;
+      const uint32 length = ReadUInt32(payload);
+      if (length > available - sizeof(uint32))
+        return 0;
+      return payload + sizeof(uint32) + length;
+    }
+    case VTYPE_LIST:
+    case VTYPE_DICTIONARY: {
+      const bool is_dict = (GetType(node) == VTYPE_DICTIONARY);
+      const uint32 entry_size = (is_dict ? 2 : 1) * sizeof(uint32);
+      if (available < sizeof(uint32))
+        return 0;
+      const uint32 count = ReadUInt32(payload);
+      if (count > (available - sizeof(uint32)) / entry_size)
+        return 0;
+
+      const uint32 key_count = ReadUInt32(key_table);
+      const uint32 entries = payload + sizeof(uint32);
+      uint32 next = entries + count * entry_size;
+      std::string last_key;
+      for (uint32 i = 0; i < count; ++i) {
+        const uint32 entry = entries + i * entry_size;
+        if (is_dict) {
+          // Keys must exist and be strictly ascending.
+          const uint32 key_index = ReadUInt32(entry);
+          if (key_index >= key_count)
+            return 0;
+          uint32 key_size;
+          const char* key_data = GetKey(key_index, &key_size);
+          std::string key(key_data, key_size);
+          if (i > 0 && !(last_key < key))
+            return 0;
+          last_key.swap(key);
+        }
+
+        // Children must immediately follow the previous child.
+        if (ReadUInt32(entry + entry_size - sizeof(uint32)) != next)
+          return 0;
+        next = ValidateNode(next, depth + 1);
+        if (next == 0)
+          return 0;
+      }
+      return next;
+    }
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+uint32 CefPackedValueBuffer::ReadUInt32(uint32 offset) const {
+  uint32 value;
+  memcpy(&value, data_.data() + offset, sizeof(value));
+  return value;
+}
+
+const char* CefPackedValueBuffer::GetKey(uint32 index, uint32* size) const {
+  const uint32 key_table = ReadUInt32(kKeyTableOffsetPos);
+  const uint32 key = ReadUInt32(key_table + sizeof(uint32) * (index + 1));
+  *size = ReadUInt32(key);
+  return data_.data() + key + sizeof(uint32);
+}
+
+
+// CefPackedListValueImpl implementation.
+
+CefPackedListValueImpl::CefPackedListValueImpl(
+    scoped_refptr<CefPackedValueBuffer> buffer,
+    uint32 node)
+  : buffer_(buffer),
+    node_(node) {
+  DCHECK_EQ(buffer_->GetType(node_), VTYPE_LIST);
+}
+
+base::ListValue* CefPackedListValueImpl::CopyValue() {
+  return static_cast<base::ListValue*>(buffer_->CreateValue(node_));
+}
+
+base::ListValue* CefPackedListValueImpl::CopyOrDetachValue(
+    CefValueController* new_controller) {
+  // The packed buffer is immutable so the value is always copied.
+  return CopyValue();
+}
+
+CefListValueImpl* CefPackedListValueImpl::AsImpl() {
+  return NULL;
+}
+
+bool CefPackedListValueImpl::IsValid() {
+  return true;
+}
+
+bool CefPackedListValueImpl::IsOwned() {
+  return false;
+}
+
+bool CefPackedListValueImpl::IsReadOnly() {
+  return true;
+}
+
+CefRefPtr<CefListValue> CefPackedListValueImpl::Copy() {
+  return new CefListValueImpl(CopyValue(), true, false);
+}
+
+CefRefPtr<CefListValue> CefPackedListValueImpl::CreateSnapshot() {
+  // Already immutable.
+  return this;
+}
+
+bool CefPackedListValueImpl::SetSize(size_t size) {
+  return false;
+}
+
+size_t CefPackedListValueImpl::GetSize() {
+  return buffer_->GetSize(node_);
+}
+
+bool CefPackedListValueImpl::Clear() {
+  return false;
+}
+
+bool CefPackedListValueImpl::Remove(int index) {
+  return false;
+}
+
+CefRefPtr<CefBinaryValue> CefPackedListValueImpl::DetachBinary(int index) {
+  return NULL;
+}
+
+CefRefPtr<CefDictionaryValue> CefPackedListValueImpl::DetachDictionary(
+    int index) {
+  return NULL;
+}
+
+CefRefPtr<CefListValue> CefPackedListValueImpl::DetachList(int index) {
+  return NULL;
+}
+
+CefValueType CefPackedListValueImpl::GetType(int index) {
+  uint32 item = GetItem(index);
+  return item ? buffer_->GetType(item) : VTYPE_INVALID;
+}
+
+bool CefPackedListValueImpl::GetBool(int index) {
+  uint32 item = GetItem(index);
+  return item ? buffer_->GetBool(item) : false;
+}
+
+int CefPackedListValueImpl::GetInt(int index) {
+  uint32 item = GetItem(index);
+  return item ? buffer_->GetInt(item) : 0;
+}
+
+double CefPackedListValueImpl::GetDouble(int index) {
+  uint32 item = GetItem(index);
+  return item ? buffer_->GetDouble(item) : 0;
+}
+
+CefString CefPackedListValueImpl::GetString(int index) {
+  uint32 item = GetItem(index);
+  if (!item)
+    return CefString();
+  return buffer_->GetString(item);
+}
+
+CefRefPtr<CefBinaryValue> CefPackedListValueImpl::GetBinary(int index) {
+  uint32 item = GetItem(index);
+  if (!item || buffer_->GetType(item) != VTYPE_BINARY)
+    return NULL;
+  uint32 size;
+  const char* data = buffer_->GetBinary(item, &size);
+  return CefBinaryValue::Create(data, size);
+}
+
+CefRefPtr<CefDictionaryValue> CefPackedListValueImpl::GetDictionary(
+    int index) {
+  uint32 item = GetItem(index);
+  if (!item || buffer_->GetType(item) != VTYPE_DICTIONARY)
+    return NULL;
+  return new CefPackedDictionaryValueImpl(buffer_, item);
+}
+
+CefRefPtr<CefListValue> CefPackedListValueImpl::GetList(int index) {
+  uint32 item = GetItem(index);
+  if (!item || buffer_->GetType(item) != VTYPE_LIST)
+    return NULL;
+  return new CefPackedListValueImpl(buffer_, item);
+}
+
+bool CefPackedListValueImpl::SetNull(int index) {
+  return false;
+}
+
+bool CefPackedListValueImpl::SetBool(int index, bool value) {
+  return false;
+}
+
+bool CefPackedListValueImpl::SetInt(int index, int value) {
+  return false;
+}
+
+bool CefPackedListValueImpl::SetDouble(int index, double value) {
+  return false;
+}
+
+bool CefPackedListValueImpl::SetString(int index, const CefString& value) {
+  return false;
+}
+
+bool CefPackedListValueImpl::SetBinary(int index,
+                                       CefRefPtr<CefBinaryValue> value) {
+  return false;
+}
+
+bool CefPackedListValueImpl::SetDictionary(
+    int index,
+    CefRefPtr<CefDictionaryValue> value) {
+  return false;
+}
+
+bool CefPackedListValueImpl::SetList(int index,
+                                     CefRefPtr<CefListValue> value) {
+  return false;
+}
+
+uint32 CefPackedListValueImpl::GetItem(int index) {
+  if (index < 0)
+    return 0;
+  return buffer_->GetListItem(node_, static_cast<uint32>(index));
+}
+
+
+// CefPackedDictionaryValueImpl implementation.
+
+CefPackedDictionaryValueImpl::CefPackedDictionaryValueImpl(
+    scoped_refptr<CefPackedValueBuffer> buffer,
+    uint32 node)
+  : buffer_(buffer),
+    node_(node) {
+  DCHECK_EQ(buffer_->GetType(node_), VTYPE_DICTIONARY);
+}
+
+base::DictionaryValue* CefPackedDictionaryValueImpl::CopyValue() {
+  return static_cast<base::DictionaryValue*>(buffer_->CreateValue(node_));
+}
+
+base::DictionaryValue* CefPackedDictionaryValueImpl::CopyOrDetachValue(
+    CefValueController* new_controller) {
+  // The packed buffer is immutable so the value is always copied.
+  return CopyValue();
+}
+
+CefDictionaryValueImpl* CefPackedDictionaryValueImpl::AsImpl() {
+  return NULL;
+}
+
+bool CefPackedDictionaryValueImpl::IsValid() {
+  return true;
+}
+
+bool CefPackedDictionaryValueImpl::IsOwned() {
+  return false;
+}
+
+bool CefPackedDictionaryValueImpl::IsReadOnly() {
+  return true;
+}
+
+CefRefPtr<CefDictionaryValue> CefPackedDictionaryValueImpl::Copy(
+    bool exclude_empty_children) {
+  base::DictionaryValue* value = CopyValue();
+  if (exclude_empty_children) {
+    base::DictionaryValue* filtered_value =
+        value->DeepCopyWithoutEmptyChildren();
+    delete value;
+    value = filtered_value;
+  }
+  return new CefDictionaryValueImpl(value, true, false);
+}
+
+CefRefPtr<CefDictionaryValue> CefPackedDictionaryValueImpl::CreateSnapshot() {
+  // Already immutable.
+  return this;
+}
+
+size_t CefPackedDictionaryValueImpl::GetSize() {
+  return buffer_->GetSize(node_);
+}
+
+bool CefPackedDictionaryValueImpl::Clear() {
+  return false;
+}
+
+bool CefPackedDictionaryValueImpl::HasKey(const CefString& key) {
+  return GetItem(key) != 0;
+}
+
+bool CefPackedDictionaryValueImpl::GetKeys(KeyList& keys) {
+  const uint32 count = buffer_->GetSize(node_);
+  for (uint32 i = 0; i < count; ++i)
+    keys.push_back(buffer_->GetDictionaryKey(node_, i));
+  return true;
+}
+
+bool CefPackedDictionaryValueImpl::Remove(const CefString& key) {
+  return false;
+}
+
+CefRefPtr<CefBinaryValue> CefPackedDictionaryValueImpl::DetachBinary(
+    const CefString& key) {
+  return NULL;
+}
+
+CefRefPtr<CefDictionaryValue> CefPackedDictionaryValueImpl::DetachDictionary(
+    const CefString& key) {
+  return NULL;
+}
+
+CefRefPtr<CefListValue> CefPackedDictionaryValueImpl::DetachList(
+    const CefString& key) {
+  return NULL;
+}
+
+CefValueType CefPackedDictionaryValueImpl::GetType(const CefString& key) {
+  uint32 item = GetItem(key);
+  return item ? buffer_->GetType(item) : VTYPE_INVALID;
+}
+
+bool CefPackedDictionaryValueImpl::GetBool(const CefString& key) {
+  uint32 item = GetItem(key);
+  return item ? buffer_->GetBool(item) : false;
+}
+
+int CefPackedDictionaryValueImpl::GetInt(const CefString& key) {
+  uint32 item = GetItem(key);
+  return item ? buffer_->GetInt(item) : 0;
+}
+
+double CefPackedDictionaryValueImpl::GetDouble(const CefString& key) {
+  uint32 item = GetItem(key);
+  return item ? buffer_->GetDouble(item) : 0;
+}
+
+CefString CefPackedDictionaryValueImpl::GetString(const CefString& key) {
+  uint32 item = GetItem(key);
+  if (!item)
+    return CefString();
+  return buffer_->GetString(item);
+}
+
+CefRefPtr<CefBinaryValue> CefPackedDictionaryValueImpl::GetBinary(
+    const CefString& key) {
+  uint32 item = GetItem(key);
+  if (!item || buffer_->GetType(item) != VTYPE_BINARY)
+    return NULL;
+  uint32 size;
+  const char* data = buffer_->GetBinary(item, &size);
+  return CefBinaryValue::Create(data, size);
+}
+
+CefRefPtr<CefDictionaryValue> CefPackedDictionaryValueImpl::GetDictionary(
+    const CefString& key) {
+  uint32 item = GetItem(key);
+  if (!item || buffer_->GetType(item) != VTYPE_DICTIONARY)
+    return NULL;
+  return new CefPackedDictionaryValueImpl(buffer_, item);
+}
+
+CefRefPtr<CefListValue> CefPackedDictionaryValueImpl::GetList(
+    const CefString& key) {
+  uint32 item = GetItem(key);
+  if (!item || buffer_->GetType(item) != VTYPE_LIST)
+    return NULL;
+  return new CefPackedListValueImpl(buffer_, item);
+}
+
+bool CefPackedDictionaryValueImpl::SetNull(const CefString& key) {
+  return false;
+}
+
+bool CefPackedDictionaryValueImpl::SetBool(const CefString& key, bool value) {
+  return false;
+}
+
+bool CefPackedDictionaryValueImpl::SetInt(const CefString& key, int value) {
+  return false;
+}
+
+bool CefPackedDictionaryValueImpl::SetDouble(const CefString& key,
+                                             double value) {
+  return false;
+}
+
+bool CefPackedDictionaryValueImpl::SetString(const CefString& key,
+                                             const CefString& value) {
+  return false;
+}
+
+bool CefPackedDictionaryValueImpl::SetBinary(const CefString& key,
+    CefRefPtr<CefBinaryValue> value) {
+  return false;
+}
+
+bool CefPackedDictionaryValueImpl::SetDictionary(const CefString& key,
+    CefRefPtr<CefDictionaryValue> value) {
+  return false;
+}
+
+bool CefPackedDictionaryValueImpl::SetList(const CefString& key,
+    CefRefPtr<CefListValue> value) {
+  return false;
+}
+
+uint32 CefPackedDictionaryValueImpl::GetItem(const CefString& key) {
+  return buffer_->FindDictionaryItem(node_, key.ToString());
+}
@@ -0,0 +1,216 @@
+// Copyright (c) 2014 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef CEF_LIBCEF_COMMON_PACKED_VALUES_IMPL_H_
+#define CEF_LIBCEF_COMMON_PACKED_VALUES_IMPL_H_
+#pragma once
+
+#include <string>
+
+#include "libcef/common/values_impl.h"
+
+#include "base/memory/ref_counted.h"
+
+// Immutable flat representation of a base::ListValue or base::DictionaryValue
+// tree. Used for packed process message arguments and value snapshots. The
+// whole tree is stored in a single contiguous buffer and containers refer to
+// their children by offset. Dictionary keys are interned in a shared key
+// table and each dictionary stores its entries sorted by key so that lookups
+// use a binary search. Reading a simple value does not allocate and nested
+// lists and dictionaries are returned as views that only reference their node.
+//
+// Buffer layout (all integers are native-endian uint32 unless noted):
+//   header:     magic, key table offset, root node offset
+//   node:       uint8 CefValueType followed by the payload
+//     bool:       uint8
+//     int:        int32
+//     double:     double
+//     string:     length, UTF8 bytes
+//     binary:     length, bytes
+//     list:       count, count x child node offset
+//     dictionary: count, count x (key index, child node offset)
+//   key table:  count, count x key offset, keys as (length, UTF8 bytes)
+//
+// The buffer may come from another process so it is validated before use.
+class CefPackedValueBuffer
+    : public base::RefCountedThreadSafe<CefPackedValueBuffer> {
+ public:
+  // Pack |value| into |output|, replacing its contents. |value| must be a list
+  // or dictionary. Returns false and clears |output| if |value| is nested
+  // deeper than Create() accepts.
+  static bool Pack(const base::Value& value, std::string* output);
+
+  // Take ownership of the packed |data| by swapping it with an empty string.
+  // Returns NULL if |data| is not a valid packed buffer.
+  static scoped_refptr<CefPackedValueBuffer> Create(std::string* data);
+
+  // Pack |value| into a new buffer. |value| must be a list or dictionary.
+  static scoped_refptr<CefPackedValueBuffer> CreateFromValue(
+      const base::Value& value);
+
+  const std::string& data() const { return data_; }
+
+  // Offset of the root list or dictionary node.
+  uint32 root() const;
+
+  // Node accessors. |node| must be a node offset obtained from this buffer.
+  CefValueType GetType(uint32 node) const;
+  bool GetBool(uint32 node) const;
+  int GetInt(uint32 node) const;
+  double GetDouble(uint32 node) const;
+  std::string GetString(uint32 node) const;
+  // Returns a pointer to the binary data of |node| and sets |size|.
+  const char* GetBinary(uint32 node, uint32* size) const;
+
+  // Container accessors. Return 0 (never a valid node) if |index| or |key| is
+  // not found.
+  uint32 GetSize(uint32 container) const;
+  uint32 GetListItem(uint32 list, uint32 index) const;
+  uint32 FindDictionaryItem(uint32 dictionary, const std::string& key) const;
+  std::string GetDictionaryKey(uint32 dictionary, uint32 index) const;
+
+  // Create a base::Value tree equivalent to |node|.
+  base::Value* CreateValue(uint32 node) const;
+
+ private:
+  friend class base::RefCountedThreadSafe<CefPackedValueBuffer>;
+
+  CefPackedValueBuffer();
+  ~CefPackedValueBuffer();
+
+  bool Validate() const;
+  uint32 ValidateNode(uint32 node, int depth) const;
+
+  uint32 ReadUInt32(uint32 offset) const;
+  // Returns the key at |index| of the key table and sets |size|.
+  const char* GetKey(uint32 index, uint32* size) const;
+
+  std::string data_;
+
+  DISALLOW_COPY_AND_ASSIGN(CefPackedValueBuffer);
+};
+
+
+// Read-only CefListValue view of a list node in a packed buffer. Views are not
+// backed by a base::Value and do not use a value controller. Reads do not lock
+// so views may be used concurrently from any thread. Copies and values set
+// into other lists or dictionaries are materialized as regular base::Value
+// trees.
+class CefPackedListValueImpl : public CefListValueInternal {
+ public:
+  CefPackedListValueImpl(scoped_refptr<CefPackedValueBuffer> buffer,
+                         uint32 node);
+
+  // CefListValueInternal methods.
+  virtual base::ListValue* CopyValue() OVERRIDE;
+  virtual base::ListValue* CopyOrDetachValue(
+      CefValueController* new_controller) OVERRIDE;
+  virtual CefListValueImpl* AsImpl() OVERRIDE;
+
+  // CefListValue methods.
+  virtual bool IsValid() OVERRIDE;
+  virtual bool IsOwned() OVERRIDE;
+  virtual bool IsReadOnly() OVERRIDE;
+  virtual CefRefPtr<CefListValue> Copy() OVERRIDE;
+  virtual CefRefPtr<CefListValue> CreateSnapshot() OVERRIDE;
+  virtual bool SetSize(size_t size) OVERRIDE;
+  virtual size_t GetSize() OVERRIDE;
+  virtual bool Clear() OVERRIDE;
+  virtual bool Remove(int index) OVERRIDE;
+  virtual CefRefPtr<CefBinaryValue> DetachBinary(int index) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> DetachDictionary(int index) OVERRIDE;
+  virtual CefRefPtr<CefListValue> DetachList(int index) OVERRIDE;
+  virtual CefValueType GetType(int index) OVERRIDE;
+  virtual bool GetBool(int index) OVERRIDE;
+  virtual int GetInt(int index) OVERRIDE;
+  virtual double GetDouble(int index) OVERRIDE;
+  virtual CefString GetString(int index) OVERRIDE;
+  virtual CefRefPtr<CefBinaryValue> GetBinary(int index) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> GetDictionary(int index) OVERRIDE;
+  virtual CefRefPtr<CefListValue> GetList(int index) OVERRIDE;
+  virtual bool SetNull(int index) OVERRIDE;
+  virtual bool SetBool(int index, bool value) OVERRIDE;
+  virtual bool SetInt(int index, int value) OVERRIDE;
+  virtual bool SetDouble(int index, double value) OVERRIDE;
+  virtual bool SetString(int index, const CefString& value) OVERRIDE;
+  virtual bool SetBinary(int index, CefRefPtr<CefBinaryValue> value) OVERRIDE;
+  virtual bool SetDictionary(int index,
+                             CefRefPtr<CefDictionaryValue> value) OVERRIDE;
+  virtual bool SetList(int index, CefRefPtr<CefListValue> value) OVERRIDE;
+
+ private:
+  // Returns the node at |index| or 0 if |index| is out of range.
+  uint32 GetItem(int index);
+
+  scoped_refptr<CefPackedValueBuffer> buffer_;
+  uint32 node_;
+
+  IMPLEMENT_REFCOUNTING(CefPackedListValueImpl);
+  DISALLOW_COPY_AND_ASSIGN(CefPackedListValueImpl);
+};
+
+
+// Read-only CefDictionaryValue view of a dictionary node in a packed buffer.
+// See CefPackedListValueImpl.
+class CefPackedDictionaryValueImpl : public CefDictionaryValueInternal {
+ public:
+  CefPackedDictionaryValueImpl(scoped_refptr<CefPackedValueBuffer> buffer,
+                               uint32 node);
+
+  // CefDictionaryValueInternal methods.
+  virtual base::DictionaryValue* CopyValue() OVERRIDE;
+  virtual base::DictionaryValue* CopyOrDetachValue(
+      CefValueController* new_controller) OVERRIDE;
+  virtual CefDictionaryValueImpl* AsImpl() OVERRIDE;
+
+  // CefDictionaryValue methods.
+  virtual bool IsValid() OVERRIDE;
+  virtual bool IsOwned() OVERRIDE;
+  virtual bool IsReadOnly() OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> Copy(
+      bool exclude_empty_children) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> CreateSnapshot() OVERRIDE;
+  virtual size_t GetSize() OVERRIDE;
+  virtual bool Clear() OVERRIDE;
+  virtual bool HasKey(const CefString& key) OVERRIDE;
+  virtual bool GetKeys(KeyList& keys) OVERRIDE;
+  virtual bool Remove(const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefBinaryValue> DetachBinary(const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> DetachDictionary(
+      const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefListValue> DetachList(const CefString& key) OVERRIDE;
+  virtual CefValueType GetType(const CefString& key) OVERRIDE;
+  virtual bool GetBool(const CefString& key) OVERRIDE;
+  virtual int GetInt(const CefString& key) OVERRIDE;
+  virtual double GetDouble(const CefString& key) OVERRIDE;
+  virtual CefString GetString(const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefBinaryValue> GetBinary(const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> GetDictionary(
+      const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefListValue> GetList(const CefString& key) OVERRIDE;
+  virtual bool SetNull(const CefString& key) OVERRIDE;
+  virtual bool SetBool(const CefString& key, bool value) OVERRIDE;
+  virtual bool SetInt(const CefString& key, int value) OVERRIDE;
+  virtual bool SetDouble(const CefString& key, double value) OVERRIDE;
+  virtual bool SetString(const CefString& key,
+                         const CefString& value) OVERRIDE;
+  virtual bool SetBinary(const CefString& key,
+      CefRefPtr<CefBinaryValue> value) OVERRIDE;
+  virtual bool SetDictionary(const CefString& key,
+      CefRefPtr<CefDictionaryValue> value) OVERRIDE;
+  virtual bool SetList(const CefString& key,
+      CefRefPtr<CefListValue> value) OVERRIDE;
+
+ private:
+  // Returns the node for |key| or 0 if |key| does not exist.
+  uint32 GetItem(const CefString& key);
+
+  scoped_refptr<CefPackedValueBuffer> buffer_;
+  uint32 node_;
+
+  IMPLEMENT_REFCOUNTING(CefPackedDictionaryValueImpl);
+  DISALLOW_COPY_AND_ASSIGN(CefPackedDictionaryValueImpl);
+};
+
+#endif  // CEF_LIBCEF_COMMON_PACKED_VALUES_IMPL_H_
@@ -4,9 +4,11 @@
 
 #include "libcef/common/process_message_impl.h"
 #include "libcef/common/cef_messages.h"
+#include "libcef/common/packed_values_impl.h"
 #include "libcef/common/values_impl.h"
 
 #include "base/logging.h"
+#include "base/process/process_handle.h"
 
 namespace {
 
@@ -23,6 +25,13 @@ void CopyValue(const Cef_Request_Params& source,
   CopyList(source.arguments, target.arguments);
 }
 
+void CopyPackedList(const CefPackedValueBuffer& source,
+                    base::ListValue& target) {
+  scoped_ptr<base::ListValue> list(
+      static_cast<base::ListValue*>(source.CreateValue(source.root())));
+  target.Swap(list.get());
+}
+
 }  // namespace
 
 // static
@@ -37,15 +46,160 @@ CefProcessMessageImpl::CefProcessMessageImpl(Cef_Request_Params* value,
                                              bool read_only)
   : CefValueBase<CefProcessMessage, Cef_Request_Params>(
         value, NULL, will_delete ? kOwnerWillDelete : kOwnerNoDelete,
-        read_only, NULL) {
+        read_only, NULL),
+    shared_memory_size_(0),
+    pack_arguments_(false) {
 }
 
 bool CefProcessMessageImpl::CopyTo(Cef_Request_Params& target) {
   CEF_VALUE_VERIFY_RETURN(false, false);
-  CopyValue(const_value(), target);
+  if (packed_arguments_.get()) {
+    // Forward the received buffer without unpacking it.
+    target.name = const_value().name;
+    target.packed_arguments = packed_arguments_->data();
+  } else if (pack_arguments_) {
+    // Pack directly from the argument list instead of copying it first. Fail
+    // the send if the receiver would reject the buffer.
+    target.name = const_value().name;
+    if (!CefPackedValueBuffer::Pack(const_value().arguments,
+                                    &target.packed_arguments)) {
+      LOG(ERROR) << "Packed arguments of message \"" << target.name <<
+          "\" are nested too deeply";
+      return false;
+    }
+  } else {
+    CopyValue(const_value(), target);
+  }
   return true;
 }
 
+bool CefProcessMessageImpl::AppendTo(Cef_RequestBatch_Params& target) {
+  CEF_VALUE_VERIFY_RETURN(false, false);
+  base::ListValue* arguments = new base::ListValue();
+  if (packed_arguments_.get())
+    CopyPackedList(*packed_arguments_.get(), *arguments);
+  else
+    CopyList(const_value().arguments, *arguments);
+  target.names.push_back(const_value().name);
+  target.arguments.Append(arguments);
+  return true;
+}
+
+// static
+void CefProcessMessageImpl::TakeFromBatch(Cef_RequestBatch_Params& batch,
+                                          size_t index,
+                                          Cef_Request_Params& target) {
+  DCHECK_LT(index, batch.names.size());
+  target.name = batch.names[index];
+  base::ListValue* arguments = NULL;
+  if (batch.arguments.GetList(index, &arguments))
+    target.arguments.Swap(arguments);
+  target.frame_id = -1;
+  target.user_initiated = true;
+  target.request_id = -1;
+  target.expect_response = false;
+  target.shared_memory_handle = base::SharedMemory::NULLHandle();
+  target.shared_memory_size = 0;
+}
+
+scoped_ptr<base::SharedMemory> CefProcessMessageImpl::PassSharedMemory(
+    uint32* size) {
+  *size = 0;
+  CEF_VALUE_VERIFY_RETURN(false, scoped_ptr<base::SharedMemory>());
+  *size = static_cast<uint32>(shared_memory_size_);
+  shared_memory_size_ = 0;
+  return shared_memory_.Pass();
+}
+
+// static
+bool CefProcessMessageImpl::GiveSharedMemory(
+    scoped_ptr<base::SharedMemory> shared_memory,
+    uint32 size,
+    base::ProcessHandle process,
+    Cef_Request_Params& target) {
+  target.shared_memory_handle = base::SharedMemory::NULLHandle();
+  target.shared_memory_size = 0;
+
+  // GiveToProcess unmaps and closes the local handle so the memory is owned by
+  // the message in transit.
+  if (!shared_memory.get() || size == 0 ||
+      !shared_memory->GiveToProcess(process, &target.shared_memory_handle)) {
+    return false;
+  }
+  target.shared_memory_size = size;
+  return true;
+}
+
+// static
+void CefProcessMessageImpl::CloseGivenSharedMemory(
+    const Cef_Request_Params& target,
+    base::ProcessHandle process) {
+  if (!base::SharedMemory::IsHandleValid(target.shared_memory_handle))
+    return;
+
+#if defined(OS_WIN)
+  // The handle was duplicated into |process| and must be closed there.
+  if (process == base::GetCurrentProcessHandle()) {
+    ::CloseHandle(target.shared_memory_handle);
+  } else {
+    ::DuplicateHandle(process, target.shared_memory_handle, NULL, NULL, 0,
+                      FALSE, DUPLICATE_CLOSE_SOURCE);
+  }
+#endif
+  // On other platforms the descriptor is owned by the IPC message and was
+  // closed when the unsent message was destroyed.
+}
+
+// static
+scoped_ptr<base::SharedMemory> CefProcessMessageImpl::TakeSharedMemory(
+    const Cef_Request_Params& source,
+    base::ProcessHandle source_process) {
+  if (source.shared_memory_size == 0 ||
+      !base::SharedMemory::IsHandleValid(source.shared_memory_handle)) {
+    return scoped_ptr<base::SharedMemory>();
+  }
+
+#if defined(OS_WIN)
+  // Duplicate the handle into this process and close the source handle so
+  // that the segment is released when this process is done with it.
+  HANDLE handle = NULL;
+  if (!::DuplicateHandle(source_process, source.shared_memory_handle,
+                         ::GetCurrentProcess(), &handle, 0, FALSE,
+                         DUPLICATE_CLOSE_SOURCE | DUPLICATE_SAME_ACCESS)) {
+    return scoped_ptr<base::SharedMemory>();
+  }
+  scoped_ptr<base::SharedMemory> shared_memory(
+      new base::SharedMemory(handle, false));
+#else
+  scoped_ptr<base::SharedMemory> shared_memory(
+      new base::SharedMemory(source.shared_memory_handle, false));
+#endif
+
+  // The handle is closed when |shared_memory| is destroyed.
+  if (!shared_memory->Map(source.shared_memory_size))
+    return scoped_ptr<base::SharedMemory>();
+  return shared_memory.Pass();
+}
+
+void CefProcessMessageImpl::SetSharedMemory(
+    scoped_ptr<base::SharedMemory> shared_memory,
+    size_t size) {
+  CEF_VALUE_VERIFY_RETURN_VOID(false);
+  shared_memory_ = shared_memory.Pass();
+  shared_memory_size_ = shared_memory_.get() ? size : 0;
+}
+
+bool CefProcessMessageImpl::SetPackedArguments(std::string* data) {
+  CEF_VALUE_VERIFY_RETURN(false, false);
+  packed_arguments_ = CefPackedValueBuffer::Create(data);
+  if (packed_arguments_.get() &&
+      packed_arguments_->GetType(packed_arguments_->root()) != VTYPE_LIST) {
+    packed_arguments_ = NULL;
+  }
+  pack_arguments_ = packed_arguments_.get() != NULL;
+  return pack_arguments_;
+}
+
 bool CefProcessMessageImpl::IsValid() {
   return !detached();
 }
@@ -57,8 +211,15 @@ bool CefProcessMessageImpl::IsReadOnly() {
 CefRefPtr<CefProcessMessage> CefProcessMessageImpl::Copy() {
   CEF_VALUE_VERIFY_RETURN(false, NULL);
   Cef_Request_Params* params = new Cef_Request_Params();
-  CopyValue(const_value(), *params);
-  return new CefProcessMessageImpl(params, true, false);
+  if (packed_arguments_.get()) {
+    params->name = const_value().name;
+    CopyPackedList(*packed_arguments_.get(), params->arguments);
+  } else {
+    CopyValue(const_value(), *params);
+  }
+  CefProcessMessageImpl* copy = new CefProcessMessageImpl(params, true, false);
+  copy->pack_arguments_ = pack_arguments_;
+  return copy;
 }
 
 CefString CefProcessMessageImpl::GetName() {
@@ -68,9 +229,79 @@ CefString CefProcessMessageImpl::GetName() {
 
 CefRefPtr<CefListValue> CefProcessMessageImpl::GetArgumentList() {
   CEF_VALUE_VERIFY_RETURN(false, NULL);
+  if (packed_arguments_.get()) {
+    return new CefPackedListValueImpl(packed_arguments_,
+                                      packed_arguments_->root());
+  }
   return CefListValueImpl::GetOrCreateRef(
         const_cast<base::ListValue*>(&(const_value().arguments)),
         const_cast<Cef_Request_Params*>(&const_value()),
         read_only(),
         controller());
 }
+
+void CefProcessMessageImpl::SetArgumentListPacked(bool packed) {
+  CEF_VALUE_VERIFY_RETURN_VOID(true);
+  pack_arguments_ = packed;
+}
+
+bool CefProcessMessageImpl::IsArgumentListPacked() {
+  CEF_VALUE_VERIFY_RETURN(false, false);
+  return pack_arguments_;
+}
+
+void* CefProcessMessageImpl::CreateSharedMemory(size_t size) {
+  CEF_VALUE_VERIFY_RETURN(true, NULL);
+  if (size == 0 || size > kuint32max)
+    return NULL;
+
+  scoped_ptr<base::SharedMemory> shared_memory(new base::SharedMemory());
+  if (!shared_memory->CreateAndMapAnonymous(size))
+    return NULL;
+
+  shared_memory_.swap(shared_memory);
+  shared_memory_size_ = size;
+  return shared_memory_->memory();
+}
+
+void* CefProcessMessageImpl::GetSharedMemory() {
+  CEF_VALUE_VERIFY_RETURN(false, NULL);
+  if (!shared_memory_.get())
+    return NULL;
+  return shared_memory_->memory();
+}
+
+size_t CefProcessMessageImpl::GetSharedMemorySize() {
+  CEF_VALUE_VERIFY_RETURN(false, 0);
+  return shared_memory_size_;
+}
+
+bool CefProcessMessageImpl::MoveSharedMemory(
+    CefRefPtr<CefProcessMessage> target) {
+  CefProcessMessageImpl* target_impl =
+      static_cast<CefProcessMessageImpl*>(target.get());
+  if (!target_impl || target_impl == this || !target_impl->IsValid() ||
+      target_impl->IsReadOnly()) {
+    return false;
+  }
+
+  scoped_ptr<base::SharedMemory> shared_memory;
+  size_t shared_memory_size = 0;
+  {
+    CEF_VALUE_VERIFY_RETURN(false, false);
+    if (!shared_memory_.get())
+      return false;
+    shared_memory.swap(shared_memory_);
+    shared_memory_size = shared_memory_size_;
+    shared_memory_size_ = 0;
+  }
+
+  // The two messages use different controllers so they are locked one at a
+  // time.
+  {
+    CEF_VALUE_VERIFY_RETURN_EX(target_impl, true, false);
+    target_impl->shared_memory_.swap(shared_memory);
+    target_impl->shared_memory_size_ = shared_memory_size;
+  }
+  return true;
+}
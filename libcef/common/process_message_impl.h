@@ -9,7 +9,14 @@
 #include "include/cef_process_message.h"
 #include "libcef/common/value_base.h"
 
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
+#include "base/process/process_handle.h"
+
+class CefPackedValueBuffer;
 struct Cef_Request_Params;
+struct Cef_RequestBatch_Params;
 
 // CefProcessMessage implementation
 class CefProcessMessageImpl
@@ -19,15 +26,77 @@ class CefProcessMessageImpl
                         bool will_delete,
                         bool read_only);
 
-  // Copies the underlying value to the specified |target| structure.
+  // Copies the underlying value to the specified |target| structure. Packed
+  // arguments are written to |target.packed_arguments|.
   bool CopyTo(Cef_Request_Params& target);
 
+  // Appends a copy of the underlying value to the specified |target| batch.
+  bool AppendTo(Cef_RequestBatch_Params& target);
+
+  // Populates |target| with the request at |index| of |batch|. The arguments
+  // are moved out of |batch|.
+  static void TakeFromBatch(Cef_RequestBatch_Params& batch,
+                            size_t index,
+                            Cef_Request_Params& target);
+
+  // Detaches and returns the attached shared memory segment, if any. |size| is
+  // set to the segment size.
+  scoped_ptr<base::SharedMemory> PassSharedMemory(uint32* size);
+
+  // Hands |shared_memory| to |process| and stores the resulting handle in
+  // |target|. Only call this immediately before sending |target| because the
+  // handle is no longer owned by this process. Returns false and leaves
+  // |target| describing an empty segment if |shared_memory| cannot be shared.
+  static bool GiveSharedMemory(scoped_ptr<base::SharedMemory> shared_memory,
+                               uint32 size,
+                               base::ProcessHandle process,
+                               Cef_Request_Params& target);
+
+  // Closes the handle stored in |target| by GiveSharedMemory after the IPC
+  // message carrying it could not be sent.
+  static void CloseGivenSharedMemory(const Cef_Request_Params& target,
+                                     base::ProcessHandle process);
+
+  // Takes ownership of the shared memory segment described by |source| and
+  // maps it. Returns NULL if |source| does not describe a segment. On Windows
+  // |source_process| is the process in which the handle is valid.
+  static scoped_ptr<base::SharedMemory> TakeSharedMemory(
+      const Cef_Request_Params& source,
+      base::ProcessHandle source_process);
+
+  // Attaches |shared_memory| of |size| bytes, replacing any existing segment.
+  void SetSharedMemory(scoped_ptr<base::SharedMemory> shared_memory,
+                       size_t size);
+
+  // Takes ownership of the packed arguments |data| received from another
+  // process by swapping it with an empty string. The argument list will then
+  // read directly from the packed buffer. Returns false if |data| is invalid.
+  bool SetPackedArguments(std::string* data);
+
   // CefProcessMessage methods.
   virtual bool IsValid() OVERRIDE;
   virtual bool IsReadOnly() OVERRIDE;
   virtual CefRefPtr<CefProcessMessage> Copy() OVERRIDE;
   virtual CefString GetName() OVERRIDE;
   virtual CefRefPtr<CefListValue> GetArgumentList() OVERRIDE;
+  virtual void SetArgumentListPacked(bool packed) OVERRIDE;
+  virtual bool IsArgumentListPacked() OVERRIDE;
+  virtual void* CreateSharedMemory(size_t size) OVERRIDE;
+  virtual void* GetSharedMemory() OVERRIDE;
+  virtual size_t GetSharedMemorySize() OVERRIDE;
+  virtual bool MoveSharedMemory(CefRefPtr<CefProcessMessage> target) OVERRIDE;
+
+ private:
+  // Shared memory segment that travels with the message outside of the
+  // serialized arguments. Protected by the controller lock.
+  scoped_ptr<base::SharedMemory> shared_memory_;
+  size_t shared_memory_size_;
+
+  // True if the arguments will be sent in the packed format.
+  bool pack_arguments_;
+  // Packed arguments of a received message. Immutable and shared with any
+  // argument list views.
+  scoped_refptr<CefPackedValueBuffer> packed_arguments_;
 
   DISALLOW_COPY_AND_ASSIGN(CefProcessMessageImpl);
 };
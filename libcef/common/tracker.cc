@@ -4,6 +4,27 @@
 
 #include "libcef/common/tracker.h"
 
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/memory/aligned_memory.h"
+
+namespace {
+
+// Size and alignment of the slabs used by CefTrackSlabAllocator. Slabs are
+// aligned to their size so that the slab for a block can be found by masking
+// the block address.
+const size_t kSlabSize = 16 * 1024;
+
+// Alignment of the blocks returned by CefTrackSlabAllocator.
+const size_t kBlockAlignment = 16;
+
+size_t AlignBlockSize(size_t size) {
+  return (size + kBlockAlignment - 1) & ~(kBlockAlignment - 1);
+}
+
+}  // namespace
+
 // CefTrackNode implementation.
 
 CefTrackNode::CefTrackNode()
@@ -42,8 +63,34 @@ void CefTrackNode::RemoveTracking() {
 
 // CefTrackManager implementation.
 
+// Locks the manager if it may be accessed from multiple threads.
+class CefTrackManager::ScopedLock {
+ public:
+  explicit ScopedLock(CefTrackManager* manager) : manager_(manager) {
+    if (manager_->mode_ == THREAD_SAFE)
+      manager_->Lock();
+    else
+      DCHECK(manager_->thread_checker_.CalledOnValidThread());
+  }
+  ~ScopedLock() {
+    if (manager_->mode_ == THREAD_SAFE)
+      manager_->Unlock();
+  }
+
+ private:
+  CefTrackManager* manager_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedLock);
+};
+
 CefTrackManager::CefTrackManager()
-  : object_count_(0) {
+  : mode_(THREAD_SAFE),
+    object_count_(0) {
+}
+
+CefTrackManager::CefTrackManager(ThreadMode mode)
+  : mode_(mode),
+    object_count_(0) {
 }
 
 CefTrackManager::~CefTrackManager() {
@@ -51,7 +98,7 @@ CefTrackManager::~CefTrackManager() {
 }
 
 void CefTrackManager::Add(CefTrackNode* object) {
-  AutoLock lock_scope(this);
+  ScopedLock lock_scope(this);
   if (!object->IsTracked()) {
     tracker_.InsertTrackNext(object);
     ++object_count_;
@@ -59,7 +106,7 @@ void CefTrackManager::Add(CefTrackNode* object) {
 }
 
 bool CefTrackManager::Delete(CefTrackNode* object) {
-  AutoLock lock_scope(this);
+  ScopedLock lock_scope(this);
   if (object->IsTracked()) {
     object->RemoveTracking();
     delete object;
@@ -70,14 +117,184 @@ bool CefTrackManager::Delete(CefTrackNode* object) {
 }
 
 void CefTrackManager::DeleteAll() {
-  AutoLock lock_scope(this);
-  CefTrackNode* next;
-  do {
-    next = tracker_.GetTrackNext();
-    if (next) {
-      next->RemoveTracking();
-      delete next;
+  ScopedLock lock_scope(this);
+
+  CefTrackNode* first = tracker_.GetTrackNext();
+  if (!first)
+    return;
+
+  // Move the whole list to |pending| at once so that objects added by
+  // destructors are kept by the manager instead of being released as well.
+  CefTrackNode pending;
+  pending.SetTrackNext(first);
+  first->SetTrackPrev(&pending);
+  tracker_.SetTrackNext(NULL);
+
+  // Each object is unlinked from |pending| before it is destroyed so that the
+  // list stays valid if a destructor removes another pending object.
+  CefTrackNode* object;
+  while ((object = pending.GetTrackNext()) != NULL) {
+    object->RemoveTracking();
+    delete object;
+    --object_count_;
+  }
+}
+
+
+// CefTrackSlabAllocator implementation.
+
+struct CefTrackSlabAllocator::FreeBlock {
+  FreeBlock* next;
+};
+
+// Header stored at the start of each slab. The blocks follow the header.
+struct CefTrackSlabAllocator::Slab {
+  // Allocator that owns this slab.
+  CefTrackSlabAllocator* allocator;
+  // Links in the |available_| list.
+  Slab* prev;
+  Slab* next;
+  // Blocks that were freed and can be reused.
+  FreeBlock* free_list;
+  // Number of blocks, starting from the first block, that have been handed out
+  // at least once. Blocks after this are unused and are not in |free_list|.
+  size_t carved_count;
+  // Number of blocks currently allocated.
+  size_t used_count;
+
+  char* block(size_t index, size_t block_size) {
+    return reinterpret_cast<char*>(this) + AlignBlockSize(sizeof(Slab)) +
+           index * block_size;
+  }
+};
+
+CefTrackSlabAllocator::CefTrackSlabAllocator(size_t block_size)
+  : block_size_(AlignBlockSize(std::max(block_size, sizeof(FreeBlock)))),
+    blocks_per_slab_((kSlabSize - AlignBlockSize(sizeof(Slab))) /
+                     block_size_),
+    available_(NULL),
+    spare_(NULL),
+    block_count_(0),
+    slab_count_(0) {
+  // Larger objects should use the system allocator.
+  CHECK_GE(blocks_per_slab_, 8U);
+}
+
+CefTrackSlabAllocator::~CefTrackSlabAllocator() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+
+  // Slabs with allocated blocks keep the allocator alive so only the spare
+  // slab can remain.
+  DCHECK_EQ(block_count_, 0);
+  DCHECK(!available_);
+  if (spare_)
+    DestroySlab(spare_);
+  DCHECK_EQ(slab_count_, 0);
+}
+
+void* CefTrackSlabAllocator::Allocate() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+
+  if (!available_) {
+    Slab* slab = spare_;
+    if (slab)
+      spare_ = NULL;
+    else
+      slab = CreateSlab();
+    LinkAvailable(slab);
+  }
+
+  Slab* slab = available_;
+  void* block;
+  if (slab->free_list) {
+    block = slab->free_list;
+    slab->free_list = slab->free_list->next;
+  } else {
+    DCHECK_LT(slab->carved_count, blocks_per_slab_);
+    block = slab->block(slab->carved_count++, block_size_);
+  }
+
+  // A slab with allocated blocks keeps the allocator alive.
+  if (slab->used_count++ == 0)
+    AddRef();
+  if (slab->used_count == blocks_per_slab_)
+    UnlinkAvailable(slab);
+  ++block_count_;
+  return block;
+}
+
+// static
+void CefTrackSlabAllocator::Free(void* block) {
+  if (!block)
+    return;
+
+  Slab* slab = reinterpret_cast<Slab*>(
+      reinterpret_cast<uintptr_t>(block) & ~(kSlabSize - 1));
+  slab->allocator->FreeInSlab(slab, block);
+}
+
+void CefTrackSlabAllocator::FreeInSlab(Slab* slab, void* block) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_GT(slab->used_count, 0U);
+
+  if (slab->used_count == blocks_per_slab_)
+    LinkAvailable(slab);
+
+  FreeBlock* free_block = static_cast<FreeBlock*>(block);
+  free_block->next = slab->free_list;
+  slab->free_list = free_block;
+  --block_count_;
+
+  if (--slab->used_count == 0) {
+    // Release the slab as a whole now that all of its blocks are free.
+    UnlinkAvailable(slab);
+    if (spare_) {
+      DestroySlab(slab);
+    } else {
+      slab->free_list = NULL;
+      slab->carved_count = 0;
+      spare_ = slab;
     }
-  } while (next != NULL);
-  object_count_ = 0;
+
+    // May delete this object.
+    Release();
+  }
+}
+
+CefTrackSlabAllocator::Slab* CefTrackSlabAllocator::CreateSlab() {
+  Slab* slab =
+      static_cast<Slab*>(base::AlignedAlloc(kSlabSize, kSlabSize));
+  slab->allocator = this;
+  slab->prev = NULL;
+  slab->next = NULL;
+  slab->free_list = NULL;
+  slab->carved_count = 0;
+  slab->used_count = 0;
+  ++slab_count_;
+  return slab;
+}
+
+void CefTrackSlabAllocator::DestroySlab(Slab* slab) {
+  DCHECK_EQ(slab->used_count, 0U);
+  base::AlignedFree(slab);
+  --slab_count_;
+}
+
+void CefTrackSlabAllocator::LinkAvailable(Slab* slab) {
+  DCHECK(!slab->prev && !slab->next && slab != available_);
+  slab->next = available_;
+  if (available_)
+    available_->prev = slab;
+  available_ = slab;
+}
+
+void CefTrackSlabAllocator::UnlinkAvailable(Slab* slab) {
+  if (slab->prev)
+    slab->prev->next = slab->next;
+  else
+    available_ = slab->next;
+  if (slab->next)
+    slab->next->prev = slab->prev;
+  slab->prev = NULL;
+  slab->next = NULL;
 }
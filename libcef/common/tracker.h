@@ -8,6 +8,10 @@
 
 #include "include/cef_base.h"
 
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/threading/thread_checker.h"
+
 // Class extended by objects that must be tracked.  After creating a tracked
 // object you should add it to the appropriate track manager.
 class CefTrackNode {
@@ -48,7 +52,16 @@ class CefTrackNode {
 // base::LazyInstance<CefTrackManager> g_singleton = LAZY_INSTANCE_INITIALIZER;
 class CefTrackManager : public CefBase {
  public:
+  enum ThreadMode {
+    // Methods may be called on any thread. Access is synchronized.
+    THREAD_SAFE,
+    // Methods must be called on the thread that created the manager. Access is
+    // not synchronized.
+    SINGLE_THREADED,
+  };
+
   CefTrackManager();
+  explicit CefTrackManager(ThreadMode mode);
   virtual ~CefTrackManager();
 
   // Add an object to be tracked by this manager.
@@ -64,6 +77,10 @@ class CefTrackManager : public CefBase {
   inline int GetCount() { return object_count_; }
 
  private:
+  class ScopedLock;
+
+  const ThreadMode mode_;
+  base::ThreadChecker thread_checker_;
   CefTrackNode tracker_;
   int object_count_;
 
@@ -71,4 +88,65 @@ class CefTrackManager : public CefBase {
   IMPLEMENT_LOCKING(CefTrackManager);
 };
 
+// Allocator for objects of a single size that are created and destroyed in
+// large numbers, such as tracked objects. Blocks are carved out of aligned
+// slabs so that allocating and freeing a block is O(1) and doesn't touch the
+// system allocator. A slab is returned to the system as soon as all of its
+// blocks are free, so releasing many objects at once (for example, when a
+// track manager is cleared) releases whole slabs instead of individual
+// allocations. Must only be used on the thread that created the allocator.
+// Each slab with allocated blocks holds a reference to the allocator so blocks
+// may still be freed after the owner has released its reference.
+class CefTrackSlabAllocator
+    : public base::RefCounted<CefTrackSlabAllocator> {
+ public:
+  explicit CefTrackSlabAllocator(size_t block_size);
+
+  // Returns a block of at least |block_size| bytes.
+  void* Allocate();
+
+  // Free a block returned by Allocate() on any CefTrackSlabAllocator. The
+  // allocator is found from the block address.
+  static void Free(void* block);
+
+  // Returns the number of allocated blocks.
+  int GetCount() const { return block_count_; }
+
+  // Returns the number of slabs that are currently allocated from the system,
+  // including the spare slab.
+  int GetSlabCount() const { return slab_count_; }
+
+  // Returns the number of blocks in each slab.
+  size_t blocks_per_slab() const { return blocks_per_slab_; }
+
+ private:
+  friend class base::RefCounted<CefTrackSlabAllocator>;
+
+  struct FreeBlock;
+  struct Slab;
+
+  ~CefTrackSlabAllocator();
+
+  void FreeInSlab(Slab* slab, void* block);
+  Slab* CreateSlab();
+  void DestroySlab(Slab* slab);
+  void LinkAvailable(Slab* slab);
+  void UnlinkAvailable(Slab* slab);
+
+  const size_t block_size_;
+  const size_t blocks_per_slab_;
+
+  // Slabs that have at least one free block.
+  Slab* available_;
+  // An empty slab that is kept to avoid repeatedly creating and destroying a
+  // slab when a single object is allocated and freed. May be NULL.
+  Slab* spare_;
+
+  int block_count_;
+  int slab_count_;
+  base::ThreadChecker thread_checker_;
+
+  DISALLOW_COPY_AND_ASSIGN(CefTrackSlabAllocator);
+};
+
 #endif  // CEF_LIBCEF_COMMON_TRACKER_H_
@@ -175,8 +175,11 @@ void CefValueController::TakeFrom(CefValueController* other) {
       // References should only be added once.
       DCHECK(reference_map_.find(it->first) == reference_map_.end());
       reference_map_.insert(std::make_pair(it->first, it->second));
+      it->second->OnControlMoved(this);
     }
-    other->reference_map_.empty();
+    // Clear the map so that the moved references are not removed along with
+    // the |other| owner.
+    other->reference_map_.clear();
   }
 
   if (!other->dependency_map_.empty()) {
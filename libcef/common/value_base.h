@@ -28,6 +28,9 @@ class CefValueController
 
     // Called when the value has been removed.
     virtual void OnControlRemoved() =0;
+
+    // Called when the value has been moved to |new_controller|.
+    virtual void OnControlMoved(CefValueController* new_controller) =0;
   };
 
   // Encapsulates context locking and verification logic.
@@ -105,7 +108,9 @@ class CefValueController
   void RemoveDependencies(void* value);
 
   // Takes ownership of all references and dependencies currently controlled by
-  // |other|. The |other| controller must already be locked.
+  // |other|. The references are moved without copying their values and will
+  // use this controller afterwards. The |other| controller must already be
+  // locked.
   void TakeFrom(CefValueController* other);
 
  private:
@@ -344,6 +349,16 @@ class CefValueBase : public CefType, public CefValueController::Object {
     value_ = NULL;
   }
 
+  virtual void OnControlMoved(CefValueController* new_controller) {
+    DCHECK(controller()->locked());
+    DCHECK(new_controller->locked());
+
+    // Only references should be moved in this manner.
+    DCHECK(reference());
+
+    controller_ = new_controller;
+  }
+
   // Override to customize value deletion.
   virtual void DeleteValue(ValueType* value) { delete value; }
 
@@ -400,6 +415,28 @@ class CefValueBase : public CefType, public CefValueController::Object {
     DISALLOW_COPY_AND_ASSIGN(AutoLock);
   };
 
+ public:
+  // Provides read access to the underlying value without copying it. The
+  // value is locked while this object exists.
+  class ScopedReadLock {
+   public:
+    explicit ScopedReadLock(CefValueBase* impl)
+      : impl_(impl),
+        auto_lock_(impl, false) {
+    }
+
+    // Returns NULL if the value cannot be accessed.
+    inline const ValueType* value() {
+      return auto_lock_.verified() ? &impl_->const_value() : NULL;
+    }
+
+   private:
+    CefValueBase* impl_;
+    AutoLock auto_lock_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedReadLock);
+  };
+
  private:
   ValueType* value_;
   ValueMode value_mode_;
@@ -3,6 +3,7 @@
 // can be found in the LICENSE file.
 
 #include "libcef/common/values_impl.h"
+#include "libcef/common/packed_values_impl.h"
 
 #include <algorithm>
 #include <vector>
@@ -150,7 +151,7 @@ CefRefPtr<CefDictionaryValue> CefDictionaryValueImpl::GetOrCreateRef(
 CefDictionaryValueImpl::CefDictionaryValueImpl(base::DictionaryValue* value,
                                                bool will_delete,
                                                bool read_only)
-  : CefValueBase<CefDictionaryValue, base::DictionaryValue>(
+  : CefValueBase<CefDictionaryValueInternal, base::DictionaryValue>(
         value, NULL, will_delete ? kOwnerWillDelete : kOwnerNoDelete,
         read_only, NULL) {
 }
@@ -176,6 +177,10 @@ base::DictionaryValue* CefDictionaryValueImpl::CopyOrDetachValue(
   return new_value;
 }
 
+CefDictionaryValueImpl* CefDictionaryValueImpl::AsImpl() {
+  return this;
+}
+
 bool CefDictionaryValueImpl::IsValid() {
   return !detached();
 }
@@ -204,6 +209,14 @@ CefRefPtr<CefDictionaryValue> CefDictionaryValueImpl::Copy(
       CefDictionaryValueImpl::kOwnerWillDelete, false, NULL);
 }
 
+CefRefPtr<CefDictionaryValue> CefDictionaryValueImpl::CreateSnapshot() {
+  CEF_VALUE_VERIFY_RETURN(false, NULL);
+
+  scoped_refptr<CefPackedValueBuffer> buffer =
+      CefPackedValueBuffer::CreateFromValue(const_value());
+  return new CefPackedDictionaryValueImpl(buffer, buffer->root());
+}
+
 size_t CefDictionaryValueImpl::GetSize() {
   CEF_VALUE_VERIFY_RETURN(false, 0);
   return const_value().size();
@@ -240,6 +253,48 @@ bool CefDictionaryValueImpl::Remove(const CefString& key) {
   return RemoveInternal(key);
 }
 
+CefRefPtr<CefBinaryValue> CefDictionaryValueImpl::DetachBinary(
+    const CefString& key) {
+  CEF_VALUE_VERIFY_RETURN(true, NULL);
+
+  const base::Value* out_value = NULL;
+  if (!const_value().GetWithoutPathExpansion(key, &out_value) ||
+      !out_value->IsType(base::Value::TYPE_BINARY)) {
+    return NULL;
+  }
+
+  return new CefBinaryValueImpl(
+      static_cast<base::BinaryValue*>(DetachInternal(key)), true, true);
+}
+
+CefRefPtr<CefDictionaryValue> CefDictionaryValueImpl::DetachDictionary(
+    const CefString& key) {
+  CEF_VALUE_VERIFY_RETURN(true, NULL);
+
+  const base::Value* out_value = NULL;
+  if (!const_value().GetWithoutPathExpansion(key, &out_value) ||
+      !out_value->IsType(base::Value::TYPE_DICTIONARY)) {
+    return NULL;
+  }
+
+  return new CefDictionaryValueImpl(
+      static_cast<base::DictionaryValue*>(DetachInternal(key)), true, false);
+}
+
+CefRefPtr<CefListValue> CefDictionaryValueImpl::DetachList(
+    const CefString& key) {
+  CEF_VALUE_VERIFY_RETURN(true, NULL);
+
+  const base::Value* out_value = NULL;
+  if (!const_value().GetWithoutPathExpansion(key, &out_value) ||
+      !out_value->IsType(base::Value::TYPE_LIST)) {
+    return NULL;
+  }
+
+  return new CefListValueImpl(
+      static_cast<base::ListValue*>(DetachInternal(key)), true, false);
+}
+
 CefValueType CefDictionaryValueImpl::GetType(const CefString& key) {
   CEF_VALUE_VERIFY_RETURN(false, VTYPE_INVALID);
 
@@ -431,8 +486,8 @@ bool CefDictionaryValueImpl::SetDictionary(
   CEF_VALUE_VERIFY_RETURN(true, false);
   RemoveInternal(key);
 
-  CefDictionaryValueImpl* impl =
-      static_cast<CefDictionaryValueImpl*>(value.get());
+  CefDictionaryValueInternal* impl =
+      static_cast<CefDictionaryValueInternal*>(value.get());
   DCHECK(impl);
 
   mutable_value()->SetWithoutPathExpansion(key,
@@ -445,7 +500,7 @@ bool CefDictionaryValueImpl::SetList(const CefString& key,
   CEF_VALUE_VERIFY_RETURN(true, false);
   RemoveInternal(key);
 
-  CefListValueImpl* impl = static_cast<CefListValueImpl*>(value.get());
+  CefListValueInternal* impl = static_cast<CefListValueInternal*>(value.get());
   DCHECK(impl);
 
   mutable_value()->SetWithoutPathExpansion(key,
@@ -454,9 +509,14 @@ bool CefDictionaryValueImpl::SetList(const CefString& key,
 }
 
 bool CefDictionaryValueImpl::RemoveInternal(const CefString& key) {
+  scoped_ptr<base::Value> out_value(DetachInternal(key));
+  return out_value.get() != NULL;
+}
+
+base::Value* CefDictionaryValueImpl::DetachInternal(const CefString& key) {
   scoped_ptr<base::Value> out_value;
   if (!mutable_value()->RemoveWithoutPathExpansion(key, &out_value))
-    return false;
+    return NULL;
 
   // Remove the value.
   controller()->Remove(out_value.get(), true);
@@ -467,7 +527,7 @@ bool CefDictionaryValueImpl::RemoveInternal(const CefString& key) {
     controller()->RemoveDependencies(out_value.get());
   }
 
-  return true;
+  return out_value.release();
 }
 
 CefDictionaryValueImpl::CefDictionaryValueImpl(
@@ -476,7 +536,7 @@ CefDictionaryValueImpl::CefDictionaryValueImpl(
     ValueMode value_mode,
     bool read_only,
     CefValueController* controller)
-  : CefValueBase<CefDictionaryValue, base::DictionaryValue>(
+  : CefValueBase<CefDictionaryValueInternal, base::DictionaryValue>(
         value, parent_value, value_mode, read_only, controller) {
 }
 
@@ -506,7 +566,7 @@ CefRefPtr<CefListValue> CefListValueImpl::GetOrCreateRef(
 CefListValueImpl::CefListValueImpl(base::ListValue* value,
                                    bool will_delete,
                                    bool read_only)
-  : CefValueBase<CefListValue, base::ListValue>(
+  : CefValueBase<CefListValueInternal, base::ListValue>(
         value, NULL, will_delete ? kOwnerWillDelete : kOwnerNoDelete,
         read_only, NULL) {
 }
@@ -532,6 +592,10 @@ base::ListValue* CefListValueImpl::CopyOrDetachValue(
   return new_value;
 }
 
+CefListValueImpl* CefListValueImpl::AsImpl() {
+  return this;
+}
+
 bool CefListValueImpl::IsValid() {
   return !detached();
 }
@@ -551,6 +615,14 @@ CefRefPtr<CefListValue> CefListValueImpl::Copy() {
       CefListValueImpl::kOwnerWillDelete, false, NULL);
 }
 
+CefRefPtr<CefListValue> CefListValueImpl::CreateSnapshot() {
+  CEF_VALUE_VERIFY_RETURN(false, NULL);
+
+  scoped_refptr<CefPackedValueBuffer> buffer =
+      CefPackedValueBuffer::CreateFromValue(const_value());
+  return new CefPackedListValueImpl(buffer, buffer->root());
+}
+
 bool CefListValueImpl::SetSize(size_t size) {
   CEF_VALUE_VERIFY_RETURN(true, false);
 
@@ -586,6 +658,45 @@ bool CefListValueImpl::Remove(int index) {
   return RemoveInternal(index);
 }
 
+CefRefPtr<CefBinaryValue> CefListValueImpl::DetachBinary(int index) {
+  CEF_VALUE_VERIFY_RETURN(true, NULL);
+
+  const base::Value* out_value = NULL;
+  if (!const_value().Get(index, &out_value) ||
+      !out_value->IsType(base::Value::TYPE_BINARY)) {
+    return NULL;
+  }
+
+  return new CefBinaryValueImpl(
+      static_cast<base::BinaryValue*>(DetachInternal(index)), true, true);
+}
+
+CefRefPtr<CefDictionaryValue> CefListValueImpl::DetachDictionary(int index) {
+  CEF_VALUE_VERIFY_RETURN(true, NULL);
+
+  const base::Value* out_value = NULL;
+  if (!const_value().Get(index, &out_value) ||
+      !out_value->IsType(base::Value::TYPE_DICTIONARY)) {
+    return NULL;
+  }
+
+  return new CefDictionaryValueImpl(
+      static_cast<base::DictionaryValue*>(DetachInternal(index)), true, false);
+}
+
+CefRefPtr<CefListValue> CefListValueImpl::DetachList(int index) {
+  CEF_VALUE_VERIFY_RETURN(true, NULL);
+
+  const base::Value* out_value = NULL;
+  if (!const_value().Get(index, &out_value) ||
+      !out_value->IsType(base::Value::TYPE_LIST)) {
+    return NULL;
+  }
+
+  return new CefListValueImpl(
+      static_cast<base::ListValue*>(DetachInternal(index)), true, false);
+}
+
 CefValueType CefListValueImpl::GetType(int index) {
   CEF_VALUE_VERIFY_RETURN(false, VTYPE_INVALID);
 
@@ -785,8 +896,8 @@ bool CefListValueImpl::SetDictionary(int index,
                                      CefRefPtr<CefDictionaryValue> value) {
   CEF_VALUE_VERIFY_RETURN(true, false);
 
-  CefDictionaryValueImpl* impl =
-      static_cast<CefDictionaryValueImpl*>(value.get());
+  CefDictionaryValueInternal* impl =
+      static_cast<CefDictionaryValueInternal*>(value.get());
   DCHECK(impl);
 
   base::Value* new_value = impl->CopyOrDetachValue(controller());
@@ -800,7 +911,7 @@ bool CefListValueImpl::SetDictionary(int index,
 bool CefListValueImpl::SetList(int index, CefRefPtr<CefListValue> value) {
   CEF_VALUE_VERIFY_RETURN(true, false);
 
-  CefListValueImpl* impl = static_cast<CefListValueImpl*>(value.get());
+  CefListValueInternal* impl = static_cast<CefListValueInternal*>(value.get());
   DCHECK(impl);
 
   base::Value* new_value = impl->CopyOrDetachValue(controller());
@@ -812,9 +923,14 @@ bool CefListValueImpl::SetList(int index, CefRefPtr<CefListValue> value) {
 }
 
 bool CefListValueImpl::RemoveInternal(int index) {
+  scoped_ptr<base::Value> out_value(DetachInternal(index));
+  return out_value.get() != NULL;
+}
+
+base::Value* CefListValueImpl::DetachInternal(int index) {
   scoped_ptr<base::Value> out_value;
   if (!mutable_value()->Remove(index, &out_value))
-    return false;
+    return NULL;
 
   // Remove the value.
   controller()->Remove(out_value.get(), true);
@@ -825,7 +941,7 @@ bool CefListValueImpl::RemoveInternal(int index) {
     controller()->RemoveDependencies(out_value.get());
   }
 
-  return true;
+  return out_value.release();
 }
 
 CefListValueImpl::CefListValueImpl(
@@ -834,6 +950,6 @@ CefListValueImpl::CefListValueImpl(
     ValueMode value_mode,
     bool read_only,
     CefValueController* controller)
-  : CefValueBase<CefListValue, base::ListValue>(
+  : CefValueBase<CefListValueInternal, base::ListValue>(
         value, parent_value, value_mode, read_only, controller) {
 }
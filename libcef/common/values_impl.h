@@ -66,9 +66,29 @@ class CefBinaryValueImpl
 };
 
 
+class CefDictionaryValueImpl;
+class CefListValueImpl;
+
+// Internal interface implemented by every CefDictionaryValue object that the
+// library creates. Values passed back to the library can be cast to this type.
+class CefDictionaryValueInternal : public CefDictionaryValue {
+ public:
+  // Return a copy of the value.
+  virtual base::DictionaryValue* CopyValue() =0;
+
+  // If a reference return a copy of the value otherwise detach the value to the
+  // specified |new_controller|.
+  virtual base::DictionaryValue* CopyOrDetachValue(
+      CefValueController* new_controller) =0;
+
+  // Returns this object if it is backed by a base::DictionaryValue or NULL if
+  // it is a packed view.
+  virtual CefDictionaryValueImpl* AsImpl() =0;
+};
+
 // CefDictionaryValue implementation
 class CefDictionaryValueImpl
-    : public CefValueBase<CefDictionaryValue, base::DictionaryValue> {
+    : public CefValueBase<CefDictionaryValueInternal, base::DictionaryValue> {
  public:
   // Get or create a reference value.
   static CefRefPtr<CefDictionaryValue> GetOrCreateRef(
@@ -82,12 +102,11 @@ class CefDictionaryValueImpl
                          bool will_delete,
                          bool read_only);
 
-  // Return a copy of the value.
-  base::DictionaryValue* CopyValue();
-
-  // If a reference return a copy of the value otherwise detach the value to the
-  // specified |new_controller|.
-  base::DictionaryValue* CopyOrDetachValue(CefValueController* new_controller);
+  // CefDictionaryValueInternal methods.
+  virtual base::DictionaryValue* CopyValue() OVERRIDE;
+  virtual base::DictionaryValue* CopyOrDetachValue(
+      CefValueController* new_controller) OVERRIDE;
+  virtual CefDictionaryValueImpl* AsImpl() OVERRIDE;
 
   // CefDictionaryValue methods.
   virtual bool IsValid() OVERRIDE;
@@ -95,11 +114,16 @@ class CefDictionaryValueImpl
   virtual bool IsReadOnly() OVERRIDE;
   virtual CefRefPtr<CefDictionaryValue> Copy(
       bool exclude_empty_children) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> CreateSnapshot() OVERRIDE;
   virtual size_t GetSize() OVERRIDE;
   virtual bool Clear() OVERRIDE;
   virtual bool HasKey(const CefString& key) OVERRIDE;
   virtual bool GetKeys(KeyList& keys) OVERRIDE;
   virtual bool Remove(const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefBinaryValue> DetachBinary(const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> DetachDictionary(
+      const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefListValue> DetachList(const CefString& key) OVERRIDE;
   virtual CefValueType GetType(const CefString& key) OVERRIDE;
   virtual bool GetBool(const CefString& key) OVERRIDE;
   virtual int GetInt(const CefString& key) OVERRIDE;
@@ -131,6 +155,10 @@ class CefDictionaryValueImpl
                          CefValueController* controller);
 
   bool RemoveInternal(const CefString& key);
+  // Remove the value for |key| and return it without copying. Any references
+  // to the value or its children are invalidated. Returns NULL if |key| does
+  // not exist.
+  base::Value* DetachInternal(const CefString& key);
 
   // For the Create() method.
   friend class CefDictionaryValue;
@@ -139,9 +167,26 @@ class CefDictionaryValueImpl
 };
 
 
+// Internal interface implemented by every CefListValue object that the library
+// creates. Values passed back to the library can be cast to this type.
+class CefListValueInternal : public CefListValue {
+ public:
+  // Return a copy of the value.
+  virtual base::ListValue* CopyValue() =0;
+
+  // If a reference return a copy of the value otherwise detach the value to the
+  // specified |new_controller|.
+  virtual base::ListValue* CopyOrDetachValue(
+      CefValueController* new_controller) =0;
+
+  // Returns this object if it is backed by a base::ListValue or NULL if it is
+  // a packed view.
+  virtual CefListValueImpl* AsImpl() =0;
+};
+
 // CefListValue implementation
 class CefListValueImpl
-    : public CefValueBase<CefListValue, base::ListValue> {
+    : public CefValueBase<CefListValueInternal, base::ListValue> {
  public:
   // Get or create a reference value.
   static CefRefPtr<CefListValue> GetOrCreateRef(
@@ -155,22 +200,25 @@ class CefListValueImpl
                    bool will_delete,
                    bool read_only);
 
-  // Return a copy of the value.
-  base::ListValue* CopyValue();
-
-  // If a reference return a copy of the value otherwise detach the value to the
-  // specified |new_controller|.
-  base::ListValue* CopyOrDetachValue(CefValueController* new_controller);
+  // CefListValueInternal methods.
+  virtual base::ListValue* CopyValue() OVERRIDE;
+  virtual base::ListValue* CopyOrDetachValue(
+      CefValueController* new_controller) OVERRIDE;
+  virtual CefListValueImpl* AsImpl() OVERRIDE;
 
   /// CefListValue methods.
   virtual bool IsValid() OVERRIDE;
   virtual bool IsOwned() OVERRIDE;
   virtual bool IsReadOnly() OVERRIDE;
   virtual CefRefPtr<CefListValue> Copy() OVERRIDE;
+  virtual CefRefPtr<CefListValue> CreateSnapshot() OVERRIDE;
   virtual bool SetSize(size_t size) OVERRIDE;
   virtual size_t GetSize() OVERRIDE;
   virtual bool Clear() OVERRIDE;
   virtual bool Remove(int index) OVERRIDE;
+  virtual CefRefPtr<CefBinaryValue> DetachBinary(int index) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> DetachDictionary(int index) OVERRIDE;
+  virtual CefRefPtr<CefListValue> DetachList(int index) OVERRIDE;
   virtual CefValueType GetType(int index) OVERRIDE;
   virtual bool GetBool(int index) OVERRIDE;
   virtual int GetInt(int index) OVERRIDE;
@@ -198,6 +246,10 @@ class CefListValueImpl
                    CefValueController* controller);
 
   bool RemoveInternal(int index);
+  // Remove the value at |index| and return it without copying. Any references
+  // to the value or its children are invalidated. Returns NULL if |index| is
+  // out of range.
+  base::Value* DetachInternal(int index);
 
   // For the Create() method.
   friend class CefListValue;
@@ -15,6 +15,7 @@
 #include "libcef/renderer/content_renderer_client.h"
 #include "libcef/renderer/dom_document_impl.h"
 #include "libcef/renderer/thread_util.h"
+#include "libcef/renderer/v8_impl.h"
 #include "libcef/renderer/webkit_glue.h"
 
 #include "base/strings/string16.h"
@@ -256,13 +257,59 @@ bool CefBrowserImpl::SendProcessMessage(CefProcessId target_process,
   CefProcessMessageImpl* impl =
       static_cast<CefProcessMessageImpl*>(message.get());
   if (impl->CopyTo(params)) {
+    uint32 shared_memory_size = 0;
+    scoped_ptr<base::SharedMemory> shared_memory =
+        impl->PassSharedMemory(&shared_memory_size);
     return SendProcessMessage(target_process, params.name, &params.arguments,
-                              true);
+                              &params.packed_arguments, shared_memory.Pass(),
+                              shared_memory_size, true);
   }
 
   return false;
 }
 
+bool CefBrowserImpl::SendProcessMessages(
+    CefProcessId target_process,
+    const std::vector<CefRefPtr<CefProcessMessage> >& messages) {
+  DCHECK_EQ(PID_BROWSER, target_process);
+
+  for (size_t i = 0; i < messages.size(); ++i) {
+    if (!messages[i].get() || !messages[i]->IsValid())
+      return false;
+  }
+
+  bool success = true;
+  Cef_RequestBatch_Params batch;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    CefProcessMessageImpl* impl =
+        static_cast<CefProcessMessageImpl*>(messages[i].get());
+    if (impl->GetSharedMemorySize() == 0 && !impl->IsArgumentListPacked()) {
+      if (!impl->AppendTo(batch))
+        success = false;
+      continue;
+    }
+
+    // Shared memory segments are sent individually to bound the number of
+    // handles per IPC message and packed arguments are sent individually to
+    // keep them packed. Send the pending batch first to preserve ordering.
+    if (!batch.names.empty()) {
+      if (!Send(new CefHostMsg_RequestBatch(routing_id(), batch)))
+        success = false;
+      batch.names.clear();
+      batch.arguments.Clear();
+    }
+    if (!SendProcessMessage(target_process, messages[i]))
+      success = false;
+  }
+
+  if (!batch.names.empty()) {
+    if (!Send(new CefHostMsg_RequestBatch(routing_id(), batch)))
+      success = false;
+  }
+
+  return success;
+}
+
 
 // CefBrowserImpl public methods.
 // -----------------------------------------------------------------------------
@@ -358,10 +405,14 @@ void CefBrowserImpl::LoadRequest(const CefMsg_LoadRequest_Params& params) {
   web_frame->loadRequest(request);
 }
 
-bool CefBrowserImpl::SendProcessMessage(CefProcessId target_process,
-                                        const std::string& name,
-                                        base::ListValue* arguments,
-                                        bool user_initiated) {
+bool CefBrowserImpl::SendProcessMessage(
+    CefProcessId target_process,
+    const std::string& name,
+    base::ListValue* arguments,
+    std::string* packed_arguments,
+    scoped_ptr<base::SharedMemory> shared_memory,
+    uint32 shared_memory_size,
+    bool user_initiated) {
   DCHECK_EQ(PID_BROWSER, target_process);
   DCHECK(!name.empty());
 
@@ -369,12 +420,38 @@ bool CefBrowserImpl::SendProcessMessage(CefProcessId target_process,
   params.name = name;
   if (arguments)
     params.arguments.Swap(arguments);
+  if (packed_arguments)
+    params.packed_arguments.swap(*packed_arguments);
   params.frame_id = -1;
   params.user_initiated = user_initiated;
   params.request_id = -1;
   params.expect_response = false;
 
-  return Send(new CefHostMsg_Request(routing_id(), params));
+  if (!shared_memory.get()) {
+    params.shared_memory_handle = base::SharedMemory::NULLHandle();
+    params.shared_memory_size = 0;
+    return Send(new CefHostMsg_Request(routing_id(), params));
+  }
+
+  // Only give the segment away if the message can be sent.
+  if (!render_view())
+    return false;
+
+  // The sandboxed renderer cannot duplicate handles into the browser process
+  // so the handle is given to this process and the browser duplicates it from
+  // here.
+  const base::ProcessHandle process = base::GetCurrentProcessHandle();
+  if (!CefProcessMessageImpl::GiveSharedMemory(shared_memory.Pass(),
+                                               shared_memory_size, process,
+                                               params)) {
+    return false;
+  }
+
+  if (!Send(new CefHostMsg_Request(routing_id(), params))) {
+    CefProcessMessageImpl::CloseGivenSharedMemory(params, process);
+    return false;
+  }
+  return true;
 }
 
 CefRefPtr<CefFrameImpl> CefBrowserImpl::GetWebFrameImpl(
@@ -615,6 +692,7 @@ bool CefBrowserImpl::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(CefBrowserImpl, message)
     IPC_MESSAGE_HANDLER(CefMsg_Request, OnRequest)
+    IPC_MESSAGE_HANDLER(CefMsg_RequestBatch, OnRequestBatch)
     IPC_MESSAGE_HANDLER(CefMsg_Response, OnResponse)
     IPC_MESSAGE_HANDLER(CefMsg_ResponseAck, OnResponseAck)
     IPC_MESSAGE_HANDLER(CefMsg_LoadRequest, LoadRequest)
@@ -636,6 +714,13 @@ void CefBrowserImpl::OnRequest(const Cef_Request_Params& params) {
                "request_id", params.request_id,
                "expect_response", params.expect_response ? 1 : 0);
 
+  // Take ownership of the shared memory segment, if any, so that it is released
+  // even if the request is not handled. The browser already gave the handle to
+  // this process.
+  scoped_ptr<base::SharedMemory> shared_memory =
+      CefProcessMessageImpl::TakeSharedMemory(params,
+                                              base::GetCurrentProcessHandle());
+
   if (params.user_initiated) {
     // Give the user a chance to handle the request.
     CefRefPtr<CefApp> app = CefContentClient::Get()->application();
@@ -646,8 +731,18 @@ void CefBrowserImpl::OnRequest(const Cef_Request_Params& params) {
         CefRefPtr<CefProcessMessageImpl> message(
             new CefProcessMessageImpl(const_cast<Cef_Request_Params*>(&params),
                                       false, true));
-        success = handler->OnProcessMessageReceived(this, PID_BROWSER,
-                                                    message.get());
+        message->SetSharedMemory(shared_memory.Pass(),
+                                 params.shared_memory_size);
+        // Drop messages with invalid packed arguments instead of delivering
+        // an argument list that does not match what was sent.
+        if (params.packed_arguments.empty() ||
+            message->SetPackedArguments(
+                const_cast<std::string*>(&params.packed_arguments))) {
+          success = handler->OnProcessMessageReceived(this, PID_BROWSER,
+                                                      message.get());
+        }
+        // Release any shared memory segment that was not moved elsewhere.
+        message->SetSharedMemory(scoped_ptr<base::SharedMemory>(), 0);
         message->Detach(NULL);
       }
     }
@@ -671,10 +766,13 @@ void CefBrowserImpl::OnRequest(const Cef_Request_Params& params) {
         DCHECK_GE(script_start_line, 0);
 
         if (is_javascript) {
-          web_frame->executeScript(
-              WebScriptSource(base::UTF8ToUTF16(code),
-                              GURL(script_url),
-                              script_start_line));
+          if (!CefV8RunPrecompiledScript(web_frame, code, script_url,
+                                         script_start_line)) {
+            web_frame->executeScript(
+                WebScriptSource(base::UTF8ToUTF16(code),
+                                GURL(script_url),
+                                script_start_line));
+          }
           success = true;
         } else {
           // TODO(cef): implement support for CSS code.
@@ -740,6 +838,19 @@ void CefBrowserImpl::OnRequest(const Cef_Request_Params& params) {
   }
 }
 
+void CefBrowserImpl::OnRequestBatch(const Cef_RequestBatch_Params& params) {
+  // The arguments are moved out of |params| as each request is dispatched.
+  Cef_RequestBatch_Params& batch =
+      const_cast<Cef_RequestBatch_Params&>(params);
+  DCHECK_EQ(batch.names.size(), batch.arguments.GetSize());
+
+  for (size_t i = 0; i < batch.names.size(); ++i) {
+    Cef_Request_Params request;
+    CefProcessMessageImpl::TakeFromBatch(batch, i, request);
+    OnRequest(request);
+  }
+}
+
 void CefBrowserImpl::OnResponse(const Cef_Response_Params& params) {
   response_manager_->RunHandler(params);
   if (params.expect_response_ack)
@@ -22,12 +22,14 @@
 class GURL;
 struct CefMsg_LoadRequest_Params;
 struct Cef_Request_Params;
+struct Cef_RequestBatch_Params;
 struct Cef_Response_Params;
 class CefContentRendererClient;
 class CefResponseManager;
 
 namespace base {
 class ListValue;
+class SharedMemory;
 }
 
 namespace blink {
@@ -76,6 +78,9 @@ class CefBrowserImpl : public CefBrowser,
   virtual bool SendProcessMessage(
       CefProcessId target_process,
       CefRefPtr<CefProcessMessage> message) OVERRIDE;
+  virtual bool SendProcessMessages(
+      CefProcessId target_process,
+      const std::vector<CefRefPtr<CefProcessMessage> >& messages) OVERRIDE;
 
   CefBrowserImpl(content::RenderView* render_view,
                  int browser_id,
@@ -85,10 +90,15 @@ class CefBrowserImpl : public CefBrowser,
 
   void LoadRequest(const CefMsg_LoadRequest_Params& params);
 
-  // Avoids unnecessary string type conversions.
+  // Avoids unnecessary string type conversions. |packed_arguments| is optional
+  // and replaces |arguments| when non-empty. |shared_memory| is optional and
+  // will be transferred to the browser process without copying.
   bool SendProcessMessage(CefProcessId target_process,
                           const std::string& name,
                           base::ListValue* arguments,
+                          std::string* packed_arguments,
+                          scoped_ptr<base::SharedMemory> shared_memory,
+                          uint32 shared_memory_size,
                           bool user_initiated);
 
   // Returns the matching CefFrameImpl reference or creates a new one.
@@ -131,6 +141,7 @@ class CefBrowserImpl : public CefBrowser,
 
   // RenderViewObserver::OnMessageReceived message handlers.
   void OnRequest(const Cef_Request_Params& params);
+  void OnRequestBatch(const Cef_RequestBatch_Params& params);
   void OnResponse(const Cef_Response_Params& params);
   void OnResponseAck(int request_id);
 
@@ -18,8 +18,8 @@
 #include "third_party/WebKit/public/platform/WebURL.h"
 #include "third_party/WebKit/public/web/WebDocument.h"
 #include "third_party/WebKit/public/web/WebFrame.h"
-#include "third_party/WebKit/public/web/WebView.h"
 #include "third_party/WebKit/public/web/WebScriptSource.h"
+#include "third_party/WebKit/public/web/WebView.h"
 
 using blink::WebString;
 
@@ -167,7 +167,8 @@ void CefFrameImpl::ExecuteJavaScript(const CefString& jsCode,
   if (startLine < 0)
     startLine = 0;
 
-  if (frame_) {
+  if (frame_ &&
+      !CefV8RunPrecompiledScript(frame_, jsCode, scriptUrl, startLine)) {
     GURL gurl = GURL(scriptUrl.ToString());
     frame_->executeScript(
         blink::WebScriptSource(jsCode.ToString16(), gurl, startLine));
@@ -6,20 +6,26 @@
 // Otherwise there will be compile errors in wtf/MathExtras.h.
 #define _USE_MATH_DEFINES
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/compiler_specific.h"
 
 #include "config.h"
 MSVC_PUSH_WARNING_LEVEL(0);
+#include "core/dom/Document.h"
 #include "core/frame/Frame.h"
+#include "core/inspector/InspectorInstrumentation.h"
 #include "core/workers/WorkerGlobalScope.h"
 #include "bindings/v8/ScriptController.h"
 #include "bindings/v8/V8Binding.h"
 #include "bindings/v8/V8RecursionScope.h"
+#include "bindings/v8/V8ScriptRunner.h"
 #include "bindings/v8/WorkerScriptController.h"
+#include "bindings/v8/custom/V8ArrayBufferCustom.h"
 MSVC_POP_WARNING();
 #undef LOG
 
@@ -29,13 +35,20 @@ MSVC_POP_WARNING();
 #include "libcef/common/content_client.h"
 #include "libcef/common/task_runner_impl.h"
 #include "libcef/common/tracker.h"
+#include "libcef/common/values_impl.h"
 #include "libcef/renderer/browser_impl.h"
 #include "libcef/renderer/thread_util.h"
 
+#include "base/auto_reset.h"
 #include "base/bind.h"
+#include "base/containers/mru_cache.h"
 #include "base/lazy_instance.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sha1.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/threading/thread_local.h"
+#include "base/values.h"
 #include "third_party/WebKit/public/web/WebKit.h"
 #include "third_party/WebKit/public/web/WebFrame.h"
 #include "third_party/WebKit/public/web/WebScriptController.h"
@@ -46,18 +59,140 @@ namespace {
 static const char kCefTrackObject[] = "Cef::TrackObject";
 static const char kCefContextState[] = "Cef::ContextState";
 
+// Maximum number of compiled scripts cached per Isolate.
+const size_t kMaxScriptCacheEntries = 32;
+
 void MessageListenerCallbackImpl(v8::Handle<v8::Message> message,
                                  v8::Handle<v8::Value> data);
 
+v8::Handle<v8::String> GetV8String(v8::Isolate* isolate,
+                                   const CefString& str);
+
+// Cache of scripts compiled with CefV8Context::PrecompileScript() and run by
+// CefV8RunPrecompiledScript(). Scripts are compiled with v8::Script::New() so
+// that they are context independent and can be run in any context of the
+// Isolate. Entries are keyed by a SHA1 hash of the source code together with
+// the script origin and are evicted in least recently used order.
+class CefV8ScriptCache {
+ public:
+  explicit CefV8ScriptCache(v8::Isolate* isolate)
+      : isolate_(isolate),
+        scripts_(kMaxScriptCacheEntries),
+        hit_count_(0) {
+  }
+
+  // Returns the cached script for |code| or an empty handle if |code| has not
+  // been compiled.
+  v8::Local<v8::Script> GetScript(const CefString& code,
+                                  const CefString& script_url,
+                                  int start_line) {
+    ScriptMap::iterator it =
+        scripts_.Get(GetKey(code, script_url, start_line));
+    if (it == scripts_.end())
+      return v8::Local<v8::Script>();
+    hit_count_++;
+    return v8::Local<v8::Script>::New(isolate_, it->second->script);
+  }
+
+  // Compiles and caches |code| if it is not already cached. |start_line| is
+  // 1-based like the line numbers used by WebKit. If not NULL |cached_data| is
+  // pre-parse data from GetCachedData() that will be used when compiling.
+  // Returns false if compilation fails, in which case the exception is
+  // reported to the current TryCatch. Must be called from within a context.
+  bool CompileScript(const CefString& code,
+                     const CefString& script_url,
+                     int start_line,
+                     const std::string* cached_data) {
+    std::string key = GetKey(code, script_url, start_line);
+    if (scripts_.Peek(key) != scripts_.end())
+      return true;
+
+    scoped_ptr<v8::ScriptData> pre_data;
+    if (cached_data && !cached_data->empty()) {
+      pre_data.reset(v8::ScriptData::New(
+          cached_data->data(), static_cast<int>(cached_data->size())));
+      if (pre_data->HasError())
+        pre_data.reset();
+    }
+
+    // Use the same origin as WebKit's ScriptController so that exceptions are
+    // reported identically.
+    v8::ScriptOrigin origin(GetV8String(isolate_, script_url),
+                            v8::Integer::New(isolate_, start_line - 1),
+                            v8::Integer::New(isolate_, 0),
+                            v8::True(isolate_));
+    v8::Local<v8::Script> script =
+        v8::Script::New(GetV8String(isolate_, code), &origin, pre_data.get());
+    if (script.IsEmpty())
+      return false;
+
+    Entry* entry = new Entry();
+    entry->script.Reset(isolate_, script);
+    scripts_.Put(key, entry);
+    return true;
+  }
+
+  // Returns pre-parse data for |code| that can be persisted and passed to a
+  // later CompileScript() call, possibly in a different process. Returns false
+  // if |code| contains syntax errors.
+  bool GetCachedData(const CefString& code, std::string* cached_data) {
+    scoped_ptr<v8::ScriptData> data(
+        v8::ScriptData::PreCompile(GetV8String(isolate_, code)));
+    if (!data.get() || data->HasError())
+      return false;
+    cached_data->assign(data->Data(), data->Length());
+    return true;
+  }
+
+  size_t size() const { return scripts_.size(); }
+  int hit_count() const { return hit_count_; }
+
+ private:
+  struct Entry {
+    ~Entry() { script.Reset(); }
+    v8::Persistent<v8::Script> script;
+  };
+  typedef base::OwningMRUCache<std::string, Entry*> ScriptMap;
+
+  static std::string GetKey(const CefString& code,
+                            const CefString& script_url,
+                            int start_line) {
+    unsigned char hash[base::kSHA1Length];
+    base::SHA1HashBytes(reinterpret_cast<const unsigned char*>(code.c_str()),
+                        code.length() * sizeof(CefString::char_type), hash);
+    std::string key(reinterpret_cast<const char*>(hash), sizeof(hash));
+    key.append(script_url.ToString());
+    key.push_back(':');
+    key.append(base::IntToString(start_line));
+    return key;
+  }
+
+  v8::Isolate* isolate_;
+  ScriptMap scripts_;
+  int hit_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(CefV8ScriptCache);
+};
+
+void NotifyWrapperBudgetExceeded();
+
 // Manages memory and state information associated with a single Isolate.
 class CefV8IsolateManager {
  public:
   CefV8IsolateManager()
       : isolate_(v8::Isolate::GetCurrent()),
         task_runner_(CefContentRendererClient::Get()->GetCurrentTaskRunner()),
+        script_cache_(isolate_),
+        tracked_memory_(0),
+        persistent_handle_limit_(0),
+        tracked_memory_limit_(0),
+        budget_task_pending_(false),
+        budget_exceeded_(false),
         context_safety_impl_(IMPL_HASH),
+        global_manager_(CefTrackManager::SINGLE_THREADED),
         message_listener_registered_(false),
-        worker_id_(0) {
+        worker_id_(0),
+        weak_ptr_factory_(this) {
     DCHECK(isolate_);
     DCHECK(task_runner_.get());
 
@@ -77,6 +212,11 @@ class CefV8IsolateManager {
   ~CefV8IsolateManager() {
     DCHECK_EQ(isolate_, v8::Isolate::GetCurrent());
     DCHECK(context_map_.empty());
+
+    // Globally tracked objects are deleted after |weak_ptr_factory_| so don't
+    // check the budget while they are released.
+    persistent_handle_limit_ = 0;
+    tracked_memory_limit_ = 0;
   }
 
   scoped_refptr<CefV8ContextState> GetContextState(
@@ -136,6 +276,7 @@ class CefV8IsolateManager {
       int hash = context->Global()->GetIdentityHash();
       ContextMap::iterator it = context_map_.find(hash);
       if (it != context_map_.end()) {
+        ReleaseContextStats(it->second.get());
         it->second->Detach();
         context_map_.erase(it);
       }
@@ -149,6 +290,7 @@ class CefV8IsolateManager {
 
       scoped_refptr<CefV8ContextState> state =
           static_cast<CefV8ContextState*>(v8::External::Cast(*value)->Value());
+      ReleaseContextStats(state.get());
       state->Detach();
       object->DeleteHiddenValue(key);
 
@@ -167,6 +309,63 @@ class CefV8IsolateManager {
     global_manager_.Delete(object);
   }
 
+  int GetGlobalTrackObjectCount() {
+    return global_manager_.GetCount();
+  }
+
+  // Allocate and free the memory for V8TrackObject instances. One instance is
+  // created for every object and function created via the CEF API so use a
+  // slab allocator to avoid a system allocation for each.
+  // Instances are freed with CefTrackSlabAllocator::Free() which does not
+  // depend on this object, so instances that outlive the Isolate (for example,
+  // when owned by a CefV8Value that is released after a WebWorker thread's
+  // Isolate is destroyed) are still freed into a valid slab.
+  void* AllocateTrackObject(size_t size) {
+    DCHECK_EQ(isolate_, v8::Isolate::GetCurrent());
+    if (!track_object_allocator_.get())
+      track_object_allocator_ = new CefTrackSlabAllocator(size);
+    return track_object_allocator_->Allocate();
+  }
+
+  // Update the statistics for a handle of |type| that is being created
+  // (|delta| is 1) or destroyed (|delta| is -1). |context_state| may be NULL.
+  void UpdateHandleStats(CefV8ContextState* context_state,
+                         CefV8HandleBase::HandleType type,
+                         int delta) {
+    ApplyHandleDelta(&stats_, type, delta);
+    if (context_state)
+      ApplyHandleDelta(context_state->stats(), type, delta);
+  }
+
+  // Update the statistics for a handle that is being persisted (|delta| is 1)
+  // or released by V8 (|delta| is -1). |context_state| may be NULL.
+  void UpdatePersistentHandleStats(CefV8ContextState* context_state,
+                                   int delta) {
+    stats_.persistent_handle_count += delta;
+    if (context_state)
+      context_state->stats()->persistent_handle_count += delta;
+    CheckBudget();
+  }
+
+  // Register externally allocated memory that is kept alive by V8 objects.
+  void AdjustTrackedMemory(int64 change_in_bytes) {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
+    tracked_memory_ += change_in_bytes;
+    CheckBudget();
+  }
+
+  const CefV8WrapperStats& stats() const { return stats_; }
+  int64 tracked_memory() const { return tracked_memory_; }
+
+  // A limit of 0 disables the corresponding check.
+  void SetBudget(int persistent_handle_limit, int64 tracked_memory_limit) {
+    persistent_handle_limit_ = std::max(persistent_handle_limit, 0);
+    tracked_memory_limit_ =
+        std::max(tracked_memory_limit, static_cast<int64>(0));
+    budget_exceeded_ = false;
+    CheckBudget();
+  }
+
   void SetUncaughtExceptionStackSize(int stack_size) {
     if (stack_size <= 0)
       return;
@@ -190,6 +389,8 @@ class CefV8IsolateManager {
     return task_runner_;
   }
 
+  CefV8ScriptCache* script_cache() { return &script_cache_; }
+
   int worker_id() const {
     return worker_id_;
   }
@@ -199,8 +400,72 @@ class CefV8IsolateManager {
   }
 
  private:
+  static void ApplyHandleDelta(CefV8WrapperStats* stats,
+                               CefV8HandleBase::HandleType type,
+                               int delta) {
+    if (type == CefV8HandleBase::TYPE_VALUE)
+      stats->value_count += delta;
+    else
+      stats->context_count += delta;
+  }
+
+  // Persistent handles of a released context are no longer tracked.
+  void ReleaseContextStats(CefV8ContextState* context_state) {
+    stats_.persistent_handle_count -=
+        context_state->stats()->persistent_handle_count;
+    context_state->stats()->persistent_handle_count = 0;
+    CheckBudget();
+  }
+
+  bool IsOverBudget() const {
+    return (persistent_handle_limit_ > 0 &&
+            stats_.persistent_handle_count > persistent_handle_limit_) ||
+           (tracked_memory_limit_ > 0 &&
+            tracked_memory_ > tracked_memory_limit_);
+  }
+
+  void CheckBudget() {
+    if (!IsOverBudget()) {
+      // Notify again the next time the budget is exceeded.
+      budget_exceeded_ = false;
+      return;
+    }
+    if (budget_exceeded_ || budget_task_pending_)
+      return;
+
+    // This method may be called from V8 callbacks, including during garbage
+    // collection, so handle the budget asynchronously.
+    budget_task_pending_ = true;
+    task_runner_->PostTask(FROM_HERE,
+        base::Bind(&CefV8IsolateManager::OnBudgetExceeded,
+                   weak_ptr_factory_.GetWeakPtr()));
+  }
+
+  void OnBudgetExceeded() {
+    budget_task_pending_ = false;
+    if (!IsOverBudget())
+      return;
+
+    // Give V8 a chance to release weak handles before notifying the client.
+    v8::V8::LowMemoryNotification();
+    if (!IsOverBudget())
+      return;
+
+    budget_exceeded_ = true;
+    NotifyWrapperBudgetExceeded();
+  }
+
   v8::Isolate* isolate_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  CefV8ScriptCache script_cache_;
+
+  // Wrapper statistics and the optional budget.
+  CefV8WrapperStats stats_;
+  int64 tracked_memory_;
+  int persistent_handle_limit_;
+  int64 tracked_memory_limit_;
+  bool budget_task_pending_;
+  bool budget_exceeded_;
 
   enum ContextSafetyImpl {
     IMPL_DISABLED,
@@ -213,6 +478,9 @@ class CefV8IsolateManager {
   typedef std::map<int, scoped_refptr<CefV8ContextState> > ContextMap;
   ContextMap context_map_;
 
+  // Remains valid while any V8TrackObject is allocated.
+  scoped_refptr<CefTrackSlabAllocator> track_object_allocator_;
+
   // Used for globally tracked objects that are not associated with a particular
   // context.
   CefTrackManager global_manager_;
@@ -223,6 +491,8 @@ class CefV8IsolateManager {
   // Attributes associated with WebWorker threads.
   int worker_id_;
   GURL worker_url_;
+
+  base::WeakPtrFactory<CefV8IsolateManager> weak_ptr_factory_;
 };
 
 // Chromium uses the default Isolate for the main render process thread and a
@@ -252,6 +522,10 @@ public:
     return manager;
   }
 
+  bool HasIsolateManager() {
+    return current_tls_.Get() != NULL;
+  }
+
  private:
   base::ThreadLocalPointer<CefV8IsolateManager> current_tls_;
 };
@@ -262,18 +536,75 @@ CefV8IsolateManager* GetIsolateManager() {
   return g_v8_state.Pointer()->GetIsolateManager();
 }
 
+// Returns false if the Isolate for the current thread has been destroyed.
+// Wrappers that are released after that point must not access V8.
+bool HasIsolateManager() {
+  return g_v8_state.Pointer()->HasIsolateManager();
+}
+
+// State for a function created with CefV8Value::CreateFastFunction(). The
+// function name and signature are resolved once at creation time and the
+// argument storage is reused between calls.
+class V8FastFunction {
+ public:
+  V8FastFunction(const CefString& name, CefRefPtr<CefV8FastHandler> handler)
+      : name_(name),
+        handler_(handler),
+        return_type_(handler->GetReturnType()),
+        in_use_(false) {
+    size_t string_count = 0;
+    const int count = handler->GetArgumentCount();
+    for (int i = 0; i < count; ++i) {
+      cef_v8_fast_type_t type = handler->GetArgumentType(i);
+      DCHECK_NE(type, V8_FAST_TYPE_VOID);
+      if (type == V8_FAST_TYPE_STRING)
+        string_count++;
+      argument_types_.push_back(type);
+    }
+    numbers_.reserve(argument_types_.size() - string_count);
+    strings_.reserve(string_count);
+  }
+
+  // V8 function callback. |info.Data()| is the V8FastFunction.
+  static void Callback(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+ private:
+  CefString name_;
+  CefRefPtr<CefV8FastHandler> handler_;
+  std::vector<cef_v8_fast_type_t> argument_types_;
+  cef_v8_fast_type_t return_type_;
+
+  // Argument storage reused between calls. Nested calls use local storage.
+  std::vector<double> numbers_;
+  std::vector<CefString> strings_;
+  bool in_use_;
+
+  DISALLOW_COPY_AND_ASSIGN(V8FastFunction);
+};
+
 class V8TrackObject : public CefTrackNode {
  public:
   explicit V8TrackObject(v8::Isolate* isolate)
       : isolate_(isolate),
         external_memory_(0) {
     DCHECK(isolate_);
-    isolate_->AdjustAmountOfExternalAllocatedMemory(
+    GetIsolateManager()->AdjustTrackedMemory(
         static_cast<int>(sizeof(V8TrackObject)));
   }
   ~V8TrackObject() {
-    isolate_->AdjustAmountOfExternalAllocatedMemory(
-        -static_cast<int>(sizeof(V8TrackObject)) - external_memory_);
+    if (HasIsolateManager()) {
+      GetIsolateManager()->AdjustTrackedMemory(
+          -static_cast<int>(sizeof(V8TrackObject)) - external_memory_);
+    }
+  }
+
+  static void* operator new(size_t size) {
+    DCHECK_EQ(size, sizeof(V8TrackObject));
+    return GetIsolateManager()->AllocateTrackObject(size);
+  }
+
+  static void operator delete(void* object) {
+    CefTrackSlabAllocator::Free(object);
   }
 
   inline int GetExternallyAllocatedMemory() {
@@ -289,7 +620,7 @@ class V8TrackObject : public CefTrackNode {
     }
 
     if (change_in_bytes != 0)
-      isolate_->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
+      GetIsolateManager()->AdjustTrackedMemory(change_in_bytes);
     external_memory_ = new_value;
 
     return new_value;
@@ -311,6 +642,11 @@ class V8TrackObject : public CefTrackNode {
     return handler_;
   }
 
+  // Takes ownership of |fast_function|.
+  inline void SetFastFunction(V8FastFunction* fast_function) {
+    fast_function_.reset(fast_function);
+  }
+
   inline void SetUserData(CefRefPtr<CefBase> user_data) {
     user_data_ = user_data;
   }
@@ -342,10 +678,231 @@ class V8TrackObject : public CefTrackNode {
   v8::Isolate* isolate_;
   CefRefPtr<CefV8Accessor> accessor_;
   CefRefPtr<CefV8Handler> handler_;
+  scoped_ptr<V8FastFunction> fast_function_;
   CefRefPtr<CefBase> user_data_;
   int external_memory_;
 };
 
+// Returns the contents of |buffer| without copying.
+void* GetArrayBufferContents(v8::Isolate* isolate,
+                             v8::Handle<v8::ArrayBuffer> buffer) {
+  // V8 only exposes the contents of an ArrayBuffer by externalizing it. Let
+  // WebKit take ownership of the contents so that they remain valid for the
+  // lifetime of the ArrayBuffer object and it can still be passed to DOM
+  // methods.
+  WTF::ArrayBuffer* native = WebCore::V8ArrayBuffer::toNative(buffer);
+  return native ? native->data() : NULL;
+}
+
+// Maximum nesting depth for conversions between V8 values and base::Value
+// trees. Deeper objects are converted to null.
+const size_t kMaxConversionDepth = 100;
+
+// Objects on the current conversion path. Used to detect cycles.
+typedef std::vector<v8::Handle<v8::Object> > V8ObjectStack;
+
+base::Value* V8ValueToBaseValue(v8::Isolate* isolate,
+                                v8::Handle<v8::Value> value,
+                                V8ObjectStack* stack);
+
+// Returns true if |object| may be converted without creating a cycle or
+// exceeding the maximum depth.
+bool CanConvertV8Object(const V8ObjectStack& stack,
+                        v8::Handle<v8::Object> object) {
+  if (stack.size() >= kMaxConversionDepth)
+    return false;
+  for (size_t i = 0; i < stack.size(); ++i) {
+    if (stack[i] == object)
+      return false;
+  }
+  return true;
+}
+
+base::ListValue* V8ArrayToListValue(v8::Isolate* isolate,
+                                    v8::Handle<v8::Array> array,
+                                    V8ObjectStack* stack) {
+  base::ListValue* list = new base::ListValue();
+  stack->push_back(array);
+
+  uint32_t len = array->Length();
+  for (uint32_t i = 0; i < len; ++i) {
+    // Release the temporary handles created for each element.
+    v8::HandleScope handle_scope(isolate);
+    base::Value* child = V8ValueToBaseValue(isolate, array->Get(i), stack);
+    // Functions and undefined values are converted to null so that indexes
+    // are preserved.
+    list->Append(child ? child : base::Value::CreateNullValue());
+  }
+
+  stack->pop_back();
+  return list;
+}
+
+base::DictionaryValue* V8ObjectToDictionaryValue(v8::Isolate* isolate,
+                                                 v8::Handle<v8::Object> object,
+                                                 V8ObjectStack* stack) {
+  base::DictionaryValue* dictionary = new base::DictionaryValue();
+  stack->push_back(object);
+
+  v8::Local<v8::Array> keys = object->GetOwnPropertyNames();
+  uint32_t len = keys.IsEmpty() ? 0 : keys->Length();
+  for (uint32_t i = 0; i < len; ++i) {
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Value> key = keys->Get(i);
+    if (key.IsEmpty())
+      continue;
+    base::Value* child =
+        V8ValueToBaseValue(isolate, object->Get(key), stack);
+    if (!child)
+      continue;
+    v8::String::Utf8Value key_str(key);
+    dictionary->SetWithoutPathExpansion(
+        std::string(*key_str, key_str.length()), child);
+  }
+
+  stack->pop_back();
+  return dictionary;
+}
+
+// Returns a new base::Value tree for |value| or NULL if |value| is undefined
+// or a function. If a property getter throws the property is skipped and the
+// exception is left for the caller's TryCatch, which discards the result.
+base::Value* V8ValueToBaseValue(v8::Isolate* isolate,
+                                v8::Handle<v8::Value> value,
+                                V8ObjectStack* stack) {
+  if (value.IsEmpty() || value->IsUndefined() || value->IsFunction())
+    return NULL;
+  if (value->IsNull())
+    return base::Value::CreateNullValue();
+  if (value->IsBoolean())
+    return new base::FundamentalValue(value->BooleanValue());
+  if (value->IsInt32())
+    return new base::FundamentalValue(value->Int32Value());
+  if (value->IsNumber())
+    return new base::FundamentalValue(value->NumberValue());
+  if (value->IsString()) {
+    v8::String::Utf8Value str(value);
+    return new base::StringValue(std::string(*str, str.length()));
+  }
+  if (value->IsDate())
+    return new base::FundamentalValue(v8::Date::Cast(*value)->ValueOf());
+
+  if (value->IsArrayBuffer() || value->IsArrayBufferView()) {
+    v8::Handle<v8::ArrayBuffer> buffer;
+    size_t offset = 0;
+    size_t length = 0;
+    if (value->IsArrayBuffer()) {
+      buffer = v8::Handle<v8::ArrayBuffer>::Cast(value);
+      length = buffer->ByteLength();
+    } else {
+      v8::Handle<v8::ArrayBufferView> view =
+          v8::Handle<v8::ArrayBufferView>::Cast(value);
+      buffer = view->Buffer();
+      offset = view->ByteOffset();
+      length = view->ByteLength();
+    }
+    const char* data =
+        static_cast<const char*>(GetArrayBufferContents(isolate, buffer));
+    if (!data)
+      return base::BinaryValue::CreateWithCopiedBuffer(NULL, 0);
+    return base::BinaryValue::CreateWithCopiedBuffer(data + offset, length);
+  }
+
+  if (value->IsObject()) {
+    v8::Handle<v8::Object> object = value->ToObject();
+    if (!CanConvertV8Object(*stack, object))
+      return base::Value::CreateNullValue();
+    if (value->IsArray()) {
+      return V8ArrayToListValue(isolate, v8::Handle<v8::Array>::Cast(value),
+                                stack);
+    }
+    return V8ObjectToDictionaryValue(isolate, object, stack);
+  }
+
+  return NULL;
+}
+
+v8::Handle<v8::Value> BaseValueToV8Value(v8::Isolate* isolate,
+                                         const base::Value* value);
+
+v8::Handle<v8::Array> ListValueToV8Array(v8::Isolate* isolate,
+                                         const base::ListValue* list) {
+  v8::Local<v8::Array> array =
+      v8::Array::New(isolate, static_cast<int>(list->GetSize()));
+  uint32_t index = 0;
+  for (base::ListValue::const_iterator it = list->begin(); it != list->end();
+       ++it, ++index) {
+    array->Set(index, BaseValueToV8Value(isolate, *it));
+  }
+  return array;
+}
+
+v8::Handle<v8::Object> DictionaryValueToV8Object(
+    v8::Isolate* isolate,
+    const base::DictionaryValue* dictionary) {
+  v8::Local<v8::Object> object = v8::Object::New(isolate);
+  for (base::DictionaryValue::Iterator it(*dictionary); !it.IsAtEnd();
+       it.Advance()) {
+    const std::string& key = it.key();
+    object->Set(v8::String::NewFromUtf8(isolate, key.c_str(),
+                                        v8::String::kNormalString,
+                                        static_cast<int>(key.length())),
+                BaseValueToV8Value(isolate, &it.value()));
+  }
+  return object;
+}
+
+// Returns a new V8 value for |value|. base::Value trees cannot contain cycles
+// and are limited in depth by the code that creates them.
+v8::Handle<v8::Value> BaseValueToV8Value(v8::Isolate* isolate,
+                                         const base::Value* value) {
+  switch (value->GetType()) {
+    case base::Value::TYPE_BOOLEAN: {
+      bool bool_value = false;
+      value->GetAsBoolean(&bool_value);
+      return v8::Boolean::New(isolate, bool_value);
+    }
+    case base::Value::TYPE_INTEGER: {
+      int int_value = 0;
+      value->GetAsInteger(&int_value);
+      return v8::Int32::New(isolate, int_value);
+    }
+    case base::Value::TYPE_DOUBLE: {
+      double double_value = 0;
+      value->GetAsDouble(&double_value);
+      return v8::Number::New(isolate, double_value);
+    }
+    case base::Value::TYPE_STRING: {
+      std::string string_value;
+      value->GetAsString(&string_value);
+      return v8::String::NewFromUtf8(isolate, string_value.c_str(),
+                                     v8::String::kNormalString,
+                                     static_cast<int>(string_value.length()));
+    }
+    case base::Value::TYPE_BINARY: {
+      const base::BinaryValue* binary =
+          static_cast<const base::BinaryValue*>(value);
+      v8::Local<v8::ArrayBuffer> buffer =
+          v8::ArrayBuffer::New(isolate, binary->GetSize());
+      if (binary->GetSize() > 0) {
+        void* data = GetArrayBufferContents(isolate, buffer);
+        if (!data)
+          return v8::Null(isolate);
+        memcpy(data, binary->GetBuffer(), binary->GetSize());
+      }
+      return buffer;
+    }
+    case base::Value::TYPE_DICTIONARY:
+      return DictionaryValueToV8Object(
+          isolate, static_cast<const base::DictionaryValue*>(value));
+    case base::Value::TYPE_LIST:
+      return ListValueToV8Array(
+          isolate, static_cast<const base::ListValue*>(value));
+    default:
+      return v8::Null(isolate);
+  }
+}
+
 class V8TrackString : public CefTrackNode {
  public:
   explicit V8TrackString(const std::string& str) : string_(str) {}
@@ -369,8 +926,9 @@ class CefV8MakeWeakParam {
     DCHECK(isolate_);
     DCHECK(object_);
 
-    isolate_->AdjustAmountOfExternalAllocatedMemory(
+    GetIsolateManager()->AdjustTrackedMemory(
         static_cast<int>(sizeof(CefV8MakeWeakParam)));
+    GetIsolateManager()->UpdatePersistentHandleStats(context_state_.get(), 1);
 
     if (context_state_.get()) {
       // |object_| will be deleted when:
@@ -388,14 +946,19 @@ class CefV8MakeWeakParam {
   ~CefV8MakeWeakParam() {
     if (context_state_.get()) {
       // If the associated context is still valid then delete |object_|.
-      // Otherwise, |object_| will already have been deleted.
-      if (context_state_->IsValid())
+      // Otherwise, |object_| will already have been deleted and the statistics
+      // for the context will already have been released.
+      if (context_state_->IsValid()) {
         context_state_->DeleteTrackObject(object_);
+        GetIsolateManager()->UpdatePersistentHandleStats(context_state_.get(),
+                                                         -1);
+      }
     } else {
       GetIsolateManager()->DeleteGlobalTrackObject(object_);
+      GetIsolateManager()->UpdatePersistentHandleStats(NULL, -1);
     }
 
-    isolate_->AdjustAmountOfExternalAllocatedMemory(
+    GetIsolateManager()->AdjustTrackedMemory(
         -static_cast<int>(sizeof(CefV8MakeWeakParam)));
   }
 
@@ -531,6 +1094,95 @@ void FunctionCallbackImpl(const v8::FunctionCallbackInfo<v8::Value>& info) {
   info.GetReturnValue().SetUndefined();
 }
 
+// static
+void V8FastFunction::Callback(
+    const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::Isolate* isolate = info.GetIsolate();
+  WebCore::V8RecursionScope recursion_scope(
+      WebCore::toExecutionContext(isolate->GetCurrentContext()));
+
+  V8FastFunction* function =
+      static_cast<V8FastFunction*>(v8::External::Cast(*info.Data())->Value());
+
+  std::vector<double> local_numbers;
+  std::vector<CefString> local_strings;
+  std::vector<double>* numbers = &function->numbers_;
+  std::vector<CefString>* strings = &function->strings_;
+  if (function->in_use_) {
+    // The handler called the function again so the storage is still in use.
+    numbers = &local_numbers;
+    strings = &local_strings;
+  }
+  base::AutoReset<bool> in_use(&function->in_use_, true);
+  numbers->clear();
+  strings->clear();
+
+  {
+    // Converting an argument may execute script that throws.
+    v8::TryCatch try_catch;
+
+    const int argument_count =
+        static_cast<int>(function->argument_types_.size());
+    for (int i = 0; i < argument_count; ++i) {
+      const bool present = i < info.Length();
+      switch (function->argument_types_[i]) {
+        case V8_FAST_TYPE_BOOL:
+          numbers->push_back(present && info[i]->BooleanValue() ? 1 : 0);
+          break;
+        case V8_FAST_TYPE_INT:
+          numbers->push_back(present ? info[i]->Int32Value() : 0);
+          break;
+        case V8_FAST_TYPE_STRING:
+          strings->push_back(CefString());
+          if (present)
+            GetCefString(info[i]->ToString(), strings->back());
+          break;
+        default:
+          numbers->push_back(present ? info[i]->NumberValue() : 0);
+          break;
+      }
+    }
+
+    if (try_catch.HasCaught()) {
+      info.GetReturnValue().Set(try_catch.ReThrow());
+      return;
+    }
+  }
+
+  double number_retval = 0;
+  CefString string_retval;
+  CefString exception;
+
+  if (function->handler_->Execute(function->name_, *numbers, *strings,
+                                  number_retval, string_retval, exception)) {
+    if (!exception.empty()) {
+      info.GetReturnValue().Set(
+          isolate->ThrowException(
+              v8::Exception::Error(GetV8String(isolate, exception))));
+      return;
+    }
+
+    switch (function->return_type_) {
+      case V8_FAST_TYPE_BOOL:
+        info.GetReturnValue().Set(number_retval != 0);
+        return;
+      case V8_FAST_TYPE_INT:
+        info.GetReturnValue().Set(static_cast<int32_t>(number_retval));
+        return;
+      case V8_FAST_TYPE_DOUBLE:
+        info.GetReturnValue().Set(number_retval);
+        return;
+      case V8_FAST_TYPE_STRING:
+        info.GetReturnValue().Set(GetV8String(isolate, string_retval));
+        return;
+      default:
+        break;
+    }
+  }
+
+  info.GetReturnValue().SetUndefined();
+}
+
 // V8 Accessor callbacks
 void AccessorGetterCallbackImpl(
     v8::Local<v8::String> property,
@@ -730,6 +1382,77 @@ void MessageListenerCallbackImpl(v8::Handle<v8::Message> message,
   }
 }
 
+void SetWrapperStats(CefRefPtr<CefDictionaryValue> dict,
+                     const CefV8WrapperStats& stats,
+                     int tracked_object_count) {
+  dict->SetInt("values", stats.value_count);
+  dict->SetInt("contexts", stats.context_count);
+  dict->SetInt("persistent_handles", stats.persistent_handle_count);
+  dict->SetInt("tracked_objects", tracked_object_count);
+}
+
+// Returns the statistics for the current Isolate and, if |context_state| is
+// not NULL, for the associated context. See CefV8Context::GetStatistics().
+CefRefPtr<CefDictionaryValue> GetWrapperStatistics(
+    CefV8ContextState* context_state) {
+  CefV8IsolateManager* manager = GetIsolateManager();
+  CefRefPtr<CefDictionaryValue> statistics = CefDictionaryValue::Create();
+
+  if (context_state) {
+    CefRefPtr<CefDictionaryValue> context = CefDictionaryValue::Create();
+    SetWrapperStats(context, *context_state->stats(),
+                    context_state->GetTrackObjectCount());
+    statistics->SetDictionary("context", context);
+  }
+
+  CefRefPtr<CefDictionaryValue> isolate = CefDictionaryValue::Create();
+  SetWrapperStats(isolate, manager->stats(),
+                  manager->GetGlobalTrackObjectCount());
+  isolate->SetDouble("tracked_bytes",
+                     static_cast<double>(manager->tracked_memory()));
+  isolate->SetInt("precompiled_scripts",
+                  static_cast<int>(manager->script_cache()->size()));
+  isolate->SetInt("precompiled_script_runs",
+                  manager->script_cache()->hit_count());
+  statistics->SetDictionary("isolate", isolate);
+
+  v8::HeapStatistics heap_stats;
+  manager->isolate()->GetHeapStatistics(&heap_stats);
+  CefRefPtr<CefDictionaryValue> heap = CefDictionaryValue::Create();
+  heap->SetDouble("total_heap_size",
+                  static_cast<double>(heap_stats.total_heap_size()));
+  heap->SetDouble("total_heap_size_executable",
+                  static_cast<double>(heap_stats.total_heap_size_executable()));
+  heap->SetDouble("total_physical_size",
+                  static_cast<double>(heap_stats.total_physical_size()));
+  heap->SetDouble("used_heap_size",
+                  static_cast<double>(heap_stats.used_heap_size()));
+  heap->SetDouble("heap_size_limit",
+                  static_cast<double>(heap_stats.heap_size_limit()));
+  statistics->SetDictionary("heap", heap);
+
+  return statistics;
+}
+
+void NotifyWrapperBudgetExceeded() {
+  // CefRenderProcessHandler callbacks are only executed on the render process
+  // main thread.
+  if (!CEF_CURRENTLY_ON_RT())
+    return;
+
+  CefRefPtr<CefApp> application = CefContentClient::Get()->application();
+  if (!application.get())
+    return;
+
+  CefRefPtr<CefRenderProcessHandler> handler =
+      application->GetRenderProcessHandler();
+  if (!handler.get())
+    return;
+
+  v8::HandleScope handle_scope(GetIsolateManager()->isolate());
+  handler->OnV8WrapperBudgetExceeded(GetWrapperStatistics(NULL));
+}
+
 }  // namespace
 
 
@@ -755,6 +1478,51 @@ void CefV8SetWorkerAttributes(int worker_id, const GURL& worker_url) {
   GetIsolateManager()->SetWorkerAttributes(worker_id, worker_url);
 }
 
+bool CefV8RunPrecompiledScript(blink::WebFrame* frame,
+                               const CefString& code,
+                               const CefString& script_url,
+                               int start_line) {
+  // Don't hash |code| for every script execution unless scripts have been
+  // precompiled.
+  CefV8ScriptCache* script_cache = GetIsolateManager()->script_cache();
+  if (script_cache->size() == 0)
+    return false;
+
+  v8::Isolate* isolate = GetIsolateManager()->isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Script> script =
+      script_cache->GetScript(code, script_url, start_line);
+  if (script.IsEmpty())
+    return false;
+
+  v8::Local<v8::Context> context = frame->mainWorldScriptContext();
+  if (context.IsEmpty())
+    return true;
+  v8::Context::Scope context_scope(context);
+
+  // Run the script with the same checks and inspector instrumentation as
+  // WebKit's ScriptController.
+  RefPtr<WebCore::Frame> core_frame = WebCore::toFrameIfNotDetached(context);
+  if (!core_frame ||
+      !core_frame->script().canExecuteScripts(WebCore::AboutToExecuteScript)) {
+    return true;
+  }
+
+  std::string url = script_url.ToString();
+  WebCore::InspectorInstrumentationCookie cookie =
+      WebCore::InspectorInstrumentation::willEvaluateScript(
+          core_frame.get(), WTF::String::fromUTF8(url.c_str()), start_line);
+  {
+    // Exceptions are reported to the console via the message listeners.
+    v8::TryCatch try_catch;
+    try_catch.SetVerbose(true);
+    WebCore::V8ScriptRunner::runCompiledScript(script, core_frame->document(),
+                                               isolate);
+  }
+  WebCore::InspectorInstrumentation::didEvaluateScript(cookie);
+  return true;
+}
+
 bool CefRegisterExtension(const CefString& extension_name,
                           const CefString& javascript_code,
                           CefRefPtr<CefV8Handler> handler) {
@@ -828,6 +1596,8 @@ bool CefRegisterExtension(const CefString& extension_name,
 
 CefV8HandleBase::~CefV8HandleBase() {
   DCHECK(BelongsToCurrentThread());
+  if (HasIsolateManager())
+    GetIsolateManager()->UpdateHandleStats(context_state_.get(), type_, -1);
 }
 
 bool CefV8HandleBase::BelongsToCurrentThread() const {
@@ -835,8 +1605,10 @@ bool CefV8HandleBase::BelongsToCurrentThread() const {
 }
 
 CefV8HandleBase::CefV8HandleBase(v8::Isolate* isolate,
-                                 v8::Handle<v8::Context> context)
-    : isolate_(isolate) {
+                                 v8::Handle<v8::Context> context,
+                                 HandleType type)
+    : isolate_(isolate),
+      type_(type) {
   DCHECK(isolate_);
 
   CefV8IsolateManager* manager = GetIsolateManager();
@@ -845,6 +1617,7 @@ CefV8HandleBase::CefV8HandleBase(v8::Isolate* isolate,
 
   task_runner_ = manager->task_runner();
   context_state_ = manager->GetContextState(context);
+  manager->UpdateHandleStats(context_state_.get(), type_, 1);
 }
 
 
@@ -881,12 +1654,75 @@ bool CefV8Context::InContext() {
   return isolate->InContext();
 }
 
+// static
+void CefV8Context::SetWrapperBudget(int persistent_handle_limit,
+                                    int64 tracked_memory_limit) {
+  if (!CEF_V8_HAS_ISOLATE()) {
+    NOTREACHED() << "V8 isolate is not valid";
+    return;
+  }
+  GetIsolateManager()->SetBudget(persistent_handle_limit,
+                                 tracked_memory_limit);
+}
+
+// static
+bool CefV8Context::PrecompileScript(const CefString& code,
+                                    const CefString& script_url,
+                                    int start_line,
+                                    CefRefPtr<CefBinaryValue> cached_data) {
+  CEF_V8_REQUIRE_ISOLATE_RETURN(false);
+
+  if (code.empty()) {
+    NOTREACHED() << "invalid input parameter";
+    return false;
+  }
+
+  v8::Isolate* isolate = GetIsolateManager()->isolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  if (context.IsEmpty()) {
+    NOTREACHED() << "not currently in a V8 context";
+    return false;
+  }
+
+  std::string data;
+  if (cached_data.get() && cached_data->GetSize() > 0) {
+    data.resize(cached_data->GetSize());
+    cached_data->GetData(&data[0], data.size(), 0);
+  }
+
+  // Syntax errors are not reported.
+  v8::TryCatch try_catch;
+  return GetIsolateManager()->script_cache()->CompileScript(
+      code, script_url, std::max(start_line, 0), data.empty() ? NULL : &data);
+}
+
+// static
+CefRefPtr<CefBinaryValue> CefV8Context::GetScriptCacheData(
+    const CefString& code) {
+  CEF_V8_REQUIRE_ISOLATE_RETURN(NULL);
+
+  if (code.empty()) {
+    NOTREACHED() << "invalid input parameter";
+    return NULL;
+  }
+
+  // Pre-parsing does not require a context.
+  v8::HandleScope handle_scope(GetIsolateManager()->isolate());
+
+  std::string data;
+  if (!GetIsolateManager()->script_cache()->GetCachedData(code, &data))
+    return NULL;
+  return CefBinaryValue::Create(data.data(), data.size());
+}
+
 
 // CefV8ContextImpl
 
 CefV8ContextImpl::CefV8ContextImpl(v8::Isolate* isolate,
                                    v8::Handle<v8::Context> context)
-  : handle_(new Handle(isolate, context, context))
+  : handle_(new Handle(isolate, context, context, Handle::TYPE_CONTEXT))
 #ifndef NDEBUG
     , enter_count_(0)
 #endif
@@ -1028,6 +1864,15 @@ bool CefV8ContextImpl::Eval(const CefString& code,
   return true;
 }
 
+CefRefPtr<CefDictionaryValue> CefV8ContextImpl::GetStatistics() {
+  CEF_V8_REQUIRE_VALID_HANDLE_RETURN(NULL);
+
+  v8::HandleScope handle_scope(handle_->isolate());
+  scoped_refptr<CefV8ContextState> context_state =
+      GetIsolateManager()->GetContextState(GetV8Context());
+  return GetWrapperStatistics(context_state.get());
+}
+
 v8::Handle<v8::Context> CefV8ContextImpl::GetV8Context() {
   return handle_->GetNewV8Handle();
 }
@@ -1044,6 +1889,15 @@ blink::WebFrame* CefV8ContextImpl::GetWebFrame() {
 // CefV8ValueImpl::Handle
 
 CefV8ValueImpl::Handle::~Handle() {
+  if (!HasIsolateManager()) {
+    // The Isolate has been destroyed so the V8 handle no longer exists. Only
+    // release the tracked object.
+    if (tracker_)
+      delete tracker_;
+    tracker_ = NULL;
+    return;
+  }
+
   // Persist the handle (call MakeWeak) if:
   // A. The handle has been passed into a V8 function or used as a return value
   //    from a V8 callback, and
@@ -1249,6 +2103,171 @@ CefRefPtr<CefV8Value> CefV8Value::CreateFunction(
   return impl.get();
 }
 
+// static
+CefRefPtr<CefV8Value> CefV8Value::CreateFastFunction(
+    const CefString& name,
+    CefRefPtr<CefV8FastHandler> handler) {
+  CEF_V8_REQUIRE_ISOLATE_RETURN(NULL);
+
+  if (!handler.get()) {
+    NOTREACHED() << "invalid parameter";
+    return NULL;
+  }
+
+  v8::Isolate* isolate = GetIsolateManager()->isolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  if (context.IsEmpty()) {
+    NOTREACHED() << "not currently in a V8 context";
+    return NULL;
+  }
+
+  // Resolve the function name and signature once.
+  scoped_ptr<V8FastFunction> fast_function(new V8FastFunction(name, handler));
+
+  // Create a new V8 function template.
+  v8::Local<v8::FunctionTemplate> tmpl = v8::FunctionTemplate::New(isolate);
+
+  v8::Local<v8::Value> data = v8::External::New(isolate, fast_function.get());
+
+  // Set the function handler callback.
+  tmpl->SetCallHandler(V8FastFunction::Callback, data);
+
+  // Retrieve the function object and set the name.
+  v8::Local<v8::Function> func = tmpl->GetFunction();
+  if (func.IsEmpty()) {
+    NOTREACHED() << "failed to create V8 function";
+    return NULL;
+  }
+
+  func->SetName(GetV8String(isolate, name));
+
+  // Create a tracker object that will cause the function state and handler
+  // reference to be released when the V8 object is destroyed.
+  V8TrackObject* tracker = new V8TrackObject(isolate);
+  tracker->SetFastFunction(fast_function.release());
+
+  // Attach the tracker object.
+  tracker->AttachTo(func);
+
+  CefRefPtr<CefV8ValueImpl> impl = new CefV8ValueImpl(isolate);
+  impl->InitObject(func, tracker);
+  return impl.get();
+}
+// static
+CefRefPtr<CefV8Value> CefV8Value::CreateArrayBuffer(size_t length) {
+  CEF_V8_REQUIRE_ISOLATE_RETURN(NULL);
+
+  // WebKit ArrayBuffer sizes are limited to 32 bits.
+  if (length > static_cast<size_t>(kint32max)) {
+    NOTREACHED() << "invalid parameter";
+    return NULL;
+  }
+
+  v8::Isolate* isolate = GetIsolateManager()->isolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  if (context.IsEmpty()) {
+    NOTREACHED() << "not currently in a V8 context";
+    return NULL;
+  }
+
+  // The contents are allocated and owned by WebKit so that the object can be
+  // passed to any DOM method. The client fills them in place through
+  // GetArrayBufferData().
+  v8::Local<v8::ArrayBuffer> array_buffer =
+      v8::ArrayBuffer::New(isolate, length);
+  if (length > 0 && !GetArrayBufferContents(isolate, array_buffer)) {
+    NOTREACHED() << "failed to allocate ArrayBuffer contents";
+    return NULL;
+  }
+
+  CefRefPtr<CefV8ValueImpl> impl = new CefV8ValueImpl(isolate);
+  impl->InitObject(array_buffer, NULL);
+  return impl.get();
+}
+
+// static
+CefRefPtr<CefV8Value> CefV8Value::CreateFromDictionary(
+    CefRefPtr<CefDictionaryValue> value) {
+  CEF_V8_REQUIRE_ISOLATE_RETURN(NULL);
+
+  if (!value.get() || !value->IsValid()) {
+    NOTREACHED() << "invalid parameter";
+    return NULL;
+  }
+
+  v8::Isolate* isolate = GetIsolateManager()->isolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  if (context.IsEmpty()) {
+    NOTREACHED() << "not currently in a V8 context";
+    return NULL;
+  }
+
+  CefDictionaryValueInternal* internal =
+      static_cast<CefDictionaryValueInternal*>(value.get());
+  v8::Handle<v8::Object> obj;
+  CefDictionaryValueImpl* value_impl = internal->AsImpl();
+  if (value_impl) {
+    // Convert the value directly instead of converting a copy.
+    CefDictionaryValueImpl::ScopedReadLock lock(value_impl);
+    if (!lock.value())
+      return NULL;
+    obj = DictionaryValueToV8Object(isolate, lock.value());
+  } else {
+    // Packed values are not backed by a base::Value.
+    scoped_ptr<base::DictionaryValue> copy(internal->CopyValue());
+    obj = DictionaryValueToV8Object(isolate, copy.get());
+  }
+
+  CefRefPtr<CefV8ValueImpl> impl = new CefV8ValueImpl(isolate);
+  impl->InitObject(obj, NULL);
+  return impl.get();
+}
+
+// static
+CefRefPtr<CefV8Value> CefV8Value::CreateFromList(
+    CefRefPtr<CefListValue> value) {
+  CEF_V8_REQUIRE_ISOLATE_RETURN(NULL);
+
+  if (!value.get() || !value->IsValid()) {
+    NOTREACHED() << "invalid parameter";
+    return NULL;
+  }
+
+  v8::Isolate* isolate = GetIsolateManager()->isolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  if (context.IsEmpty()) {
+    NOTREACHED() << "not currently in a V8 context";
+    return NULL;
+  }
+
+  CefListValueInternal* internal =
+      static_cast<CefListValueInternal*>(value.get());
+  v8::Handle<v8::Array> arr;
+  CefListValueImpl* value_impl = internal->AsImpl();
+  if (value_impl) {
+    // Convert the value directly instead of converting a copy.
+    CefListValueImpl::ScopedReadLock lock(value_impl);
+    if (!lock.value())
+      return NULL;
+    arr = ListValueToV8Array(isolate, lock.value());
+  } else {
+    // Packed values are not backed by a base::Value.
+    scoped_ptr<base::ListValue> copy(internal->CopyValue());
+    arr = ListValueToV8Array(isolate, copy.get());
+  }
+
+  CefRefPtr<CefV8ValueImpl> impl = new CefV8ValueImpl(isolate);
+  impl->InitObject(arr, NULL);
+  return impl.get();
+}
 
 // CefV8ValueImpl
 
@@ -1467,6 +2486,26 @@ bool CefV8ValueImpl::IsFunction() {
   }
 }
 
+bool CefV8ValueImpl::IsArrayBuffer() {
+  CEF_V8_REQUIRE_MLT_RETURN(false);
+  if (type_ == TYPE_OBJECT) {
+    v8::HandleScope handle_scope(handle_->isolate());
+    return handle_->GetNewV8Handle(false)->IsArrayBuffer();
+  } else {
+    return false;
+  }
+}
+
+bool CefV8ValueImpl::IsTypedArray() {
+  CEF_V8_REQUIRE_MLT_RETURN(false);
+  if (type_ == TYPE_OBJECT) {
+    v8::HandleScope handle_scope(handle_->isolate());
+    return handle_->GetNewV8Handle(false)->IsTypedArray();
+  } else {
+    return false;
+  }
+}
+
 bool CefV8ValueImpl::IsSame(CefRefPtr<CefV8Value> that) {
   CEF_V8_REQUIRE_MLT_RETURN(false);
 
@@ -1785,6 +2824,44 @@ bool CefV8ValueImpl::GetKeys(std::vector<CefString>& keys) {
   return true;
 }
 
+CefRefPtr<CefDictionaryValue> CefV8ValueImpl::ToDictionary() {
+  CEF_V8_REQUIRE_OBJECT_RETURN(NULL);
+
+  v8::Isolate* isolate = handle_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Handle<v8::Value> value = handle_->GetNewV8Handle(false);
+  if (value->IsArray())
+    return NULL;
+
+  v8::TryCatch try_catch;
+  try_catch.SetVerbose(true);
+  V8ObjectStack stack;
+  scoped_ptr<base::DictionaryValue> dictionary(
+      V8ObjectToDictionaryValue(isolate, value->ToObject(), &stack));
+  if (HasCaught(try_catch))
+    return NULL;
+  return new CefDictionaryValueImpl(dictionary.release(), true, false);
+}
+
+CefRefPtr<CefListValue> CefV8ValueImpl::ToList() {
+  CEF_V8_REQUIRE_OBJECT_RETURN(NULL);
+
+  v8::Isolate* isolate = handle_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Handle<v8::Value> value = handle_->GetNewV8Handle(false);
+  if (!value->IsArray())
+    return NULL;
+
+  v8::TryCatch try_catch;
+  try_catch.SetVerbose(true);
+  V8ObjectStack stack;
+  scoped_ptr<base::ListValue> list(
+      V8ArrayToListValue(isolate, v8::Handle<v8::Array>::Cast(value), &stack));
+  if (HasCaught(try_catch))
+    return NULL;
+  return new CefListValueImpl(list.release(), true, false);
+}
+
 bool CefV8ValueImpl::SetUserData(CefRefPtr<CefBase> user_data) {
   CEF_V8_REQUIRE_OBJECT_RETURN(false);
 
@@ -1862,6 +2939,50 @@ int CefV8ValueImpl::GetArrayLength() {
   return arr->Length();
 }
 
+void* CefV8ValueImpl::GetArrayBufferData() {
+  CEF_V8_REQUIRE_OBJECT_RETURN(NULL);
+
+  v8::Isolate* isolate = handle_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Handle<v8::Value> value = handle_->GetNewV8Handle(false);
+
+  v8::Handle<v8::ArrayBuffer> buffer;
+  size_t offset = 0;
+  size_t length = 0;
+  if (value->IsArrayBuffer()) {
+    buffer = v8::Handle<v8::ArrayBuffer>::Cast(value);
+    length = buffer->ByteLength();
+  } else if (value->IsTypedArray()) {
+    v8::Handle<v8::TypedArray> array = v8::Handle<v8::TypedArray>::Cast(value);
+    buffer = array->Buffer();
+    offset = array->ByteOffset();
+    length = array->ByteLength();
+  } else {
+    NOTREACHED() << "V8 value is not an ArrayBuffer or typed array";
+    return NULL;
+  }
+
+  if (length == 0)
+    return NULL;
+
+  char* data = static_cast<char*>(GetArrayBufferContents(isolate, buffer));
+  return data ? data + offset : NULL;
+}
+
+size_t CefV8ValueImpl::GetArrayBufferByteLength() {
+  CEF_V8_REQUIRE_OBJECT_RETURN(0);
+
+  v8::HandleScope handle_scope(handle_->isolate());
+  v8::Handle<v8::Value> value = handle_->GetNewV8Handle(false);
+  if (value->IsArrayBuffer())
+    return v8::Handle<v8::ArrayBuffer>::Cast(value)->ByteLength();
+  if (value->IsTypedArray())
+    return v8::Handle<v8::TypedArray>::Cast(value)->ByteLength();
+
+  NOTREACHED() << "V8 value is not an ArrayBuffer or typed array";
+  return 0;
+}
+
 CefString CefV8ValueImpl::GetFunctionName() {
   CefString rv;
   CEF_V8_REQUIRE_OBJECT_RETURN(rv);
@@ -39,13 +39,44 @@ void CefV8SetUncaughtExceptionStackSize(int stack_size);
 // Set attributes associated with a WebWorker thread.
 void CefV8SetWorkerAttributes(int worker_id, const GURL& worker_url);
 
+// Run |code| in the main world context of |frame| if it was compiled with
+// CefV8Context::PrecompileScript(). Returns false if |code| has not been
+// precompiled, in which case the caller should execute it with
+// WebFrame::executeScript().
+bool CefV8RunPrecompiledScript(blink::WebFrame* frame,
+                               const CefString& code,
+                               const CefString& script_url,
+                               int start_line);
+
+// Counts of V8 wrapper objects associated with an Isolate or a context. Only
+// accessed on the thread that owns the Isolate.
+struct CefV8WrapperStats {
+  CefV8WrapperStats()
+      : value_count(0),
+        context_count(0),
+        persistent_handle_count(0) {
+  }
+
+  // Live CefV8ValueImpl objects that reference a V8 object.
+  int value_count;
+  // Live CefV8ContextImpl objects.
+  int context_count;
+  // Handles that were kept alive after the CefV8ValueImpl was released because
+  // the value was passed into V8.
+  int persistent_handle_count;
+};
+
 // Used to detach handles when the associated context is released.
 class CefV8ContextState : public base::RefCounted<CefV8ContextState> {
  public:
-  CefV8ContextState() : valid_(true) {}
+  CefV8ContextState()
+      : valid_(true),
+        track_manager_(CefTrackManager::SINGLE_THREADED) {}
   virtual ~CefV8ContextState() {}
 
   bool IsValid() { return valid_; }
+  CefV8WrapperStats* stats() { return &stats_; }
+  int GetTrackObjectCount() { return track_manager_.GetCount(); }
   void Detach() {
     DCHECK(valid_);
     valid_ = false;
@@ -65,6 +96,7 @@ class CefV8ContextState : public base::RefCounted<CefV8ContextState> {
  private:
   bool valid_;
   CefTrackManager track_manager_;
+  CefV8WrapperStats stats_;
 };
 
 
@@ -100,6 +132,12 @@ class CefV8HandleBase :
     return (!context_state_.get() || context_state_->IsValid());
   }
 
+  // The type of wrapper object that owns the handle. Used for statistics.
+  enum HandleType {
+    TYPE_CONTEXT,
+    TYPE_VALUE,
+  };
+
   bool BelongsToCurrentThread() const;
 
   v8::Isolate* isolate() const { return isolate_; }
@@ -111,12 +149,14 @@ class CefV8HandleBase :
   // |context| is the context that owns this handle. If empty the current
   // context will be used.
   CefV8HandleBase(v8::Isolate* isolate,
-                  v8::Handle<v8::Context> context);
+                  v8::Handle<v8::Context> context,
+                  HandleType type);
 
  protected:
   v8::Isolate* isolate_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   scoped_refptr<CefV8ContextState> context_state_;
+  HandleType type_;
 };
 
 // Template for V8 Handle types. This class is used to ensure that V8 objects
@@ -129,8 +169,9 @@ class CefV8Handle : public CefV8HandleBase {
 
   CefV8Handle(v8::Isolate* isolate,
               v8::Handle<v8::Context> context,
-              handleType v)
-      : CefV8HandleBase(isolate, context),
+              handleType v,
+              HandleType type)
+      : CefV8HandleBase(isolate, context, type),
         handle_(isolate, v) {
   }
   virtual ~CefV8Handle() {
@@ -176,6 +217,7 @@ class CefV8ContextImpl : public CefV8Context {
   virtual bool Eval(const CefString& code,
                     CefRefPtr<CefV8Value>& retval,
                     CefRefPtr<CefV8Exception>& exception) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> GetStatistics() OVERRIDE;
 
   v8::Handle<v8::Context> GetV8Context();
   blink::WebFrame* GetWebFrame();
@@ -229,6 +271,8 @@ class CefV8ValueImpl : public CefV8Value {
   virtual bool IsObject() OVERRIDE;
   virtual bool IsArray() OVERRIDE;
   virtual bool IsFunction() OVERRIDE;
+  virtual bool IsArrayBuffer() OVERRIDE;
+  virtual bool IsTypedArray() OVERRIDE;
   virtual bool IsSame(CefRefPtr<CefV8Value> value) OVERRIDE;
   virtual bool GetBoolValue() OVERRIDE;
   virtual int32 GetIntValue() OVERRIDE;
@@ -254,11 +298,15 @@ class CefV8ValueImpl : public CefV8Value {
   virtual bool SetValue(const CefString& key, AccessControl settings,
                         PropertyAttribute attribute) OVERRIDE;
   virtual bool GetKeys(std::vector<CefString>& keys) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> ToDictionary() OVERRIDE;
+  virtual CefRefPtr<CefListValue> ToList() OVERRIDE;
   virtual bool SetUserData(CefRefPtr<CefBase> user_data) OVERRIDE;
   virtual CefRefPtr<CefBase> GetUserData() OVERRIDE;
   virtual int GetExternallyAllocatedMemory() OVERRIDE;
   virtual int AdjustExternallyAllocatedMemory(int change_in_bytes) OVERRIDE;
   virtual int GetArrayLength() OVERRIDE;
+  virtual void* GetArrayBufferData() OVERRIDE;
+  virtual size_t GetArrayBufferByteLength() OVERRIDE;
   virtual CefString GetFunctionName() OVERRIDE;
   virtual CefRefPtr<CefV8Handler> GetFunctionHandler() OVERRIDE;
   virtual CefRefPtr<CefV8Value> ExecuteFunction(
@@ -282,7 +330,7 @@ class CefV8ValueImpl : public CefV8Value {
            v8::Handle<v8::Context> context,
            handleType v,
            CefTrackNode* tracker)
-        : CefV8HandleBase(isolate, context),
+        : CefV8HandleBase(isolate, context, TYPE_VALUE),
           handle_(isolate, v),
           tracker_(tracker),
           should_persist_(false) {
@@ -355,6 +355,36 @@ int CEF_CALLBACK browser_send_process_message(struct _cef_browser_t* self,
   return _retval;
 }
 
+int CEF_CALLBACK browser_send_process_messages(struct _cef_browser_t* self,
+    cef_process_id_t target_process, size_t messagesCount,
+    struct _cef_process_message_t* const* messages) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+  // Verify param: messages; type: refptr_vec_same_byref_const
+  DCHECK(messagesCount == 0 || messages);
+  if (messagesCount > 0 && !messages)
+    return 0;
+
+  // Translate param: messages; type: refptr_vec_same_byref_const
+  std::vector<CefRefPtr<CefProcessMessage> > messagesList;
+  if (messagesCount > 0) {
+    for (size_t i = 0; i < messagesCount; ++i) {
+      messagesList.push_back(CefProcessMessageCppToC::Unwrap(messages[i]));
+    }
+  }
+
+  // Execute
+  bool _retval = CefBrowserCppToC::Get(self)->SendProcessMessages(
+      target_process,
+      messagesList);
+
+  // Return type: bool
+  return _retval;
+}
+
 
 // CONSTRUCTOR - Do not edit by hand.
 
@@ -381,6 +411,7 @@ CefBrowserCppToC::CefBrowserCppToC(CefBrowser* cls)
   struct_.struct_.get_frame_identifiers = browser_get_frame_identifiers;
   struct_.struct_.get_frame_names = browser_get_frame_names;
   struct_.struct_.send_process_message = browser_send_process_message;
+  struct_.struct_.send_process_messages = browser_send_process_messages;
 }
 
 #ifndef NDEBUG
@@ -469,6 +469,61 @@ void CEF_CALLBACK browser_host_invalidate(struct _cef_browser_host_t* self,
       type);
 }
 
+int64 CEF_CALLBACK browser_host_get_paint_delivered_bytes(
+    struct _cef_browser_host_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  int64 _retval = CefBrowserHostCppToC::Get(self)->GetPaintDeliveredBytes();
+
+  // Return type: simple
+  return _retval;
+}
+
+int64 CEF_CALLBACK browser_host_get_paint_view_bytes(
+    struct _cef_browser_host_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  int64 _retval = CefBrowserHostCppToC::Get(self)->GetPaintViewBytes();
+
+  // Return type: simple
+  return _retval;
+}
+
+void CEF_CALLBACK browser_host_set_windowless_frame_rate(
+    struct _cef_browser_host_t* self, int frame_rate) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return;
+
+  // Execute
+  CefBrowserHostCppToC::Get(self)->SetWindowlessFrameRate(
+      frame_rate);
+}
+
+void CEF_CALLBACK browser_host_flush_windowless_paint(
+    struct _cef_browser_host_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return;
+
+  // Execute
+  CefBrowserHostCppToC::Get(self)->FlushWindowlessPaint();
+}
+
 void CEF_CALLBACK browser_host_send_key_event(struct _cef_browser_host_t* self,
     const struct _cef_key_event_t* event) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -666,6 +721,12 @@ CefBrowserHostCppToC::CefBrowserHostCppToC(CefBrowserHost* cls)
   struct_.struct_.notify_screen_info_changed =
       browser_host_notify_screen_info_changed;
   struct_.struct_.invalidate = browser_host_invalidate;
+  struct_.struct_.get_paint_delivered_bytes =
+      browser_host_get_paint_delivered_bytes;
+  struct_.struct_.get_paint_view_bytes = browser_host_get_paint_view_bytes;
+  struct_.struct_.set_windowless_frame_rate =
+      browser_host_set_windowless_frame_rate;
+  struct_.struct_.flush_windowless_paint = browser_host_flush_windowless_paint;
   struct_.struct_.send_key_event = browser_host_send_key_event;
   struct_.struct_.send_mouse_click_event = browser_host_send_mouse_click_event;
   struct_.struct_.send_mouse_move_event = browser_host_send_mouse_move_event;
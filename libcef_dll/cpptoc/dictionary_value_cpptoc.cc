@@ -93,6 +93,22 @@ struct _cef_dictionary_value_t* CEF_CALLBACK dictionary_value_copy(
   return CefDictionaryValueCppToC::Wrap(_retval);
 }
 
+struct _cef_dictionary_value_t* CEF_CALLBACK dictionary_value_create_snapshot(
+    struct _cef_dictionary_value_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefDictionaryValue> _retval = CefDictionaryValueCppToC::Get(
+      self)->CreateSnapshot();
+
+  // Return type: refptr_same
+  return CefDictionaryValueCppToC::Wrap(_retval);
+}
+
 size_t CEF_CALLBACK dictionary_value_get_size(
     struct _cef_dictionary_value_t* self) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -190,6 +206,69 @@ int CEF_CALLBACK dictionary_value_remove(struct _cef_dictionary_value_t* self,
   return _retval;
 }
 
+cef_binary_value_t* CEF_CALLBACK dictionary_value_detach_binary(
+    struct _cef_dictionary_value_t* self, const cef_string_t* key) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+  // Verify param: key; type: string_byref_const
+  DCHECK(key);
+  if (!key)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefBinaryValue> _retval = CefDictionaryValueCppToC::Get(
+      self)->DetachBinary(
+      CefString(key));
+
+  // Return type: refptr_same
+  return CefBinaryValueCppToC::Wrap(_retval);
+}
+
+struct _cef_dictionary_value_t* CEF_CALLBACK dictionary_value_detach_dictionary(
+    struct _cef_dictionary_value_t* self, const cef_string_t* key) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+  // Verify param: key; type: string_byref_const
+  DCHECK(key);
+  if (!key)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefDictionaryValue> _retval = CefDictionaryValueCppToC::Get(
+      self)->DetachDictionary(
+      CefString(key));
+
+  // Return type: refptr_same
+  return CefDictionaryValueCppToC::Wrap(_retval);
+}
+
+struct _cef_list_value_t* CEF_CALLBACK dictionary_value_detach_list(
+    struct _cef_dictionary_value_t* self, const cef_string_t* key) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+  // Verify param: key; type: string_byref_const
+  DCHECK(key);
+  if (!key)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefListValue> _retval = CefDictionaryValueCppToC::Get(
+      self)->DetachList(
+      CefString(key));
+
+  // Return type: refptr_same
+  return CefListValueCppToC::Wrap(_retval);
+}
+
 cef_value_type_t CEF_CALLBACK dictionary_value_get_type(
     struct _cef_dictionary_value_t* self, const cef_string_t* key) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -547,11 +626,15 @@ CefDictionaryValueCppToC::CefDictionaryValueCppToC(CefDictionaryValue* cls)
   struct_.struct_.is_owned = dictionary_value_is_owned;
   struct_.struct_.is_read_only = dictionary_value_is_read_only;
   struct_.struct_.copy = dictionary_value_copy;
+  struct_.struct_.create_snapshot = dictionary_value_create_snapshot;
   struct_.struct_.get_size = dictionary_value_get_size;
   struct_.struct_.clear = dictionary_value_clear;
   struct_.struct_.has_key = dictionary_value_has_key;
   struct_.struct_.get_keys = dictionary_value_get_keys;
   struct_.struct_.remove = dictionary_value_remove;
+  struct_.struct_.detach_binary = dictionary_value_detach_binary;
+  struct_.struct_.detach_dictionary = dictionary_value_detach_dictionary;
+  struct_.struct_.detach_list = dictionary_value_detach_list;
   struct_.struct_.get_type = dictionary_value_get_type;
   struct_.struct_.get_bool = dictionary_value_get_bool;
   struct_.struct_.get_int = dictionary_value_get_int;
@@ -87,6 +87,22 @@ struct _cef_list_value_t* CEF_CALLBACK list_value_copy(
   return CefListValueCppToC::Wrap(_retval);
 }
 
+struct _cef_list_value_t* CEF_CALLBACK list_value_create_snapshot(
+    struct _cef_list_value_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefListValue> _retval = CefListValueCppToC::Get(
+      self)->CreateSnapshot();
+
+  // Return type: refptr_same
+  return CefListValueCppToC::Wrap(_retval);
+}
+
 int CEF_CALLBACK list_value_set_size(struct _cef_list_value_t* self,
     size_t size) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -150,6 +166,68 @@ int CEF_CALLBACK list_value_remove(struct _cef_list_value_t* self, int index) {
   return _retval;
 }
 
+cef_binary_value_t* CEF_CALLBACK list_value_detach_binary(
+    struct _cef_list_value_t* self, int index) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+  // Verify param: index; type: simple_byval
+  DCHECK_GE(index, 0);
+  if (index < 0)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefBinaryValue> _retval = CefListValueCppToC::Get(
+      self)->DetachBinary(
+      index);
+
+  // Return type: refptr_same
+  return CefBinaryValueCppToC::Wrap(_retval);
+}
+
+cef_dictionary_value_t* CEF_CALLBACK list_value_detach_dictionary(
+    struct _cef_list_value_t* self, int index) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+  // Verify param: index; type: simple_byval
+  DCHECK_GE(index, 0);
+  if (index < 0)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefDictionaryValue> _retval = CefListValueCppToC::Get(
+      self)->DetachDictionary(
+      index);
+
+  // Return type: refptr_same
+  return CefDictionaryValueCppToC::Wrap(_retval);
+}
+
+struct _cef_list_value_t* CEF_CALLBACK list_value_detach_list(
+    struct _cef_list_value_t* self, int index) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+  // Verify param: index; type: simple_byval
+  DCHECK_GE(index, 0);
+  if (index < 0)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefListValue> _retval = CefListValueCppToC::Get(self)->DetachList(
+      index);
+
+  // Return type: refptr_same
+  return CefListValueCppToC::Wrap(_retval);
+}
+
 cef_value_type_t CEF_CALLBACK list_value_get_type(
     struct _cef_list_value_t* self, int index) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -499,10 +577,14 @@ CefListValueCppToC::CefListValueCppToC(CefListValue* cls)
   struct_.struct_.is_owned = list_value_is_owned;
   struct_.struct_.is_read_only = list_value_is_read_only;
   struct_.struct_.copy = list_value_copy;
+  struct_.struct_.create_snapshot = list_value_create_snapshot;
   struct_.struct_.set_size = list_value_set_size;
   struct_.struct_.get_size = list_value_get_size;
   struct_.struct_.clear = list_value_clear;
   struct_.struct_.remove = list_value_remove;
+  struct_.struct_.detach_binary = list_value_detach_binary;
+  struct_.struct_.detach_dictionary = list_value_detach_dictionary;
+  struct_.struct_.detach_list = list_value_detach_list;
   struct_.struct_.get_type = list_value_get_type;
   struct_.struct_.get_bool = list_value_get_bool;
   struct_.struct_.get_int = list_value_get_int;
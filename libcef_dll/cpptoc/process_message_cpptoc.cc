@@ -112,6 +112,97 @@ struct _cef_list_value_t* CEF_CALLBACK process_message_get_argument_list(
   return CefListValueCppToC::Wrap(_retval);
 }
 
+void CEF_CALLBACK process_message_set_argument_list_packed(
+    struct _cef_process_message_t* self, int packed) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return;
+
+  // Execute
+  CefProcessMessageCppToC::Get(self)->SetArgumentListPacked(
+      packed?true:false);
+}
+
+int CEF_CALLBACK process_message_is_argument_list_packed(
+    struct _cef_process_message_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  bool _retval = CefProcessMessageCppToC::Get(self)->IsArgumentListPacked();
+
+  // Return type: bool
+  return _retval;
+}
+
+void* CEF_CALLBACK process_message_create_shared_memory(
+    struct _cef_process_message_t* self, size_t size) {
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  void* _retval = CefProcessMessageCppToC::Get(self)->CreateSharedMemory(
+      size);
+
+  // Return type: simple_byaddr
+  return _retval;
+}
+
+void* CEF_CALLBACK process_message_get_shared_memory(
+    struct _cef_process_message_t* self) {
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  void* _retval = CefProcessMessageCppToC::Get(self)->GetSharedMemory();
+
+  // Return type: simple_byaddr
+  return _retval;
+}
+
+size_t CEF_CALLBACK process_message_get_shared_memory_size(
+    struct _cef_process_message_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  size_t _retval = CefProcessMessageCppToC::Get(self)->GetSharedMemorySize();
+
+  // Return type: simple
+  return _retval;
+}
+
+int CEF_CALLBACK process_message_move_shared_memory(
+    struct _cef_process_message_t* self,
+    struct _cef_process_message_t* target) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+  // Verify param: target; type: refptr_same
+  DCHECK(target);
+  if (!target)
+    return 0;
+
+  // Execute
+  bool _retval = CefProcessMessageCppToC::Get(self)->MoveSharedMemory(
+      CefProcessMessageCppToC::Unwrap(target));
+
+  // Return type: bool
+  return _retval;
+}
+
 
 // CONSTRUCTOR - Do not edit by hand.
 
@@ -123,6 +214,15 @@ CefProcessMessageCppToC::CefProcessMessageCppToC(CefProcessMessage* cls)
   struct_.struct_.copy = process_message_copy;
   struct_.struct_.get_name = process_message_get_name;
   struct_.struct_.get_argument_list = process_message_get_argument_list;
+  struct_.struct_.set_argument_list_packed =
+      process_message_set_argument_list_packed;
+  struct_.struct_.is_argument_list_packed =
+      process_message_is_argument_list_packed;
+  struct_.struct_.create_shared_memory = process_message_create_shared_memory;
+  struct_.struct_.get_shared_memory = process_message_get_shared_memory;
+  struct_.struct_.get_shared_memory_size =
+      process_message_get_shared_memory_size;
+  struct_.struct_.move_shared_memory = process_message_move_shared_memory;
 }
 
 #ifndef NDEBUG
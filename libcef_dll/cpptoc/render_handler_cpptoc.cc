@@ -206,6 +206,52 @@ void CEF_CALLBACK render_handler_on_popup_size(
       rectVal);
 }
 
+void* CEF_CALLBACK render_handler_get_paint_buffer(
+    struct _cef_render_handler_t* self, cef_browser_t* browser,
+    cef_paint_element_type_t type, int width, int height) {
+  DCHECK(self);
+  if (!self)
+    return NULL;
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser);
+  if (!browser)
+    return NULL;
+
+  // Execute
+  void* _retval = CefRenderHandlerCppToC::Get(self)->GetPaintBuffer(
+      CefBrowserCToCpp::Wrap(browser),
+      type,
+      width,
+      height);
+
+  // Return type: simple_byaddr
+  return _retval;
+}
+
+void CEF_CALLBACK render_handler_on_paint_buffer_released(
+    struct _cef_render_handler_t* self, cef_browser_t* browser,
+    cef_paint_element_type_t type, void* buffer) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return;
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser);
+  if (!browser)
+    return;
+  // Verify param: buffer; type: simple_byaddr
+  DCHECK(buffer);
+  if (!buffer)
+    return;
+
+  // Execute
+  CefRenderHandlerCppToC::Get(self)->OnPaintBufferReleased(
+      CefBrowserCToCpp::Wrap(browser),
+      type,
+      buffer);
+}
+
 void CEF_CALLBACK render_handler_on_paint(struct _cef_render_handler_t* self,
     cef_browser_t* browser, cef_paint_element_type_t type,
     size_t dirtyRectsCount, cef_rect_t const* dirtyRects, const void* buffer,
@@ -246,6 +292,98 @@ void CEF_CALLBACK render_handler_on_paint(struct _cef_render_handler_t* self,
       height);
 }
 
+int CEF_CALLBACK render_handler_get_paint_span_merge_threshold(
+    struct _cef_render_handler_t* self, cef_browser_t* browser) {
+  DCHECK(self);
+  if (!self)
+    return -1;
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser);
+  if (!browser)
+    return -1;
+
+  // Execute
+  int _retval = CefRenderHandlerCppToC::Get(self)->GetPaintSpanMergeThreshold(
+      CefBrowserCToCpp::Wrap(browser));
+
+  // Return type: simple
+  return _retval;
+}
+
+int CEF_CALLBACK render_handler_get_paint_tile_size(
+    struct _cef_render_handler_t* self, cef_browser_t* browser) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser);
+  if (!browser)
+    return 0;
+
+  // Execute
+  int _retval = CefRenderHandlerCppToC::Get(self)->GetPaintTileSize(
+      CefBrowserCToCpp::Wrap(browser));
+
+  // Return type: simple
+  return _retval;
+}
+
+int CEF_CALLBACK render_handler_get_paint_tile_discard_delay(
+    struct _cef_render_handler_t* self, cef_browser_t* browser) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser);
+  if (!browser)
+    return 0;
+
+  // Execute
+  int _retval = CefRenderHandlerCppToC::Get(self)->GetPaintTileDiscardDelay(
+      CefBrowserCToCpp::Wrap(browser));
+
+  // Return type: simple
+  return _retval;
+}
+
+void CEF_CALLBACK render_handler_on_paint_span(
+    struct _cef_render_handler_t* self, cef_browser_t* browser,
+    cef_paint_element_type_t type, const cef_rect_t* rect, const void* buffer,
+    int stride) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return;
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser);
+  if (!browser)
+    return;
+  // Verify param: rect; type: simple_byref_const
+  DCHECK(rect);
+  if (!rect)
+    return;
+  // Verify param: buffer; type: simple_byaddr
+  DCHECK(buffer);
+  if (!buffer)
+    return;
+
+  // Translate param: rect; type: simple_byref_const
+  CefRect rectVal = rect?*rect:CefRect();
+
+  // Execute
+  CefRenderHandlerCppToC::Get(self)->OnPaintSpan(
+      CefBrowserCToCpp::Wrap(browser),
+      type,
+      rectVal,
+      buffer,
+      stride);
+}
+
 void CEF_CALLBACK render_handler_on_cursor_change(
     struct _cef_render_handler_t* self, cef_browser_t* browser,
     cef_cursor_handle_t cursor) {
@@ -294,7 +432,16 @@ CefRenderHandlerCppToC::CefRenderHandlerCppToC(CefRenderHandler* cls)
   struct_.struct_.get_screen_info = render_handler_get_screen_info;
   struct_.struct_.on_popup_show = render_handler_on_popup_show;
   struct_.struct_.on_popup_size = render_handler_on_popup_size;
+  struct_.struct_.get_paint_buffer = render_handler_get_paint_buffer;
+  struct_.struct_.on_paint_buffer_released =
+      render_handler_on_paint_buffer_released;
   struct_.struct_.on_paint = render_handler_on_paint;
+  struct_.struct_.get_paint_span_merge_threshold =
+      render_handler_get_paint_span_merge_threshold;
+  struct_.struct_.get_paint_tile_size = render_handler_get_paint_tile_size;
+  struct_.struct_.get_paint_tile_discard_delay =
+      render_handler_get_paint_tile_discard_delay;
+  struct_.struct_.on_paint_span = render_handler_on_paint_span;
   struct_.struct_.on_cursor_change = render_handler_on_cursor_change;
   struct_.struct_.on_scroll_offset_changed =
       render_handler_on_scroll_offset_changed;
@@ -14,6 +14,7 @@
 #include "libcef_dll/cpptoc/render_process_handler_cpptoc.h"
 #include "libcef_dll/ctocpp/browser_ctocpp.h"
 #include "libcef_dll/ctocpp/domnode_ctocpp.h"
+#include "libcef_dll/ctocpp/dictionary_value_ctocpp.h"
 #include "libcef_dll/ctocpp/frame_ctocpp.h"
 #include "libcef_dll/ctocpp/list_value_ctocpp.h"
 #include "libcef_dll/ctocpp/process_message_ctocpp.h"
@@ -235,6 +236,24 @@ void CEF_CALLBACK render_process_handler_on_uncaught_exception(
       CefV8StackTraceCToCpp::Wrap(stackTrace));
 }
 
+void CEF_CALLBACK render_process_handler_on_v8wrapper_budget_exceeded(
+    struct _cef_render_process_handler_t* self,
+    struct _cef_dictionary_value_t* statistics) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return;
+  // Verify param: statistics; type: refptr_diff
+  DCHECK(statistics);
+  if (!statistics)
+    return;
+
+  // Execute
+  CefRenderProcessHandlerCppToC::Get(self)->OnV8WrapperBudgetExceeded(
+      CefDictionaryValueCToCpp::Wrap(statistics));
+}
+
 void CEF_CALLBACK render_process_handler_on_focused_node_changed(
     struct _cef_render_process_handler_t* self, cef_browser_t* browser,
     cef_frame_t* frame, cef_domnode_t* node) {
@@ -308,6 +327,8 @@ CefRenderProcessHandlerCppToC::CefRenderProcessHandlerCppToC(
       render_process_handler_on_context_released;
   struct_.struct_.on_uncaught_exception =
       render_process_handler_on_uncaught_exception;
+  struct_.struct_.on_v8wrapper_budget_exceeded =
+      render_process_handler_on_v8wrapper_budget_exceeded;
   struct_.struct_.on_focused_node_changed =
       render_process_handler_on_focused_node_changed;
   struct_.struct_.on_process_message_received =
@@ -11,6 +11,7 @@
 //
 
 #include "libcef_dll/cpptoc/resource_handler_cpptoc.h"
+#include "libcef_dll/ctocpp/binary_value_ctocpp.h"
 #include "libcef_dll/ctocpp/callback_ctocpp.h"
 #include "libcef_dll/ctocpp/request_ctocpp.h"
 #include "libcef_dll/ctocpp/response_ctocpp.h"
@@ -81,6 +82,22 @@ void CEF_CALLBACK resource_handler_get_response_headers(
     *response_length = response_lengthVal;
 }
 
+struct _cef_binary_value_t* CEF_CALLBACK resource_handler_get_response_data(
+    struct _cef_resource_handler_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefBinaryValue> _retval = CefResourceHandlerCppToC::Get(
+      self)->GetResponseData();
+
+  // Return type: refptr_diff
+  return CefBinaryValueCToCpp::Unwrap(_retval);
+}
+
 int CEF_CALLBACK resource_handler_read_response(
     struct _cef_resource_handler_t* self, void* data_out, int bytes_to_read,
     int* bytes_read, cef_callback_t* callback) {
@@ -190,6 +207,7 @@ CefResourceHandlerCppToC::CefResourceHandlerCppToC(CefResourceHandler* cls)
         cef_resource_handler_t>(cls) {
   struct_.struct_.process_request = resource_handler_process_request;
   struct_.struct_.get_response_headers = resource_handler_get_response_headers;
+  struct_.struct_.get_response_data = resource_handler_get_response_data;
   struct_.struct_.read_response = resource_handler_read_response;
   struct_.struct_.can_get_cookie = resource_handler_can_get_cookie;
   struct_.struct_.can_set_cookie = resource_handler_can_set_cookie;
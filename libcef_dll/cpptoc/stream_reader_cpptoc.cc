@@ -33,6 +33,23 @@ CEF_EXPORT cef_stream_reader_t* cef_stream_reader_create_for_file(
   return CefStreamReaderCppToC::Wrap(_retval);
 }
 
+CEF_EXPORT cef_stream_reader_t* cef_stream_reader_create_for_mapped_file(
+    const cef_string_t* fileName) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: fileName; type: string_byref_const
+  DCHECK(fileName);
+  if (!fileName)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefStreamReader> _retval = CefStreamReader::CreateForMappedFile(
+      CefString(fileName));
+
+  // Return type: refptr_same
+  return CefStreamReaderCppToC::Wrap(_retval);
+}
+
 CEF_EXPORT cef_stream_reader_t* cef_stream_reader_create_for_data(void* data,
     size_t size) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -152,6 +169,34 @@ int CEF_CALLBACK stream_reader_may_block(struct _cef_stream_reader_t* self) {
   return _retval;
 }
 
+const void* CEF_CALLBACK stream_reader_get_data(
+    struct _cef_stream_reader_t* self) {
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  const void* _retval = CefStreamReaderCppToC::Get(self)->GetData();
+
+  // Return type: simple
+  return _retval;
+}
+
+size_t CEF_CALLBACK stream_reader_get_data_size(
+    struct _cef_stream_reader_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  size_t _retval = CefStreamReaderCppToC::Get(self)->GetDataSize();
+
+  // Return type: simple
+  return _retval;
+}
+
 
 // CONSTRUCTOR - Do not edit by hand.
 
@@ -163,6 +208,8 @@ CefStreamReaderCppToC::CefStreamReaderCppToC(CefStreamReader* cls)
   struct_.struct_.tell = stream_reader_tell;
   struct_.struct_.eof = stream_reader_eof;
   struct_.struct_.may_block = stream_reader_may_block;
+  struct_.struct_.get_data = stream_reader_get_data;
+  struct_.struct_.get_data_size = stream_reader_get_data_size;
 }
 
 #ifndef NDEBUG
@@ -98,6 +98,38 @@ void CEF_CALLBACK urlrequest_client_on_download_data(
       data_length);
 }
 
+size_t CEF_CALLBACK urlrequest_client_get_download_window_size(
+    struct _cef_urlrequest_client_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  size_t _retval = CefURLRequestClientCppToC::Get(self)->GetDownloadWindowSize(
+      );
+
+  // Return type: simple
+  return _retval;
+}
+
+cef_string_userfree_t CEF_CALLBACK urlrequest_client_get_download_file_path(
+    struct _cef_urlrequest_client_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  CefString _retval = CefURLRequestClientCppToC::Get(self)->GetDownloadFilePath(
+      );
+
+  // Return type: string
+  return _retval.DetachToUserFree();
+}
+
 int CEF_CALLBACK urlrequest_client_get_auth_credentials(
     struct _cef_urlrequest_client_t* self, int isProxy,
     const cef_string_t* host, int port, const cef_string_t* realm,
@@ -144,6 +176,10 @@ CefURLRequestClientCppToC::CefURLRequestClientCppToC(CefURLRequestClient* cls)
   struct_.struct_.on_upload_progress = urlrequest_client_on_upload_progress;
   struct_.struct_.on_download_progress = urlrequest_client_on_download_progress;
   struct_.struct_.on_download_data = urlrequest_client_on_download_data;
+  struct_.struct_.get_download_window_size =
+      urlrequest_client_get_download_window_size;
+  struct_.struct_.get_download_file_path =
+      urlrequest_client_get_download_file_path;
   struct_.struct_.get_auth_credentials = urlrequest_client_get_auth_credentials;
 }
 
@@ -10,7 +10,9 @@
 // for more information.
 //
 
+#include "libcef_dll/cpptoc/binary_value_cpptoc.h"
 #include "libcef_dll/cpptoc/browser_cpptoc.h"
+#include "libcef_dll/cpptoc/dictionary_value_cpptoc.h"
 #include "libcef_dll/cpptoc/frame_cpptoc.h"
 #include "libcef_dll/cpptoc/task_runner_cpptoc.h"
 #include "libcef_dll/cpptoc/v8context_cpptoc.h"
@@ -50,6 +52,55 @@ CEF_EXPORT int cef_v8context_in_context() {
   return _retval;
 }
 
+CEF_EXPORT int cef_v8context_precompile_script(const cef_string_t* code,
+    const cef_string_t* script_url, int start_line,
+    struct _cef_binary_value_t* cached_data) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: code; type: string_byref_const
+  DCHECK(code);
+  if (!code)
+    return 0;
+  // Unverified params: script_url, cached_data
+
+  // Execute
+  bool _retval = CefV8Context::PrecompileScript(
+      CefString(code),
+      CefString(script_url),
+      start_line,
+      CefBinaryValueCppToC::Unwrap(cached_data));
+
+  // Return type: bool
+  return _retval;
+}
+
+CEF_EXPORT struct _cef_binary_value_t* cef_v8context_get_script_cache_data(
+    const cef_string_t* code) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: code; type: string_byref_const
+  DCHECK(code);
+  if (!code)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefBinaryValue> _retval = CefV8Context::GetScriptCacheData(
+      CefString(code));
+
+  // Return type: refptr_same
+  return CefBinaryValueCppToC::Wrap(_retval);
+}
+
+CEF_EXPORT void cef_v8context_set_wrapper_budget(int persistent_handle_limit,
+    int64 tracked_memory_limit) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  CefV8Context::SetWrapperBudget(
+      persistent_handle_limit,
+      tracked_memory_limit);
+}
+
 
 // MEMBER FUNCTIONS - Body may be edited by hand.
 
@@ -238,6 +289,22 @@ int CEF_CALLBACK v8context_eval(struct _cef_v8context_t* self,
   return _retval;
 }
 
+struct _cef_dictionary_value_t* CEF_CALLBACK v8context_get_statistics(
+    struct _cef_v8context_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefDictionaryValue> _retval = CefV8ContextCppToC::Get(
+      self)->GetStatistics();
+
+  // Return type: refptr_same
+  return CefDictionaryValueCppToC::Wrap(_retval);
+}
+
 
 // CONSTRUCTOR - Do not edit by hand.
 
@@ -252,6 +319,7 @@ CefV8ContextCppToC::CefV8ContextCppToC(CefV8Context* cls)
   struct_.struct_.exit = v8context_exit;
   struct_.struct_.is_same = v8context_is_same;
   struct_.struct_.eval = v8context_eval;
+  struct_.struct_.get_statistics = v8context_get_statistics;
 }
 
 #ifndef NDEBUG
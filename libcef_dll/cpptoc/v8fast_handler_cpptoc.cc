@@ -0,0 +1,144 @@
+// Copyright (c) 2014 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// This file was generated by the CEF translator tool. If making changes by
+// hand only do so within the body of existing method and function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#include "libcef_dll/cpptoc/v8fast_handler_cpptoc.h"
+#include "libcef_dll/transfer_util.h"
+
+
+// MEMBER FUNCTIONS - Body may be edited by hand.
+
+int CEF_CALLBACK v8fast_handler_get_argument_count(
+    struct _cef_v8fast_handler_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  int _retval = CefV8FastHandlerCppToC::Get(self)->GetArgumentCount();
+
+  // Return type: simple
+  return _retval;
+}
+
+cef_v8_fast_type_t CEF_CALLBACK v8fast_handler_get_argument_type(
+    struct _cef_v8fast_handler_t* self, int index) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return V8_FAST_TYPE_VOID;
+
+  // Execute
+  cef_v8_fast_type_t _retval = CefV8FastHandlerCppToC::Get(
+      self)->GetArgumentType(
+      index);
+
+  // Return type: simple
+  return _retval;
+}
+
+cef_v8_fast_type_t CEF_CALLBACK v8fast_handler_get_return_type(
+    struct _cef_v8fast_handler_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return V8_FAST_TYPE_VOID;
+
+  // Execute
+  cef_v8_fast_type_t _retval = CefV8FastHandlerCppToC::Get(self)->GetReturnType(
+      );
+
+  // Return type: simple
+  return _retval;
+}
+
+int CEF_CALLBACK v8fast_handler_execute(struct _cef_v8fast_handler_t* self,
+    const cef_string_t* name, size_t numbersCount, double const* numbers,
+    cef_string_list_t strings, double* number_retval,
+    cef_string_t* string_retval, cef_string_t* exception) {
+  DCHECK(self);
+  if (!self)
+    return 0;
+  // Verify param: name; type: string_byref_const
+  DCHECK(name);
+  if (!name)
+    return 0;
+  // Verify param: numbers; type: simple_vec_byref_const
+  DCHECK(numbersCount == 0 || numbers);
+  if (numbersCount > 0 && !numbers)
+    return 0;
+  // Unverified params: strings (NULL for an empty list)
+  // Verify param: number_retval; type: simple_byref
+  DCHECK(number_retval);
+  if (!number_retval)
+    return 0;
+  // Verify param: string_retval; type: string_byref
+  DCHECK(string_retval);
+  if (!string_retval)
+    return 0;
+  // Verify param: exception; type: string_byref
+  DCHECK(exception);
+  if (!exception)
+    return 0;
+
+  // Translate param: numbers; type: simple_vec_byref_const
+  // The C++ interface takes vectors so the arguments are copied here. Nothing
+  // is allocated for a function without arguments of the respective type.
+  std::vector<double> numbersList(numbers, numbers + numbersCount);
+  // Translate param: strings; type: string_vec_byref_const
+  std::vector<CefString> stringsList;
+  if (strings)
+    transfer_string_list_contents(strings, stringsList);
+  // Translate param: number_retval; type: simple_byref
+  double number_retvalVal = number_retval?*number_retval:0;
+  // Translate param: string_retval; type: string_byref
+  CefString string_retvalStr(string_retval);
+  // Translate param: exception; type: string_byref
+  CefString exceptionStr(exception);
+
+  // Execute
+  bool _retval = CefV8FastHandlerCppToC::Get(self)->Execute(
+      CefString(name),
+      numbersList,
+      stringsList,
+      number_retvalVal,
+      string_retvalStr,
+      exceptionStr);
+
+  // Restore param: number_retval; type: simple_byref
+  if (number_retval)
+    *number_retval = number_retvalVal;
+
+  // Return type: bool
+  return _retval;
+}
+
+
+// CONSTRUCTOR - Do not edit by hand.
+
+CefV8FastHandlerCppToC::CefV8FastHandlerCppToC(CefV8FastHandler* cls)
+    : CefCppToC<CefV8FastHandlerCppToC, CefV8FastHandler, cef_v8fast_handler_t>(
+        cls) {
+  struct_.struct_.get_argument_count = v8fast_handler_get_argument_count;
+  struct_.struct_.get_argument_type = v8fast_handler_get_argument_type;
+  struct_.struct_.get_return_type = v8fast_handler_get_return_type;
+  struct_.struct_.execute = v8fast_handler_execute;
+}
+
+#ifndef NDEBUG
+template<> long CefCppToC<CefV8FastHandlerCppToC, CefV8FastHandler,
+    cef_v8fast_handler_t>::DebugObjCt = 0;
+#endif
+
@@ -10,11 +10,14 @@
 // for more information.
 //
 
+#include "libcef_dll/cpptoc/dictionary_value_cpptoc.h"
+#include "libcef_dll/cpptoc/list_value_cpptoc.h"
 #include "libcef_dll/cpptoc/v8context_cpptoc.h"
 #include "libcef_dll/cpptoc/v8exception_cpptoc.h"
 #include "libcef_dll/cpptoc/v8value_cpptoc.h"
 #include "libcef_dll/ctocpp/base_ctocpp.h"
 #include "libcef_dll/ctocpp/v8accessor_ctocpp.h"
+#include "libcef_dll/ctocpp/v8fast_handler_ctocpp.h"
 #include "libcef_dll/ctocpp/v8handler_ctocpp.h"
 #include "libcef_dll/transfer_util.h"
 
@@ -164,6 +167,73 @@ CEF_EXPORT cef_v8value_t* cef_v8value_create_function(const cef_string_t* name,
   return CefV8ValueCppToC::Wrap(_retval);
 }
 
+CEF_EXPORT cef_v8value_t* cef_v8value_create_fast_function(
+    const cef_string_t* name, cef_v8fast_handler_t* handler) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: name; type: string_byref_const
+  DCHECK(name);
+  if (!name)
+    return NULL;
+  // Verify param: handler; type: refptr_diff
+  DCHECK(handler);
+  if (!handler)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefV8Value> _retval = CefV8Value::CreateFastFunction(
+      CefString(name),
+      CefV8FastHandlerCToCpp::Wrap(handler));
+
+  // Return type: refptr_same
+  return CefV8ValueCppToC::Wrap(_retval);
+}
+
+CEF_EXPORT cef_v8value_t* cef_v8value_create_array_buffer(size_t length) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  CefRefPtr<CefV8Value> _retval = CefV8Value::CreateArrayBuffer(
+      length);
+
+  // Return type: refptr_same
+  return CefV8ValueCppToC::Wrap(_retval);
+}
+
+CEF_EXPORT cef_v8value_t* cef_v8value_create_from_dictionary(
+    struct _cef_dictionary_value_t* value) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: value; type: refptr_same
+  DCHECK(value);
+  if (!value)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefV8Value> _retval = CefV8Value::CreateFromDictionary(
+      CefDictionaryValueCppToC::Unwrap(value));
+
+  // Return type: refptr_same
+  return CefV8ValueCppToC::Wrap(_retval);
+}
+
+CEF_EXPORT cef_v8value_t* cef_v8value_create_from_list(
+    struct _cef_list_value_t* value) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: value; type: refptr_same
+  DCHECK(value);
+  if (!value)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefV8Value> _retval = CefV8Value::CreateFromList(
+      CefListValueCppToC::Unwrap(value));
+
+  // Return type: refptr_same
+  return CefV8ValueCppToC::Wrap(_retval);
+}
+
 
 // MEMBER FUNCTIONS - Body may be edited by hand.
 
@@ -335,6 +405,34 @@ int CEF_CALLBACK v8value_is_function(struct _cef_v8value_t* self) {
   return _retval;
 }
 
+int CEF_CALLBACK v8value_is_array_buffer(struct _cef_v8value_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  bool _retval = CefV8ValueCppToC::Get(self)->IsArrayBuffer();
+
+  // Return type: bool
+  return _retval;
+}
+
+int CEF_CALLBACK v8value_is_typed_array(struct _cef_v8value_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  bool _retval = CefV8ValueCppToC::Get(self)->IsTypedArray();
+
+  // Return type: bool
+  return _retval;
+}
+
 int CEF_CALLBACK v8value_is_same(struct _cef_v8value_t* self,
     struct _cef_v8value_t* that) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -736,6 +834,37 @@ int CEF_CALLBACK v8value_get_keys(struct _cef_v8value_t* self,
   return _retval;
 }
 
+struct _cef_dictionary_value_t* CEF_CALLBACK v8value_to_dictionary(
+    struct _cef_v8value_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefDictionaryValue> _retval = CefV8ValueCppToC::Get(
+      self)->ToDictionary();
+
+  // Return type: refptr_same
+  return CefDictionaryValueCppToC::Wrap(_retval);
+}
+
+struct _cef_list_value_t* CEF_CALLBACK v8value_to_list(
+    struct _cef_v8value_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  CefRefPtr<CefListValue> _retval = CefV8ValueCppToC::Get(self)->ToList();
+
+  // Return type: refptr_same
+  return CefListValueCppToC::Wrap(_retval);
+}
+
 int CEF_CALLBACK v8value_set_user_data(struct _cef_v8value_t* self,
     cef_base_t* user_data) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -812,6 +941,33 @@ int CEF_CALLBACK v8value_get_array_length(struct _cef_v8value_t* self) {
   return _retval;
 }
 
+void* CEF_CALLBACK v8value_get_array_buffer_data(struct _cef_v8value_t* self) {
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  // Execute
+  void* _retval = CefV8ValueCppToC::Get(self)->GetArrayBufferData();
+
+  // Return type: simple
+  return _retval;
+}
+
+size_t CEF_CALLBACK v8value_get_array_buffer_byte_length(
+    struct _cef_v8value_t* self) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  // Execute
+  size_t _retval = CefV8ValueCppToC::Get(self)->GetArrayBufferByteLength();
+
+  // Return type: simple
+  return _retval;
+}
+
 cef_string_userfree_t CEF_CALLBACK v8value_get_function_name(
     struct _cef_v8value_t* self) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -929,6 +1085,8 @@ CefV8ValueCppToC::CefV8ValueCppToC(CefV8Value* cls)
   struct_.struct_.is_object = v8value_is_object;
   struct_.struct_.is_array = v8value_is_array;
   struct_.struct_.is_function = v8value_is_function;
+  struct_.struct_.is_array_buffer = v8value_is_array_buffer;
+  struct_.struct_.is_typed_array = v8value_is_typed_array;
   struct_.struct_.is_same = v8value_is_same;
   struct_.struct_.get_bool_value = v8value_get_bool_value;
   struct_.struct_.get_int_value = v8value_get_int_value;
@@ -952,6 +1110,8 @@ CefV8ValueCppToC::CefV8ValueCppToC(CefV8Value* cls)
   struct_.struct_.set_value_byindex = v8value_set_value_byindex;
   struct_.struct_.set_value_byaccessor = v8value_set_value_byaccessor;
   struct_.struct_.get_keys = v8value_get_keys;
+  struct_.struct_.to_dictionary = v8value_to_dictionary;
+  struct_.struct_.to_list = v8value_to_list;
   struct_.struct_.set_user_data = v8value_set_user_data;
   struct_.struct_.get_user_data = v8value_get_user_data;
   struct_.struct_.get_externally_allocated_memory =
@@ -959,6 +1119,9 @@ CefV8ValueCppToC::CefV8ValueCppToC(CefV8Value* cls)
   struct_.struct_.adjust_externally_allocated_memory =
       v8value_adjust_externally_allocated_memory;
   struct_.struct_.get_array_length = v8value_get_array_length;
+  struct_.struct_.get_array_buffer_data = v8value_get_array_buffer_data;
+  struct_.struct_.get_array_buffer_byte_length =
+      v8value_get_array_buffer_byte_length;
   struct_.struct_.get_function_name = v8value_get_function_name;
   struct_.struct_.get_function_handler = v8value_get_function_handler;
   struct_.struct_.execute_function = v8value_execute_function;
@@ -335,6 +335,40 @@ bool CefBrowserCToCpp::SendProcessMessage(CefProcessId target_process,
   return _retval?true:false;
 }
 
+bool CefBrowserCToCpp::SendProcessMessages(CefProcessId target_process,
+    const std::vector<CefRefPtr<CefProcessMessage> >& messages) {
+  if (CEF_MEMBER_MISSING(struct_, send_process_messages))
+    return false;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Translate param: messages; type: refptr_vec_same_byref_const
+  const size_t messagesCount = messages.size();
+  cef_process_message_t** messagesList = NULL;
+  if (messagesCount > 0) {
+    messagesList = new cef_process_message_t*[messagesCount];
+    DCHECK(messagesList);
+    if (messagesList) {
+      for (size_t i = 0; i < messagesCount; ++i) {
+        messagesList[i] = CefProcessMessageCToCpp::Unwrap(messages[i]);
+      }
+    }
+  }
+
+  // Execute
+  int _retval = struct_->send_process_messages(struct_,
+      target_process,
+      messagesCount,
+      messagesList);
+
+  // Restore param:messages; type: refptr_vec_same_byref_const
+  if (messagesList)
+    delete [] messagesList;
+
+  // Return type: bool
+  return _retval?true:false;
+}
+
 
 #ifndef NDEBUG
 template<> long CefCToCpp<CefBrowserCToCpp, CefBrowser,
@@ -57,6 +57,8 @@ class CefBrowserCToCpp
   virtual void GetFrameNames(std::vector<CefString>& names) OVERRIDE;
   virtual bool SendProcessMessage(CefProcessId target_process,
       CefRefPtr<CefProcessMessage> message) OVERRIDE;
+  virtual bool SendProcessMessages(CefProcessId target_process,
+      const std::vector<CefRefPtr<CefProcessMessage> >& messages) OVERRIDE;
 };
 
 #endif  // USING_CEF_SHARED
@@ -376,6 +376,53 @@ void CefBrowserHostCToCpp::Invalidate(const CefRect& dirtyRect,
       type);
 }
 
+int64 CefBrowserHostCToCpp::GetPaintDeliveredBytes() {
+  if (CEF_MEMBER_MISSING(struct_, get_paint_delivered_bytes))
+    return 0;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  int64 _retval = struct_->get_paint_delivered_bytes(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
+int64 CefBrowserHostCToCpp::GetPaintViewBytes() {
+  if (CEF_MEMBER_MISSING(struct_, get_paint_view_bytes))
+    return 0;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  int64 _retval = struct_->get_paint_view_bytes(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
+void CefBrowserHostCToCpp::SetWindowlessFrameRate(int frame_rate) {
+  if (CEF_MEMBER_MISSING(struct_, set_windowless_frame_rate))
+    return;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  struct_->set_windowless_frame_rate(struct_,
+      frame_rate);
+}
+
+void CefBrowserHostCToCpp::FlushWindowlessPaint() {
+  if (CEF_MEMBER_MISSING(struct_, flush_windowless_paint))
+    return;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  struct_->flush_windowless_paint(struct_);
+}
+
 void CefBrowserHostCToCpp::SendKeyEvent(const CefKeyEvent& event) {
   if (CEF_MEMBER_MISSING(struct_, send_key_event))
     return;
@@ -67,6 +67,10 @@ class CefBrowserHostCToCpp
   virtual void NotifyScreenInfoChanged() OVERRIDE;
   virtual void Invalidate(const CefRect& dirtyRect,
       PaintElementType type) OVERRIDE;
+  virtual int64 GetPaintDeliveredBytes() OVERRIDE;
+  virtual int64 GetPaintViewBytes() OVERRIDE;
+  virtual void SetWindowlessFrameRate(int frame_rate) OVERRIDE;
+  virtual void FlushWindowlessPaint() OVERRIDE;
   virtual void SendKeyEvent(const CefKeyEvent& event) OVERRIDE;
   virtual void SendMouseClickEvent(const CefMouseEvent& event,
       MouseButtonType type, bool mouseUp, int clickCount) OVERRIDE;
@@ -85,6 +85,19 @@ CefRefPtr<CefDictionaryValue> CefDictionaryValueCToCpp::Copy(
   return CefDictionaryValueCToCpp::Wrap(_retval);
 }
 
+CefRefPtr<CefDictionaryValue> CefDictionaryValueCToCpp::CreateSnapshot() {
+  if (CEF_MEMBER_MISSING(struct_, create_snapshot))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_dictionary_value_t* _retval = struct_->create_snapshot(struct_);
+
+  // Return type: refptr_same
+  return CefDictionaryValueCToCpp::Wrap(_retval);
+}
+
 size_t CefDictionaryValueCToCpp::GetSize() {
   if (CEF_MEMBER_MISSING(struct_, get_size))
     return 0;
@@ -176,6 +189,66 @@ bool CefDictionaryValueCToCpp::Remove(const CefString& key) {
   return _retval?true:false;
 }
 
+CefRefPtr<CefBinaryValue> CefDictionaryValueCToCpp::DetachBinary(
+    const CefString& key) {
+  if (CEF_MEMBER_MISSING(struct_, detach_binary))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: key; type: string_byref_const
+  DCHECK(!key.empty());
+  if (key.empty())
+    return NULL;
+
+  // Execute
+  cef_binary_value_t* _retval = struct_->detach_binary(struct_,
+      key.GetStruct());
+
+  // Return type: refptr_same
+  return CefBinaryValueCToCpp::Wrap(_retval);
+}
+
+CefRefPtr<CefDictionaryValue> CefDictionaryValueCToCpp::DetachDictionary(
+    const CefString& key) {
+  if (CEF_MEMBER_MISSING(struct_, detach_dictionary))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: key; type: string_byref_const
+  DCHECK(!key.empty());
+  if (key.empty())
+    return NULL;
+
+  // Execute
+  cef_dictionary_value_t* _retval = struct_->detach_dictionary(struct_,
+      key.GetStruct());
+
+  // Return type: refptr_same
+  return CefDictionaryValueCToCpp::Wrap(_retval);
+}
+
+CefRefPtr<CefListValue> CefDictionaryValueCToCpp::DetachList(
+    const CefString& key) {
+  if (CEF_MEMBER_MISSING(struct_, detach_list))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: key; type: string_byref_const
+  DCHECK(!key.empty());
+  if (key.empty())
+    return NULL;
+
+  // Execute
+  cef_list_value_t* _retval = struct_->detach_list(struct_,
+      key.GetStruct());
+
+  // Return type: refptr_same
+  return CefListValueCToCpp::Wrap(_retval);
+}
+
 CefValueType CefDictionaryValueCToCpp::GetType(const CefString& key) {
   if (CEF_MEMBER_MISSING(struct_, get_type))
     return VTYPE_INVALID;
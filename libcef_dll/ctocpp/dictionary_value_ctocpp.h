@@ -39,11 +39,16 @@ class CefDictionaryValueCToCpp
   virtual bool IsReadOnly() OVERRIDE;
   virtual CefRefPtr<CefDictionaryValue> Copy(
       bool exclude_empty_children) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> CreateSnapshot() OVERRIDE;
   virtual size_t GetSize() OVERRIDE;
   virtual bool Clear() OVERRIDE;
   virtual bool HasKey(const CefString& key) OVERRIDE;
   virtual bool GetKeys(KeyList& keys) OVERRIDE;
   virtual bool Remove(const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefBinaryValue> DetachBinary(const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> DetachDictionary(
+      const CefString& key) OVERRIDE;
+  virtual CefRefPtr<CefListValue> DetachList(const CefString& key) OVERRIDE;
   virtual CefValueType GetType(const CefString& key) OVERRIDE;
   virtual bool GetBool(const CefString& key) OVERRIDE;
   virtual int GetInt(const CefString& key) OVERRIDE;
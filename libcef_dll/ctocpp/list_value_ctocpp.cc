@@ -82,6 +82,19 @@ CefRefPtr<CefListValue> CefListValueCToCpp::Copy() {
   return CefListValueCToCpp::Wrap(_retval);
 }
 
+CefRefPtr<CefListValue> CefListValueCToCpp::CreateSnapshot() {
+  if (CEF_MEMBER_MISSING(struct_, create_snapshot))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_list_value_t* _retval = struct_->create_snapshot(struct_);
+
+  // Return type: refptr_same
+  return CefListValueCToCpp::Wrap(_retval);
+}
+
 bool CefListValueCToCpp::SetSize(size_t size) {
   if (CEF_MEMBER_MISSING(struct_, set_size))
     return false;
@@ -141,6 +154,63 @@ bool CefListValueCToCpp::Remove(int index) {
   return _retval?true:false;
 }
 
+CefRefPtr<CefBinaryValue> CefListValueCToCpp::DetachBinary(int index) {
+  if (CEF_MEMBER_MISSING(struct_, detach_binary))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: index; type: simple_byval
+  DCHECK_GE(index, 0);
+  if (index < 0)
+    return NULL;
+
+  // Execute
+  cef_binary_value_t* _retval = struct_->detach_binary(struct_,
+      index);
+
+  // Return type: refptr_same
+  return CefBinaryValueCToCpp::Wrap(_retval);
+}
+
+CefRefPtr<CefDictionaryValue> CefListValueCToCpp::DetachDictionary(int index) {
+  if (CEF_MEMBER_MISSING(struct_, detach_dictionary))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: index; type: simple_byval
+  DCHECK_GE(index, 0);
+  if (index < 0)
+    return NULL;
+
+  // Execute
+  cef_dictionary_value_t* _retval = struct_->detach_dictionary(struct_,
+      index);
+
+  // Return type: refptr_same
+  return CefDictionaryValueCToCpp::Wrap(_retval);
+}
+
+CefRefPtr<CefListValue> CefListValueCToCpp::DetachList(int index) {
+  if (CEF_MEMBER_MISSING(struct_, detach_list))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: index; type: simple_byval
+  DCHECK_GE(index, 0);
+  if (index < 0)
+    return NULL;
+
+  // Execute
+  cef_list_value_t* _retval = struct_->detach_list(struct_,
+      index);
+
+  // Return type: refptr_same
+  return CefListValueCToCpp::Wrap(_retval);
+}
+
 CefValueType CefListValueCToCpp::GetType(int index) {
   if (CEF_MEMBER_MISSING(struct_, get_type))
     return VTYPE_INVALID;
@@ -36,10 +36,14 @@ class CefListValueCToCpp
   virtual bool IsOwned() OVERRIDE;
   virtual bool IsReadOnly() OVERRIDE;
   virtual CefRefPtr<CefListValue> Copy() OVERRIDE;
+  virtual CefRefPtr<CefListValue> CreateSnapshot() OVERRIDE;
   virtual bool SetSize(size_t size) OVERRIDE;
   virtual size_t GetSize() OVERRIDE;
   virtual bool Clear() OVERRIDE;
   virtual bool Remove(int index) OVERRIDE;
+  virtual CefRefPtr<CefBinaryValue> DetachBinary(int index) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> DetachDictionary(int index) OVERRIDE;
+  virtual CefRefPtr<CefListValue> DetachList(int index) OVERRIDE;
   virtual CefValueType GetType(int index) OVERRIDE;
   virtual bool GetBool(int index) OVERRIDE;
   virtual int GetInt(int index) OVERRIDE;
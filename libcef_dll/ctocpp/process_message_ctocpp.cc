@@ -102,6 +102,86 @@ CefRefPtr<CefListValue> CefProcessMessageCToCpp::GetArgumentList() {
   return CefListValueCToCpp::Wrap(_retval);
 }
 
+void CefProcessMessageCToCpp::SetArgumentListPacked(bool packed) {
+  if (CEF_MEMBER_MISSING(struct_, set_argument_list_packed))
+    return;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  struct_->set_argument_list_packed(struct_,
+      packed);
+}
+
+bool CefProcessMessageCToCpp::IsArgumentListPacked() {
+  if (CEF_MEMBER_MISSING(struct_, is_argument_list_packed))
+    return false;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  int _retval = struct_->is_argument_list_packed(struct_);
+
+  // Return type: bool
+  return _retval?true:false;
+}
+
+void* CefProcessMessageCToCpp::CreateSharedMemory(size_t size) {
+  if (CEF_MEMBER_MISSING(struct_, create_shared_memory))
+    return NULL;
+
+  // Execute
+  void* _retval = struct_->create_shared_memory(struct_,
+      size);
+
+  // Return type: simple_byaddr
+  return _retval;
+}
+
+void* CefProcessMessageCToCpp::GetSharedMemory() {
+  if (CEF_MEMBER_MISSING(struct_, get_shared_memory))
+    return NULL;
+
+  // Execute
+  void* _retval = struct_->get_shared_memory(struct_);
+
+  // Return type: simple_byaddr
+  return _retval;
+}
+
+size_t CefProcessMessageCToCpp::GetSharedMemorySize() {
+  if (CEF_MEMBER_MISSING(struct_, get_shared_memory_size))
+    return 0;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  size_t _retval = struct_->get_shared_memory_size(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
+bool CefProcessMessageCToCpp::MoveSharedMemory(
+    CefRefPtr<CefProcessMessage> target) {
+  if (CEF_MEMBER_MISSING(struct_, move_shared_memory))
+    return false;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: target; type: refptr_same
+  DCHECK(target.get());
+  if (!target.get())
+    return false;
+
+  // Execute
+  int _retval = struct_->move_shared_memory(struct_,
+      CefProcessMessageCToCpp::Unwrap(target));
+
+  // Return type: bool
+  return _retval?true:false;
+}
+
 
 #ifndef NDEBUG
 template<> long CefCToCpp<CefProcessMessageCToCpp, CefProcessMessage,
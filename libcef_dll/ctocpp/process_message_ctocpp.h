@@ -39,6 +39,12 @@ class CefProcessMessageCToCpp
   virtual CefRefPtr<CefProcessMessage> Copy() OVERRIDE;
   virtual CefString GetName() OVERRIDE;
   virtual CefRefPtr<CefListValue> GetArgumentList() OVERRIDE;
+  virtual void SetArgumentListPacked(bool packed) OVERRIDE;
+  virtual bool IsArgumentListPacked() OVERRIDE;
+  virtual void* CreateSharedMemory(size_t size) OVERRIDE;
+  virtual void* GetSharedMemory() OVERRIDE;
+  virtual size_t GetSharedMemorySize() OVERRIDE;
+  virtual bool MoveSharedMemory(CefRefPtr<CefProcessMessage> target) OVERRIDE;
 };
 
 #endif  // USING_CEF_SHARED
@@ -139,6 +139,50 @@ void CefRenderHandlerCToCpp::OnPopupSize(CefRefPtr<CefBrowser> browser,
       &rect);
 }
 
+void* CefRenderHandlerCToCpp::GetPaintBuffer(CefRefPtr<CefBrowser> browser,
+    PaintElementType type, int width, int height) {
+  if (CEF_MEMBER_MISSING(struct_, get_paint_buffer))
+    return NULL;
+
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser.get());
+  if (!browser.get())
+    return NULL;
+
+  // Execute
+  void* _retval = struct_->get_paint_buffer(struct_,
+      CefBrowserCppToC::Wrap(browser),
+      type,
+      width,
+      height);
+
+  // Return type: simple_byaddr
+  return _retval;
+}
+
+void CefRenderHandlerCToCpp::OnPaintBufferReleased(
+    CefRefPtr<CefBrowser> browser, PaintElementType type, void* buffer) {
+  if (CEF_MEMBER_MISSING(struct_, on_paint_buffer_released))
+    return;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser.get());
+  if (!browser.get())
+    return;
+  // Verify param: buffer; type: simple_byaddr
+  DCHECK(buffer);
+  if (!buffer)
+    return;
+
+  // Execute
+  struct_->on_paint_buffer_released(struct_,
+      CefBrowserCppToC::Wrap(browser),
+      type,
+      buffer);
+}
+
 void CefRenderHandlerCToCpp::OnPaint(CefRefPtr<CefBrowser> browser,
     PaintElementType type, const RectList& dirtyRects, const void* buffer,
     int width, int height) {
@@ -184,6 +228,89 @@ void CefRenderHandlerCToCpp::OnPaint(CefRefPtr<CefBrowser> browser,
     delete [] dirtyRectsList;
 }
 
+int CefRenderHandlerCToCpp::GetPaintSpanMergeThreshold(
+    CefRefPtr<CefBrowser> browser) {
+  if (CEF_MEMBER_MISSING(struct_, get_paint_span_merge_threshold))
+    return -1;
+
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser.get());
+  if (!browser.get())
+    return -1;
+
+  // Execute
+  int _retval = struct_->get_paint_span_merge_threshold(struct_,
+      CefBrowserCppToC::Wrap(browser));
+
+  // Return type: simple
+  return _retval;
+}
+
+int CefRenderHandlerCToCpp::GetPaintTileSize(CefRefPtr<CefBrowser> browser) {
+  if (CEF_MEMBER_MISSING(struct_, get_paint_tile_size))
+    return 0;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser.get());
+  if (!browser.get())
+    return 0;
+
+  // Execute
+  int _retval = struct_->get_paint_tile_size(struct_,
+      CefBrowserCppToC::Wrap(browser));
+
+  // Return type: simple
+  return _retval;
+}
+
+int CefRenderHandlerCToCpp::GetPaintTileDiscardDelay(
+    CefRefPtr<CefBrowser> browser) {
+  if (CEF_MEMBER_MISSING(struct_, get_paint_tile_discard_delay))
+    return 0;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser.get());
+  if (!browser.get())
+    return 0;
+
+  // Execute
+  int _retval = struct_->get_paint_tile_discard_delay(struct_,
+      CefBrowserCppToC::Wrap(browser));
+
+  // Return type: simple
+  return _retval;
+}
+
+void CefRenderHandlerCToCpp::OnPaintSpan(CefRefPtr<CefBrowser> browser,
+    PaintElementType type, const CefRect& rect, const void* buffer,
+    int stride) {
+  if (CEF_MEMBER_MISSING(struct_, on_paint_span))
+    return;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: browser; type: refptr_diff
+  DCHECK(browser.get());
+  if (!browser.get())
+    return;
+  // Verify param: buffer; type: simple_byaddr
+  DCHECK(buffer);
+  if (!buffer)
+    return;
+
+  // Execute
+  struct_->on_paint_span(struct_,
+      CefBrowserCppToC::Wrap(browser),
+      type,
+      &rect,
+      buffer,
+      stride);
+}
+
 void CefRenderHandlerCToCpp::OnCursorChange(CefRefPtr<CefBrowser> browser,
     CefCursorHandle cursor) {
   if (CEF_MEMBER_MISSING(struct_, on_cursor_change))
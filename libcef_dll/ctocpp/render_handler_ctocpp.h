@@ -45,9 +45,19 @@ class CefRenderHandlerCToCpp
   virtual void OnPopupShow(CefRefPtr<CefBrowser> browser, bool show) OVERRIDE;
   virtual void OnPopupSize(CefRefPtr<CefBrowser> browser,
       const CefRect& rect) OVERRIDE;
+  virtual void* GetPaintBuffer(CefRefPtr<CefBrowser> browser,
+      PaintElementType type, int width, int height) OVERRIDE;
+  virtual void OnPaintBufferReleased(CefRefPtr<CefBrowser> browser,
+      PaintElementType type, void* buffer) OVERRIDE;
   virtual void OnPaint(CefRefPtr<CefBrowser> browser, PaintElementType type,
       const RectList& dirtyRects, const void* buffer, int width,
       int height) OVERRIDE;
+  virtual int GetPaintSpanMergeThreshold(
+      CefRefPtr<CefBrowser> browser) OVERRIDE;
+  virtual int GetPaintTileSize(CefRefPtr<CefBrowser> browser) OVERRIDE;
+  virtual int GetPaintTileDiscardDelay(CefRefPtr<CefBrowser> browser) OVERRIDE;
+  virtual void OnPaintSpan(CefRefPtr<CefBrowser> browser, PaintElementType type,
+      const CefRect& rect, const void* buffer, int stride) OVERRIDE;
   virtual void OnCursorChange(CefRefPtr<CefBrowser> browser,
       CefCursorHandle cursor) OVERRIDE;
   virtual void OnScrollOffsetChanged(CefRefPtr<CefBrowser> browser) OVERRIDE;
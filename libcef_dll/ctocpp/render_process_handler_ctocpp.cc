@@ -12,6 +12,7 @@
 
 #include "libcef_dll/cpptoc/browser_cpptoc.h"
 #include "libcef_dll/cpptoc/domnode_cpptoc.h"
+#include "libcef_dll/cpptoc/dictionary_value_cpptoc.h"
 #include "libcef_dll/cpptoc/frame_cpptoc.h"
 #include "libcef_dll/cpptoc/list_value_cpptoc.h"
 #include "libcef_dll/cpptoc/process_message_cpptoc.h"
@@ -228,6 +229,23 @@ void CefRenderProcessHandlerCToCpp::OnUncaughtException(
       CefV8StackTraceCppToC::Wrap(stackTrace));
 }
 
+void CefRenderProcessHandlerCToCpp::OnV8WrapperBudgetExceeded(
+    CefRefPtr<CefDictionaryValue> statistics) {
+  if (CEF_MEMBER_MISSING(struct_, on_v8wrapper_budget_exceeded))
+    return;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: statistics; type: refptr_diff
+  DCHECK(statistics.get());
+  if (!statistics.get())
+    return;
+
+  // Execute
+  struct_->on_v8wrapper_budget_exceeded(struct_,
+      CefDictionaryValueCppToC::Wrap(statistics));
+}
+
 void CefRenderProcessHandlerCToCpp::OnFocusedNodeChanged(
     CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame,
     CefRefPtr<CefDOMNode> node) {
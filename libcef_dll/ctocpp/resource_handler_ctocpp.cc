@@ -10,6 +10,7 @@
 // for more information.
 //
 
+#include "libcef_dll/cpptoc/binary_value_cpptoc.h"
 #include "libcef_dll/cpptoc/callback_cpptoc.h"
 #include "libcef_dll/cpptoc/request_cpptoc.h"
 #include "libcef_dll/cpptoc/response_cpptoc.h"
@@ -63,6 +64,19 @@ void CefResourceHandlerCToCpp::GetResponseHeaders(
       redirectUrl.GetWritableStruct());
 }
 
+CefRefPtr<CefBinaryValue> CefResourceHandlerCToCpp::GetResponseData() {
+  if (CEF_MEMBER_MISSING(struct_, get_response_data))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_binary_value_t* _retval = struct_->get_response_data(struct_);
+
+  // Return type: refptr_diff
+  return CefBinaryValueCppToC::Unwrap(_retval);
+}
+
 bool CefResourceHandlerCToCpp::ReadResponse(void* data_out, int bytes_to_read,
     int& bytes_read, CefRefPtr<CefCallback> callback) {
   if (CEF_MEMBER_MISSING(struct_, read_response))
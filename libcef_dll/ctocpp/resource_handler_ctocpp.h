@@ -38,6 +38,7 @@ class CefResourceHandlerCToCpp
       CefRefPtr<CefCallback> callback) OVERRIDE;
   virtual void GetResponseHeaders(CefRefPtr<CefResponse> response,
       int64& response_length, CefString& redirectUrl) OVERRIDE;
+  virtual CefRefPtr<CefBinaryValue> GetResponseData() OVERRIDE;
   virtual bool ReadResponse(void* data_out, int bytes_to_read, int& bytes_read,
       CefRefPtr<CefCallback> callback) OVERRIDE;
   virtual bool CanGetCookie(const CefCookie& cookie) OVERRIDE;
@@ -33,6 +33,23 @@ CefRefPtr<CefStreamReader> CefStreamReader::CreateForFile(
   return CefStreamReaderCToCpp::Wrap(_retval);
 }
 
+CefRefPtr<CefStreamReader> CefStreamReader::CreateForMappedFile(
+    const CefString& fileName) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: fileName; type: string_byref_const
+  DCHECK(!fileName.empty());
+  if (fileName.empty())
+    return NULL;
+
+  // Execute
+  cef_stream_reader_t* _retval = cef_stream_reader_create_for_mapped_file(
+      fileName.GetStruct());
+
+  // Return type: refptr_same
+  return CefStreamReaderCToCpp::Wrap(_retval);
+}
+
 CefRefPtr<CefStreamReader> CefStreamReader::CreateForData(void* data,
     size_t size) {
   // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
@@ -146,6 +163,30 @@ bool CefStreamReaderCToCpp::MayBlock() {
   return _retval?true:false;
 }
 
+const void* CefStreamReaderCToCpp::GetData() {
+  if (CEF_MEMBER_MISSING(struct_, get_data))
+    return NULL;
+
+  // Execute
+  const void* _retval = struct_->get_data(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
+size_t CefStreamReaderCToCpp::GetDataSize() {
+  if (CEF_MEMBER_MISSING(struct_, get_data_size))
+    return 0;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  size_t _retval = struct_->get_data_size(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
 
 #ifndef NDEBUG
 template<> long CefCToCpp<CefStreamReaderCToCpp, CefStreamReader,
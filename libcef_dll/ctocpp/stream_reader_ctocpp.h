@@ -39,6 +39,8 @@ class CefStreamReaderCToCpp
   virtual int64 Tell() OVERRIDE;
   virtual int Eof() OVERRIDE;
   virtual bool MayBlock() OVERRIDE;
+  virtual const void* GetData() OVERRIDE;
+  virtual size_t GetDataSize() OVERRIDE;
 };
 
 #endif  // USING_CEF_SHARED
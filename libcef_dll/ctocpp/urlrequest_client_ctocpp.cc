@@ -95,6 +95,34 @@ void CefURLRequestClientCToCpp::OnDownloadData(CefRefPtr<CefURLRequest> request,
       data_length);
 }
 
+size_t CefURLRequestClientCToCpp::GetDownloadWindowSize() {
+  if (CEF_MEMBER_MISSING(struct_, get_download_window_size))
+    return 0;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  size_t _retval = struct_->get_download_window_size(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
+CefString CefURLRequestClientCToCpp::GetDownloadFilePath() {
+  if (CEF_MEMBER_MISSING(struct_, get_download_file_path))
+    return CefString();
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_string_userfree_t _retval = struct_->get_download_file_path(struct_);
+
+  // Return type: string
+  CefString _retvalStr;
+  _retvalStr.AttachToUserFree(_retval);
+  return _retvalStr;
+}
+
 bool CefURLRequestClientCToCpp::GetAuthCredentials(bool isProxy,
     const CefString& host, int port, const CefString& realm,
     const CefString& scheme, CefRefPtr<CefAuthCallback> callback) {
@@ -41,6 +41,8 @@ class CefURLRequestClientCToCpp
       uint64 current, uint64 total) OVERRIDE;
   virtual void OnDownloadData(CefRefPtr<CefURLRequest> request,
       const void* data, size_t data_length) OVERRIDE;
+  virtual size_t GetDownloadWindowSize() OVERRIDE;
+  virtual CefString GetDownloadFilePath() OVERRIDE;
   virtual bool GetAuthCredentials(bool isProxy, const CefString& host, int port,
       const CefString& realm, const CefString& scheme,
       CefRefPtr<CefAuthCallback> callback) OVERRIDE;
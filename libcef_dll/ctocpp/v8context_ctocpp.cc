@@ -10,7 +10,9 @@
 // for more information.
 //
 
+#include "libcef_dll/ctocpp/binary_value_ctocpp.h"
 #include "libcef_dll/ctocpp/browser_ctocpp.h"
+#include "libcef_dll/ctocpp/dictionary_value_ctocpp.h"
 #include "libcef_dll/ctocpp/frame_ctocpp.h"
 #include "libcef_dll/ctocpp/task_runner_ctocpp.h"
 #include "libcef_dll/ctocpp/v8context_ctocpp.h"
@@ -50,6 +52,55 @@ bool CefV8Context::InContext() {
   return _retval?true:false;
 }
 
+bool CefV8Context::PrecompileScript(const CefString& code,
+    const CefString& script_url, int start_line,
+    CefRefPtr<CefBinaryValue> cached_data) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: code; type: string_byref_const
+  DCHECK(!code.empty());
+  if (code.empty())
+    return false;
+  // Unverified params: script_url, cached_data
+
+  // Execute
+  int _retval = cef_v8context_precompile_script(
+      code.GetStruct(),
+      script_url.GetStruct(),
+      start_line,
+      CefBinaryValueCToCpp::Unwrap(cached_data));
+
+  // Return type: bool
+  return _retval?true:false;
+}
+
+CefRefPtr<CefBinaryValue> CefV8Context::GetScriptCacheData(
+    const CefString& code) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: code; type: string_byref_const
+  DCHECK(!code.empty());
+  if (code.empty())
+    return NULL;
+
+  // Execute
+  cef_binary_value_t* _retval = cef_v8context_get_script_cache_data(
+      code.GetStruct());
+
+  // Return type: refptr_same
+  return CefBinaryValueCToCpp::Wrap(_retval);
+}
+
+void CefV8Context::SetWrapperBudget(int persistent_handle_limit,
+    int64 tracked_memory_limit) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_v8context_set_wrapper_budget(
+      persistent_handle_limit,
+      tracked_memory_limit);
+}
+
 
 // VIRTUAL METHODS - Body may be edited by hand.
 
@@ -213,6 +264,19 @@ bool CefV8ContextCToCpp::Eval(const CefString& code,
   return _retval?true:false;
 }
 
+CefRefPtr<CefDictionaryValue> CefV8ContextCToCpp::GetStatistics() {
+  if (CEF_MEMBER_MISSING(struct_, get_statistics))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_dictionary_value_t* _retval = struct_->get_statistics(struct_);
+
+  // Return type: refptr_same
+  return CefDictionaryValueCToCpp::Wrap(_retval);
+}
+
 
 #ifndef NDEBUG
 template<> long CefCToCpp<CefV8ContextCToCpp, CefV8Context,
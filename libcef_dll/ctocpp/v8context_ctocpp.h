@@ -42,6 +42,7 @@ class CefV8ContextCToCpp
   virtual bool IsSame(CefRefPtr<CefV8Context> that) OVERRIDE;
   virtual bool Eval(const CefString& code, CefRefPtr<CefV8Value>& retval,
       CefRefPtr<CefV8Exception>& exception) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> GetStatistics() OVERRIDE;
 };
 
 #endif  // USING_CEF_SHARED
@@ -0,0 +1,108 @@
+// Copyright (c) 2014 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// This file was generated by the CEF translator tool. If making changes by
+// hand only do so within the body of existing method and function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#include "libcef_dll/ctocpp/v8fast_handler_ctocpp.h"
+#include "libcef_dll/transfer_util.h"
+
+
+// VIRTUAL METHODS - Body may be edited by hand.
+
+int CefV8FastHandlerCToCpp::GetArgumentCount() {
+  if (CEF_MEMBER_MISSING(struct_, get_argument_count))
+    return 0;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  int _retval = struct_->get_argument_count(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
+CefV8FastHandler::Type CefV8FastHandlerCToCpp::GetArgumentType(int index) {
+  if (CEF_MEMBER_MISSING(struct_, get_argument_type))
+    return V8_FAST_TYPE_VOID;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_v8_fast_type_t _retval = struct_->get_argument_type(struct_,
+      index);
+
+  // Return type: simple
+  return _retval;
+}
+
+CefV8FastHandler::Type CefV8FastHandlerCToCpp::GetReturnType() {
+  if (CEF_MEMBER_MISSING(struct_, get_return_type))
+    return V8_FAST_TYPE_VOID;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_v8_fast_type_t _retval = struct_->get_return_type(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
+bool CefV8FastHandlerCToCpp::Execute(const CefString& name,
+    const std::vector<double>& numbers, const std::vector<CefString>& strings,
+    double& number_retval, CefString& string_retval, CefString& exception) {
+  if (CEF_MEMBER_MISSING(struct_, execute))
+    return false;
+
+  // Verify param: name; type: string_byref_const
+  DCHECK(!name.empty());
+  if (name.empty())
+    return false;
+
+  // Translate param: numbers; type: simple_vec_byref_const
+  // The vector storage is passed directly to avoid a copy for each call.
+  const size_t numbersCount = numbers.size();
+  const double* numbersList = numbersCount > 0 ? &numbers[0] : NULL;
+  // Translate param: strings; type: string_vec_byref_const
+  // The list is only allocated when there are string arguments. NULL is
+  // passed for an empty list.
+  cef_string_list_t stringsList = NULL;
+  if (!strings.empty()) {
+    stringsList = cef_string_list_alloc();
+    DCHECK(stringsList);
+    if (stringsList)
+      transfer_string_list_contents(strings, stringsList);
+  }
+
+  // Execute
+  int _retval = struct_->execute(struct_,
+      name.GetStruct(),
+      numbersCount,
+      numbersList,
+      stringsList,
+      &number_retval,
+      string_retval.GetWritableStruct(),
+      exception.GetWritableStruct());
+
+  // Restore param:strings; type: string_vec_byref_const
+  if (stringsList)
+    cef_string_list_free(stringsList);
+
+  // Return type: bool
+  return _retval?true:false;
+}
+
+
+#ifndef NDEBUG
+template<> long CefCToCpp<CefV8FastHandlerCToCpp, CefV8FastHandler,
+    cef_v8fast_handler_t>::DebugObjCt = 0;
+#endif
+
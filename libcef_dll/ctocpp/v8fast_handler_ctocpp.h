@@ -0,0 +1,49 @@
+// Copyright (c) 2014 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// This file was generated by the CEF translator tool. If making changes by
+// hand only do so within the body of existing method and function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#ifndef CEF_LIBCEF_DLL_CTOCPP_V8FAST_HANDLER_CTOCPP_H_
+#define CEF_LIBCEF_DLL_CTOCPP_V8FAST_HANDLER_CTOCPP_H_
+#pragma once
+
+#ifndef BUILDING_CEF_SHARED
+#pragma message("Warning: "__FILE__" may be accessed DLL-side only")
+#else  // BUILDING_CEF_SHARED
+
+#include <vector>
+#include "include/cef_v8.h"
+#include "include/capi/cef_v8_capi.h"
+#include "libcef_dll/ctocpp/ctocpp.h"
+
+// Wrap a C structure with a C++ class.
+// This class may be instantiated and accessed DLL-side only.
+class CefV8FastHandlerCToCpp
+    : public CefCToCpp<CefV8FastHandlerCToCpp, CefV8FastHandler,
+        cef_v8fast_handler_t> {
+ public:
+  explicit CefV8FastHandlerCToCpp(cef_v8fast_handler_t* str)
+      : CefCToCpp<CefV8FastHandlerCToCpp, CefV8FastHandler,
+          cef_v8fast_handler_t>(str) {}
+  virtual ~CefV8FastHandlerCToCpp() {}
+
+  // CefV8FastHandler methods
+  virtual int GetArgumentCount() OVERRIDE;
+  virtual Type GetArgumentType(int index) OVERRIDE;
+  virtual Type GetReturnType() OVERRIDE;
+  virtual bool Execute(const CefString& name,
+      const std::vector<double>& numbers,
+      const std::vector<CefString>& strings, double& number_retval,
+      CefString& string_retval, CefString& exception) OVERRIDE;
+};
+
+#endif  // BUILDING_CEF_SHARED
+#endif  // CEF_LIBCEF_DLL_CTOCPP_V8FAST_HANDLER_CTOCPP_H_
+
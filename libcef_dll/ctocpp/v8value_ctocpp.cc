@@ -12,7 +12,10 @@
 
 #include "libcef_dll/cpptoc/base_cpptoc.h"
 #include "libcef_dll/cpptoc/v8accessor_cpptoc.h"
+#include "libcef_dll/cpptoc/v8fast_handler_cpptoc.h"
 #include "libcef_dll/cpptoc/v8handler_cpptoc.h"
+#include "libcef_dll/ctocpp/dictionary_value_ctocpp.h"
+#include "libcef_dll/ctocpp/list_value_ctocpp.h"
 #include "libcef_dll/ctocpp/v8context_ctocpp.h"
 #include "libcef_dll/ctocpp/v8exception_ctocpp.h"
 #include "libcef_dll/ctocpp/v8value_ctocpp.h"
@@ -156,6 +159,73 @@ CefRefPtr<CefV8Value> CefV8Value::CreateFunction(const CefString& name,
   return CefV8ValueCToCpp::Wrap(_retval);
 }
 
+CefRefPtr<CefV8Value> CefV8Value::CreateFastFunction(const CefString& name,
+    CefRefPtr<CefV8FastHandler> handler) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: name; type: string_byref_const
+  DCHECK(!name.empty());
+  if (name.empty())
+    return NULL;
+  // Verify param: handler; type: refptr_diff
+  DCHECK(handler.get());
+  if (!handler.get())
+    return NULL;
+
+  // Execute
+  cef_v8value_t* _retval = cef_v8value_create_fast_function(
+      name.GetStruct(),
+      CefV8FastHandlerCppToC::Wrap(handler));
+
+  // Return type: refptr_same
+  return CefV8ValueCToCpp::Wrap(_retval);
+}
+
+CefRefPtr<CefV8Value> CefV8Value::CreateArrayBuffer(size_t length) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_v8value_t* _retval = cef_v8value_create_array_buffer(
+      length);
+
+  // Return type: refptr_same
+  return CefV8ValueCToCpp::Wrap(_retval);
+}
+
+CefRefPtr<CefV8Value> CefV8Value::CreateFromDictionary(
+    CefRefPtr<CefDictionaryValue> value) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: value; type: refptr_same
+  DCHECK(value.get());
+  if (!value.get())
+    return NULL;
+
+  // Execute
+  cef_v8value_t* _retval = cef_v8value_create_from_dictionary(
+      CefDictionaryValueCToCpp::Unwrap(value));
+
+  // Return type: refptr_same
+  return CefV8ValueCToCpp::Wrap(_retval);
+}
+
+CefRefPtr<CefV8Value> CefV8Value::CreateFromList(
+    CefRefPtr<CefListValue> value) {
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Verify param: value; type: refptr_same
+  DCHECK(value.get());
+  if (!value.get())
+    return NULL;
+
+  // Execute
+  cef_v8value_t* _retval = cef_v8value_create_from_list(
+      CefListValueCToCpp::Unwrap(value));
+
+  // Return type: refptr_same
+  return CefV8ValueCToCpp::Wrap(_retval);
+}
+
 
 // VIRTUAL METHODS - Body may be edited by hand.
 
@@ -315,6 +385,32 @@ bool CefV8ValueCToCpp::IsFunction() {
   return _retval?true:false;
 }
 
+bool CefV8ValueCToCpp::IsArrayBuffer() {
+  if (CEF_MEMBER_MISSING(struct_, is_array_buffer))
+    return false;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  int _retval = struct_->is_array_buffer(struct_);
+
+  // Return type: bool
+  return _retval?true:false;
+}
+
+bool CefV8ValueCToCpp::IsTypedArray() {
+  if (CEF_MEMBER_MISSING(struct_, is_typed_array))
+    return false;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  int _retval = struct_->is_typed_array(struct_);
+
+  // Return type: bool
+  return _retval?true:false;
+}
+
 bool CefV8ValueCToCpp::IsSame(CefRefPtr<CefV8Value> that) {
   if (CEF_MEMBER_MISSING(struct_, is_same))
     return false;
@@ -691,6 +787,32 @@ bool CefV8ValueCToCpp::GetKeys(std::vector<CefString>& keys) {
   return _retval?true:false;
 }
 
+CefRefPtr<CefDictionaryValue> CefV8ValueCToCpp::ToDictionary() {
+  if (CEF_MEMBER_MISSING(struct_, to_dictionary))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_dictionary_value_t* _retval = struct_->to_dictionary(struct_);
+
+  // Return type: refptr_same
+  return CefDictionaryValueCToCpp::Wrap(_retval);
+}
+
+CefRefPtr<CefListValue> CefV8ValueCToCpp::ToList() {
+  if (CEF_MEMBER_MISSING(struct_, to_list))
+    return NULL;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  cef_list_value_t* _retval = struct_->to_list(struct_);
+
+  // Return type: refptr_same
+  return CefListValueCToCpp::Wrap(_retval);
+}
+
 bool CefV8ValueCToCpp::SetUserData(CefRefPtr<CefBase> user_data) {
   if (CEF_MEMBER_MISSING(struct_, set_user_data))
     return false;
@@ -760,6 +882,30 @@ int CefV8ValueCToCpp::GetArrayLength() {
   return _retval;
 }
 
+void* CefV8ValueCToCpp::GetArrayBufferData() {
+  if (CEF_MEMBER_MISSING(struct_, get_array_buffer_data))
+    return NULL;
+
+  // Execute
+  void* _retval = struct_->get_array_buffer_data(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
+size_t CefV8ValueCToCpp::GetArrayBufferByteLength() {
+  if (CEF_MEMBER_MISSING(struct_, get_array_buffer_byte_length))
+    return 0;
+
+  // AUTO-GENERATED CONTENT - DELETE THIS COMMENT BEFORE MODIFYING
+
+  // Execute
+  size_t _retval = struct_->get_array_buffer_byte_length(struct_);
+
+  // Return type: simple
+  return _retval;
+}
+
 CefString CefV8ValueCToCpp::GetFunctionName() {
   if (CEF_MEMBER_MISSING(struct_, get_function_name))
     return CefString();
@@ -45,6 +45,8 @@ class CefV8ValueCToCpp
   virtual bool IsObject() OVERRIDE;
   virtual bool IsArray() OVERRIDE;
   virtual bool IsFunction() OVERRIDE;
+  virtual bool IsArrayBuffer() OVERRIDE;
+  virtual bool IsTypedArray() OVERRIDE;
   virtual bool IsSame(CefRefPtr<CefV8Value> that) OVERRIDE;
   virtual bool GetBoolValue() OVERRIDE;
   virtual int32 GetIntValue() OVERRIDE;
@@ -70,11 +72,15 @@ class CefV8ValueCToCpp
   virtual bool SetValue(const CefString& key, AccessControl settings,
       PropertyAttribute attribute) OVERRIDE;
   virtual bool GetKeys(std::vector<CefString>& keys) OVERRIDE;
+  virtual CefRefPtr<CefDictionaryValue> ToDictionary() OVERRIDE;
+  virtual CefRefPtr<CefListValue> ToList() OVERRIDE;
   virtual bool SetUserData(CefRefPtr<CefBase> user_data) OVERRIDE;
   virtual CefRefPtr<CefBase> GetUserData() OVERRIDE;
   virtual int GetExternallyAllocatedMemory() OVERRIDE;
   virtual int AdjustExternallyAllocatedMemory(int change_in_bytes) OVERRIDE;
   virtual int GetArrayLength() OVERRIDE;
+  virtual void* GetArrayBufferData() OVERRIDE;
+  virtual size_t GetArrayBufferByteLength() OVERRIDE;
   virtual CefString GetFunctionName() OVERRIDE;
   virtual CefRefPtr<CefV8Handler> GetFunctionHandler() OVERRIDE;
   virtual CefRefPtr<CefV8Value> ExecuteFunction(CefRefPtr<CefV8Value> object,
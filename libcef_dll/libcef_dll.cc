@@ -100,6 +100,7 @@
 #include "libcef_dll/ctocpp/task_ctocpp.h"
 #include "libcef_dll/ctocpp/urlrequest_client_ctocpp.h"
 #include "libcef_dll/ctocpp/v8accessor_ctocpp.h"
+#include "libcef_dll/ctocpp/v8fast_handler_ctocpp.h"
 #include "libcef_dll/ctocpp/v8handler_ctocpp.h"
 #include "libcef_dll/ctocpp/web_plugin_info_visitor_ctocpp.h"
 #include "libcef_dll/ctocpp/web_plugin_unstable_callback_ctocpp.h"
@@ -236,6 +237,7 @@ CEF_EXPORT void cef_shutdown() {
   DCHECK_EQ(CefV8AccessorCToCpp::DebugObjCt, 0);
   DCHECK_EQ(CefV8ContextCppToC::DebugObjCt, 0);
   DCHECK_EQ(CefV8ExceptionCppToC::DebugObjCt, 0);
+  DCHECK_EQ(CefV8FastHandlerCToCpp::DebugObjCt, 0);
   DCHECK_EQ(CefV8HandlerCToCpp::DebugObjCt, 0);
   DCHECK_EQ(CefV8StackFrameCppToC::DebugObjCt, 0);
   DCHECK_EQ(CefV8StackTraceCppToC::DebugObjCt, 0);
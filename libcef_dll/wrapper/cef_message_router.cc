@@ -4,8 +4,10 @@
 
 #include "include/wrapper/cef_message_router.h"
 
+#include <algorithm>
 #include <map>
 #include <set>
+#include <vector>
 
 #include "include/cef_runnable.h"
 #include "include/cef_task.h"
@@ -26,6 +28,30 @@ const char kMemberRequest[] = "request";
 const char kMemberOnSuccess[] = "onSuccess";
 const char kMemberOnFailure[] = "onFailure";
 const char kMemberPersistent[] = "persistent";
+const char kMemberCoalesce[] = "coalesce";
+
+// Values for the cefQuery coalesce member.
+const char kCoalesceLatest[] = "latest";
+const char kCoalesceBatch[] = "batch";
+
+// Appended to the JS query function name for the credit IPC message.
+const char kCreditMessageSuffix[] = "CreditMsg";
+
+// How responses to a persistent query are delivered.
+enum CoalesceMode {
+  // Every response is delivered as a separate onSuccess call.
+  COALESCE_NONE = 0,
+  // Only the most recent undelivered response is kept.
+  COALESCE_LATEST,
+  // Undelivered responses are delivered together as an array.
+  COALESCE_BATCH
+};
+
+// Number of responses to a coalescing query that the browser may send before
+// the renderer returns credits, and the number of credits that the renderer
+// returns at a time.
+const int kCoalesceCredits = 4;
+const int kCoalesceCreditReturn = 2;
 
 // Default error information when a query is canceled.
 const int kCanceledErrorCode = -1;
@@ -42,6 +68,136 @@ bool ValidateConfig(CefMessageRouterConfig& config) {
   return true;
 }
 
+// Copy the value at |source_index| of |source| to |target_index| of |target|.
+// Binary, dictionary and list values are copied because they remain owned by
+// |source|.
+void CopyListItem(CefRefPtr<CefListValue> source,
+                  int source_index,
+                  CefRefPtr<CefListValue> target,
+                  int target_index) {
+  switch (source->GetType(source_index)) {
+    case VTYPE_BOOL:
+      target->SetBool(target_index, source->GetBool(source_index));
+      break;
+    case VTYPE_INT:
+      target->SetInt(target_index, source->GetInt(source_index));
+      break;
+    case VTYPE_DOUBLE:
+      target->SetDouble(target_index, source->GetDouble(source_index));
+      break;
+    case VTYPE_STRING:
+      target->SetString(target_index, source->GetString(source_index));
+      break;
+    case VTYPE_BINARY:
+      target->SetBinary(target_index, source->GetBinary(source_index));
+      break;
+    case VTYPE_DICTIONARY:
+      target->SetDictionary(target_index,
+                            source->GetDictionary(source_index));
+      break;
+    case VTYPE_LIST:
+      target->SetList(target_index, source->GetList(source_index));
+      break;
+    default:
+      target->SetNull(target_index);
+      break;
+  }
+}
+
+// Move the value at |source_index| of |source| to |target_index| of |target|.
+// Binary, dictionary and list values are detached from |source| so that they
+// are not copied. Values of read-only lists can't be detached and are copied.
+void MoveListItem(CefRefPtr<CefListValue> source,
+                  int source_index,
+                  CefRefPtr<CefListValue> target,
+                  int target_index) {
+  if (source->IsReadOnly()) {
+    CopyListItem(source, source_index, target, target_index);
+    return;
+  }
+
+  switch (source->GetType(source_index)) {
+    case VTYPE_BINARY:
+      target->SetBinary(target_index, source->DetachBinary(source_index));
+      break;
+    case VTYPE_DICTIONARY:
+      target->SetDictionary(target_index,
+                            source->DetachDictionary(source_index));
+      break;
+    case VTYPE_LIST:
+      target->SetList(target_index, source->DetachList(source_index));
+      break;
+    default:
+      CopyListItem(source, source_index, target, target_index);
+      break;
+  }
+}
+
+// Create a V8 value from the value at |index| of |list|. Must be called with a
+// V8 context entered.
+CefRefPtr<CefV8Value> CreateV8Value(CefRefPtr<CefListValue> list, int index) {
+  switch (list->GetType(index)) {
+    case VTYPE_BOOL:
+      return CefV8Value::CreateBool(list->GetBool(index));
+    case VTYPE_INT:
+      return CefV8Value::CreateInt(list->GetInt(index));
+    case VTYPE_DOUBLE:
+      return CefV8Value::CreateDouble(list->GetDouble(index));
+    case VTYPE_STRING:
+      return CefV8Value::CreateString(list->GetString(index));
+    case VTYPE_BINARY: {
+      // Copy the bytes directly into a new ArrayBuffer owned by JavaScript.
+      CefRefPtr<CefBinaryValue> binary = list->GetBinary(index);
+      const size_t size = binary->GetSize();
+      CefRefPtr<CefV8Value> array_buffer = CefV8Value::CreateArrayBuffer(size);
+      if (!array_buffer.get())
+        return NULL;
+      if (size > 0)
+        binary->GetData(array_buffer->GetArrayBufferData(), size, 0);
+      return array_buffer;
+    }
+    case VTYPE_DICTIONARY:
+      return CefV8Value::CreateFromDictionary(list->GetDictionary(index));
+    case VTYPE_LIST:
+      return CefV8Value::CreateFromList(list->GetList(index));
+    default:
+      return CefV8Value::CreateNull();
+  }
+}
+
+// Set |index| of |list| to the request value |value|. Strings are stored as
+// strings, ArrayBuffers and typed arrays as binary values, arrays as lists and
+// other objects as dictionaries. Returns false if |value| can't be converted
+// or is an empty ArrayBuffer.
+bool SetRequestValue(CefRefPtr<CefListValue> list,
+                     int index,
+                     CefRefPtr<CefV8Value> value) {
+  if (value->IsString())
+    return list->SetString(index, value->GetStringValue());
+
+  if (value->IsArrayBuffer() || value->IsTypedArray()) {
+    // Binary values can't be empty.
+    const size_t length = value->GetArrayBufferByteLength();
+    if (length == 0)
+      return false;
+    CefRefPtr<CefBinaryValue> binary =
+        CefBinaryValue::Create(value->GetArrayBufferData(), length);
+    return binary.get() && list->SetBinary(index, binary);
+  }
+
+  if (value->IsArray()) {
+    CefRefPtr<CefListValue> request = value->ToList();
+    return request.get() && list->SetList(index, request);
+  }
+
+  if (value->IsObject() && !value->IsFunction()) {
+    CefRefPtr<CefDictionaryValue> request = value->ToDictionary();
+    return request.get() && list->SetDictionary(index, request);
+  }
+
+  return false;
+}
+
 // Helper template for generated ID values.
 template <typename T>
 class IdGenerator {
@@ -61,10 +217,15 @@ class IdGenerator {
   DISALLOW_COPY_AND_ASSIGN(IdGenerator);
 };
 
-// Browser-side router implementation.
+// Browser-side router implementation. Query bookkeeping is protected by the
+// router lock so that handlers can execute on any browser process thread.
+// Handler methods and CallbackImpl methods must not be called while the lock
+// is held.
 class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
  public:
-  // Implementation of the Callback interface.
+  // Implementation of the Callback interface. Responses are delivered to the
+  // router with the callback lock held so that a response sent on one thread
+  // can't overtake a response that was sent earlier on another thread.
   class CallbackImpl : public CefMessageRouterBrowserSide::Callback {
    public:
     CallbackImpl(CefRefPtr<CefMessageRouterBrowserSideImpl> router,
@@ -74,7 +235,8 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
         : router_(router),
           browser_id_(browser_id),
           query_id_(query_id),
-          persistent_(persistent) {
+          persistent_(persistent),
+          ready_(false) {
     }
     virtual ~CallbackImpl() {
       // Hitting this DCHECK means that you didn't call Success or Failure
@@ -84,61 +246,130 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
     }
 
     virtual void Success(const CefString& response) OVERRIDE {
-      if (!CefCurrentlyOn(TID_UI)) {
-        // Must execute on the UI thread to access member variables.
-        CefPostTask(TID_UI,
-            NewCefRunnableMethod(this, &CallbackImpl::Success, response));
-        return;
-      }
+      SendSuccess(response, NULL);
+    }
 
-      if (router_) {
-        CefPostTask(TID_UI,
-            NewCefRunnableMethod(
-                router_.get(),
-                &CefMessageRouterBrowserSideImpl::OnCallbackSuccess,
-                browser_id_, query_id_, response));
+    virtual void SuccessValue(CefRefPtr<CefListValue> response) OVERRIDE {
+      // Move the value into the response message without copying it.
+      CefRefPtr<CefListValue> response_value = CefListValue::Create();
+      MoveListItem(response, 0, response_value, 0);
+      SendSuccess(CefString(), response_value);
+    }
 
-        if (!persistent_) {
-          // Non-persistent callbacks are only good for a single use.
-          router_ = NULL;
-        }
+    virtual bool IsThrottled() OVERRIDE {
+      CefRefPtr<CefMessageRouterBrowserSideImpl> router;
+      {
+        AutoLock lock_scope(this);
+        router = router_;
       }
+      return router.get() && router->IsThrottled(browser_id_, query_id_);
     }
 
     virtual void Failure(int error_code,
                          const CefString& error_message) OVERRIDE {
-      if (!CefCurrentlyOn(TID_UI)) {
-        // Must execute on the UI thread to access member variables.
-        CefPostTask(TID_UI,
-            NewCefRunnableMethod(this, &CallbackImpl::Failure,
-                                 error_code, error_message));
+      AutoLock lock_scope(this);
+      if (!router_)
         return;
-      }
 
-      if (router_) {
-        CefPostTask(TID_UI,
-            NewCefRunnableMethod(
-                router_.get(),
-                &CefMessageRouterBrowserSideImpl::OnCallbackFailure,
-                browser_id_, query_id_, error_code, error_message));
+      // Failure always invalidates the callback.
+      CefRefPtr<CefMessageRouterBrowserSideImpl> router = router_;
+      router_ = NULL;
 
-        // Failure always invalidates the callback.
-        router_ = NULL;
-      }
+      Response response;
+      response.success = false;
+      response.error_code = error_code;
+      response.error_message = error_message;
+      if (ready_)
+        Deliver(router, response);
+      else
+        pending_responses_.push_back(response);
+    }
+
+    // Called by the router after the query has been registered. Responses
+    // sent before this call are delivered to |router| now and responses sent
+    // after this call are delivered immediately.
+    void SetReady(CefRefPtr<CefMessageRouterBrowserSideImpl> router) {
+      AutoLock lock_scope(this);
+      DCHECK(!ready_);
+      ready_ = true;
+      for (size_t i = 0; i < pending_responses_.size(); ++i)
+        Deliver(router, pending_responses_[i]);
+      pending_responses_.clear();
+    }
+
+    // Called by the router when the renderer has returned credits for a
+    // coalescing query. Delivering the held responses here keeps them ordered
+    // with responses that are sent concurrently.
+    void DeliverUndeliveredResponses() {
+      AutoLock lock_scope(this);
+      if (router_ && ready_)
+        router_->SendUndeliveredResponses(browser_id_, query_id_);
     }
 
     void Detach() {
-      CEF_REQUIRE_UI_THREAD();
+      AutoLock lock_scope(this);
       router_ = NULL;
+      pending_responses_.clear();
     }
 
    private:
+    // A response that was sent before the query was registered.
+    struct Response {
+      bool success;
+      CefString response;
+      CefRefPtr<CefListValue> response_value;
+      int error_code;
+      CefString error_message;
+    };
+    typedef std::vector<Response> ResponseList;
+
+    // |response_value| is used instead of |response| if it is non-NULL.
+    void SendSuccess(const CefString& response,
+                     CefRefPtr<CefListValue> response_value) {
+      AutoLock lock_scope(this);
+      if (!router_)
+        return;
+
+      CefRefPtr<CefMessageRouterBrowserSideImpl> router = router_;
+      if (!persistent_) {
+        // Non-persistent callbacks are only good for a single use.
+        router_ = NULL;
+      }
+
+      Response pending;
+      pending.success = true;
+      pending.response = response;
+      pending.response_value = response_value;
+      pending.error_code = 0;
+      if (ready_)
+        Deliver(router, pending);
+      else
+        pending_responses_.push_back(pending);
+    }
+
+    // Must be called with the lock held.
+    void Deliver(CefRefPtr<CefMessageRouterBrowserSideImpl> router,
+                 const Response& response) {
+      if (response.success) {
+        router->OnCallbackSuccess(browser_id_, query_id_, response.response,
+                                  response.response_value);
+      } else {
+        router->OnCallbackFailure(browser_id_, query_id_, response.error_code,
+                                  response.error_message);
+      }
+    }
+
     CefRefPtr<CefMessageRouterBrowserSideImpl> router_;
     const int browser_id_;
     const int64 query_id_;
     const bool persistent_;
 
+    // False until the query has been registered with the router.
+    bool ready_;
+    ResponseList pending_responses_;
+
     IMPLEMENT_REFCOUNTING(CefQueryCallbackImpl);
+    IMPLEMENT_LOCKING(CallbackImpl);
   };
 
   explicit CefMessageRouterBrowserSideImpl(const CefMessageRouterConfig& config)
@@ -146,31 +377,78 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
         query_message_name_(
           config.js_query_function.ToString() + kMessageSuffix),
         cancel_message_name_(
-          config.js_cancel_function.ToString() + kMessageSuffix) {
+          config.js_cancel_function.ToString() + kMessageSuffix),
+        credit_message_name_(
+          config.js_query_function.ToString() + kCreditMessageSuffix),
+        route_delimiter_(config.route_delimiter) {
   }
 
   virtual ~CefMessageRouterBrowserSideImpl() {
     // There should be no pending queries when the router is deleted.
     DCHECK(browser_query_info_map_.empty());
+    DCHECK(pending_query_map_.empty());
   }
 
   virtual bool AddHandler(Handler* handler, bool first) OVERRIDE {
     CEF_REQUIRE_UI_THREAD();
+    const CefThreadId thread_id = handler->GetThreadId();
+
+    AutoLock lock_scope(this);
+    if (!CanAddHandler(handler, thread_id))
+      return false;
     if (handler_set_.find(handler) == handler_set_.end()) {
       handler_set_.insert(
           first ? handler_set_.begin() : handler_set_.end(), handler);
+      handler_map_.insert(std::make_pair(handler, thread_id));
       return true;
     }
     return false;
   }
 
+  virtual bool AddHandler(Handler* handler,
+                          bool first,
+                          const CefString& route) OVERRIDE {
+    CEF_REQUIRE_UI_THREAD();
+    if (route.empty())
+      return false;
+
+    const CefThreadId thread_id = handler->GetThreadId();
+
+    AutoLock lock_scope(this);
+    if (!CanAddHandler(handler, thread_id))
+      return false;
+    HandlerList& handlers = route_map_[route].handlers;
+    if (std::find(handlers.begin(), handlers.end(), handler) !=
+        handlers.end()) {
+      return false;
+    }
+    handlers.insert(first ? handlers.begin() : handlers.end(), handler);
+    handler_map_.insert(std::make_pair(handler, thread_id));
+    return true;
+  }
+
   virtual bool RemoveHandler(Handler* handler) OVERRIDE {
     CEF_REQUIRE_UI_THREAD();
-    if (handler_set_.erase(handler) > 0) {
-      CancelPendingFor(NULL, handler, true);
-      return true;
+    {
+      AutoLock lock_scope(this);
+      if (handler_map_.erase(handler) == 0)
+        return false;
+
+      handler_set_.erase(handler);
+
+      // Route entries are kept so that their statistics remain available.
+      RouteMap::iterator it = route_map_.begin();
+      for (; it != route_map_.end(); ++it) {
+        HandlerList& handlers = it->second.handlers;
+        HandlerList::iterator it_handler =
+            std::find(handlers.begin(), handlers.end(), handler);
+        if (it_handler != handlers.end())
+          handlers.erase(it_handler);
+      }
     }
-    return false;
+
+    CancelPendingFor(NULL, handler, true);
+    return true;
   }
 
   virtual void CancelPending(CefRefPtr<CefBrowser> browser,
@@ -180,7 +458,7 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
 
   virtual int GetPendingCount(CefRefPtr<CefBrowser> browser,
                               Handler* handler) OVERRIDE {
-    CEF_REQUIRE_UI_THREAD();
+    AutoLock lock_scope(this);
 
     if (browser_query_info_map_.empty())
       return 0;
@@ -208,7 +486,7 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
         Handler* handler_;
         int count_;
       };
-    
+
       Visitor visitor(handler);
 
       if (browser.get()) {
@@ -231,6 +509,20 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
     return 0;
   }
 
+  virtual CefRefPtr<CefDictionaryValue> GetRouteStatistics() OVERRIDE {
+    CefRefPtr<CefDictionaryValue> statistics = CefDictionaryValue::Create();
+
+    AutoLock lock_scope(this);
+    statistics->SetDictionary(CefString(),
+                              CreateRouteStatistics(default_route_));
+
+    RouteMap::const_iterator it = route_map_.begin();
+    for (; it != route_map_.end(); ++it)
+      statistics->SetDictionary(it->first, CreateRouteStatistics(it->second));
+
+    return statistics;
+  }
+
   virtual void OnBeforeClose(CefRefPtr<CefBrowser> browser) OVERRIDE {
     CancelPendingFor(browser, NULL, false);
   }
@@ -255,65 +547,49 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
     const std::string& message_name = message->GetName();
     if (message_name == query_message_name_) {
       CefRefPtr<CefListValue> args = message->GetArgumentList();
-      DCHECK_EQ(args->GetSize(), 6U);
-
-      const int64 frame_id = CefInt64Set(args->GetInt(0), args->GetInt(1));
-      const int context_id = args->GetInt(2);
-      const int request_id = args->GetInt(3);
-      const CefString& request = args->GetString(4);
-      const bool persistent = args->GetBool(5);
-
-      if (handler_set_.empty()) {
-        // No handlers so cancel the query.
-        CancelUnhandledQuery(browser, context_id, request_id);
-        return true;
+      DCHECK_EQ(args->GetSize(), 7U);
+
+      PendingQuery* query = new PendingQuery;
+      query->browser = browser;
+      query->frame_id = CefInt64Set(args->GetInt(0), args->GetInt(1));
+      query->frame = browser->GetFrame(query->frame_id);
+      query->context_id = args->GetInt(2);
+      query->request_id = args->GetInt(3);
+      if (args->GetType(4) == VTYPE_STRING) {
+        query->request = args->GetString(4);
+      } else {
+        query->request_value = CefListValue::Create();
+        CopyListItem(args, 4, query->request_value, 0);
       }
-
-      const int browser_id = browser->GetIdentifier();
-      const int64 query_id = query_id_generator_.GetNextId();
-
-      CefRefPtr<CefFrame> frame = browser->GetFrame(frame_id);
-      CefRefPtr<CallbackImpl> callback(
-          new CallbackImpl(this, browser_id, query_id, persistent));
-    
-      // Make a copy of the handler list in case the user adds or removes a
-      // handler while we're iterating.
-      HandlerSet handler_set = handler_set_;
-
-      bool handled = false;
-      HandlerSet::const_iterator it_handler = handler_set.begin();
-      for (; it_handler != handler_set.end(); ++it_handler) {
-        handled = (*it_handler)->OnQuery(browser, frame, query_id, request,
-                                         persistent, callback.get());
-        if (handled)
-          break;
+      query->persistent = args->GetBool(5);
+      const int coalesce_mode = args->GetInt(6);
+      if (query->persistent && coalesce_mode > COALESCE_NONE &&
+          coalesce_mode <= COALESCE_BATCH) {
+        query->coalesce_mode = static_cast<CoalesceMode>(coalesce_mode);
       }
-
-      // If the query isn't handled nothing should be keeping a reference to
-      // the callback.
-      DCHECK(handled || callback->GetRefCt() == 1);
-
-      if (handled) {
-        // Persist the query information until the callback executes.
-        // It's safe to do this here because the callback will execute
-        // asynchronously.
-        QueryInfo* info = new QueryInfo;
-        info->browser = browser;
-        info->frame_id = frame_id;
-        info->context_id = context_id;
-        info->request_id = request_id;
-        info->persistent = persistent;
-        info->callback = callback;
-        info->handler = *(it_handler);
-        browser_query_info_map_.Add(browser_id, query_id, info);
-      } else {
-        // Invalidate the callback.
-        callback->Detach();
-
-        // No one chose to handle the query so cancel it.
-        CancelUnhandledQuery(browser, context_id, request_id);
+      query->start_time.Now();
+
+      {
+        AutoLock lock_scope(this);
+        query->query_id = query_id_generator_.GetNextId();
+        query->route = GetRouteInfo(query->request);
+        query->route->query_count++;
+
+        // Make a copy of the handler list in case the user adds or removes a
+        // handler while the query is being dispatched. Handlers for the route
+        // are offered the query first. Queries with a non-string request
+        // always use the default route, which has no handlers.
+        query->handlers = query->route->handlers;
+        query->handlers.insert(query->handlers.end(), handler_set_.begin(),
+                               handler_set_.end());
+
+        pending_query_map_.insert(std::make_pair(query->query_id, query));
       }
 
+      query->callback = new CallbackImpl(this, browser->GetIdentifier(),
+                                         query->query_id, query->persistent);
+
+      DispatchQuery(query);
       return true;
     } else if (message_name == cancel_message_name_) {
       CefRefPtr<CefListValue> args = message->GetArgumentList();
@@ -325,12 +601,83 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
 
       CancelPendingRequest(browser_id, context_id, request_id);
       return true;
+    } else if (message_name == credit_message_name_) {
+      CefRefPtr<CefListValue> args = message->GetArgumentList();
+      DCHECK_EQ(args->GetSize(), 3U);
+
+      const int browser_id = browser->GetIdentifier();
+      const int context_id = args->GetInt(0);
+      const int request_id = args->GetInt(1);
+      const int credits = args->GetInt(2);
+
+      OnCreditReceived(browser_id, context_id, request_id, credits);
+      return true;
     }
 
     return false;
   }
 
  private:
+  typedef std::vector<Handler*> HandlerList;
+
+  // Handlers and statistics for a route.
+  struct RouteInfo {
+    RouteInfo()
+        : query_count(0),
+          unhandled_count(0),
+          pending_count(0),
+          completed_count(0),
+          total_latency_ms(0),
+          max_latency_ms(0) {}
+
+    // Handlers in the order that they will be offered queries.
+    HandlerList handlers;
+
+    int query_count;
+    int unhandled_count;
+    int pending_count;
+    int completed_count;
+    int64 total_latency_ms;
+    int64 max_latency_ms;
+  };
+
+  // Structure representing a query that is being offered to handlers.
+  struct PendingQuery {
+    PendingQuery()
+        : coalesce_mode(COALESCE_NONE),
+          next_handler(0),
+          current_handler(NULL),
+          current_thread(TID_UI),
+          canceled(false),
+          notify_renderer(false) {}
+
+    CefRefPtr<CefBrowser> browser;
+    CefRefPtr<CefFrame> frame;
+    int64 frame_id;
+    int context_id;
+    int request_id;
+    CefString request;
+    // Non-NULL if the request is not a string.
+    CefRefPtr<CefListValue> request_value;
+    bool persistent;
+    CoalesceMode coalesce_mode;
+    int64 query_id;
+    RouteInfo* route;
+    CefTime start_time;
+    CefRefPtr<CallbackImpl> callback;
+
+    // Handlers that will be offered the query, the index of the next handler
+    // and the handler that is currently executing OnQuery, if any.
+    HandlerList handlers;
+    size_t next_handler;
+    Handler* current_handler;
+    CefThreadId current_thread;
+
+    // Set if the query is canceled while it is being dispatched.
+    bool canceled;
+    bool notify_renderer;
+  };
+
   // Structure representing a pending query.
   struct QueryInfo {
     // Browser and frame originated the query.
@@ -346,19 +693,245 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
     // True if the query is persistent.
     bool persistent;
 
+    // How responses are delivered, the number of responses that may be sent
+    // before the renderer returns credits and the responses that are waiting
+    // for credits. Only used by persistent queries that coalesce responses.
+    CoalesceMode coalesce_mode;
+    int credits;
+    CefRefPtr<CefListValue> undelivered_responses;
+
     // Callback associated with the query that must be detached when the query
     // is canceled.
     CefRefPtr<CallbackImpl> callback;
 
-    // Handler that should be notified if the query is automatically canceled.
+    // Handler that should be notified if the query is automatically canceled
+    // and the thread that the handler executes on.
     Handler* handler;
+    CefThreadId handler_thread;
+
+    // Route that the query was dispatched to and the time it was received.
+    RouteInfo* route;
+    CefTime start_time;
   };
 
+  typedef CefBrowserInfoMap<int64, QueryInfo*> BrowserQueryInfoMap;
+
+  // Offer |query| to the remaining handlers. Executes on the thread of the
+  // next handler.
+  void DispatchQuery(PendingQuery* query) {
+    while (true) {
+      Handler* handler = NULL;
+      {
+        AutoLock lock_scope(this);
+        query->current_handler = NULL;
+
+        // Skip handlers that have been removed since the query was received.
+        HandlerMap::const_iterator it_handler = handler_map_.end();
+        while (!query->canceled &&
+               query->next_handler < query->handlers.size()) {
+          it_handler = handler_map_.find(query->handlers[query->next_handler]);
+          if (it_handler != handler_map_.end())
+            break;
+          query->next_handler++;
+        }
+
+        if (query->canceled || query->next_handler == query->handlers.size())
+          break;
+
+        if (!CefCurrentlyOn(it_handler->second)) {
+          // Continue on the handler's thread.
+          if (CefPostTask(it_handler->second,
+                  NewCefRunnableMethod(this,
+                      &CefMessageRouterBrowserSideImpl::DispatchQuery,
+                      query))) {
+            return;
+          }
+
+          // The handler's thread is no longer running so fail the query
+          // instead of leaving it pending.
+          break;
+        }
+
+        handler = it_handler->first;
+        query->next_handler++;
+        query->current_handler = handler;
+        query->current_thread = it_handler->second;
+      }
+
+      bool handled;
+      if (query->request_value.get()) {
+        handled = handler->OnQueryValue(query->browser, query->frame,
+                                        query->query_id, query->request_value,
+                                        query->persistent,
+                                        query->callback.get());
+      } else {
+        handled = handler->OnQuery(query->browser, query->frame,
+                                   query->query_id, query->request,
+                                   query->persistent, query->callback.get());
+      }
+      if (handled) {
+        OnQueryHandled(query, handler);
+        return;
+      }
+    }
+
+    OnQueryUnhandled(query);
+  }
+
+  // Called on the handler's thread after |handler| accepts |query|.
+  void OnQueryHandled(PendingQuery* query, Handler* handler) {
+    const int browser_id = query->browser->GetIdentifier();
+    const int64 query_id = query->query_id;
+    // |info| may be deleted by another thread once it has been added to the
+    // map so keep a reference to the callback.
+    CefRefPtr<CallbackImpl> callback = query->callback;
+
+    QueryInfo* info = new QueryInfo;
+    info->browser = query->browser;
+    info->frame_id = query->frame_id;
+    info->context_id = query->context_id;
+    info->request_id = query->request_id;
+    info->persistent = query->persistent;
+    info->coalesce_mode = query->coalesce_mode;
+    info->credits = kCoalesceCredits;
+    info->callback = query->callback;
+    info->handler = handler;
+    info->handler_thread = query->current_thread;
+    info->route = query->route;
+    info->start_time = query->start_time;
+
+    bool canceled;
+    bool notify_renderer;
+    {
+      AutoLock lock_scope(this);
+      pending_query_map_.erase(query_id);
+      canceled = query->canceled;
+      notify_renderer = query->notify_renderer;
+      if (!canceled) {
+        // Persist the query information until the callback executes.
+        browser_query_info_map_.Add(browser_id, query_id, info);
+        info->route->pending_count++;
+      }
+    }
+    delete query;
+
+    if (canceled) {
+      CancelQuery(query_id, info, notify_renderer);
+      return;
+    }
+
+    // Deliver any responses that were sent while the query was being
+    // dispatched.
+    callback->SetReady(this);
+  }
+
+  // Called after all handlers have declined |query|, the query has been
+  // canceled during dispatch or the query can't be posted to the thread of the
+  // next handler.
+  void OnQueryUnhandled(PendingQuery* query) {
+    bool canceled;
+    bool notify_renderer;
+    {
+      AutoLock lock_scope(this);
+      pending_query_map_.erase(query->query_id);
+      canceled = query->canceled;
+      notify_renderer = query->notify_renderer;
+      query->route->unhandled_count++;
+    }
+
+    // If the query isn't handled nothing should be keeping a reference to
+    // the callback.
+    DCHECK(canceled || query->callback->GetRefCt() == 1);
+
+    // Invalidate the callback.
+    query->callback->Detach();
+
+    // No one chose to handle the query so cancel it.
+    if (!canceled || notify_renderer) {
+      CancelUnhandledQuery(query->browser, query->context_id,
+                           query->request_id);
+    }
+
+    delete query;
+  }
+
+  // Returns true if |handler| may be added to execute on |thread_id|. A handler
+  // that is added more than once must always use the same thread. Must be
+  // called with the lock held.
+  bool CanAddHandler(Handler* handler, CefThreadId thread_id) {
+    switch (thread_id) {
+      case TID_UI:
+      case TID_DB:
+      case TID_FILE:
+      case TID_FILE_USER_BLOCKING:
+      case TID_PROCESS_LAUNCHER:
+      case TID_CACHE:
+      case TID_IO:
+        break;
+      default:
+        // Not a browser process thread.
+        return false;
+    }
+
+    HandlerMap::const_iterator it = handler_map_.find(handler);
+    return (it == handler_map_.end() || it->second == thread_id);
+  }
+
+  // Returns the route for |request|, or |default_route_| if no handlers have
+  // been added for the route. Must be called with the lock held.
+  RouteInfo* GetRouteInfo(const CefString& request) {
+    if (route_map_.empty())
+      return &default_route_;
+
+    const CefString::char_type* str = request.c_str();
+    const size_t length = request.length();
+    size_t route_length = 0;
+    while (route_length < length && str[route_length] != route_delimiter_)
+      ++route_length;
+
+    RouteMap::iterator it =
+        route_map_.find(CefString(str, route_length, false));
+    if (it != route_map_.end())
+      return &it->second;
+    return &default_route_;
+  }
+
+  static CefRefPtr<CefDictionaryValue> CreateRouteStatistics(
+      const RouteInfo& route) {
+    CefRefPtr<CefDictionaryValue> statistics = CefDictionaryValue::Create();
+    statistics->SetInt("query_count", route.query_count);
+    statistics->SetInt("unhandled_count", route.unhandled_count);
+    statistics->SetInt("pending_count", route.pending_count);
+    statistics->SetInt("completed_count", route.completed_count);
+    statistics->SetDouble("total_latency_ms",
+                          static_cast<double>(route.total_latency_ms));
+    statistics->SetDouble("max_latency_ms",
+                          static_cast<double>(route.max_latency_ms));
+    return statistics;
+  }
+
+  // Update the route statistics for a query that is being completed via the
+  // Callback. Must be called with the lock held.
+  void OnQueryCompleted(QueryInfo* info) {
+    CefTime now;
+    now.Now();
+    int64 latency_ms = info->start_time.Delta(now);
+    if (latency_ms < 0)
+      latency_ms = 0;
+
+    RouteInfo* route = info->route;
+    route->pending_count--;
+    route->completed_count++;
+    route->total_latency_ms += latency_ms;
+    route->max_latency_ms = std::max(route->max_latency_ms, latency_ms);
+  }
+
   // Retrieve a QueryInfo object from the map based on the browser-side query
   // ID. If |always_remove| is true then the QueryInfo object will always be
   // removed from the map. Othewise, the QueryInfo object will only be removed
   // if the query is non-persistent. If |removed| is true the caller is
-  // responsible for deleting the returned QueryInfo object.
+  // responsible for deleting the returned QueryInfo object. Must be called
+  // with the lock held.
   QueryInfo* GetQueryInfo(int browser_id,
                           int64 query_id,
                           bool always_remove,
@@ -392,54 +965,203 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
     return info;
   }
 
-  // Called by CallbackImpl on success.
+  // Add a response to the undelivered responses of a coalescing query. Must be
+  // called with the lock held.
+  void AddUndeliveredResponse(QueryInfo* info,
+                              const CefString& response,
+                              CefRefPtr<CefListValue> response_value) {
+    if (!info->undelivered_responses.get() ||
+        info->coalesce_mode == COALESCE_LATEST) {
+      // Replace any response that has not been delivered yet.
+      info->undelivered_responses = CefListValue::Create();
+    }
+
+    CefRefPtr<CefListValue> responses = info->undelivered_responses;
+    const int index = static_cast<int>(responses->GetSize());
+    if (response_value.get())
+      MoveListItem(response_value, 0, responses, index);
+    else
+      responses->SetString(index, response);
+  }
+
+  // Returns the undelivered responses of a coalescing query as a list with the
+  // value to send at index 0. Must be called with the lock held.
+  CefRefPtr<CefListValue> TakeUndeliveredResponses(QueryInfo* info) {
+    CefRefPtr<CefListValue> responses = info->undelivered_responses;
+    info->undelivered_responses = NULL;
+    if (info->coalesce_mode == COALESCE_LATEST)
+      return responses;
+
+    // Batched responses are delivered as an array.
+    CefRefPtr<CefListValue> response_value = CefListValue::Create();
+    response_value->SetList(0, responses);
+    return response_value;
+  }
+
+  // Called when the renderer has consumed responses to a coalescing query.
+  void OnCreditReceived(int browser_id,
+                        int context_id,
+                        int request_id,
+                        int credits) {
+    class Visitor : public BrowserQueryInfoMap::Visitor {
+     public:
+      Visitor(int context_id, int request_id)
+          : context_id_(context_id),
+            request_id_(request_id),
+            info_(NULL) {}
+
+      virtual bool OnNextInfo(int browser_id,
+                              InfoIdType info_id,
+                              InfoObjectType info,
+                              bool* remove) OVERRIDE {
+        if (info->context_id == context_id_ &&
+            info->request_id == request_id_) {
+          info_ = info;
+          return false;
+        }
+        return true;
+      }
+
+      QueryInfo* info() const { return info_; }
+
+     private:
+      const int context_id_;
+      const int request_id_;
+      QueryInfo* info_;
+    };
+
+    CefRefPtr<CallbackImpl> callback;
+    {
+      AutoLock lock_scope(this);
+      Visitor visitor(context_id, request_id);
+      browser_query_info_map_.FindAll(browser_id, &visitor);
+      QueryInfo* info = visitor.info();
+      if (!info || info->coalesce_mode == COALESCE_NONE || credits <= 0)
+        return;
+
+      info->credits = std::min(info->credits + credits, kCoalesceCredits);
+      if (!info->undelivered_responses.get())
+        return;
+
+      callback = info->callback;
+    }
+
+    // Responses are sent through the callback so that they are ordered with
+    // responses that the handler sends concurrently.
+    callback->DeliverUndeliveredResponses();
+  }
+
+  // Send the undelivered responses of a coalescing query if the renderer has
+  // credits available. Called by CallbackImpl with the callback lock held.
+  void SendUndeliveredResponses(int browser_id, int64 query_id) {
+    CefRefPtr<CefBrowser> browser;
+    int context_id, request_id;
+    CefRefPtr<CefListValue> response_value;
+    {
+      AutoLock lock_scope(this);
+      QueryInfo* info =
+          browser_query_info_map_.Find(browser_id, query_id, NULL);
+      if (!info || !info->undelivered_responses.get() || info->credits == 0)
+        return;
+
+      info->credits--;
+      response_value = TakeUndeliveredResponses(info);
+      browser = info->browser;
+      context_id = info->context_id;
+      request_id = info->request_id;
+    }
+
+    SendQuerySuccess(browser, context_id, request_id, CefString(),
+                     response_value);
+  }
+
+  // Returns true if responses to the query are currently being held back
+  // until the renderer returns credits.
+  bool IsThrottled(int browser_id, int64 query_id) {
+    AutoLock lock_scope(this);
+    QueryInfo* info = browser_query_info_map_.Find(browser_id, query_id, NULL);
+    return info && info->coalesce_mode != COALESCE_NONE && info->credits == 0;
+  }
+
+  // Called by CallbackImpl on success with the callback lock held. May be
+  // called on any thread.
   void OnCallbackSuccess(int browser_id,
                          int64 query_id,
-                         const CefString& response) {
-    CEF_REQUIRE_UI_THREAD();
+                         const CefString& response,
+                         CefRefPtr<CefListValue> response_value) {
+    CefRefPtr<CefBrowser> browser;
+    int context_id, request_id;
+    QueryInfo* removed_info = NULL;
+    {
+      AutoLock lock_scope(this);
+      bool removed;
+      QueryInfo* info = GetQueryInfo(browser_id, query_id, false, &removed);
+      if (!info)
+        return;
 
-    bool removed;
-    QueryInfo* info = GetQueryInfo(browser_id, query_id, false, &removed);
-    if (info) {
-      SendQuerySuccess(info, response);
-      if (removed)
-        delete info;
+      if (info->coalesce_mode != COALESCE_NONE) {
+        DCHECK(!removed);
+        AddUndeliveredResponse(info, response, response_value);
+        if (info->credits == 0)
+          return;  // Wait for the renderer to return credits.
+        info->credits--;
+        response_value = TakeUndeliveredResponses(info);
+      }
+
+      browser = info->browser;
+      context_id = info->context_id;
+      request_id = info->request_id;
+      if (removed) {
+        OnQueryCompleted(info);
+        removed_info = info;
+      }
     }
+
+    SendQuerySuccess(browser, context_id, request_id, response,
+                     response_value);
+    if (removed_info)
+      delete removed_info;
   }
 
-  // Called by CallbackImpl on failure.
+  // Called by CallbackImpl on failure with the callback lock held. May be
+  // called on any thread.
   void OnCallbackFailure(int browser_id,
                          int64 query_id,
                          int error_code,
                          const CefString& error_message) {
-    CEF_REQUIRE_UI_THREAD();
+    QueryInfo* info;
+    {
+      AutoLock lock_scope(this);
+      bool removed;
+      info = GetQueryInfo(browser_id, query_id, true, &removed);
+      if (!info)
+        return;
 
-    bool removed;
-    QueryInfo* info = GetQueryInfo(browser_id, query_id, true, &removed);
-    if (info) {
-      SendQueryFailure(info, error_code, error_message);
       DCHECK(removed);
-      delete info;
+      OnQueryCompleted(info);
     }
-  }
 
-  void SendQuerySuccess(QueryInfo* info,
-                        const CefString& response) {
-    SendQuerySuccess(info->browser, info->context_id, info->request_id,
-                     response);
+    SendQueryFailure(info, error_code, error_message);
+    delete info;
   }
 
+  // If |response_value| is non-NULL its value is moved into the message and
+  // |response| is ignored.
   void SendQuerySuccess(CefRefPtr<CefBrowser> browser,
                         int context_id,
                         int request_id,
-                        const CefString& response) {
+                        const CefString& response,
+                        CefRefPtr<CefListValue> response_value) {
     CefRefPtr<CefProcessMessage> message =
         CefProcessMessage::Create(query_message_name_);
     CefRefPtr<CefListValue> args = message->GetArgumentList();
     args->SetInt(0, context_id);
     args->SetInt(1, request_id);
     args->SetBool(2, true);  // Indicates a success result.
-    args->SetString(3, response);
+    if (response_value.get())
+      MoveListItem(response_value, 0, args, 3);
+    else
+      args->SetString(3, response);
     browser->SendProcessMessage(PID_RENDERER, message);
   }
 
@@ -471,134 +1193,185 @@ class CefMessageRouterBrowserSideImpl : public CefMessageRouterBrowserSide {
                             int request_id) {
      SendQueryFailure(browser, context_id, request_id, kCanceledErrorCode,
                       kCanceledErrorMessage);
-  }                   
+  }
 
-  // Cancel a query that has already been sent to a handler.
+  // Cancel a query that has already been sent to a handler. |info| must
+  // already have been removed from the map and will be deleted.
   void CancelQuery(int64 query_id, QueryInfo* info, bool notify_renderer) {
     if (notify_renderer)
       SendQueryFailure(info, kCanceledErrorCode, kCanceledErrorMessage);
 
-    CefRefPtr<CefFrame> frame = info->browser->GetFrame(info->frame_id);
-    info->handler->OnQueryCanceled(info->browser, frame, query_id);
-
     // Invalidate the callback.
     info->callback->Detach();
+
+    if (CefCurrentlyOn(info->handler_thread)) {
+      NotifyQueryCanceled(query_id, info);
+    } else if (!CefPostTask(info->handler_thread,
+                   NewCefRunnableMethod(this,
+                       &CefMessageRouterBrowserSideImpl::NotifyQueryCanceled,
+                       query_id, info))) {
+      // The handler's thread is no longer running so the handler can't be
+      // notified.
+      delete info;
+    }
+  }
+
+  // Notify the handler that a query has been canceled and delete |info|.
+  // Executes on the handler's thread.
+  void NotifyQueryCanceled(int64 query_id, QueryInfo* info) {
+    CefRefPtr<CefFrame> frame = info->browser->GetFrame(info->frame_id);
+    info->handler->OnQueryCanceled(info->browser, frame, query_id);
+    delete info;
   }
 
+  typedef std::vector<std::pair<int64, QueryInfo*> > CanceledQueryList;
+
+  // Visitor that removes queries from the map for cancellation.
+  class CancelVisitor : public BrowserQueryInfoMap::Visitor {
+   public:
+    CancelVisitor(Handler* handler,
+                  int context_id,
+                  int request_id,
+                  CanceledQueryList* canceled)
+        : handler_(handler),
+          context_id_(context_id),
+          request_id_(request_id),
+          canceled_(canceled) {}
+
+    virtual bool OnNextInfo(int browser_id,
+                            InfoIdType info_id,
+                            InfoObjectType info,
+                            bool* remove) OVERRIDE {
+      if (handler_ && info->handler != handler_)
+        return true;
+      if (context_id_ != kReservedId &&
+          (info->context_id != context_id_ ||
+           (request_id_ != kReservedId && info->request_id != request_id_))) {
+        return true;
+      }
+
+      *remove = true;
+      info->route->pending_count--;
+      canceled_->push_back(std::make_pair(info_id, info));
+
+      // Stop iterating if only canceling a single request.
+      return (context_id_ == kReservedId || request_id_ == kReservedId);
+    }
+
+   private:
+    Handler* handler_;
+    const int context_id_;
+    const int request_id_;
+    CanceledQueryList* canceled_;
+  };
+
   // Cancel all pending queries associated with either |browser| or |handler|.
   // If both |browser| and |handler| are NULL all pending queries will be
   // canceled. Set |notify_renderer| to true if the renderer should be notified.
+  // May be called on any thread.
   void CancelPendingFor(CefRefPtr<CefBrowser> browser,
                         Handler* handler,
                         bool notify_renderer) {
-    if (!CefCurrentlyOn(TID_UI)) {
-      // Must execute on the UI thread.
-      CefPostTask(TID_UI,
-          NewCefRunnableMethod(this,
-              &CefMessageRouterBrowserSideImpl::CancelPendingFor,
-              browser, handler, notify_renderer));
-      return;
-    }
-
-    if (browser_query_info_map_.empty())
-      return;
-
-    class Visitor : public BrowserQueryInfoMap::Visitor {
-     public:
-      Visitor(CefMessageRouterBrowserSideImpl* router,
-              Handler* handler,
-              bool notify_renderer)
-          : router_(router),
-            handler_(handler),
-            notify_renderer_(notify_renderer) {}
-
-      virtual bool OnNextInfo(int browser_id,
-                              InfoIdType info_id,
-                              InfoObjectType info,
-                              bool* remove) OVERRIDE {
-        if (!handler_ || info->handler == handler_) {
-          *remove = true;
-          router_->CancelQuery(info_id, info, notify_renderer_);
-          delete info;
+    const int browser_id = browser.get() ? browser->GetIdentifier() : 0;
+
+    CanceledQueryList canceled;
+    {
+      AutoLock lock_scope(this);
+
+      // Queries that are still being dispatched are canceled when the current
+      // handler returns.
+      PendingQueryMap::const_iterator it = pending_query_map_.begin();
+      for (; it != pending_query_map_.end(); ++it) {
+        PendingQuery* query = it->second;
+        if ((!browser.get() ||
+             query->browser->GetIdentifier() == browser_id) &&
+            (!handler || query->current_handler == handler)) {
+          query->canceled = true;
+          query->notify_renderer = notify_renderer;
         }
-        return true;
       }
 
-     private:
-      CefMessageRouterBrowserSideImpl* router_;
-      Handler* handler_;
-      const bool notify_renderer_;
-    };
-
-    Visitor visitor(this, handler, notify_renderer);
-
-    if (browser.get()) {
-      // Cancel all queries associated with the specified browser.
-      browser_query_info_map_.FindAll(
-          browser->GetIdentifier(), &visitor);
-    } else {
-      // Cancel all queries for all browsers.
-      browser_query_info_map_.FindAll(&visitor);
+      if (!browser_query_info_map_.empty()) {
+        CancelVisitor visitor(handler, kReservedId, kReservedId, &canceled);
+        if (browser.get()) {
+          // Cancel all queries associated with the specified browser.
+          browser_query_info_map_.FindAll(browser_id, &visitor);
+        } else {
+          // Cancel all queries for all browsers.
+          browser_query_info_map_.FindAll(&visitor);
+        }
+      }
     }
+
+    for (size_t i = 0; i < canceled.size(); ++i)
+      CancelQuery(canceled[i].first, canceled[i].second, notify_renderer);
   }
 
   // Cancel a query based on the renderer-side IDs. If |request_id| is
   // kReservedId all requests associated with |context_id| will be canceled.
   void CancelPendingRequest(int browser_id, int context_id, int request_id) {
-    class Visitor : public BrowserQueryInfoMap::Visitor {
-     public:
-      Visitor(CefMessageRouterBrowserSideImpl* router,
-              int context_id,
-              int request_id)
-          : router_(router),
-            context_id_(context_id),
-            request_id_(request_id) {}
-
-      virtual bool OnNextInfo(int browser_id,
-                              InfoIdType info_id,
-                              InfoObjectType info,
-                              bool* remove) OVERRIDE {
-        if (info->context_id == context_id_ &&
-            (request_id_ == kReservedId || info->request_id == request_id_)) {
-          *remove = true;
-          router_->CancelQuery(info_id, info, false);
-          delete info;
-          
-          // Stop iterating if only canceling a single request.
-          return (request_id_ == kReservedId);
+    CanceledQueryList canceled;
+    {
+      AutoLock lock_scope(this);
+
+      PendingQueryMap::const_iterator it = pending_query_map_.begin();
+      for (; it != pending_query_map_.end(); ++it) {
+        PendingQuery* query = it->second;
+        if (query->browser->GetIdentifier() == browser_id &&
+            query->context_id == context_id &&
+            (request_id == kReservedId || query->request_id == request_id)) {
+          query->canceled = true;
+          query->notify_renderer = false;
         }
-        return true;
       }
 
-     private:
-      CefMessageRouterBrowserSideImpl* router_;
-      const int context_id_;
-      const int request_id_;
-    };
+      CancelVisitor visitor(NULL, context_id, request_id, &canceled);
+      browser_query_info_map_.FindAll(browser_id, &visitor);
+    }
 
-    Visitor visitor(this, context_id, request_id);
-    browser_query_info_map_.FindAll(browser_id, &visitor);
+    for (size_t i = 0; i < canceled.size(); ++i)
+      CancelQuery(canceled[i].first, canceled[i].second, false);
   }
 
   const CefMessageRouterConfig config_;
   const std::string query_message_name_;
   const std::string cancel_message_name_;
+  const std::string credit_message_name_;
+  const CefString::char_type route_delimiter_;
 
   IdGenerator<int64> query_id_generator_;
 
-  // Set of currently registered handlers. An entry is added when a handler is
-  // registered and removed when a handler is unregistered.
+  // Map of all registered handlers to the thread that they execute on. An
+  // entry is added when a handler is first registered and removed when the
+  // handler is unregistered.
+  typedef std::map<Handler*, CefThreadId> HandlerMap;
+  HandlerMap handler_map_;
+
+  // Set of currently registered handlers without a route.
   typedef std::set<Handler*> HandlerSet;
   HandlerSet handler_set_;
 
+  // Map of route to the handlers registered for the route. An entry is added
+  // the first time a handler is registered for the route and is never removed.
+  typedef std::map<CefString, RouteInfo> RouteMap;
+  RouteMap route_map_;
+
+  // Statistics for queries that don't match an entry in |route_map_|.
+  RouteInfo default_route_;
+
+  // Map of query ID to PendingQuery instance for queries that are being
+  // offered to handlers.
+  typedef std::map<int64, PendingQuery*> PendingQueryMap;
+  PendingQueryMap pending_query_map_;
+
   // Map of query ID to QueryInfo instance. An entry is added when a Handler
   // indicates that it will handle the query and removed when either the query
   // is completed via the Callback, the query is explicitly canceled from the
   // renderer process, or the associated context is (or will be) released.
-  typedef CefBrowserInfoMap<int64, QueryInfo*> BrowserQueryInfoMap;
   BrowserQueryInfoMap browser_query_info_map_;
 
   IMPLEMENT_REFCOUNTING(CefMessageRouterBrowserSideImpl);
+  IMPLEMENT_LOCKING(CefMessageRouterBrowserSideImpl);
   DISALLOW_COPY_AND_ASSIGN(CefMessageRouterBrowserSideImpl);
 };
 
@@ -629,10 +1402,12 @@ class CefMessageRouterRendererSideImpl : public CefMessageRouterRendererSide {
         CefRefPtr<CefV8Value> arg = arguments[0];
 
         CefRefPtr<CefV8Value> requestVal = arg->GetValue(kMemberRequest);
-        if (!requestVal.get() || !requestVal->IsString()) {
+        if (!requestVal.get() ||
+            !(requestVal->IsString() || requestVal->IsObject()) ||
+            requestVal->IsFunction()) {
           exception = "Invalid arguments; object member '"+
                       std::string(kMemberRequest) +"' is required and must "
-                      "have type string";
+                      "have type string, ArrayBuffer, array or object";
           return true;
         }
 
@@ -669,15 +1444,43 @@ class CefMessageRouterRendererSideImpl : public CefMessageRouterRendererSide {
           }
         }
 
+        CoalesceMode coalesce_mode = COALESCE_NONE;
+        if (arg->HasValue(kMemberCoalesce)) {
+          CefRefPtr<CefV8Value> coalesceVal = arg->GetValue(kMemberCoalesce);
+          const std::string& coalesce =
+              coalesceVal->IsString() ?
+                  coalesceVal->GetStringValue().ToString() : std::string();
+          if (coalesce == kCoalesceLatest) {
+            coalesce_mode = COALESCE_LATEST;
+          } else if (coalesce == kCoalesceBatch) {
+            coalesce_mode = COALESCE_BATCH;
+          } else {
+            exception = "Invalid arguments; object member '"+
+                        std::string(kMemberCoalesce) +"' must be '"+
+                        std::string(kCoalesceLatest) +"' or '"+
+                        std::string(kCoalesceBatch) +"'";
+            return true;
+          }
+        }
+
         CefRefPtr<CefV8Context> context = CefV8Context::GetCurrentContext();
         const int context_id = GetIDForContext(context);
         const int64 frame_id = context->GetFrame()->GetIdentifier();
         const bool persistent =
             (persistentVal.get() && persistentVal->GetBoolValue());
 
+        // Only persistent queries receive multiple responses.
+        if (!persistent)
+          coalesce_mode = COALESCE_NONE;
+
         const int request_id = router_->SendQuery(
-            context->GetBrowser(), frame_id, context_id,
-            requestVal->GetStringValue(), persistent, successVal, failureVal);
+            context->GetBrowser(), frame_id, context_id, requestVal,
+            persistent, coalesce_mode, successVal, failureVal);
+        if (request_id == kReservedId) {
+          exception = "Invalid arguments; object member '"+
+                      std::string(kMemberRequest) +"' could not be converted";
+          return true;
+        }
         retval = CefV8Value::CreateInt(request_id);
         return true;
       } else if (name == config_.js_cancel_function) {
@@ -723,7 +1526,9 @@ class CefMessageRouterRendererSideImpl : public CefMessageRouterRendererSide {
         query_message_name_(
           config.js_query_function.ToString() + kMessageSuffix),
         cancel_message_name_(
-          config.js_cancel_function.ToString() + kMessageSuffix) {
+          config.js_cancel_function.ToString() + kMessageSuffix),
+        credit_message_name_(
+          config.js_query_function.ToString() + kCreditMessageSuffix) {
   }
 
   virtual ~CefMessageRouterRendererSideImpl() {
@@ -842,11 +1647,24 @@ class CefMessageRouterRendererSideImpl : public CefMessageRouterRendererSide {
 
       if (is_success) {
         DCHECK_EQ(args->GetSize(), 4U);
-        const CefString& response = args->GetString(3);
+        CefRefPtr<CefV8Context> context = GetContextByID(context_id);
+        if (!context.get())
+          return true;
+
+        // Convert the response directly from the message arguments because
+        // the message is only valid until this method returns.
+        CefRefPtr<CefV8Value> response;
+        if (context->Enter()) {
+          response = CreateV8Value(args, 3);
+          context->Exit();
+        }
+        if (!response.get())
+          return true;
+
         CefPostTask(TID_RENDERER,
             NewCefRunnableMethod(this,
                 &CefMessageRouterRendererSideImpl::ExecuteSuccessCallback,
-                browser->GetIdentifier(), context_id, request_id, response));
+                browser, context_id, request_id, response));
       } else {
         DCHECK_EQ(args->GetSize(), 5U);
         int error_code = args->GetInt(3);
@@ -870,6 +1688,11 @@ class CefMessageRouterRendererSideImpl : public CefMessageRouterRendererSide {
     // True if the request is persistent.
     bool persistent;
 
+    // How the browser delivers responses and the number of responses consumed
+    // since credits were last returned to the browser.
+    CoalesceMode coalesce_mode;
+    int consumed_count;
+
     // Success callback function. May be NULL.
     CefRefPtr<CefV8Value> success_callback;
 
@@ -916,35 +1739,42 @@ class CefMessageRouterRendererSideImpl : public CefMessageRouterRendererSide {
     return info;
   }
 
-  // Returns the new request ID.
+  // Returns the new request ID or kReservedId if |request| can't be
+  // converted.
   int SendQuery(CefRefPtr<CefBrowser> browser,
                 int64 frame_id,
                 int context_id,
-                const CefString& request,
+                CefRefPtr<CefV8Value> request,
                 bool persistent,
+                CoalesceMode coalesce_mode,
                 CefRefPtr<CefV8Value> success_callback,
                 CefRefPtr<CefV8Value> failure_callback) {
     CEF_REQUIRE_RENDERER_THREAD();
 
+    CefRefPtr<CefProcessMessage> message =
+        CefProcessMessage::Create(query_message_name_);
+
+    CefRefPtr<CefListValue> args = message->GetArgumentList();
+    if (!SetRequestValue(args, 4, request))
+      return kReservedId;
+
     const int request_id = request_id_generator_.GetNextId();
 
     RequestInfo* info = new RequestInfo;
     info->persistent = persistent;
+    info->coalesce_mode = coalesce_mode;
+    info->consumed_count = 0;
     info->success_callback = success_callback;
     info->failure_callback = failure_callback;
     browser_request_info_map_.Add(browser->GetIdentifier(),
         std::make_pair(context_id, request_id), info);
 
-    CefRefPtr<CefProcessMessage> message =
-        CefProcessMessage::Create(query_message_name_);
-
-    CefRefPtr<CefListValue> args = message->GetArgumentList();
     args->SetInt(0, CefInt64GetLow(frame_id));
     args->SetInt(1, CefInt64GetHigh(frame_id));
     args->SetInt(2, context_id);
     args->SetInt(3, request_id);
-    args->SetString(4, request);
     args->SetBool(5, persistent);
+    args->SetInt(6, coalesce_mode);
 
     browser->SendProcessMessage(PID_BROWSER, message);
 
@@ -1021,25 +1851,56 @@ class CefMessageRouterRendererSideImpl : public CefMessageRouterRendererSide {
   }
 
   // Execute the onSuccess JavaScript callback.
-  void ExecuteSuccessCallback(int browser_id, int context_id, int request_id,
-                              const CefString& response) {
+  void ExecuteSuccessCallback(CefRefPtr<CefBrowser> browser,
+                              int context_id,
+                              int request_id,
+                              CefRefPtr<CefV8Value> response) {
     CEF_REQUIRE_RENDERER_THREAD();
 
+    const int browser_id = browser->GetIdentifier();
+
     bool removed;
     RequestInfo* info =
         GetRequestInfo(browser_id, context_id, request_id, false, &removed);
     if (!info)
       return;
 
+    const bool coalescing = (info->coalesce_mode != COALESCE_NONE);
+
     CefRefPtr<CefV8Context> context = GetContextByID(context_id);
     if (context && info->success_callback) {
       CefV8ValueList args;
-      args.push_back(CefV8Value::CreateString(response));
+      args.push_back(response);
       info->success_callback->ExecuteFunctionWithContext(context, NULL, args);
     }
 
-    if (removed)
+    if (removed) {
       delete info;
+    } else if (coalescing) {
+      // The callback may have canceled the request so look it up again.
+      info = GetRequestInfo(browser_id, context_id, request_id, false,
+                            &removed);
+      if (info && ++info->consumed_count >= kCoalesceCreditReturn) {
+        SendCredit(browser, context_id, request_id, info->consumed_count);
+        info->consumed_count = 0;
+      }
+    }
+  }
+
+  // Allow the browser to send |credits| more responses to a coalescing query.
+  void SendCredit(CefRefPtr<CefBrowser> browser,
+                  int context_id,
+                  int request_id,
+                  int credits) {
+    CefRefPtr<CefProcessMessage> message =
+        CefProcessMessage::Create(credit_message_name_);
+
+    CefRefPtr<CefListValue> args = message->GetArgumentList();
+    args->SetInt(0, context_id);
+    args->SetInt(1, request_id);
+    args->SetInt(2, credits);
+
+    browser->SendProcessMessage(PID_BROWSER, message);
   }
 
   // Execute the onFailure JavaScript callback.
@@ -1106,6 +1967,7 @@ class CefMessageRouterRendererSideImpl : public CefMessageRouterRendererSide {
   const CefMessageRouterConfig config_;
   const std::string query_message_name_;
   const std::string cancel_message_name_;
+  const std::string credit_message_name_;
 
   IdGenerator<int> context_id_generator_;
   IdGenerator<int> request_id_generator_;
@@ -1132,7 +1994,8 @@ class CefMessageRouterRendererSideImpl : public CefMessageRouterRendererSide {
 
 CefMessageRouterConfig::CefMessageRouterConfig()
   : js_query_function("cefQuery"),
-    js_cancel_function("cefQueryCancel") {
+    js_cancel_function("cefQueryCancel"),
+    route_delimiter(':') {
 }
 
 // static
@@ -3,13 +3,89 @@
 // can be found in the LICENSE file.
 
 #include "include/wrapper/cef_stream_resource_handler.h"
+#include <ctype.h>
+#include <stdio.h>
 #include <algorithm>
+#include <sstream>
 #include "include/cef_callback.h"
 #include "include/cef_request.h"
 #include "include/cef_runnable.h"
 #include "include/cef_stream.h"
 #include "libcef_dll/cef_logging.h"
 
+namespace {
+
+// Size and number of the buffers used when reading ahead on the FILE thread.
+const int kReadAheadBufferSize = 32 * 1024;
+const size_t kReadAheadBufferCount = 4;
+
+// Parse a non-negative decimal integer. Returns false if |str| is not a valid
+// value.
+bool ParseInt64(const std::string& str, int64* value) {
+  if (str.empty() || str.size() > 18)
+    return false;
+  int64 result = 0;
+  for (size_t i = 0; i < str.size(); ++i) {
+    if (str[i] < '0' || str[i] > '9')
+      return false;
+    result = result * 10 + (str[i] - '0');
+  }
+  *value = result;
+  return true;
+}
+
+// Parse the "Range" header |value| for a resource of |total_length| bytes.
+// Only a single byte range is supported. Returns false if the header should
+// be ignored. Otherwise sets |satisfiable| and, if true, the inclusive
+// |start| and |end| positions.
+bool ParseRange(const std::string& value, int64 total_length,
+                bool* satisfiable, int64* start, int64* end) {
+  std::string spec;
+  for (size_t i = 0; i < value.size(); ++i) {
+    if (value[i] != ' ' && value[i] != '\t')
+      spec += static_cast<char>(tolower(value[i]));
+  }
+
+  const std::string kPrefix = "bytes=";
+  if (spec.compare(0, kPrefix.size(), kPrefix) != 0)
+    return false;
+  spec = spec.substr(kPrefix.size());
+  if (spec.find(',') != std::string::npos)
+    return false;
+
+  const size_t dash = spec.find('-');
+  if (dash == std::string::npos)
+    return false;
+  const std::string first = spec.substr(0, dash);
+  const std::string last = spec.substr(dash + 1);
+
+  int64 first_pos = 0, last_pos = 0;
+  if (first.empty()) {
+    // Suffix range of the last |last_pos| bytes.
+    if (!ParseInt64(last, &last_pos))
+      return false;
+    *satisfiable = (last_pos > 0 && total_length > 0);
+    *start = std::max(total_length - last_pos, static_cast<int64>(0));
+    *end = total_length - 1;
+    return true;
+  }
+
+  if (!ParseInt64(first, &first_pos))
+    return false;
+  if (last.empty()) {
+    last_pos = total_length - 1;
+  } else if (!ParseInt64(last, &last_pos) || last_pos < first_pos) {
+    return false;
+  }
+
+  *satisfiable = (first_pos < total_length);
+  *start = first_pos;
+  *end = std::min(last_pos, total_length - 1);
+  return true;
+}
+
+}  // namespace
+
 // Class that represents a readable/writable character buffer.
 class CefStreamResourceHandler::Buffer {
  public:
@@ -39,10 +115,6 @@ class CefStreamResourceHandler::Buffer {
     bytes_read_ = 0;
   }
 
-  bool IsEmpty() const {
-    return (bytes_written_ == 0);
-  }
-
   bool CanRead() const {
     return (bytes_read_ < bytes_written_);
   }
@@ -57,17 +129,8 @@ class CefStreamResourceHandler::Buffer {
     return write_size;
   }
 
-  int ReadFrom(CefRefPtr<CefStreamReader> reader) {
-    // Read until the buffer is full or until Read() returns 0 to indicate no
-    // more data.
-    int bytes_read;
-    do {
-      bytes_read = static_cast<int>(
-          reader->Read(buffer_ + bytes_written_, 1,
-                       bytes_requested_ - bytes_written_));
-      bytes_written_ += bytes_read;
-    } while (bytes_read != 0 && bytes_written_ < bytes_requested_);
-
+  int ReadFrom(CefStreamResourceHandler* handler) {
+    bytes_written_ = handler->ReadFromStream(buffer_, bytes_requested_);
     return bytes_written_;
   }
 
@@ -86,14 +149,22 @@ CefStreamResourceHandler::CefStreamResourceHandler(
       status_text_("OK"),
       mime_type_(mime_type),
       stream_(stream),
-      buffer_(NULL)
-#ifndef NDEBUG
-      , buffer_owned_by_file_thread_(false)
-#endif
-{
+      data_(NULL),
+      data_size_(0),
+      data_offset_(0),
+      has_range_(false),
+      range_satisfiable_(false),
+      range_start_(0),
+      range_end_(0),
+      total_length_(0),
+      read_remaining_(-1),
+      read_ahead_pending_(false),
+      read_complete_(false),
+      canceled_(false) {
   DCHECK(!mime_type_.empty());
   DCHECK(stream_.get());
   read_on_file_thread_ = stream_->MayBlock();
+  InitData();
 }
 
 CefStreamResourceHandler::CefStreamResourceHandler(
@@ -107,19 +178,61 @@ CefStreamResourceHandler::CefStreamResourceHandler(
       mime_type_(mime_type),
       header_map_(header_map),
       stream_(stream),
-      buffer_(NULL) {
+      data_(NULL),
+      data_size_(0),
+      data_offset_(0),
+      has_range_(false),
+      range_satisfiable_(false),
+      range_start_(0),
+      range_end_(0),
+      total_length_(0),
+      read_remaining_(-1),
+      read_ahead_pending_(false),
+      read_complete_(false),
+      canceled_(false) {
   DCHECK(!mime_type_.empty());
   DCHECK(stream_.get());
   read_on_file_thread_ = stream_->MayBlock();
+  InitData();
 }
 
 CefStreamResourceHandler::~CefStreamResourceHandler() {
-  if (buffer_)
-    delete buffer_;
+  BufferQueue::const_iterator it = filled_buffers_.begin();
+  for (; it != filled_buffers_.end(); ++it)
+    delete *it;
+  for (it = free_buffers_.begin(); it != free_buffers_.end(); ++it)
+    delete *it;
 }
 
 bool CefStreamResourceHandler::ProcessRequest(CefRefPtr<CefRequest> request,
                                               CefRefPtr<CefCallback> callback) {
+  std::string range;
+  if (status_code_ == 200) {
+    CefRequest::HeaderMap header_map;
+    request->GetHeaderMap(header_map);
+    CefRequest::HeaderMap::const_iterator it = header_map.begin();
+    for (; it != header_map.end(); ++it) {
+      std::string name = it->first;
+      std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+      if (name == "range") {
+        range = it->second;
+        break;
+      }
+    }
+  }
+
+  if (!range.empty()) {
+    if (read_on_file_thread_ && !data_) {
+      // Seeking may block so apply the range on the FILE thread.
+      CefPostTask(TID_FILE,
+          NewCefRunnableMethod(this,
+              &CefStreamResourceHandler::ApplyRangeOnFileThread, range,
+              callback));
+      return true;
+    }
+    ApplyRange(range);
+  }
+
   callback->Continue();
   return true;
 }
@@ -128,14 +241,37 @@ void CefStreamResourceHandler::GetResponseHeaders(
     CefRefPtr<CefResponse> response,
     int64& response_length,
     CefString& redirectUrl) {
+  response->SetMimeType(mime_type_);
+
+  if (has_range_) {
+    CefResponse::HeaderMap header_map = header_map_;
+    header_map.insert(std::make_pair("Accept-Ranges", "bytes"));
+
+    std::stringstream content_range;
+    if (range_satisfiable_) {
+      response->SetStatus(206);
+      response->SetStatusText("Partial Content");
+      content_range << "bytes " << range_start_ << "-" << range_end_ << "/" <<
+          total_length_;
+      response_length = range_end_ - range_start_ + 1;
+    } else {
+      response->SetStatus(416);
+      response->SetStatusText("Requested Range Not Satisfiable");
+      content_range << "bytes */" << total_length_;
+      response_length = 0;
+    }
+    header_map.insert(std::make_pair("Content-Range", content_range.str()));
+    response->SetHeaderMap(header_map);
+    return;
+  }
+
   response->SetStatus(status_code_);
   response->SetStatusText(status_text_);
-  response->SetMimeType(mime_type_);
 
   if (!header_map_.empty())
     response->SetHeaderMap(header_map_);
 
-  response_length = -1;
+  response_length = data_ ? data_size_ - data_offset_ : -1;
 }
 
 bool CefStreamResourceHandler::ReadResponse(void* data_out,
@@ -144,61 +280,218 @@ bool CefStreamResourceHandler::ReadResponse(void* data_out,
                                             CefRefPtr<CefCallback> callback) {
   DCHECK_GT(bytes_to_read, 0);
 
+  if (data_ && !read_on_file_thread_) {
+    // Copy directly from the stream data.
+    bytes_read = ReadFromData(static_cast<char*>(data_out), bytes_to_read);
+    return (bytes_read > 0);
+  }
+
   if (read_on_file_thread_) {
-    DCHECK(!buffer_owned_by_file_thread_);
-    if (buffer_ && (buffer_->CanRead() || buffer_->IsEmpty())) {
-      if (buffer_->CanRead()) {
-        // Provide data from the buffer.
-        bytes_read = buffer_->WriteTo(data_out, bytes_to_read);
-        return (bytes_read > 0);
-      } else {
-        // End of the steam.
-        bytes_read = 0;
-        return false;
+    AutoLock lock_scope(this);
+
+    bytes_read = 0;
+    while (!filled_buffers_.empty() && bytes_read < bytes_to_read) {
+      // Provide data from the buffers that have been read ahead.
+      Buffer* buffer = filled_buffers_.front();
+      bytes_read += buffer->WriteTo(static_cast<char*>(data_out) + bytes_read,
+                                    bytes_to_read - bytes_read);
+      if (!buffer->CanRead()) {
+        filled_buffers_.pop_front();
+        free_buffers_.push_back(buffer);
       }
-    } else {
-      // Perform another read on the file thread.
-      bytes_read = 0;
-#ifndef NDEBUG
-      buffer_owned_by_file_thread_ = true;
-#endif
-      CefPostTask(TID_FILE,
-          NewCefRunnableMethod(this, &CefStreamResourceHandler::ReadOnFileThread,
-                               bytes_to_read, callback));
+    }
+
+    if (bytes_read > 0) {
+      // Continue filling the free buffers.
+      StartReadAheadLocked();
       return true;
     }
-  } else {
-    // Read until the buffer is full or until Read() returns 0 to indicate no
-    // more data.
-    bytes_read = 0;
-    int read = 0;
-    do {
-      read = static_cast<int>(
-          stream_->Read(static_cast<char*>(data_out) + bytes_read, 1,
-                        bytes_to_read - bytes_read));
-      bytes_read += read;
-    } while (read != 0 && bytes_read < bytes_to_read);
 
-    return (bytes_read > 0);
+    if (read_complete_) {
+      // End of the stream.
+      return false;
+    }
+
+    // Wait for the FILE thread to provide more data.
+    read_callback_ = callback;
+    StartReadAheadLocked();
+    return true;
   }
+
+  bytes_read = ReadFromStream(static_cast<char*>(data_out), bytes_to_read);
+  return (bytes_read > 0);
 }
 
 void CefStreamResourceHandler::Cancel() {
+  AutoLock lock_scope(this);
+  canceled_ = true;
+  read_callback_ = NULL;
+}
+
+void CefStreamResourceHandler::InitData() {
+  // Only the position within the data is used here. The data itself is
+  // accessed by ReadFromData() which runs on the FILE thread if
+  // |read_on_file_thread_| is true.
+  data_ = static_cast<const char*>(stream_->GetData());
+  if (data_) {
+    // Start at the current stream position.
+    data_size_ = static_cast<int64>(stream_->GetDataSize());
+    data_offset_ = std::min(std::max(stream_->Tell(), static_cast<int64>(0)),
+                            data_size_);
+  }
 }
 
-void CefStreamResourceHandler::ReadOnFileThread(
-    int bytes_to_read,
+void CefStreamResourceHandler::ApplyRange(const std::string& value) {
+  // The resource starts at the current stream position.
+  int64 base = 0;
+  if (data_) {
+    base = data_offset_;
+    total_length_ = data_size_ - base;
+  } else {
+    base = stream_->Tell();
+    if (base < 0 || stream_->Seek(0, SEEK_END) != 0)
+      return;
+    total_length_ = stream_->Tell() - base;
+    if (stream_->Seek(base, SEEK_SET) != 0 || total_length_ < 0)
+      return;
+  }
+
+  if (!ParseRange(value, total_length_, &range_satisfiable_, &range_start_,
+                  &range_end_)) {
+    return;
+  }
+
+  has_range_ = true;
+
+  if (!range_satisfiable_) {
+    // Nothing will be read.
+    if (data_)
+      data_size_ = data_offset_;
+    read_remaining_ = 0;
+    return;
+  }
+
+  if (data_) {
+    data_offset_ = base + range_start_;
+    data_size_ = base + range_end_ + 1;
+  } else if (stream_->Seek(base + range_start_, SEEK_SET) == 0) {
+    read_remaining_ = range_end_ - range_start_ + 1;
+  } else {
+    // Seeking failed so return the complete response.
+    stream_->Seek(base, SEEK_SET);
+    has_range_ = false;
+  }
+}
+
+void CefStreamResourceHandler::ApplyRangeOnFileThread(
+    const std::string& value,
     CefRefPtr<CefCallback> callback) {
   CEF_REQUIRE_FILE_THREAD();
-  DCHECK(buffer_owned_by_file_thread_);
+  ApplyRange(value);
+  callback->Continue();
+}
+
+int CefStreamResourceHandler::ReadFromData(char* data_out, int bytes_to_read) {
+  const int bytes_read = static_cast<int>(
+      std::min(static_cast<int64>(bytes_to_read), data_size_ - data_offset_));
+  if (bytes_read > 0) {
+    memcpy(data_out, data_ + data_offset_, bytes_read);
+    data_offset_ += bytes_read;
+  }
+  return std::max(bytes_read, 0);
+}
 
-  if (!buffer_)
-    buffer_ = new Buffer();
-  buffer_->Reset(bytes_to_read);
-  buffer_->ReadFrom(stream_);
+int CefStreamResourceHandler::ReadFromStream(char* data_out,
+                                             int bytes_to_read) {
+  if (data_)
+    return ReadFromData(data_out, bytes_to_read);
 
-#ifndef NDEBUG
-  buffer_owned_by_file_thread_ = false;
-#endif
-  callback->Continue();
+  if (read_remaining_ >= 0) {
+    bytes_to_read = static_cast<int>(
+        std::min(static_cast<int64>(bytes_to_read), read_remaining_));
+  }
+
+  // Read until the buffer is full or until Read() returns 0 to indicate no
+  // more data.
+  int bytes_read = 0;
+  int read = 0;
+  while (bytes_read < bytes_to_read) {
+    read = static_cast<int>(
+        stream_->Read(data_out + bytes_read, 1, bytes_to_read - bytes_read));
+    if (read == 0)
+      break;
+    bytes_read += read;
+  }
+
+  if (read_remaining_ > 0)
+    read_remaining_ -= bytes_read;
+
+  return bytes_read;
+}
+
+void CefStreamResourceHandler::StartReadAheadLocked() {
+  if (read_ahead_pending_ || read_complete_ || canceled_)
+    return;
+
+  if (free_buffers_.empty() &&
+      filled_buffers_.size() < kReadAheadBufferCount) {
+    // Allocate buffers as needed up to the limit.
+    free_buffers_.push_back(new Buffer());
+  }
+
+  if (free_buffers_.empty())
+    return;
+
+  read_ahead_pending_ = true;
+  CefPostTask(TID_FILE,
+      NewCefRunnableMethod(this,
+          &CefStreamResourceHandler::ReadAheadOnFileThread));
+}
+
+void CefStreamResourceHandler::ReadAheadOnFileThread() {
+  CEF_REQUIRE_FILE_THREAD();
+
+  while (true) {
+    Buffer* buffer = NULL;
+    {
+      AutoLock lock_scope(this);
+      DCHECK(read_ahead_pending_);
+      if (canceled_ || free_buffers_.empty()) {
+        read_ahead_pending_ = false;
+        return;
+      }
+      buffer = free_buffers_.front();
+      free_buffers_.pop_front();
+    }
+
+    // Read outside of the lock so that the IO thread can consume other
+    // buffers at the same time.
+    buffer->Reset(kReadAheadBufferSize);
+    const bool has_data = (buffer->ReadFrom(this) > 0);
+
+    CefRefPtr<CefCallback> callback;
+    {
+      AutoLock lock_scope(this);
+      if (has_data) {
+        filled_buffers_.push_back(buffer);
+        if (free_buffers_.empty() &&
+            filled_buffers_.size() < kReadAheadBufferCount) {
+          free_buffers_.push_back(new Buffer());
+        }
+      } else {
+        free_buffers_.push_back(buffer);
+        read_complete_ = true;
+        read_ahead_pending_ = false;
+      }
+      callback = read_callback_;
+      read_callback_ = NULL;
+    }
+
+    // Notify the IO thread that data is available.
+    if (callback.get())
+      callback->Continue();
+
+    if (!has_data)
+      return;
+  }
 }
@@ -64,6 +64,7 @@
 #include "libcef_dll/cpptoc/task_cpptoc.h"
 #include "libcef_dll/cpptoc/urlrequest_client_cpptoc.h"
 #include "libcef_dll/cpptoc/v8accessor_cpptoc.h"
+#include "libcef_dll/cpptoc/v8fast_handler_cpptoc.h"
 #include "libcef_dll/cpptoc/v8handler_cpptoc.h"
 #include "libcef_dll/cpptoc/web_plugin_info_visitor_cpptoc.h"
 #include "libcef_dll/cpptoc/web_plugin_unstable_callback_cpptoc.h"
@@ -228,6 +229,7 @@ CEF_GLOBAL void CefShutdown() {
   DCHECK_EQ(CefV8AccessorCppToC::DebugObjCt, 0);
   DCHECK_EQ(CefV8ContextCToCpp::DebugObjCt, 0);
   DCHECK_EQ(CefV8ExceptionCToCpp::DebugObjCt, 0);
+  DCHECK_EQ(CefV8FastHandlerCppToC::DebugObjCt, 0);
   DCHECK_EQ(CefV8HandlerCppToC::DebugObjCt, 0);
   DCHECK_EQ(CefV8StackFrameCToCpp::DebugObjCt, 0);
   DCHECK_EQ(CefV8StackTraceCToCpp::DebugObjCt, 0);
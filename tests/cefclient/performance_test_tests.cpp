@@ -2,14 +2,127 @@
 // reserved. Use of this source code is governed by a BSD-style license that
 // can be found in the LICENSE file.
 
+#include <stdio.h>
+#include <sstream>
+#include <string>
+
 #include "cefclient/performance_test.h"
 #include "cefclient/performance_test_setup.h"
+#include "include/cef_stream.h"
 #include "include/cef_v8.h"
+#include "include/cef_values.h"
 
 namespace performance_test {
 
 namespace {
 
+// JavaScript object graph used by the value conversion tests.
+const char kConversionTestObject[] =
+    "({name: 'test', id: 12, ratio: 0.5, enabled: true,"
+    "  items: [1, 2, 3, 4, 5, 6, 7, 8, 9, 10],"
+    "  children: [{name: 'a', value: 1}, {name: 'b', value: 2},"
+    "             {name: 'c', value: 3}, {name: 'd', value: 4}],"
+    "  nested: {x: 1, y: 2, z: {label: 'deep', flags: [true, false]}}})";
+
+CefRefPtr<CefV8Value> CreateConversionTestObject() {
+  CefRefPtr<CefV8Value> retval;
+  CefRefPtr<CefV8Exception> exception;
+  CefV8Context::GetCurrentContext()->Eval(kConversionTestObject, retval,
+                                          exception);
+  return retval;
+}
+
+CefRefPtr<CefListValue> ManualToList(CefRefPtr<CefV8Value> value);
+
+// Convert |value| to a dictionary using the per-property accessors.
+CefRefPtr<CefDictionaryValue> ManualToDictionary(
+    CefRefPtr<CefV8Value> value) {
+  CefRefPtr<CefDictionaryValue> dict = CefDictionaryValue::Create();
+  std::vector<CefString> keys;
+  value->GetKeys(keys);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    CefRefPtr<CefV8Value> child = value->GetValue(keys[i]);
+    if (child->IsBool())
+      dict->SetBool(keys[i], child->GetBoolValue());
+    else if (child->IsInt())
+      dict->SetInt(keys[i], child->GetIntValue());
+    else if (child->IsDouble())
+      dict->SetDouble(keys[i], child->GetDoubleValue());
+    else if (child->IsString())
+      dict->SetString(keys[i], child->GetStringValue());
+    else if (child->IsArray())
+      dict->SetList(keys[i], ManualToList(child));
+    else if (child->IsObject())
+      dict->SetDictionary(keys[i], ManualToDictionary(child));
+  }
+  return dict;
+}
+
+// Convert |value| to a list using the per-element accessors.
+CefRefPtr<CefListValue> ManualToList(CefRefPtr<CefV8Value> value) {
+  CefRefPtr<CefListValue> list = CefListValue::Create();
+  int length = value->GetArrayLength();
+  list->SetSize(length);
+  for (int i = 0; i < length; ++i) {
+    CefRefPtr<CefV8Value> child = value->GetValue(i);
+    if (child->IsBool())
+      list->SetBool(i, child->GetBoolValue());
+    else if (child->IsInt())
+      list->SetInt(i, child->GetIntValue());
+    else if (child->IsDouble())
+      list->SetDouble(i, child->GetDoubleValue());
+    else if (child->IsString())
+      list->SetString(i, child->GetStringValue());
+    else if (child->IsArray())
+      list->SetList(i, ManualToList(child));
+    else if (child->IsObject())
+      list->SetDictionary(i, ManualToDictionary(child));
+  }
+  return list;
+}
+
+// File used by the stream read tests.
+const char kStreamTestFile[] = "perf_stream_test.dat";
+const size_t kStreamTestFileSize = 4 * 1024 * 1024;
+const size_t kStreamTestChunkSize = 32 * 1024;
+
+// Create the stream test file. Returns false on failure.
+bool CreateStreamTestFile() {
+  FILE* f = fopen(kStreamTestFile, "wb");
+  if (!f)
+    return false;
+  std::string chunk(kStreamTestChunkSize, 'x');
+  bool success = true;
+  for (size_t i = 0; success && i < kStreamTestFileSize;
+       i += kStreamTestChunkSize) {
+    success = (fwrite(chunk.data(), chunk.size(), 1, f) == 1);
+  }
+  fclose(f);
+  return success;
+}
+
+// Read the stream test file in chunks using |mapped| or FILE* access and
+// return the time taken.
+int64 ReadStreamTestFile(int iterations, bool mapped) {
+  if (!CreateStreamTestFile())
+    return 0;
+
+  std::string buffer(kStreamTestChunkSize, 0);
+  int64 result = 0;
+  PERF_ITERATIONS_START_EX()
+  CefRefPtr<CefStreamReader> stream = mapped ?
+      CefStreamReader::CreateForMappedFile(kStreamTestFile) :
+      CefStreamReader::CreateForFile(kStreamTestFile);
+  if (!stream.get())
+    break;
+  while (stream->Read(&buffer[0], 1, buffer.size()) > 0) {
+  }
+  PERF_ITERATIONS_END_EX(result)
+
+  remove(kStreamTestFile);
+  return result;
+}
+
 // Test function implementations.
 
 PERF_TEST_FUNC(V8NullCreate) {
@@ -127,6 +240,35 @@ PERF_TEST_FUNC(V8FunctionExecute) {
   PERF_ITERATIONS_END()
 }
 
+PERF_TEST_FUNC(V8FunctionExecuteWithArgs) {
+  class Handler : public CefV8Handler {
+   public:
+    Handler() {}
+    virtual bool Execute(const CefString& name,
+                         CefRefPtr<CefV8Value> object,
+                         const CefV8ValueList& arguments,
+                         CefRefPtr<CefV8Value>& retval,
+                         CefString& exception) OVERRIDE {
+      retval = CefV8Value::CreateDouble(arguments[0]->GetIntValue() +
+                                        arguments[1]->GetDoubleValue());
+      return true;
+    }
+    IMPLEMENT_REFCOUNTING(Handler);
+  };
+
+  CefString name = "name";
+  CefRefPtr<CefV8Handler> handler = new Handler();
+  CefRefPtr<CefV8Value> func = CefV8Value::CreateFunction(name, handler);
+  CefRefPtr<CefV8Value> obj = CefV8Context::GetCurrentContext()->GetGlobal();
+  CefV8ValueList args;
+  args.push_back(CefV8Value::CreateInt(5));
+  args.push_back(CefV8Value::CreateDouble(12.432));
+
+  PERF_ITERATIONS_START()
+  func->ExecuteFunction(obj, args);
+  PERF_ITERATIONS_END()
+}
+
 PERF_TEST_FUNC(V8FunctionExecuteWithContext) {
   class Handler : public CefV8Handler {
    public:
@@ -151,6 +293,69 @@ PERF_TEST_FUNC(V8FunctionExecuteWithContext) {
   PERF_ITERATIONS_END()
 }
 
+PERF_TEST_FUNC(V8FastFunctionExecute) {
+  class Handler : public CefV8FastHandler {
+   public:
+    Handler() {}
+    virtual int GetArgumentCount() OVERRIDE { return 0; }
+    virtual Type GetArgumentType(int index) OVERRIDE {
+      return V8_FAST_TYPE_VOID;
+    }
+    virtual Type GetReturnType() OVERRIDE { return V8_FAST_TYPE_VOID; }
+    virtual bool Execute(const CefString& name,
+                         const std::vector<double>& numbers,
+                         const std::vector<CefString>& strings,
+                         double& number_retval,
+                         CefString& string_retval,
+                         CefString& exception) OVERRIDE { return true; }
+    IMPLEMENT_REFCOUNTING(Handler);
+  };
+
+  CefString name = "name";
+  CefRefPtr<CefV8FastHandler> handler = new Handler();
+  CefRefPtr<CefV8Value> func = CefV8Value::CreateFastFunction(name, handler);
+  CefRefPtr<CefV8Value> obj = CefV8Context::GetCurrentContext()->GetGlobal();
+  CefV8ValueList args;
+
+  PERF_ITERATIONS_START()
+  func->ExecuteFunction(obj, args);
+  PERF_ITERATIONS_END()
+}
+
+PERF_TEST_FUNC(V8FastFunctionExecuteWithArgs) {
+  class Handler : public CefV8FastHandler {
+   public:
+    Handler() {}
+    virtual int GetArgumentCount() OVERRIDE { return 2; }
+    virtual Type GetArgumentType(int index) OVERRIDE {
+      return index == 0 ? V8_FAST_TYPE_INT : V8_FAST_TYPE_DOUBLE;
+    }
+    virtual Type GetReturnType() OVERRIDE { return V8_FAST_TYPE_DOUBLE; }
+    virtual bool Execute(const CefString& name,
+                         const std::vector<double>& numbers,
+                         const std::vector<CefString>& strings,
+                         double& number_retval,
+                         CefString& string_retval,
+                         CefString& exception) OVERRIDE {
+      number_retval = numbers[0] + numbers[1];
+      return true;
+    }
+    IMPLEMENT_REFCOUNTING(Handler);
+  };
+
+  CefString name = "name";
+  CefRefPtr<CefV8FastHandler> handler = new Handler();
+  CefRefPtr<CefV8Value> func = CefV8Value::CreateFastFunction(name, handler);
+  CefRefPtr<CefV8Value> obj = CefV8Context::GetCurrentContext()->GetGlobal();
+  CefV8ValueList args;
+  args.push_back(CefV8Value::CreateInt(5));
+  args.push_back(CefV8Value::CreateDouble(12.432));
+
+  PERF_ITERATIONS_START()
+  func->ExecuteFunction(obj, args);
+  PERF_ITERATIONS_END()
+}
+
 PERF_TEST_FUNC(V8ObjectCreate) {
   PERF_ITERATIONS_START()
   CefRefPtr<CefV8Value> value = CefV8Value::CreateObject(NULL);
@@ -274,6 +479,31 @@ PERF_TEST_FUNC(V8ObjectGetValueWithAccessor) {
   PERF_ITERATIONS_END()
 }
 
+PERF_TEST_FUNC(V8ObjectToDictionaryManual) {
+  CefRefPtr<CefV8Value> obj = CreateConversionTestObject();
+
+  PERF_ITERATIONS_START()
+  CefRefPtr<CefDictionaryValue> dict = ManualToDictionary(obj);
+  PERF_ITERATIONS_END()
+}
+
+PERF_TEST_FUNC(V8ObjectToDictionary) {
+  CefRefPtr<CefV8Value> obj = CreateConversionTestObject();
+
+  PERF_ITERATIONS_START()
+  CefRefPtr<CefDictionaryValue> dict = obj->ToDictionary();
+  PERF_ITERATIONS_END()
+}
+
+PERF_TEST_FUNC(V8ObjectCreateFromDictionary) {
+  CefRefPtr<CefDictionaryValue> dict =
+      CreateConversionTestObject()->ToDictionary();
+
+  PERF_ITERATIONS_START()
+  CefRefPtr<CefV8Value> value = CefV8Value::CreateFromDictionary(dict);
+  PERF_ITERATIONS_END()
+}
+
 PERF_TEST_FUNC(V8ContextEnterExit) {
   CefRefPtr<CefV8Context> context = CefV8Context::GetCurrentContext();
 
@@ -294,6 +524,78 @@ PERF_TEST_FUNC(V8ContextEval) {
   PERF_ITERATIONS_END()
 }
 
+PERF_TEST_FUNC(V8ContextEvalLarge) {
+  // Generate a script that is expensive to parse relative to running it.
+  std::stringstream ss;
+  for (int i = 0; i < 1000; ++i) {
+    ss << "function perf_func" << i << "(a, b) { var c = a * " << i <<
+          "; return c + b; }\n";
+  }
+  ss << "var i = 0;";
+
+  CefRefPtr<CefV8Context> context = CefV8Context::GetCurrentContext();
+  CefString jsCode = ss.str();
+  CefRefPtr<CefV8Value> retval;
+  CefRefPtr<CefV8Exception> exception;
+
+  PERF_ITERATIONS_START()
+  context->Eval(jsCode, retval, exception);
+  PERF_ITERATIONS_END()
+}
+
+// Measures the time required to release a frame context that owns many
+// native-backed objects.
+PERF_TEST_FUNC(V8ContextRelease) {
+  static const int kObjectCount = 10000;
+
+  CefRefPtr<CefV8Context> context = CefV8Context::GetCurrentContext();
+  CefRefPtr<CefBrowser> browser = context->GetBrowser();
+  CefRefPtr<CefV8Value> retval;
+  CefRefPtr<CefV8Exception> exception;
+  int64 result = 0;
+
+  for (int i = 0; i < PERF_TEST_PARAM_ITERATIONS; ++i) {
+    context->Eval(
+        "var perfFrame = document.createElement('iframe');"
+        "perfFrame.name = 'perf_context_release';"
+        "document.body.appendChild(perfFrame);",
+        retval, exception);
+
+    CefRefPtr<CefFrame> frame = browser->GetFrame("perf_context_release");
+    if (!frame.get())
+      return 0;
+
+    // Objects stored in the frame are tracked until its context is released.
+    CefRefPtr<CefV8Context> frame_context = frame->GetV8Context();
+    frame_context->Enter();
+    CefRefPtr<CefV8Value> objects = CefV8Value::CreateArray(kObjectCount);
+    for (int j = 0; j < kObjectCount; ++j)
+      objects->SetValue(j, CefV8Value::CreateObject(NULL));
+    frame_context->GetGlobal()->SetValue("objects", objects,
+                                         V8_PROPERTY_ATTRIBUTE_NONE);
+    objects = NULL;
+    frame_context->Exit();
+    frame_context = NULL;
+    frame = NULL;
+
+    CefTimer timer;
+    timer.Start();
+    context->Eval("document.body.removeChild(perfFrame);", retval, exception);
+    timer.Stop();
+    result += timer.Delta();
+  }
+
+  return result;
+}
+
+PERF_TEST_FUNC(StreamReadFile) {
+  return ReadStreamTestFile(PERF_TEST_PARAM_ITERATIONS, false);
+}
+
+PERF_TEST_FUNC(StreamReadMappedFile) {
+  return ReadStreamTestFile(PERF_TEST_PARAM_ITERATIONS, true);
+}
+
 }  // namespace
 
 
@@ -312,15 +614,25 @@ const PerfTestEntry kPerfTests[] = {
   PERF_TEST_ENTRY(V8ArrayGetValue),
   PERF_TEST_ENTRY(V8FunctionCreate),
   PERF_TEST_ENTRY(V8FunctionExecute),
+  PERF_TEST_ENTRY(V8FunctionExecuteWithArgs),
   PERF_TEST_ENTRY(V8FunctionExecuteWithContext),
+  PERF_TEST_ENTRY(V8FastFunctionExecute),
+  PERF_TEST_ENTRY(V8FastFunctionExecuteWithArgs),
   PERF_TEST_ENTRY(V8ObjectCreate),
   PERF_TEST_ENTRY(V8ObjectCreateWithAccessor),
   PERF_TEST_ENTRY(V8ObjectSetValue),
   PERF_TEST_ENTRY(V8ObjectGetValue),
   PERF_TEST_ENTRY(V8ObjectSetValueWithAccessor),
   PERF_TEST_ENTRY(V8ObjectGetValueWithAccessor),
+  PERF_TEST_ENTRY(V8ObjectToDictionaryManual),
+  PERF_TEST_ENTRY(V8ObjectToDictionary),
+  PERF_TEST_ENTRY(V8ObjectCreateFromDictionary),
   PERF_TEST_ENTRY(V8ContextEnterExit),
   PERF_TEST_ENTRY(V8ContextEval),
+  PERF_TEST_ENTRY(V8ContextEvalLarge),
+  PERF_TEST_ENTRY_EX(V8ContextRelease, 10),
+  PERF_TEST_ENTRY_EX(StreamReadFile, 100),
+  PERF_TEST_ENTRY_EX(StreamReadMappedFile, 100),
 };
 
 const int kPerfTestsCount = (sizeof(kPerfTests) / sizeof(kPerfTests[0]));
@@ -0,0 +1,215 @@
+// Copyright (c) 2014 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "base/time/time.h"
+#include "libcef/browser/backing_store_osr_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Resolutions used for benchmarking.
+struct Resolution {
+  const char* name;
+  int width;
+  int height;
+};
+
+const Resolution kResolutions[] = {
+  {"720p", 1280, 720},
+  {"1080p", 1920, 1080},
+  {"1440p", 2560, 1440},
+};
+
+// Scroll deltas used for benchmarking.
+const int kScrollDeltas[] = {1, 40, -40, 200};
+
+const int kBenchmarkIterations = 20;
+
+typedef std::vector<uint32> Image;
+
+void FillRandom(Image* image) {
+  srand(1);
+  for (size_t i = 0; i < image->size(); ++i)
+    (*image)[i] = (static_cast<uint32>(rand()) << 16) ^
+                  static_cast<uint32>(rand());
+}
+
+uint8* Pixels(Image* image) {
+  return reinterpret_cast<uint8*>(&(*image)[0]);
+}
+
+// Straightforward per-pixel implementation of ScrollRect.
+void ScrollRectReference(Image* image, int image_width,
+                         int x, int y, int width, int height,
+                         int dx, int dy) {
+  Image copy(*image);
+  for (int py = y; py < y + height; ++py) {
+    for (int px = x; px < x + width; ++px) {
+      const int sx = px - dx;
+      const int sy = py - dy;
+      if (sx >= x && sx < x + width && sy >= y && sy < y + height)
+        (*image)[py * image_width + px] = copy[sy * image_width + sx];
+    }
+  }
+}
+
+double MBPerSecond(size_t bytes, const base::TimeDelta& elapsed) {
+  const double seconds = elapsed.InSecondsF();
+  if (seconds <= 0)
+    return 0;
+  return bytes / (1024.0 * 1024.0) / seconds;
+}
+
+class BackingStoreOSRUtilTest : public testing::Test {
+ protected:
+  virtual void TearDown() OVERRIDE {
+    backing_store_osr_util::SetForceScalar(false);
+  }
+};
+
+}  // namespace
+
+// Verify ScrollRect against the reference implementation.
+TEST_F(BackingStoreOSRUtilTest, ScrollRect) {
+  const int kWidth = 67;
+  const int kHeight = 41;
+
+  srand(2);
+  for (int i = 0; i < 500; ++i) {
+    Image expected(kWidth * kHeight);
+    FillRandom(&expected);
+    Image actual(expected);
+
+    const int x = rand() % kWidth;
+    const int y = rand() % kHeight;
+    const int width = rand() % (kWidth - x) + 1;
+    const int height = rand() % (kHeight - y) + 1;
+    const int dx = rand() % 41 - 20;
+    const int dy = rand() % 41 - 20;
+
+    ScrollRectReference(&expected, kWidth, x, y, width, height, dx, dy);
+    backing_store_osr_util::ScrollRect(Pixels(&actual), kWidth * 4,
+                                       x, y, width, height, dx, dy);
+    EXPECT_TRUE(expected == actual) <<
+        "rect=" << x << "," << y << " " << width << "x" << height <<
+        " delta=" << dx << "," << dy;
+  }
+}
+
+// Verify that the SSE2 and scalar scale kernels produce identical output.
+TEST_F(BackingStoreOSRUtilTest, Scale2x) {
+  srand(3);
+  for (int i = 0; i < 100; ++i) {
+    const int width = rand() % 37 + 2;
+    const int height = rand() % 9 + 2;
+    Image src(width * height);
+    FillRandom(&src);
+
+    Image up_simd(width * height * 4), up_scalar(width * height * 4);
+    backing_store_osr_util::SetForceScalar(false);
+    backing_store_osr_util::Upscale2x(Pixels(&src), width * 4, width, height,
+                                      Pixels(&up_simd), width * 8);
+    backing_store_osr_util::SetForceScalar(true);
+    backing_store_osr_util::Upscale2x(Pixels(&src), width * 4, width, height,
+                                      Pixels(&up_scalar), width * 8);
+    EXPECT_TRUE(up_simd == up_scalar);
+    EXPECT_EQ(src[0], up_scalar[1]);
+    EXPECT_EQ(src[0], up_scalar[width * 2]);
+    EXPECT_EQ(src[width - 1], up_scalar[width * 2 - 1]);
+
+    const int down_width = width / 2;
+    const int down_height = height / 2;
+    Image down_simd(down_width * down_height);
+    Image down_scalar(down_width * down_height);
+    backing_store_osr_util::SetForceScalar(false);
+    backing_store_osr_util::Downscale2x(Pixels(&src), width * 4, down_width,
+                                        down_height, Pixels(&down_simd),
+                                        down_width * 4);
+    backing_store_osr_util::SetForceScalar(true);
+    backing_store_osr_util::Downscale2x(Pixels(&src), width * 4, down_width,
+                                        down_height, Pixels(&down_scalar),
+                                        down_width * 4);
+    EXPECT_TRUE(down_simd == down_scalar);
+  }
+
+  // Downscaling an upscaled image must return the original.
+  Image src(16 * 8);
+  FillRandom(&src);
+  Image up(16 * 8 * 4), down(16 * 8);
+  backing_store_osr_util::Upscale2x(Pixels(&src), 16 * 4, 16, 8,
+                                    Pixels(&up), 32 * 4);
+  backing_store_osr_util::Downscale2x(Pixels(&up), 32 * 4, 16, 8,
+                                      Pixels(&down), 16 * 4);
+  EXPECT_TRUE(src == down);
+}
+
+// The benchmarks below only report timings and are disabled by default. Run
+// them with --gtest_also_run_disabled_tests.
+
+// Report scroll throughput in MB/s for common resolutions and deltas.
+TEST_F(BackingStoreOSRUtilTest, DISABLED_ScrollBenchmark) {
+  for (size_t r = 0; r < arraysize(kResolutions); ++r) {
+    const Resolution& res = kResolutions[r];
+    Image image(res.width * res.height);
+    FillRandom(&image);
+    const size_t bytes = image.size() * 4;
+
+    for (size_t d = 0; d < arraysize(kScrollDeltas); ++d) {
+      const int delta = kScrollDeltas[d];
+      base::TimeTicks start = base::TimeTicks::HighResNow();
+      for (int i = 0; i < kBenchmarkIterations; ++i) {
+        backing_store_osr_util::ScrollRect(Pixels(&image), res.width * 4,
+                                           0, 0, res.width, res.height,
+                                           0, delta);
+      }
+      const double mbps = MBPerSecond(bytes * kBenchmarkIterations,
+                                      base::TimeTicks::HighResNow() - start);
+      printf("ScrollRect %s dy=%d: %.0f MB/s\n", res.name, delta, mbps);
+    }
+  }
+}
+
+// Report 2x scale throughput in MB/s for common resolutions.
+TEST_F(BackingStoreOSRUtilTest, DISABLED_Scale2xBenchmark) {
+  for (size_t r = 0; r < arraysize(kResolutions); ++r) {
+    const Resolution& res = kResolutions[r];
+    Image small_image(res.width * res.height);
+    Image large_image(res.width * res.height * 4);
+    FillRandom(&small_image);
+    const size_t bytes = large_image.size() * 4;
+
+    double up_mbps[2], down_mbps[2];
+    for (int scalar = 0; scalar <= 1; ++scalar) {
+      backing_store_osr_util::SetForceScalar(scalar != 0);
+
+      base::TimeTicks start = base::TimeTicks::HighResNow();
+      for (int i = 0; i < kBenchmarkIterations; ++i) {
+        backing_store_osr_util::Upscale2x(Pixels(&small_image), res.width * 4,
+                                          res.width, res.height,
+                                          Pixels(&large_image),
+                                          res.width * 8);
+      }
+      up_mbps[scalar] = MBPerSecond(bytes * kBenchmarkIterations,
+                                    base::TimeTicks::HighResNow() - start);
+
+      start = base::TimeTicks::HighResNow();
+      for (int i = 0; i < kBenchmarkIterations; ++i) {
+        backing_store_osr_util::Downscale2x(Pixels(&large_image),
+                                            res.width * 8, res.width,
+                                            res.height, Pixels(&small_image),
+                                            res.width * 4);
+      }
+      down_mbps[scalar] = MBPerSecond(bytes * kBenchmarkIterations,
+                                      base::TimeTicks::HighResNow() - start);
+    }
+    printf("Upscale2x %s: simd=%.0f MB/s scalar=%.0f MB/s\n",
+           res.name, up_mbps[0], up_mbps[1]);
+    printf("Downscale2x %s: simd=%.0f MB/s scalar=%.0f MB/s\n",
+           res.name, down_mbps[0], down_mbps[1]);
+  }
+}
@@ -858,6 +858,709 @@ TEST(MessageRouterTest, SinglePersistentQueryFailureAsyncCallback) {
 }
 
 
+namespace {
+
+// Test that queries are dispatched to the handlers for their route.
+class RouteQueryTestHandler : public SingleLoadTestHandler {
+ public:
+  RouteQueryTestHandler()
+      : alpha_handler_("alpha"),
+        beta_handler_("beta"),
+        default_query_ct_(0) {}
+
+  virtual std::string GetMainHTML() OVERRIDE {
+    std::string html;
+
+    html = "<html><body><script>\n"
+           "var requests = ['alpha:1', 'beta:2', 'gamma:3', 'alpha', "
+                           "'beta:decline'];\n"
+           "var responses = [];\n"
+           "function onSuccess(response) {\n"
+           "  responses.push(response);\n"
+           "  if (responses.length == requests.length)\n"
+           "    window.mrtNotify(responses.join(','));\n"
+           "}\n"
+           "function onFailure(error_code, error_message) {\n"
+           "  window.mrtNotify('error-onFailure');\n"
+           "}\n"
+           "for (var i = 0; i < requests.length; ++i) {\n"
+           "  window.mrtQuery({request: requests[i], persistent: false,\n"
+           "                   onSuccess: onSuccess, onFailure: onFailure});\n"
+           "}\n"
+           "</script></body></html>";
+    return html;
+  }
+
+  virtual void AddHandlers(
+      CefRefPtr<CefMessageRouterBrowserSide> message_router) OVERRIDE {
+    SingleLoadTestHandler::AddHandlers(message_router);
+
+    EXPECT_TRUE(message_router->AddHandler(&alpha_handler_, false, "alpha"));
+    EXPECT_TRUE(message_router->AddHandler(&beta_handler_, false, "beta"));
+    EXPECT_FALSE(message_router->AddHandler(&beta_handler_, true, "beta"));
+    EXPECT_FALSE(message_router->AddHandler(&beta_handler_, false, ""));
+  }
+
+  virtual void OnNotify(CefRefPtr<CefBrowser> browser,
+                        CefRefPtr<CefFrame> frame,
+                        const std::string& message) OVERRIDE {
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+    EXPECT_STREQ("alpha=alpha:1,beta=beta:2,default=gamma:3,alpha=alpha,"
+                 "default=beta:decline", message.c_str());
+
+    got_notify_.yes();
+
+    CefRefPtr<CefDictionaryValue> statistics =
+        GetRouter()->GetRouteStatistics();
+    EXPECT_EQ(3U, statistics->GetSize());
+    VerifyRouteStatistics(statistics->GetDictionary("alpha"), 2);
+    VerifyRouteStatistics(statistics->GetDictionary("beta"), 2);
+    VerifyRouteStatistics(statistics->GetDictionary(CefString()), 1);
+
+    DestroyTest();
+  }
+
+  virtual bool OnQuery(CefRefPtr<CefBrowser> browser,
+                       CefRefPtr<CefFrame> frame,
+                       int64 query_id,
+                       const CefString& request,
+                       bool persistent,
+                       CefRefPtr<Callback> callback) OVERRIDE {
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+
+    default_query_ct_++;
+    callback->Success("default=" + request.ToString());
+    return true;
+  }
+
+  virtual void DestroyTest() OVERRIDE {
+    EXPECT_TRUE(got_notify_);
+    EXPECT_EQ(2, alpha_handler_.query_ct());
+    EXPECT_EQ(2, beta_handler_.query_ct());
+    EXPECT_EQ(2, default_query_ct_);
+
+    TestHandler::DestroyTest();
+  }
+
+ private:
+  // Handles all queries for a route except "<route>:decline".
+  class RouteHandler : public CefMessageRouterBrowserSide::Handler {
+   public:
+    explicit RouteHandler(const std::string& route)
+        : route_(route),
+          query_ct_(0) {}
+
+    virtual bool OnQuery(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int64 query_id,
+                         const CefString& request,
+                         bool persistent,
+                         CefRefPtr<Callback> callback) OVERRIDE {
+      query_ct_++;
+      const std::string& request_str = request.ToString();
+      EXPECT_EQ(0U, request_str.find(route_));
+      if (request_str == route_ + ":decline")
+        return false;
+
+      callback->Success(route_ + "=" + request_str);
+      return true;
+    }
+
+    int query_ct() const { return query_ct_; }
+
+   private:
+    const std::string route_;
+    int query_ct_;
+  };
+
+  static void VerifyRouteStatistics(CefRefPtr<CefDictionaryValue> statistics,
+                                    int expected_count) {
+    EXPECT_TRUE(statistics.get());
+    if (!statistics.get())
+      return;
+    EXPECT_EQ(expected_count, statistics->GetInt("query_count"));
+    EXPECT_EQ(0, statistics->GetInt("unhandled_count"));
+    EXPECT_EQ(0, statistics->GetInt("pending_count"));
+    EXPECT_EQ(expected_count, statistics->GetInt("completed_count"));
+    EXPECT_GE(statistics->GetDouble("total_latency_ms"),
+              statistics->GetDouble("max_latency_ms"));
+  }
+
+  RouteHandler alpha_handler_;
+  RouteHandler beta_handler_;
+  int default_query_ct_;
+
+  TrackCallback got_notify_;
+};
+
+}  // namespace
+
+// Test that queries are dispatched to the handlers for their route.
+TEST(MessageRouterTest, RouteQuery) {
+  CefRefPtr<RouteQueryTestHandler> handler = new RouteQueryTestHandler();
+  handler->ExecuteTest();
+}
+
+
+namespace {
+
+// Test that queries are dispatched to handlers on the thread returned by
+// Handler::GetThreadId.
+class ThreadQueryTestHandler : public SingleLoadTestHandler {
+ public:
+  ThreadQueryTestHandler()
+      : ui_query_ct_(0) {}
+
+  virtual std::string GetMainHTML() OVERRIDE {
+    std::string html;
+
+    html = "<html><body><script>\n"
+           "var requests = ['file:sync', 'file:async', 'file:decline', "
+                           "'file:fail'];\n"
+           "var responses = [];\n"
+           "function onResponse(response) {\n"
+           "  responses.push(response);\n"
+           "  if (responses.length == requests.length + 1)\n"
+           "    window.mrtNotify(responses.sort().join(','));\n"
+           "}\n"
+           "function onFailure(error_code, error_message) {\n"
+           "  onResponse(error_code + '=' + error_message);\n"
+           "}\n"
+           "for (var i = 0; i < requests.length; ++i) {\n"
+           "  window.mrtQuery({request: requests[i], persistent: false,\n"
+           "                   onSuccess: onResponse, onFailure: onFailure});\n"
+           "}\n"
+           // Responses to a persistent query are sent from multiple threads.
+           "var ordered = '';\n"
+           "window.mrtQuery({request: 'file:ordered', persistent: true,\n"
+           "    onSuccess: function(response) { ordered += response; },\n"
+           "    onFailure: function() {\n"
+           "      onResponse('ordered=' + ordered);\n"
+           "    }});\n"
+           "</script></body></html>";
+    return html;
+  }
+
+  virtual void AddHandlers(
+      CefRefPtr<CefMessageRouterBrowserSide> message_router) OVERRIDE {
+    EXPECT_TRUE(message_router->AddHandler(&file_handler_, false, "file"));
+    SingleLoadTestHandler::AddHandlers(message_router);
+
+    // Handlers can't execute on threads that don't exist in the browser
+    // process or change threads.
+    EXPECT_FALSE(message_router->AddHandler(&renderer_handler_, false));
+    EXPECT_FALSE(message_router->AddHandler(&renderer_handler_, false,
+                                            "file"));
+    file_handler_.set_thread_id(TID_IO);
+    EXPECT_FALSE(message_router->AddHandler(&file_handler_, false));
+    file_handler_.set_thread_id(TID_FILE);
+  }
+
+  virtual void OnNotify(CefRefPtr<CefBrowser> browser,
+                        CefRefPtr<CefFrame> frame,
+                        const std::string& message) OVERRIDE {
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+    EXPECT_STREQ("5=file:fail,file=file:async,file=file:sync,"
+                 "ordered=0123456789,ui=file:decline", message.c_str());
+
+    got_notify_.yes();
+    DestroyTest();
+  }
+
+  virtual bool OnQuery(CefRefPtr<CefBrowser> browser,
+                       CefRefPtr<CefFrame> frame,
+                       int64 query_id,
+                       const CefString& request,
+                       bool persistent,
+                       CefRefPtr<Callback> callback) OVERRIDE {
+    EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+
+    // Only queries declined by |file_handler_| should get here.
+    ui_query_ct_++;
+    EXPECT_STREQ("file:decline", request.ToString().c_str());
+    callback->Success("ui=" + request.ToString());
+    return true;
+  }
+
+  virtual void DestroyTest() OVERRIDE {
+    EXPECT_TRUE(got_notify_);
+    EXPECT_EQ(5, file_handler_.query_ct());
+    EXPECT_EQ(1, ui_query_ct_);
+
+    TestHandler::DestroyTest();
+  }
+
+ private:
+  // Handles queries on the FILE thread.
+  class FileHandler : public CefMessageRouterBrowserSide::Handler {
+   public:
+    FileHandler()
+        : thread_id_(TID_FILE),
+          query_ct_(0) {}
+
+    virtual CefThreadId GetThreadId() OVERRIDE {
+      EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+      return thread_id_;
+    }
+
+    virtual bool OnQuery(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int64 query_id,
+                         const CefString& request,
+                         bool persistent,
+                         CefRefPtr<Callback> callback) OVERRIDE {
+      EXPECT_TRUE(CefCurrentlyOn(TID_FILE));
+      query_ct_++;
+
+      const std::string& request_str = request.ToString();
+      if (request_str == "file:decline")
+        return false;
+
+      if (request_str == "file:fail") {
+        callback->Failure(kSingleQueryErrorCode, request_str);
+      } else if (request_str == "file:ordered") {
+        // The first response is sent before the query is registered and the
+        // rest are sent concurrently from the IO thread.
+        EXPECT_TRUE(persistent);
+        callback->Success("0");
+        CefPostTask(TID_IO,
+            NewCefRunnableFunction(&FileHandler::SendOrdered, callback));
+      } else if (request_str == "file:async") {
+        CefPostTask(TID_FILE,
+            NewCefRunnableMethod(callback.get(), &Callback::Success,
+                                 CefString("file=" + request_str)));
+      } else {
+        callback->Success("file=" + request_str);
+      }
+      return true;
+    }
+
+    virtual void OnQueryCanceled(CefRefPtr<CefBrowser> browser,
+                                 CefRefPtr<CefFrame> frame,
+                                 int64 query_id) OVERRIDE {
+      EXPECT_TRUE(CefCurrentlyOn(TID_FILE));
+    }
+
+    void set_thread_id(CefThreadId thread_id) { thread_id_ = thread_id; }
+    int query_ct() const { return query_ct_; }
+
+   private:
+    static void SendOrdered(CefRefPtr<Callback> callback) {
+      for (char c = '1'; c <= '9'; ++c)
+        callback->Success(std::string(1, c));
+      callback->Failure(kSingleQueryErrorCode, "done");
+    }
+
+    CefThreadId thread_id_;
+    int query_ct_;
+  };
+
+  // Can't be added because it returns a renderer process thread.
+  class RendererHandler : public CefMessageRouterBrowserSide::Handler {
+   public:
+    virtual CefThreadId GetThreadId() OVERRIDE {
+      return TID_RENDERER;
+    }
+
+    virtual bool OnQuery(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int64 query_id,
+                         const CefString& request,
+                         bool persistent,
+                         CefRefPtr<Callback> callback) OVERRIDE {
+      ADD_FAILURE();
+      return false;
+    }
+  };
+
+  FileHandler file_handler_;
+  RendererHandler renderer_handler_;
+  int ui_query_ct_;
+
+  TrackCallback got_notify_;
+};
+
+}  // namespace
+
+// Test that queries are dispatched to handlers on other browser threads.
+TEST(MessageRouterTest, ThreadQuery) {
+  CefRefPtr<ThreadQueryTestHandler> handler = new ThreadQueryTestHandler();
+  handler->ExecuteTest();
+}
+
+
+namespace {
+
+// Echo the value at index 0 of |request| with Callback::SuccessValue.
+void EchoRequestValue(
+    CefRefPtr<CefListValue> request,
+    CefRefPtr<CefMessageRouterBrowserSide::Callback> callback) {
+  CefRefPtr<CefListValue> response = CefListValue::Create();
+  switch (request->GetType(0)) {
+    case VTYPE_BINARY:
+      response->SetBinary(0, request->GetBinary(0));
+      break;
+    case VTYPE_DICTIONARY:
+      response->SetDictionary(0, request->GetDictionary(0));
+      break;
+    case VTYPE_LIST:
+      response->SetList(0, request->GetList(0));
+      break;
+    default:
+      EXPECT_TRUE(false);  // Not reached.
+      break;
+  }
+  callback->SuccessValue(response);
+
+  // The value was moved out of |response| instead of being copied.
+  EXPECT_EQ(0U, response->GetSize());
+}
+
+// Test queries with binary and structured requests and responses.
+class ValueQueryTestHandler : public SingleLoadTestHandler {
+ public:
+  ValueQueryTestHandler()
+      : query_ct_(0),
+        value_query_ct_(0) {}
+
+  virtual std::string GetMainHTML() OVERRIDE {
+    std::string html;
+
+    html = "<html><body><script>\n"
+           "var results = [];\n"
+           "var expected_ct = 5;\n"
+           "function onResult(result) {\n"
+           "  results.push(result);\n"
+           "  if (results.length == expected_ct)\n"
+           "    window.mrtNotify(results.sort().join(','));\n"
+           "}\n"
+           "function onFailure(error_code, error_message) {\n"
+           "  onResult('failure');\n"
+           "}\n"
+           "function query(request, onSuccess) {\n"
+           "  window.mrtQuery({request: request, persistent: false,\n"
+           "                   onSuccess: onSuccess, onFailure: onFailure});\n"
+           "}\n"
+           "query({a: 1, b: 'two', c: [3, 4]}, function(response) {\n"
+           "  onResult('object=' + JSON.stringify(response));\n"
+           "});\n"
+           "query([true, 'x', {y: 2.5}], function(response) {\n"
+           "  onResult('array=' + JSON.stringify(response));\n"
+           "});\n"
+           "query(new Uint8Array([1, 2, 3, 250]), function(response) {\n"
+           "  onResult('binary=' + (response instanceof ArrayBuffer) + ':' +\n"
+           "           Array.prototype.join.call(new Uint8Array(response)));\n"
+           "});\n"
+           "query('int', function(response) {\n"
+           "  onResult('int=' + (typeof response) + ':' + response);\n"
+           "});\n"
+           "try {\n"
+           "  query(new ArrayBuffer(0), function() {});\n"
+           "} catch (e) {\n"
+           "  onResult('exception');\n"
+           "}\n"
+           "</script></body></html>";
+    return html;
+  }
+
+  virtual void OnNotify(CefRefPtr<CefBrowser> browser,
+                        CefRefPtr<CefFrame> frame,
+                        const std::string& message) OVERRIDE {
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+    EXPECT_STREQ("array=[true,\"x\",{\"y\":2.5}],binary=true:1,2,3,250,"
+                 "exception,int=number:42,"
+                 "object={\"a\":1,\"b\":\"two\",\"c\":[3,4]}",
+                 message.c_str());
+
+    got_notify_.yes();
+    DestroyTest();
+  }
+
+  virtual bool OnQuery(CefRefPtr<CefBrowser> browser,
+                       CefRefPtr<CefFrame> frame,
+                       int64 query_id,
+                       const CefString& request,
+                       bool persistent,
+                       CefRefPtr<Callback> callback) OVERRIDE {
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+    EXPECT_STREQ("int", request.ToString().c_str());
+
+    query_ct_++;
+    CefRefPtr<CefListValue> response = CefListValue::Create();
+    response->SetInt(0, 42);
+    callback->SuccessValue(response);
+    return true;
+  }
+
+  virtual bool OnQueryValue(CefRefPtr<CefBrowser> browser,
+                            CefRefPtr<CefFrame> frame,
+                            int64 query_id,
+                            CefRefPtr<CefListValue> request,
+                            bool persistent,
+                            CefRefPtr<Callback> callback) OVERRIDE {
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+    EXPECT_EQ(1U, request->GetSize());
+
+    value_query_ct_++;
+    if (request->GetType(0) == VTYPE_DICTIONARY) {
+      CefRefPtr<CefDictionaryValue> dictionary = request->GetDictionary(0);
+      EXPECT_EQ(1, dictionary->GetInt("a"));
+      EXPECT_STREQ("two", dictionary->GetString("b").ToString().c_str());
+      EXPECT_EQ(2U, dictionary->GetList("c")->GetSize());
+    } else if (request->GetType(0) == VTYPE_LIST) {
+      CefRefPtr<CefListValue> list = request->GetList(0);
+      EXPECT_EQ(3U, list->GetSize());
+      EXPECT_TRUE(list->GetBool(0));
+    } else {
+      EXPECT_EQ(VTYPE_BINARY, request->GetType(0));
+      EXPECT_EQ(4U, request->GetBinary(0)->GetSize());
+    }
+
+    EchoRequestValue(request, callback);
+    return true;
+  }
+
+  virtual void DestroyTest() OVERRIDE {
+    EXPECT_TRUE(got_notify_);
+    EXPECT_EQ(1, query_ct_);
+    EXPECT_EQ(3, value_query_ct_);
+
+    TestHandler::DestroyTest();
+  }
+
+ private:
+  int query_ct_;
+  int value_query_ct_;
+
+  TrackCallback got_notify_;
+};
+
+const int kValueQueryThroughputCount = 100;
+const int kValueQueryThroughputSize = 64 * 1024;
+
+// Test the round trip of many large binary requests and responses.
+class ValueQueryThroughputTestHandler : public SingleLoadTestHandler {
+ public:
+  ValueQueryThroughputTestHandler()
+      : value_query_ct_(0) {}
+
+  virtual std::string GetMainHTML() OVERRIDE {
+    return base::StringPrintf(
+        "<html><body><script>\n"
+        "var count = %d;\n"
+        "var size = %d;\n"
+        "var received = 0;\n"
+        "var errors = 0;\n"
+        "function onSuccess(response) {\n"
+        "  var bytes = new Uint8Array(response);\n"
+        "  if (bytes.length != size || bytes[0] != bytes[size - 1])\n"
+        "    errors++;\n"
+        "  if (++received == count)\n"
+        "    window.mrtNotify(received + ':' + errors);\n"
+        "}\n"
+        "function onFailure(error_code, error_message) {\n"
+        "  window.mrtNotify('failure');\n"
+        "}\n"
+        "for (var i = 0; i < count; ++i) {\n"
+        "  var request = new Uint8Array(size);\n"
+        "  request[0] = request[size - 1] = i;\n"
+        "  window.mrtQuery({request: request.buffer, persistent: false,\n"
+        "                   onSuccess: onSuccess, onFailure: onFailure});\n"
+        "}\n"
+        "</script></body></html>",
+        kValueQueryThroughputCount, kValueQueryThroughputSize);
+  }
+
+  virtual void OnNotify(CefRefPtr<CefBrowser> browser,
+                        CefRefPtr<CefFrame> frame,
+                        const std::string& message) OVERRIDE {
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+
+    EXPECT_STREQ(base::StringPrintf("%d:0", kValueQueryThroughputCount).c_str(),
+                 message.c_str());
+
+    got_notify_.yes();
+    DestroyTest();
+  }
+
+  virtual bool OnQueryValue(CefRefPtr<CefBrowser> browser,
+                            CefRefPtr<CefFrame> frame,
+                            int64 query_id,
+                            CefRefPtr<CefListValue> request,
+                            bool persistent,
+                            CefRefPtr<Callback> callback) OVERRIDE {
+    EXPECT_EQ(VTYPE_BINARY, request->GetType(0));
+    EXPECT_EQ(static_cast<size_t>(kValueQueryThroughputSize),
+              request->GetBinary(0)->GetSize());
+
+    value_query_ct_++;
+    EchoRequestValue(request, callback);
+    return true;
+  }
+
+  virtual void DestroyTest() OVERRIDE {
+    EXPECT_TRUE(got_notify_);
+    EXPECT_EQ(kValueQueryThroughputCount, value_query_ct_);
+
+    TestHandler::DestroyTest();
+  }
+
+ private:
+  int value_query_ct_;
+
+  TrackCallback got_notify_;
+};
+
+}  // namespace
+
+// Test queries with binary and structured requests and responses.
+TEST(MessageRouterTest, ValueQuery) {
+  CefRefPtr<ValueQueryTestHandler> handler = new ValueQueryTestHandler();
+  handler->ExecuteTest();
+}
+
+// Test the round trip of many large binary requests and responses. This is a
+// throughput benchmark so it is disabled by default. Run it with
+// --gtest_also_run_disabled_tests.
+TEST(MessageRouterTest, DISABLED_ValueQueryThroughput) {
+  CefRefPtr<ValueQueryThroughputTestHandler> handler =
+      new ValueQueryThroughputTestHandler();
+  handler->ExecuteTest();
+}
+
+
+namespace {
+
+const int kCoalesceQueryResponseCount = 20;
+
+// Test persistent queries that coalesce responses.
+class CoalesceQueryTestHandler : public SingleLoadTestHandler {
+ public:
+  explicit CoalesceQueryTestHandler(bool batch)
+      : batch_(batch) {}
+
+  virtual std::string GetMainHTML() OVERRIDE {
+    // With 'batch' each onSuccess call receives an array of responses.
+    return base::StringPrintf(
+        "<html><body><script>\n"
+        "var batch = %s;\n"
+        "var responses = [];\n"
+        "var call_ct = 0;\n"
+        "var request_id = window.mrtQuery({\n"
+        "  request: 'coalesce', persistent: true, coalesce: '%s',\n"
+        "  onSuccess: function(response) {\n"
+        "    call_ct++;\n"
+        "    responses = responses.concat(batch ? response : [response]);\n"
+        "    if (responses[responses.length - 1] == '%d') {\n"
+        "      window.mrtQueryCancel(request_id);\n"
+        "      window.mrtNotify(call_ct + ':' + responses.join(','));\n"
+        "    }\n"
+        "  },\n"
+        "  onFailure: function(error_code, error_message) {\n"
+        "    window.mrtNotify('failure');\n"
+        "  }\n"
+        "});\n"
+        "</script></body></html>",
+        batch_ ? "true" : "false", batch_ ? "batch" : "latest",
+        kCoalesceQueryResponseCount - 1);
+  }
+
+  virtual void OnNotify(CefRefPtr<CefBrowser> browser,
+                        CefRefPtr<CefFrame> frame,
+                        const std::string& message) OVERRIDE {
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+
+    // The first 4 responses are sent individually. All other responses are
+    // held until the renderer returns credits and then sent together.
+    std::string expected = "5:0,1,2,3";
+    if (batch_) {
+      for (int i = 4; i < kCoalesceQueryResponseCount; ++i)
+        expected += base::StringPrintf(",%d", i);
+    } else {
+      expected += base::StringPrintf(",%d", kCoalesceQueryResponseCount - 1);
+    }
+    EXPECT_STREQ(expected.c_str(), message.c_str());
+
+    got_notify_.yes();
+    DestroyTest();
+  }
+
+  virtual bool OnQuery(CefRefPtr<CefBrowser> browser,
+                       CefRefPtr<CefFrame> frame,
+                       int64 query_id,
+                       const CefString& request,
+                       bool persistent,
+                       CefRefPtr<Callback> callback) OVERRIDE {
+    AssertMainBrowser(browser);
+    AssertMainFrame(frame);
+    EXPECT_TRUE(persistent);
+
+    callback_ = callback;
+    CefPostTask(TID_UI,
+        NewCefRunnableMethod(this, &CoalesceQueryTestHandler::SendResponses));
+    return true;
+  }
+
+  virtual void OnQueryCanceled(CefRefPtr<CefBrowser> browser,
+                               CefRefPtr<CefFrame> frame,
+                               int64 query_id) OVERRIDE {
+    got_query_canceled_.yes();
+    callback_ = NULL;
+  }
+
+  virtual void DestroyTest() OVERRIDE {
+    EXPECT_TRUE(got_notify_);
+    EXPECT_TRUE(got_query_canceled_);
+    EXPECT_FALSE(callback_.get());
+
+    TestHandler::DestroyTest();
+  }
+
+ private:
+  void SendResponses() {
+    EXPECT_FALSE(callback_->IsThrottled());
+
+    // The renderer can't return credits while this method is executing.
+    for (int i = 0; i < kCoalesceQueryResponseCount; ++i)
+      callback_->Success(base::StringPrintf("%d", i));
+
+    EXPECT_TRUE(callback_->IsThrottled());
+  }
+
+  const bool batch_;
+  CefRefPtr<Callback> callback_;
+
+  TrackCallback got_notify_;
+  TrackCallback got_query_canceled_;
+};
+
+}  // namespace
+
+// Test a persistent query that only delivers the latest held response.
+TEST(MessageRouterTest, CoalesceQueryLatest) {
+  CefRefPtr<CoalesceQueryTestHandler> handler =
+      new CoalesceQueryTestHandler(false);
+  handler->ExecuteTest();
+}
+
+// Test a persistent query that delivers held responses as a batch.
+TEST(MessageRouterTest, CoalesceQueryBatch) {
+  CefRefPtr<CoalesceQueryTestHandler> handler =
+      new CoalesceQueryTestHandler(true);
+  handler->ExecuteTest();
+}
+
+
 namespace {
 
 // Test a single unhandled query in a single page load.
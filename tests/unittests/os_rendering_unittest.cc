@@ -2,6 +2,9 @@
 // reserved. Use of this source code is governed by a BSD-style license that
 // can be found in the LICENSE file.
 
+#include <algorithm>
+#include <vector>
+
 #include "include/cef_runnable.h"
 #include "include/cef_v8.h"
 #include "include/wrapper/cef_stream_resource_handler.h"
@@ -11,6 +14,7 @@
 #include "tests/unittests/routing_test_handler.h"
 
 #include "base/logging.h"
+#include "base/time/time.h"
 #include "ui/events/keycodes/keyboard_codes.h"
 #include "ui/events/keycodes/keyboard_code_conversion.h"
 
@@ -35,6 +39,25 @@ const char kTestUrl[] = "http://tests/osrtest";
 // default osr widget size
 const int kOsrWidth = 600;
 const int kOsrHeight = 400;
+const int kOsrTileSize = 256;
+// Device scale factor used by OSR_TEST_PAINT_SPAN.
+const int kOsrSpanScaleFactor = 2;
+
+// Windowless frame rate used by OSR_TEST_FRAME_RATE.
+const int kFrameRate = 10;
+// Time window over which the delivered paints are counted.
+const int kFrameRateCountMs = 500;
+// Interval between FlushWindowlessPaint calls.
+const int kFrameRateFlushDelayMs = 20;
+// Maximum time for a flushed paint to arrive at a frame rate of 1.
+const int kFrameRateFlushLimitMs = 500;
+
+// Delay before the tiles of a hidden view are discarded. Returned from
+// GetPaintTileDiscardDelay so that it is shorter than the default.
+const int kTileDiscardDelayMs = 2000;
+// Time that OSR_TEST_PAINT_TILES_KEEP keeps the view hidden and then waits
+// for unexpected repaints.
+const int kTileKeepDelayMs = 1000;
 
 // precomputed bounding client rects for html elements (h1 and li).
 #if defined(OS_WIN) || defined(OS_LINUX)
@@ -146,6 +169,20 @@ enum OSRTestType {
   OSR_TEST_PAINT,
   // same as OSR_TEST_PAINT but with alpha values
   OSR_TEST_TRANSPARENCY,
+  // same as OSR_TEST_PAINT but rendering into a client-provided buffer
+  OSR_TEST_PAINT_BUFFER,
+  // same as OSR_TEST_PAINT but delivering dirty rects via OnPaintSpan
+  OSR_TEST_PAINT_SPAN,
+  // same as OSR_TEST_PAINT but delivering each dirty tile via OnPaintSpan
+  OSR_TEST_PAINT_TILES,
+  // same as OSR_TEST_PAINT_TILES but hiding the view for longer than the
+  // discard delay releases the tiles so that showing it repaints them
+  OSR_TEST_PAINT_TILES_DISCARD,
+  // same as OSR_TEST_PAINT_TILES but hiding the view briefly keeps the tiles
+  // so that showing it does not repaint them
+  OSR_TEST_PAINT_TILES_KEEP,
+  // same as OSR_TEST_PAINT but with a windowless frame rate limit
+  OSR_TEST_FRAME_RATE,
   // moving mouse over L02, OnCursorChange will be called
   OSR_TEST_CURSOR,
   // moving mouse on L03, OnPaint will be called for its bounding rectangle
@@ -196,6 +233,13 @@ class OSRTestHandler : public RoutingTestHandler,
  public:
   explicit OSRTestHandler(OSRTestType test)
       : test_type_(test),
+        paint_buffer_(NULL),
+        frame_rate_state_(FRAME_RATE_LOAD),
+        frame_rate_paint_count_(0),
+        tile_state_(TILE_LOAD),
+        tile_shown_paint_count_(0),
+        span_delivered_bytes_(-1),
+        span_view_bytes_(-1),
         event_count_(0),
         event_total_(1),
         started_(false) {
@@ -205,17 +249,25 @@ class OSRTestHandler : public RoutingTestHandler,
     }
   }
 
-  virtual ~OSRTestHandler() {}
+  virtual ~OSRTestHandler() {
+    // All paint buffers must be released before the browser is destroyed.
+    EXPECT_TRUE(paint_buffers_.empty());
+    for (size_t i = 0; i < paint_buffers_.size(); ++i)
+      delete [] paint_buffers_[i];
+  }
 
   // TestHandler methods
   virtual void RunTest() OVERRIDE {
     CreateOSRBrowser(kTestUrl);
 #if !defined(DEBUGGER_ATTACHED)
-    // Each test has a 5 second timeout. After this timeout it will be destroyed
-    // and the test will fail. DestroyTest will be called at the timeout even
-    // if the test is already destroyed and this is fine.
+    // Each test has a 5 second timeout, extended for tests that wait for the
+    // tile discard delay. After this timeout it will be destroyed and the test
+    // will fail. DestroyTest will be called at the timeout even if the test is
+    // already destroyed and this is fine.
+    const int timeout_ms = test_type_ == OSR_TEST_PAINT_TILES_DISCARD ?
+        kTileDiscardDelayMs + 5000 : 5000;
     CefPostDelayedTask(TID_UI, NewCefRunnableMethod(this,
-        &OSRTestHandler::DestroyTest), 5000);
+        &OSRTestHandler::DestroyTest), timeout_ms);
 #endif  // DEBUGGER_ATTACHED
   }
 
@@ -223,6 +275,8 @@ class OSRTestHandler : public RoutingTestHandler,
     if (test_type_ == OSR_TEST_IS_WINDOWLESS) {
       EXPECT_TRUE(browser->GetHost()->IsWindowRenderingDisabled());
       DestroySucceededTestSoon();
+    } else if (test_type_ == OSR_TEST_FRAME_RATE) {
+      browser->GetHost()->SetWindowlessFrameRate(kFrameRate);
     }
     RoutingTestHandler::OnAfterCreated(browser);
   }
@@ -345,7 +399,8 @@ class OSRTestHandler : public RoutingTestHandler,
 
   virtual bool GetScreenInfo(CefRefPtr<CefBrowser> browser,
                              CefScreenInfo& screen_info) {
-    screen_info.device_scale_factor = 1;
+    screen_info.device_scale_factor =
+        test_type_ == OSR_TEST_PAINT_SPAN ? kOsrSpanScaleFactor : 1;
 
     // The screen info rectangles are used by the renderer to create and
     // position popups. If not overwritten in this function, the rectangle from
@@ -357,6 +412,114 @@ class OSRTestHandler : public RoutingTestHandler,
     return true;
   }
 
+  virtual void* GetPaintBuffer(CefRefPtr<CefBrowser> browser,
+                               PaintElementType type,
+                               int width, int height) OVERRIDE {
+    if (test_type_ != OSR_TEST_PAINT_BUFFER || type != PET_VIEW)
+      return NULL;
+    // The previous buffer may still be referenced until it is released so
+    // each request gets a separate allocation.
+    paint_buffer_ = new uint32[width * height];
+    paint_buffers_.push_back(paint_buffer_);
+    return paint_buffer_;
+  }
+
+  virtual void OnPaintBufferReleased(CefRefPtr<CefBrowser> browser,
+                                     PaintElementType type,
+                                     void* buffer) OVERRIDE {
+    EXPECT_EQ(OSR_TEST_PAINT_BUFFER, test_type_);
+    EXPECT_EQ(PET_VIEW, type);
+    std::vector<uint32*>::iterator it = std::find(paint_buffers_.begin(),
+        paint_buffers_.end(), static_cast<uint32*>(buffer));
+    EXPECT_TRUE(it != paint_buffers_.end());
+    if (it == paint_buffers_.end())
+      return;
+    if (*it == paint_buffer_)
+      paint_buffer_ = NULL;
+    delete [] *it;
+    paint_buffers_.erase(it);
+  }
+
+  virtual int GetPaintSpanMergeThreshold(
+      CefRefPtr<CefBrowser> browser) OVERRIDE {
+    return test_type_ == OSR_TEST_PAINT_SPAN ? 0 : -1;
+  }
+
+  virtual int GetPaintTileSize(CefRefPtr<CefBrowser> browser) OVERRIDE {
+    return IsTileTest() ? kOsrTileSize : 0;
+  }
+
+  virtual int GetPaintTileDiscardDelay(
+      CefRefPtr<CefBrowser> browser) OVERRIDE {
+    EXPECT_TRUE(IsTileTest());
+    return kTileDiscardDelayMs;
+  }
+
+  virtual void OnPaintSpan(CefRefPtr<CefBrowser> browser,
+                           PaintElementType type,
+                           const CefRect& rect,
+                           const void* buffer,
+                           int stride) OVERRIDE {
+    if (IsTileTest()) {
+      // each call covers at most one tile and points into the tile memory
+      EXPECT_LE(rect.width, kOsrTileSize);
+      EXPECT_LE(rect.height, kOsrTileSize);
+      EXPECT_GE(stride, rect.width * 4);
+
+      if (type == PET_VIEW && tile_state_ == TILE_SHOWN)
+        tile_shown_paint_count_++;
+
+      // wait for the upper-left tile to contain the page content
+      if (type != PET_VIEW || rect.x != 0 || rect.y != 0 ||
+          *(reinterpret_cast<const uint32*>(buffer)) == 0xFFFFFFFF) {
+        return;
+      }
+
+      EXPECT_EQ(*(reinterpret_cast<const uint32*>(buffer)), 0xffff8080);
+      OnTileContentPainted(browser);
+      return;
+    }
+
+    EXPECT_EQ(OSR_TEST_PAINT_SPAN, test_type_);
+    EXPECT_EQ(rect.width * 4, stride);
+
+    // wait for the full repaint after the page has loaded. Span rects are in
+    // device pixels.
+    if (type != PET_VIEW || span_view_bytes_ >= 0 ||
+        !IsFullRepaint(rect, kOsrWidth * kOsrSpanScaleFactor,
+                       kOsrHeight * kOsrSpanScaleFactor) ||
+        IsBackgroundInBuffer(reinterpret_cast<const uint32*>(buffer),
+                             rect.width * rect.height, 0xFFFFFFFF)) {
+      return;
+    }
+
+    EXPECT_EQ(*(reinterpret_cast<const uint32*>(buffer)), 0xffff8080);
+
+    // The byte counts for this paint are added after the spans have been
+    // delivered.
+    CefRefPtr<CefBrowserHost> host = browser->GetHost();
+    span_delivered_bytes_ = host->GetPaintDeliveredBytes();
+    span_view_bytes_ = host->GetPaintViewBytes();
+    CefPostTask(TID_UI, NewCefRunnableMethod(this,
+        &OSRTestHandler::VerifyPaintSpanBytes));
+  }
+
+  void VerifyPaintSpanBytes() {
+    // The full view and the delivered bytes are both counted in device pixels.
+    const int64 kViewPixelBytes =
+        static_cast<int64>(kOsrWidth * kOsrSpanScaleFactor) *
+        kOsrHeight * kOsrSpanScaleFactor * 4;
+    CefRefPtr<CefBrowserHost> host = GetBrowser()->GetHost();
+    const int64 view_bytes = host->GetPaintViewBytes() - span_view_bytes_;
+    const int64 delivered_bytes =
+        host->GetPaintDeliveredBytes() - span_delivered_bytes_;
+    EXPECT_GT(view_bytes, 0);
+    EXPECT_EQ(0, view_bytes % kViewPixelBytes);
+    EXPECT_GE(delivered_bytes, kViewPixelBytes);
+    EXPECT_LE(delivered_bytes, view_bytes);
+    DestroySucceededTestSoon();
+  }
+
   virtual void OnPopupShow(CefRefPtr<CefBrowser> browser,
                            bool show) OVERRIDE {
     if (show && started()) {
@@ -432,6 +595,18 @@ class OSRTestHandler : public RoutingTestHandler,
         EXPECT_EQ(*(reinterpret_cast<const uint32*>(buffer)), 0xffff8080);
         DestroySucceededTestSoon();
         break;
+      case OSR_TEST_FRAME_RATE:
+        OnFrameRatePaint(browser, dirtyRects, buffer);
+        break;
+      case OSR_TEST_PAINT_BUFFER:
+        // test that the browser painted directly into our buffer
+        EXPECT_EQ(dirtyRects.size(), 1U);
+        EXPECT_TRUE(IsFullRepaint(dirtyRects[0]));
+        ASSERT_TRUE(paint_buffer_ != NULL);
+        EXPECT_EQ(static_cast<const void*>(paint_buffer_), buffer);
+        EXPECT_EQ(paint_buffer_[0], 0xffff8080);
+        DestroySucceededTestSoon();
+        break;
       case OSR_TEST_TRANSPARENCY:
         // test that we have a full repaint
         EXPECT_EQ(dirtyRects.size(), 1U);
@@ -878,6 +1053,130 @@ class OSRTestHandler : public RoutingTestHandler,
     }
   }
 
+  void OnFrameRatePaint(CefRefPtr<CefBrowser> browser,
+                        const RectList& dirtyRects,
+                        const void* buffer) {
+    switch (frame_rate_state_) {
+      case FRAME_RATE_LOAD:
+        // test that we have a full repaint
+        EXPECT_EQ(dirtyRects.size(), 1U);
+        EXPECT_TRUE(IsFullRepaint(dirtyRects[0]));
+        EXPECT_EQ(*(reinterpret_cast<const uint32*>(buffer)), 0xffff8080);
+
+        // Update the page much faster than the frame rate and count the
+        // paints that are delivered.
+        frame_rate_state_ = FRAME_RATE_COUNT;
+        frame_rate_paint_count_ = 0;
+        frame_rate_start_ = base::TimeTicks::Now();
+        browser->GetMainFrame()->ExecuteJavaScript(
+            "var osrToggle = 0; window.osrTimer = setInterval(function() {"
+            "  (osrToggle++ % 2) ? makeH1Red() : makeH1Black(); }, 5);",
+            kTestUrl, 0);
+        CefPostDelayedTask(TID_UI, NewCefRunnableMethod(this,
+            &OSRTestHandler::EndFrameRateCount), kFrameRateCountMs);
+        break;
+      case FRAME_RATE_COUNT:
+        frame_rate_paint_count_++;
+        break;
+      case FRAME_RATE_SLOW:
+        // A timer started at the previous frame rate may deliver one more
+        // paint. The next update is now held for a full second unless
+        // flushed.
+        frame_rate_state_ = FRAME_RATE_FLUSH;
+        frame_rate_start_ = base::TimeTicks::Now();
+        CefPostDelayedTask(TID_UI, NewCefRunnableMethod(this,
+            &OSRTestHandler::FlushFrameRatePaint), kFrameRateFlushDelayMs);
+        break;
+      case FRAME_RATE_FLUSH: {
+        // The flushed paint must arrive well before the next frame.
+        const int64 elapsed_ms =
+            (base::TimeTicks::Now() - frame_rate_start_).InMilliseconds();
+        EXPECT_LT(elapsed_ms, kFrameRateFlushLimitMs);
+        frame_rate_state_ = FRAME_RATE_DONE;
+        browser->GetMainFrame()->ExecuteJavaScript(
+            "clearInterval(window.osrTimer);", kTestUrl, 0);
+        DestroySucceededTestSoon();
+        } break;
+      case FRAME_RATE_DONE:
+        break;
+    }
+  }
+
+  void EndFrameRateCount() {
+    EXPECT_EQ(FRAME_RATE_COUNT, frame_rate_state_);
+    const int64 elapsed_ms =
+        (base::TimeTicks::Now() - frame_rate_start_).InMilliseconds();
+
+    // Updates arrive every few milliseconds so without coalescing there
+    // would be far more paints than frames.
+    EXPECT_GE(frame_rate_paint_count_, 2);
+    EXPECT_LE(frame_rate_paint_count_,
+              elapsed_ms * kFrameRate / 1000 + 2);
+
+    frame_rate_state_ = FRAME_RATE_SLOW;
+    GetBrowser()->GetHost()->SetWindowlessFrameRate(1);
+  }
+
+  void FlushFrameRatePaint() {
+    if (frame_rate_state_ != FRAME_RATE_FLUSH)
+      return;
+    GetBrowser()->GetHost()->FlushWindowlessPaint();
+    // Keep flushing until the held update has been delivered.
+    CefPostDelayedTask(TID_UI, NewCefRunnableMethod(this,
+        &OSRTestHandler::FlushFrameRatePaint), kFrameRateFlushDelayMs);
+  }
+
+  bool IsTileTest() const {
+    return test_type_ == OSR_TEST_PAINT_TILES ||
+           test_type_ == OSR_TEST_PAINT_TILES_DISCARD ||
+           test_type_ == OSR_TEST_PAINT_TILES_KEEP;
+  }
+
+  void OnTileContentPainted(CefRefPtr<CefBrowser> browser) {
+    if (test_type_ == OSR_TEST_PAINT_TILES) {
+      DestroySucceededTestSoon();
+      return;
+    }
+
+    switch (tile_state_) {
+      case TILE_LOAD: {
+        // Hide the view for longer or shorter than the discard delay.
+        tile_state_ = TILE_HIDDEN;
+        browser->GetHost()->WasHidden(true);
+        const int delay_ms = test_type_ == OSR_TEST_PAINT_TILES_DISCARD ?
+            kTileDiscardDelayMs + 1000 : kTileKeepDelayMs;
+        CefPostDelayedTask(TID_UI, NewCefRunnableMethod(this,
+            &OSRTestHandler::ShowTiles), delay_ms);
+        } break;
+      case TILE_HIDDEN:
+        // Ignore updates that were in flight when the view was hidden.
+        break;
+      case TILE_SHOWN:
+        // The discarded tiles have been repainted.
+        EXPECT_EQ(OSR_TEST_PAINT_TILES_DISCARD, test_type_);
+        DestroySucceededTestSoon();
+        break;
+    }
+  }
+
+  void ShowTiles() {
+    EXPECT_EQ(TILE_HIDDEN, tile_state_);
+    tile_state_ = TILE_SHOWN;
+    tile_shown_paint_count_ = 0;
+    GetBrowser()->GetHost()->WasHidden(false);
+
+    if (test_type_ == OSR_TEST_PAINT_TILES_KEEP) {
+      CefPostDelayedTask(TID_UI, NewCefRunnableMethod(this,
+          &OSRTestHandler::EndTilesKeep), kTileKeepDelayMs);
+    }
+  }
+
+  void EndTilesKeep() {
+    // The tiles were kept so showing the view did not repaint them.
+    EXPECT_EQ(0, tile_shown_paint_count_);
+    DestroySucceededTestSoon();
+  }
+
   void ExpandDropDown() {
     GetBrowser()->GetHost()->SendFocusEvent(true);
     CefMouseEvent mouse_event;
@@ -906,6 +1205,36 @@ class OSRTestHandler : public RoutingTestHandler,
 
  private:
   OSRTestType test_type_;
+  // Most recent buffer returned from GetPaintBuffer.
+  uint32* paint_buffer_;
+  // Buffers that have not yet been released.
+  std::vector<uint32*> paint_buffers_;
+
+  // Progress of OSR_TEST_FRAME_RATE.
+  enum FrameRateState {
+    FRAME_RATE_LOAD,
+    FRAME_RATE_COUNT,
+    FRAME_RATE_SLOW,
+    FRAME_RATE_FLUSH,
+    FRAME_RATE_DONE,
+  };
+  FrameRateState frame_rate_state_;
+  int frame_rate_paint_count_;
+  base::TimeTicks frame_rate_start_;
+
+  // Progress of OSR_TEST_PAINT_TILES_DISCARD and OSR_TEST_PAINT_TILES_KEEP.
+  enum TileState {
+    TILE_LOAD,
+    TILE_HIDDEN,
+    TILE_SHOWN,
+  };
+  TileState tile_state_;
+  int tile_shown_paint_count_;
+
+  // Byte counts recorded by OSR_TEST_PAINT_SPAN before the full repaint is
+  // accounted, or -1 if the full repaint has not been delivered yet.
+  int64 span_delivered_bytes_;
+  int64 span_view_bytes_;
   int event_count_;
   int event_total_;
   bool started_;
@@ -928,6 +1257,12 @@ OSR_TEST(Windowless, OSR_TEST_IS_WINDOWLESS);
 OSR_TEST(Focus, OSR_TEST_FOCUS);
 OSR_TEST(Paint, OSR_TEST_PAINT);
 OSR_TEST(TransparentPaint, OSR_TEST_TRANSPARENCY);
+OSR_TEST(PaintBuffer, OSR_TEST_PAINT_BUFFER);
+OSR_TEST(PaintSpan, OSR_TEST_PAINT_SPAN);
+OSR_TEST(PaintTiles, OSR_TEST_PAINT_TILES);
+OSR_TEST(PaintTilesDiscard, OSR_TEST_PAINT_TILES_DISCARD);
+OSR_TEST(PaintTilesKeep, OSR_TEST_PAINT_TILES_KEEP);
+OSR_TEST(FrameRate, OSR_TEST_FRAME_RATE);
 OSR_TEST(Cursor, OSR_TEST_CURSOR);
 OSR_TEST(MouseMove, OSR_TEST_MOUSE_MOVE);
 OSR_TEST(MouseRightClick, OSR_TEST_CLICK_RIGHT);
@@ -2,6 +2,11 @@
 // reserved. Use of this source code is governed by a BSD-style license that
 // can be found in the LICENSE file.
 
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "base/time/time.h"
 #include "include/cef_process_message.h"
 #include "include/cef_task.h"
 #include "tests/cefclient/client_app.h"
@@ -36,6 +41,38 @@ CefRefPtr<CefProcessMessage> CreateTestMessage() {
   return msg;
 }
 
+// Unique values for the SendRecvPacked test.
+const char kSendRecvPackedUrl[] =
+    "http://tests/ProcessMessageTest.SendRecvPacked";
+
+// Creates a test message with nested dictionaries and binary data that is
+// sent with packed arguments.
+CefRefPtr<CefProcessMessage> CreatePackedTestMessage() {
+  CefRefPtr<CefProcessMessage> msg = CreateTestMessage();
+  CefRefPtr<CefListValue> args = msg->GetArgumentList();
+
+  CefRefPtr<CefDictionaryValue> child = CefDictionaryValue::Create();
+  child->SetBool("bool", true);
+  // Same key as in the parent dictionary with a different type.
+  child->SetDouble("int", 3.5);
+
+  CefRefPtr<CefDictionaryValue> dict = CefDictionaryValue::Create();
+  dict->SetInt("int", 7);
+  dict->SetString("string", "dictionary string");
+  dict->SetList("list", args->Copy());
+  dict->SetDictionary("child", child);
+
+  const char kData[] = "binary\0data";
+  int index = static_cast<int>(args->GetSize());
+  args->SetDictionary(index++, dict);
+  args->SetBinary(index++, CefBinaryValue::Create(kData, sizeof(kData)));
+
+  msg->SetArgumentListPacked(true);
+  EXPECT_TRUE(msg->IsArgumentListPacked());
+
+  return msg;
+}
+
 // Renderer side.
 class SendRecvRendererTest : public ClientApp::RenderDelegate {
  public:
@@ -52,7 +89,13 @@ class SendRecvRendererTest : public ClientApp::RenderDelegate {
       EXPECT_TRUE(message.get());
 
       std::string url = browser->GetMainFrame()->GetURL();
-      if (url == kSendRecvUrl) {
+      if (url == kSendRecvPackedUrl) {
+        // Packed arguments are read directly from the received buffer and
+        // are forwarded without unpacking.
+        EXPECT_TRUE(message->IsArgumentListPacked());
+        EXPECT_TRUE(message->GetArgumentList()->IsReadOnly());
+      }
+      if (url == kSendRecvUrl || url == kSendRecvPackedUrl) {
         // Echo the message back to the sender natively.
         EXPECT_TRUE(browser->SendProcessMessage(PID_BROWSER, message));
         return true;
@@ -66,17 +109,174 @@ class SendRecvRendererTest : public ClientApp::RenderDelegate {
   IMPLEMENT_REFCOUNTING(SendRecvRendererTest);
 };
 
+// Unique values for the SendRecvBatch test.
+const char kSendRecvBatchUrl[] =
+    "http://tests/ProcessMessageTest.SendRecvBatch";
+const char kSendRecvBatchMsg[] = "ProcessMessageTest.SendRecvBatch";
+const int kSendRecvBatchCount = 50;
+// Index of the message that carries a shared memory segment.
+const int kSendRecvBatchSharedIndex = 20;
+
+// Creates the batch of test messages.
+std::vector<CefRefPtr<CefProcessMessage> > CreateTestBatch() {
+  std::vector<CefRefPtr<CefProcessMessage> > messages;
+  for (int i = 0; i < kSendRecvBatchCount; ++i) {
+    CefRefPtr<CefProcessMessage> msg =
+        CefProcessMessage::Create(kSendRecvBatchMsg);
+    msg->GetArgumentList()->SetInt(0, i);
+    if (i == kSendRecvBatchSharedIndex) {
+      int* memory = static_cast<int*>(msg->CreateSharedMemory(sizeof(int)));
+      EXPECT_TRUE(memory);
+      if (memory)
+        *memory = i;
+    }
+    messages.push_back(msg);
+  }
+  return messages;
+}
+
+// Verifies that |message| is the next message of the batch.
+void TestBatchMessage(CefRefPtr<CefProcessMessage> message, int index) {
+  EXPECT_STREQ(kSendRecvBatchMsg, message->GetName().ToString().c_str());
+  EXPECT_EQ(index, message->GetArgumentList()->GetInt(0));
+  if (index == kSendRecvBatchSharedIndex) {
+    EXPECT_EQ(sizeof(int), message->GetSharedMemorySize());
+    const int* memory = static_cast<const int*>(message->GetSharedMemory());
+    EXPECT_TRUE(memory);
+    if (memory)
+      EXPECT_EQ(index, *memory);
+  } else {
+    EXPECT_EQ(0U, message->GetSharedMemorySize());
+  }
+}
+
+// Renderer side.
+class SendRecvBatchRendererTest : public ClientApp::RenderDelegate {
+ public:
+  SendRecvBatchRendererTest() {}
+
+  virtual bool OnProcessMessageReceived(
+      CefRefPtr<ClientApp> app,
+      CefRefPtr<CefBrowser> browser,
+      CefProcessId source_process,
+      CefRefPtr<CefProcessMessage> message) OVERRIDE {
+    if (message->GetName() != kSendRecvBatchMsg)
+      return false;
+
+    EXPECT_EQ(PID_BROWSER, source_process);
+    TestBatchMessage(message, static_cast<int>(messages_.size()));
+
+    // Keep a copy that owns the shared memory segment, if any.
+    CefRefPtr<CefProcessMessage> copy = message->Copy();
+    if (message->GetSharedMemorySize() > 0)
+      EXPECT_TRUE(message->MoveSharedMemory(copy));
+    messages_.push_back(copy);
+
+    if (messages_.size() == static_cast<size_t>(kSendRecvBatchCount)) {
+      // Echo the whole batch back to the sender.
+      EXPECT_TRUE(browser->SendProcessMessages(PID_BROWSER, messages_));
+      messages_.clear();
+    }
+    return true;
+  }
+
+ private:
+  std::vector<CefRefPtr<CefProcessMessage> > messages_;
+
+  IMPLEMENT_REFCOUNTING(SendRecvBatchRendererTest);
+};
+
+// Unique values for the SharedMemoryThroughput test.
+const char kSharedMemoryUrl[] =
+    "http://tests/ProcessMessageTest.SharedMemoryThroughput";
+const char kSharedMemoryMsg[] = "ProcessMessageTest.SharedMemoryThroughput";
+const size_t kSharedMemoryPayloadSize = 4 * 1024 * 1024;
+const int kSharedMemoryIterations = 10;
+
+uint32 PayloadChecksum(const void* data, size_t size) {
+  const uint32* words = static_cast<const uint32*>(data);
+  uint32 checksum = 0;
+  for (size_t i = 0; i < size / sizeof(uint32); ++i)
+    checksum = checksum * 31 + words[i];
+  return checksum;
+}
+
+// Returns the payload of a SharedMemoryThroughput message from either the
+// shared memory segment or the first argument. |buffer| is used as storage for
+// the argument copy.
+const void* GetPayload(CefRefPtr<CefProcessMessage> message,
+                       std::vector<uint8>* buffer,
+                       size_t* size) {
+  if (message->GetSharedMemorySize() > 0) {
+    *size = message->GetSharedMemorySize();
+    return message->GetSharedMemory();
+  }
+
+  CefRefPtr<CefBinaryValue> binary =
+      message->GetArgumentList()->GetBinary(0);
+  if (!binary.get()) {
+    *size = 0;
+    return NULL;
+  }
+  *size = binary->GetSize();
+  buffer->resize(*size);
+  binary->GetData(&(*buffer)[0], *size, 0);
+  return &(*buffer)[0];
+}
+
+// Renderer side.
+class SharedMemoryRendererTest : public ClientApp::RenderDelegate {
+ public:
+  SharedMemoryRendererTest() {}
+
+  virtual bool OnProcessMessageReceived(
+      CefRefPtr<ClientApp> app,
+      CefRefPtr<CefBrowser> browser,
+      CefProcessId source_process,
+      CefRefPtr<CefProcessMessage> message) OVERRIDE {
+    if (message->GetName() != kSharedMemoryMsg)
+      return false;
+
+    // Read the whole payload so that both transports do the same work.
+    std::vector<uint8> buffer;
+    size_t size = 0;
+    const void* payload = GetPayload(message, &buffer, &size);
+    EXPECT_EQ(kSharedMemoryPayloadSize, size);
+
+    // Echo the payload back using the same transport.
+    CefRefPtr<CefProcessMessage> reply =
+        CefProcessMessage::Create(kSharedMemoryMsg);
+    CefRefPtr<CefListValue> args = reply->GetArgumentList();
+    if (message->GetSharedMemorySize() > 0) {
+      // Ownership of the segment moves to the reply without copying.
+      EXPECT_TRUE(message->MoveSharedMemory(reply));
+      EXPECT_EQ(payload, reply->GetSharedMemory());
+      EXPECT_EQ(0U, message->GetSharedMemorySize());
+    } else {
+      args->SetBinary(0, CefBinaryValue::Create(payload, size));
+    }
+    args->SetInt(1, static_cast<int>(PayloadChecksum(payload, size)));
+
+    EXPECT_TRUE(browser->SendProcessMessage(PID_BROWSER, reply));
+    return true;
+  }
+
+  IMPLEMENT_REFCOUNTING(SharedMemoryRendererTest);
+};
+
 // Browser side.
 class SendRecvTestHandler : public TestHandler {
  public:
-  SendRecvTestHandler() {
+  explicit SendRecvTestHandler(bool packed)
+      : packed_(packed) {
   }
 
   virtual void RunTest() OVERRIDE {
-    message_ = CreateTestMessage();
+    message_ = packed_ ? CreatePackedTestMessage() : CreateTestMessage();
 
-    AddResource(kSendRecvUrl, "<html><body>TEST</body></html>", "text/html");
-    CreateBrowser(kSendRecvUrl);
+    const char* url = packed_ ? kSendRecvPackedUrl : kSendRecvUrl;
+    AddResource(url, "<html><body>TEST</body></html>", "text/html");
+    CreateBrowser(url);
   }
 
   virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
@@ -98,6 +298,9 @@ class SendRecvTestHandler : public TestHandler {
     // Verify that the recieved message is the same as the sent message.
     TestProcessMessageEqual(message_, message);
 
+    if (packed_)
+      TestPackedMessage(message);
+
     got_message_.yes();
 
     // Test is complete.
@@ -106,20 +309,332 @@ class SendRecvTestHandler : public TestHandler {
     return true;
   }
 
+  void TestPackedMessage(CefRefPtr<CefProcessMessage> message) {
+    EXPECT_TRUE(message->IsArgumentListPacked());
+
+    CefRefPtr<CefListValue> args = message->GetArgumentList();
+    EXPECT_TRUE(args->IsValid());
+    EXPECT_TRUE(args->IsReadOnly());
+    EXPECT_FALSE(args->SetInt(0, 1));
+    EXPECT_EQ(VTYPE_NULL, args->GetType(0));
+    EXPECT_EQ(VTYPE_INVALID, args->GetType(100));
+
+    // Keyed lookups into nested dictionaries.
+    CefRefPtr<CefDictionaryValue> dict = args->GetDictionary(6);
+    EXPECT_TRUE(dict.get());
+    EXPECT_TRUE(dict->IsReadOnly());
+    EXPECT_EQ(7, dict->GetInt("int"));
+    EXPECT_EQ(0, dict->GetInt("missing"));
+    EXPECT_FALSE(dict->HasKey("missing"));
+    EXPECT_EQ(3.5, dict->GetDictionary("child")->GetDouble("int"));
+    EXPECT_EQ(5, dict->GetList("list")->GetInt(1));
+
+    // Copies are unpacked and writable but are still sent packed.
+    CefRefPtr<CefProcessMessage> copy = message->Copy();
+    EXPECT_TRUE(copy->IsArgumentListPacked());
+    EXPECT_FALSE(copy->GetArgumentList()->IsReadOnly());
+    TestProcessMessageEqual(message_, copy);
+
+    // Packed values can be set into other values.
+    CefRefPtr<CefListValue> list = CefListValue::Create();
+    EXPECT_TRUE(list->SetDictionary(0, dict));
+    EXPECT_TRUE(dict->IsValid());
+    TestDictionaryEqual(dict, list->GetDictionary(0));
+  }
+
+  bool packed_;
   CefRefPtr<CefProcessMessage> message_;
   TrackCallback got_message_;
 };
 
+// Browser side.
+class SendRecvBatchTestHandler : public TestHandler {
+ public:
+  SendRecvBatchTestHandler() : received_count_(0) {}
+
+  virtual void RunTest() OVERRIDE {
+    AddResource(kSendRecvBatchUrl, "<html><body>TEST</body></html>",
+                "text/html");
+    CreateBrowser(kSendRecvBatchUrl);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE {
+    std::vector<CefRefPtr<CefProcessMessage> > messages = CreateTestBatch();
+    EXPECT_TRUE(browser->SendProcessMessages(PID_RENDERER, messages));
+
+    // The shared memory segment is transferred when sent.
+    EXPECT_EQ(0U,
+        messages[kSendRecvBatchSharedIndex]->GetSharedMemorySize());
+  }
+
+  virtual bool OnProcessMessageReceived(
+      CefRefPtr<CefBrowser> browser,
+      CefProcessId source_process,
+      CefRefPtr<CefProcessMessage> message) OVERRIDE {
+    EXPECT_EQ(PID_RENDERER, source_process);
+    EXPECT_TRUE(message->IsReadOnly());
+    TestBatchMessage(message, received_count_);
+
+    if (++received_count_ == kSendRecvBatchCount) {
+      got_batch_.yes();
+      DestroyTest();
+    }
+    return true;
+  }
+
+  int received_count_;
+  TrackCallback got_batch_;
+};
+
+// Browser side. Round-trips a payload through the renderer using the
+// ListValue path and then the shared memory path and reports the throughput
+// of each.
+class SharedMemoryTestHandler : public TestHandler {
+ public:
+  SharedMemoryTestHandler()
+      : shared_mode_(false),
+        count_(0),
+        checksum_(0) {
+    elapsed_[0] = elapsed_[1] = 0;
+  }
+
+  virtual void RunTest() OVERRIDE {
+    payload_.resize(kSharedMemoryPayloadSize / sizeof(uint32));
+    for (size_t i = 0; i < payload_.size(); ++i)
+      payload_[i] = static_cast<uint32>(i * 2654435761U);
+    checksum_ = PayloadChecksum(&payload_[0], kSharedMemoryPayloadSize);
+
+    AddResource(kSharedMemoryUrl, "<html><body>TEST</body></html>",
+                "text/html");
+    CreateBrowser(kSharedMemoryUrl);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE {
+    start_time_ = base::TimeTicks::HighResNow();
+    SendPayload(browser);
+  }
+
+  virtual bool OnProcessMessageReceived(
+      CefRefPtr<CefBrowser> browser,
+      CefProcessId source_process,
+      CefRefPtr<CefProcessMessage> message) OVERRIDE {
+    EXPECT_EQ(PID_RENDERER, source_process);
+    EXPECT_STREQ(kSharedMemoryMsg, message->GetName().ToString().c_str());
+    EXPECT_EQ(shared_mode_, message->GetSharedMemorySize() > 0);
+
+    std::vector<uint8> buffer;
+    size_t size = 0;
+    const void* payload = GetPayload(message, &buffer, &size);
+    EXPECT_EQ(kSharedMemoryPayloadSize, size);
+    if (payload) {
+      EXPECT_EQ(checksum_, PayloadChecksum(payload, size));
+    }
+    EXPECT_EQ(static_cast<int>(checksum_),
+              message->GetArgumentList()->GetInt(1));
+
+    if (++count_ < kSharedMemoryIterations) {
+      SendPayload(browser);
+      return true;
+    }
+
+    const base::TimeTicks now = base::TimeTicks::HighResNow();
+    elapsed_[shared_mode_ ? 1 : 0] = (now - start_time_).InSecondsF();
+
+    if (!shared_mode_) {
+      // Repeat using shared memory.
+      shared_mode_ = true;
+      count_ = 0;
+      start_time_ = now;
+      SendPayload(browser);
+      return true;
+    }
+
+    got_shared_.yes();
+
+    const double megabytes = 2.0 * kSharedMemoryIterations *
+        kSharedMemoryPayloadSize / (1024.0 * 1024.0);
+    printf("ProcessMessage round trip of %d x %d MB: "
+           "list=%.0f MB/s shared=%.0f MB/s\n",
+           kSharedMemoryIterations,
+           static_cast<int>(kSharedMemoryPayloadSize / (1024 * 1024)),
+           elapsed_[0] > 0 ? megabytes / elapsed_[0] : 0,
+           elapsed_[1] > 0 ? megabytes / elapsed_[1] : 0);
+
+    DestroyTest();
+    return true;
+  }
+
+  void SendPayload(CefRefPtr<CefBrowser> browser) {
+    CefRefPtr<CefProcessMessage> message =
+        CefProcessMessage::Create(kSharedMemoryMsg);
+    if (shared_mode_) {
+      void* memory = message->CreateSharedMemory(kSharedMemoryPayloadSize);
+      EXPECT_TRUE(memory);
+      if (!memory)
+        return;
+      memcpy(memory, &payload_[0], kSharedMemoryPayloadSize);
+    } else {
+      message->GetArgumentList()->SetBinary(0,
+          CefBinaryValue::Create(&payload_[0], kSharedMemoryPayloadSize));
+    }
+
+    EXPECT_TRUE(browser->SendProcessMessage(PID_RENDERER, message));
+
+    // The segment is transferred to the renderer when sent.
+    EXPECT_FALSE(message->GetSharedMemory());
+    EXPECT_EQ(0U, message->GetSharedMemorySize());
+  }
+
+  bool shared_mode_;
+  int count_;
+  std::vector<uint32> payload_;
+  uint32 checksum_;
+  base::TimeTicks start_time_;
+  double elapsed_[2];
+
+  TrackCallback got_shared_;
+};
+
+// Unique values for the PackedDepth test.
+const char kPackedDepthUrl[] = "http://tests/ProcessMessageTest.PackedDepth";
+const char kPackedDepthMsg[] = "ProcessMessageTest.PackedDepth";
+
+// Maximum nesting depth of packed arguments accepted by the receiver.
+const int kPackedMaxDepth = 100;
+
+// Creates a packed message whose deepest argument is a list nested |depth|
+// levels below the argument list.
+CefRefPtr<CefProcessMessage> CreateNestedTestMessage(int depth) {
+  CefRefPtr<CefListValue> list = CefListValue::Create();
+  for (int i = 1; i < depth; ++i) {
+    CefRefPtr<CefListValue> parent = CefListValue::Create();
+    parent->SetList(0, list);
+    list = parent;
+  }
+
+  CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create(kPackedDepthMsg);
+  msg->GetArgumentList()->SetList(0, list);
+  msg->SetArgumentListPacked(true);
+  return msg;
+}
+
+// Browser side.
+class PackedDepthTestHandler : public TestHandler {
+ public:
+  PackedDepthTestHandler() {}
+
+  virtual void RunTest() OVERRIDE {
+    AddResource(kPackedDepthUrl, "<html><body>TEST</body></html>",
+                "text/html");
+    CreateBrowser(kPackedDepthUrl);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE {
+    // A message at the depth limit is sent.
+    EXPECT_TRUE(browser->SendProcessMessage(PID_RENDERER,
+        CreateNestedTestMessage(kPackedMaxDepth)));
+
+    // A deeper message would be rejected by the receiver so the send fails.
+    EXPECT_FALSE(browser->SendProcessMessage(PID_RENDERER,
+        CreateNestedTestMessage(kPackedMaxDepth + 1)));
+
+    // The same message can be sent unpacked.
+    CefRefPtr<CefProcessMessage> message =
+        CreateNestedTestMessage(kPackedMaxDepth + 1);
+    message->SetArgumentListPacked(false);
+    EXPECT_TRUE(browser->SendProcessMessage(PID_RENDERER, message));
+
+    got_result_.yes();
+    DestroyTest();
+  }
+
+  TrackCallback got_result_;
+};
+
 }  // namespace
 
 // Verify send and recieve.
 TEST(ProcessMessageTest, SendRecv) {
-  CefRefPtr<SendRecvTestHandler> handler = new SendRecvTestHandler();
+  CefRefPtr<SendRecvTestHandler> handler = new SendRecvTestHandler(false);
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(handler->got_message_);
+}
+
+// Verify send and recieve with packed arguments.
+TEST(ProcessMessageTest, SendRecvPacked) {
+  CefRefPtr<SendRecvTestHandler> handler = new SendRecvTestHandler(true);
   handler->ExecuteTest();
 
   EXPECT_TRUE(handler->got_message_);
 }
 
+// Verify that batched messages are received in order.
+TEST(ProcessMessageTest, SendRecvBatch) {
+  CefRefPtr<SendRecvBatchTestHandler> handler = new SendRecvBatchTestHandler();
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(handler->got_batch_);
+}
+
+// Verify that packed arguments nested deeper than the receiver accepts fail
+// to send.
+TEST(ProcessMessageTest, PackedDepth) {
+  CefRefPtr<PackedDepthTestHandler> handler = new PackedDepthTestHandler();
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(handler->got_result_);
+}
+
+// Report the throughput of shared memory payloads compared to ListValue
+// payloads. Only reports timings so it is disabled by default. Run it with
+// --gtest_also_run_disabled_tests.
+TEST(ProcessMessageTest, DISABLED_SharedMemoryThroughput) {
+  CefRefPtr<SharedMemoryTestHandler> handler = new SharedMemoryTestHandler();
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(handler->got_shared_);
+}
+
+// Verify shared memory ownership.
+TEST(ProcessMessageTest, SharedMemory) {
+  CefRefPtr<CefProcessMessage> message =
+      CefProcessMessage::Create(kSendRecvMsg);
+  EXPECT_FALSE(message->GetSharedMemory());
+  EXPECT_EQ(0U, message->GetSharedMemorySize());
+
+  uint8* memory = static_cast<uint8*>(message->CreateSharedMemory(100));
+  EXPECT_TRUE(memory);
+  EXPECT_EQ(memory, message->GetSharedMemory());
+  EXPECT_EQ(100U, message->GetSharedMemorySize());
+  memory[0] = 1;
+  memory[99] = 2;
+
+  // Segments are not copied.
+  CefRefPtr<CefProcessMessage> message2 = message->Copy();
+  EXPECT_FALSE(message2->GetSharedMemory());
+  EXPECT_EQ(0U, message2->GetSharedMemorySize());
+
+  // Moving keeps the same memory.
+  EXPECT_TRUE(message->MoveSharedMemory(message2));
+  EXPECT_FALSE(message->GetSharedMemory());
+  EXPECT_EQ(0U, message->GetSharedMemorySize());
+  EXPECT_EQ(memory, message2->GetSharedMemory());
+  EXPECT_EQ(100U, message2->GetSharedMemorySize());
+  EXPECT_EQ(1, memory[0]);
+  EXPECT_EQ(2, memory[99]);
+
+  // Nothing left to move.
+  EXPECT_FALSE(message->MoveSharedMemory(message2));
+  EXPECT_EQ(memory, message2->GetSharedMemory());
+}
+
 // Verify create.
 TEST(ProcessMessageTest, Create) {
   CefRefPtr<CefProcessMessage> message =
@@ -148,6 +663,12 @@ TEST(ProcessMessageTest, Copy) {
 // Called from client_app_delegates.cc.
 void CreateProcessMessageRendererTests(
     ClientApp::RenderDelegateSet& delegates) {
-  // For ProcessMessageTest.SendRecv
+  // For ProcessMessageTest.SendRecv and ProcessMessageTest.SendRecvPacked
   delegates.insert(new SendRecvRendererTest);
+
+  // For ProcessMessageTest.SendRecvBatch
+  delegates.insert(new SendRecvBatchRendererTest);
+
+  // For ProcessMessageTest.SharedMemoryThroughput
+  delegates.insert(new SharedMemoryRendererTest);
 }
@@ -16,7 +16,8 @@ class TestResults {
   TestResults()
     : status_code(0),
       sub_status_code(0),
-      delay(0) {
+      delay(0),
+      use_response_data(false) {
   }
 
   void reset() {
@@ -30,8 +31,10 @@ class TestResults {
     sub_allow_origin.clear();
     exit_url.clear();
     delay = 0;
+    use_response_data = false;
     got_request.reset();
     got_read.reset();
+    got_response_data.reset();
     got_output.reset();
     got_redirect.reset();
     got_error.reset();
@@ -58,9 +61,13 @@ class TestResults {
   // Delay for returning scheme handler results.
   int delay;
 
+  // If true the main response will be returned using GetResponseData().
+  bool use_response_data;
+
   TrackCallback
       got_request,
       got_read,
+      got_response_data,
       got_output,
       got_redirect,
       got_error,
@@ -159,7 +166,8 @@ class ClientSchemeHandler : public CefResourceHandler {
     : test_results_(tr),
       offset_(0),
       is_sub_(false),
-      has_delayed_(false) {
+      has_delayed_(false),
+      data_count_(0) {
   }
 
   virtual bool ProcessRequest(CefRefPtr<CefRequest> request,
@@ -236,6 +244,26 @@ class ClientSchemeHandler : public CefResourceHandler {
     }
   }
 
+  virtual CefRefPtr<CefBinaryValue> GetResponseData() OVERRIDE {
+    EXPECT_TRUE(CefCurrentlyOn(TID_IO));
+
+    if (is_sub_ || !test_results_->use_response_data)
+      return NULL;
+
+    test_results_->got_response_data.yes();
+
+    // Return the response as a sequence of two values.
+    const std::string& data = test_results_->html;
+    const size_t half = data.size() / 2;
+    CefRefPtr<CefBinaryValue> value;
+    if (data_count_ == 0)
+      value = CefBinaryValue::Create(data.c_str(), half);
+    else if (data_count_ == 1)
+      value = CefBinaryValue::Create(data.c_str() + half, data.size() - half);
+    data_count_++;
+    return value;
+  }
+
   virtual void Cancel() OVERRIDE {
     EXPECT_TRUE(CefCurrentlyOn(TID_IO));
   }
@@ -299,6 +327,7 @@ class ClientSchemeHandler : public CefResourceHandler {
   size_t offset_;
   bool is_sub_;
   bool has_delayed_;
+  int data_count_;
 
   IMPLEMENT_REFCOUNTING(ClientSchemeHandler);
   IMPLEMENT_LOCKING(ClientSchemeHandler);
@@ -549,6 +578,27 @@ TEST(SchemeHandlerTest, CustomStandardNormalResponseDelayed) {
   ClearTestSchemes();
 }
 
+// Test that a custom standard scheme can return results using
+// GetResponseData().
+TEST(SchemeHandlerTest, CustomStandardResponseData) {
+  RegisterTestScheme("customstd", "test");
+  g_TestResults.url = "customstd://test/run.html";
+  g_TestResults.html =
+      "<html><head></head><body><h1>Success!</h1></body></html>";
+  g_TestResults.status_code = 200;
+  g_TestResults.use_response_data = true;
+
+  CefRefPtr<TestSchemeHandler> handler = new TestSchemeHandler(&g_TestResults);
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(g_TestResults.got_request);
+  EXPECT_TRUE(g_TestResults.got_response_data);
+  EXPECT_FALSE(g_TestResults.got_read);
+  EXPECT_TRUE(g_TestResults.got_output);
+
+  ClearTestSchemes();
+}
+
 // Test that a custom nonstandard scheme can return normal results.
 TEST(SchemeHandlerTest, CustomNonStandardNormalResponse) {
   RegisterTestScheme("customnonstd", std::string());
@@ -3,6 +3,7 @@
 // can be found in the LICENSE file.
 
 #include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <string>
 #include "include/cef_runnable.h"
@@ -17,6 +18,9 @@
 namespace {
 
 const char kTestUrl[] = "http://tests-srh/test.html";
+const char kRangeTestUrl[] = "http://tests-srh/range.html";
+const char kRangeDataUrl[] = "http://tests-srh/range.txt";
+const char kRangeData[] = "0123456789abcdefghijklmnopqrstuvwxyz";
 const size_t kReadBlockSize = 1024U;  // 1k.
 
 // The usual network buffer size is about 32k. Choose a value that's larger.
@@ -173,6 +177,137 @@ class ReadTestHandler : public RoutingTestHandler {
   TrackCallback got_on_loading_state_change_done_;
 };
 
+// Read handler for in-memory data that supports seeking.
+class SeekReadHandler : public CefReadHandler {
+ public:
+  SeekReadHandler(const std::string& content, bool may_block)
+    : content_(content),
+      may_block_(may_block),
+      offset_(0) {
+  }
+
+  virtual size_t Read(void* ptr, size_t size, size_t n) OVERRIDE {
+    EXPECT_EQ(1U, size);
+    const size_t read_bytes = std::min(size * n, content_.size() - offset_);
+    if (read_bytes > 0) {
+      memcpy(ptr, content_.c_str() + offset_, read_bytes);
+      offset_ += read_bytes;
+    }
+    return read_bytes;
+  }
+
+  virtual int Seek(int64 offset, int whence) OVERRIDE {
+    int64 new_offset = offset;
+    if (whence == SEEK_CUR)
+      new_offset += offset_;
+    else if (whence == SEEK_END)
+      new_offset += content_.size();
+    if (new_offset < 0 || new_offset > static_cast<int64>(content_.size()))
+      return -1;
+    offset_ = static_cast<size_t>(new_offset);
+    return 0;
+  }
+
+  virtual int64 Tell() OVERRIDE {
+    return offset_;
+  }
+
+  virtual int Eof() OVERRIDE {
+    return (offset_ >= content_.size());
+  }
+
+  virtual bool MayBlock() OVERRIDE {
+    return may_block_;
+  }
+
+ private:
+  const std::string content_;
+  const bool may_block_;
+  size_t offset_;
+
+  IMPLEMENT_REFCOUNTING(SeekReadHandler);
+};
+
+class RangeTestHandler : public RoutingTestHandler {
+ public:
+  explicit RangeTestHandler(bool may_block)
+      : may_block_(may_block) {}
+
+  virtual void RunTest() OVERRIDE {
+    // Create the browser.
+    CreateBrowser(kRangeTestUrl);
+
+#if defined(TIMEOUT_ENABLED)
+    // Time out the test after a reasonable period of time.
+    CefPostDelayedTask(TID_UI,
+        NewCefRunnableMethod(this, &RangeTestHandler::DestroyTest), 3000);
+#endif
+  }
+
+  virtual CefRefPtr<CefResourceHandler> GetResourceHandler(
+      CefRefPtr<CefBrowser> browser,
+      CefRefPtr<CefFrame> frame,
+      CefRefPtr<CefRequest> request) OVERRIDE {
+    const std::string& url = request->GetURL();
+    if (url == kRangeTestUrl) {
+      const std::string html =
+          "<html><body><script>"
+          "function request(range) {"
+          "  var xhr = new XMLHttpRequest();"
+          "  xhr.open('GET', '" + std::string(kRangeDataUrl) + "', false);"
+          "  xhr.setRequestHeader('Range', range);"
+          "  xhr.send();"
+          "  return xhr.status + ':' + xhr.responseText;"
+          "}"
+          "window.testQuery({request: request('bytes=10-19') + '|' +"
+          "                           request('bytes=-5') + '|' +"
+          "                           request('bytes=30-') + '|' +"
+          "                           request('bytes=100-')});"
+          "</script></body></html>";
+      CefRefPtr<CefStreamReader> stream =
+          CefStreamReader::CreateForData(
+              static_cast<void*>(const_cast<char*>(html.c_str())),
+              html.size());
+      return new CefStreamResourceHandler("text/html", stream);
+    }
+
+    EXPECT_STREQ(kRangeDataUrl, url.c_str());
+    got_range_request_.yes();
+
+    CefRefPtr<CefStreamReader> stream =
+        CefStreamReader::CreateForHandler(
+            new SeekReadHandler(kRangeData, may_block_));
+    return new CefStreamResourceHandler("text/plain", stream);
+  }
+
+  virtual bool OnQuery(CefRefPtr<CefBrowser> browser,
+                       CefRefPtr<CefFrame> frame,
+                       int64 query_id,
+                       const CefString& request,
+                       bool persistent,
+                       CefRefPtr<Callback> callback) OVERRIDE {
+    got_on_query_.yes();
+
+    EXPECT_STREQ("206:abcdefghij|206:vwxyz|206:uvwxyz|416:",
+                 request.ToString().c_str());
+
+    DestroyTest();
+    return true;
+  }
+
+ private:
+  virtual void DestroyTest() OVERRIDE {
+    EXPECT_TRUE(got_range_request_);
+    EXPECT_TRUE(got_on_query_);
+    RoutingTestHandler::DestroyTest();
+  }
+
+  const bool may_block_;
+
+  TrackCallback got_range_request_;
+  TrackCallback got_on_query_;
+};
+
 }  // namespace
 
 TEST(StreamResourceHandlerTest, ReadWillBlock) {
@@ -184,3 +319,13 @@ TEST(StreamResourceHandlerTest, ReadWontBlock) {
   CefRefPtr<ReadTestHandler> handler = new ReadTestHandler(false);
   handler->ExecuteTest();
 }
+
+TEST(StreamResourceHandlerTest, RangeWillBlock) {
+  CefRefPtr<RangeTestHandler> handler = new RangeTestHandler(true);
+  handler->ExecuteTest();
+}
+
+TEST(StreamResourceHandlerTest, RangeWontBlock) {
+  CefRefPtr<RangeTestHandler> handler = new RangeTestHandler(false);
+  handler->ExecuteTest();
+}
@@ -88,6 +88,8 @@ TEST(StreamTest, ReadFile) {
       CefStreamReader::CreateForFile(fileNameStr));
   ASSERT_TRUE(stream.get() != NULL);
   ASSERT_TRUE(stream->MayBlock());
+  EXPECT_TRUE(stream->GetData() == NULL);
+  EXPECT_EQ((size_t)0, stream->GetDataSize());
   VerifyStreamReadBehavior(stream, contents);
 
   // Release the file pointer
@@ -111,9 +113,54 @@ TEST(StreamTest, ReadData) {
           contents.size()));
   ASSERT_TRUE(stream.get() != NULL);
   ASSERT_FALSE(stream->MayBlock());
+  ASSERT_TRUE(stream->GetData() != NULL);
+  ASSERT_EQ(contents.size(), stream->GetDataSize());
+  EXPECT_TRUE(!memcmp(contents.c_str(), stream->GetData(), contents.size()));
   VerifyStreamReadBehavior(stream, contents);
 }
 
+TEST(StreamTest, ReadMappedFile) {
+  const char* fileName = "StreamTest.VerifyReadMappedFile.txt";
+  CefString fileNameStr = "StreamTest.VerifyReadMappedFile.txt";
+  std::string contents = "This is my test\ncontents for the file";
+
+  // Create the file
+  FILE* f = NULL;
+#ifdef _WIN32
+  fopen_s(&f, fileName, "wb");
+#else
+  f = fopen(fileName, "wb");
+#endif
+  ASSERT_TRUE(f != NULL);
+  ASSERT_EQ((size_t)1, fwrite(contents.c_str(), contents.size(), 1, f));
+  fclose(f);
+
+  // Test the stream
+  CefRefPtr<CefStreamReader> stream(
+      CefStreamReader::CreateForMappedFile(fileNameStr));
+  ASSERT_TRUE(stream.get() != NULL);
+  // Reads may fault in pages from disk.
+  ASSERT_TRUE(stream->MayBlock());
+  ASSERT_TRUE(stream->GetData() != NULL);
+  ASSERT_EQ(contents.size(), stream->GetDataSize());
+  EXPECT_TRUE(!memcmp(contents.c_str(), stream->GetData(), contents.size()));
+  VerifyStreamReadBehavior(stream, contents);
+
+  // Release the mapping
+  stream = NULL;
+
+  // Delete the file
+#ifdef _WIN32
+  ASSERT_EQ(0, _unlink(fileName));
+#else
+  ASSERT_EQ(0, unlink(fileName));
+#endif
+
+  // Mapping a file that does not exist fails
+  stream = CefStreamReader::CreateForMappedFile(fileNameStr);
+  EXPECT_TRUE(stream.get() == NULL);
+}
+
 TEST(StreamTest, WriteFile) {
   const char* fileName = "StreamTest.VerifyWriteFile.txt";
   CefString fileNameStr = "StreamTest.VerifyWriteFile.txt";
@@ -0,0 +1,203 @@
+// Copyright (c) 2014 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include <string.h>
+#include <set>
+#include <vector>
+
+#include "libcef/common/tracker.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Not a multiple of the block alignment.
+const size_t kBlockSize = 40;
+
+// Fill |block| with a pattern derived from |index|.
+void FillBlock(void* block, size_t size, size_t index) {
+  memset(block, static_cast<int>(index & 0xFF), size);
+}
+
+// Returns true if |block| still contains the pattern written by FillBlock().
+bool VerifyBlock(const void* block, size_t size, size_t index) {
+  const unsigned char* data = static_cast<const unsigned char*>(block);
+  for (size_t i = 0; i < size; ++i) {
+    if (data[i] != static_cast<unsigned char>(index & 0xFF))
+      return false;
+  }
+  return true;
+}
+
+// Tracked object that counts its destruction. Optionally deletes another
+// tracked object or adds a new one when destroyed.
+class TestNode : public CefTrackNode {
+ public:
+  explicit TestNode(int* destroy_count)
+      : destroy_count_(destroy_count),
+        manager_(NULL),
+        delete_object_(NULL),
+        add_object_(NULL) {
+  }
+  virtual ~TestNode() {
+    (*destroy_count_)++;
+    if (delete_object_)
+      manager_->Delete(delete_object_);
+    if (add_object_)
+      manager_->Add(add_object_);
+  }
+
+  void set_delete_object(CefTrackManager* manager, CefTrackNode* object) {
+    manager_ = manager;
+    delete_object_ = object;
+  }
+  void set_add_object(CefTrackManager* manager, CefTrackNode* object) {
+    manager_ = manager;
+    add_object_ = object;
+  }
+
+ private:
+  int* destroy_count_;
+  CefTrackManager* manager_;
+  CefTrackNode* delete_object_;
+  CefTrackNode* add_object_;
+};
+
+}  // namespace
+
+// Verify that blocks are distinct across slab boundaries and that freeing
+// blocks in any order returns the slabs to the system.
+TEST(TrackerTest, SlabAllocatorBlockBoundaries) {
+  scoped_refptr<CefTrackSlabAllocator> allocator =
+      new CefTrackSlabAllocator(kBlockSize);
+  const size_t per_slab = allocator->blocks_per_slab();
+  EXPECT_GE(per_slab, 8U);
+  EXPECT_EQ(0, allocator->GetSlabCount());
+
+  // Fill two slabs and start a third.
+  const size_t count = per_slab * 2 + 1;
+  std::vector<void*> blocks;
+  std::set<void*> unique;
+  for (size_t i = 0; i < count; ++i) {
+    void* block = allocator->Allocate();
+    EXPECT_TRUE(block);
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(block) % 16);
+    FillBlock(block, kBlockSize, i);
+    blocks.push_back(block);
+    unique.insert(block);
+
+    // A new slab is only created once the previous slabs are full.
+    EXPECT_EQ(static_cast<int>(i / per_slab + 1), allocator->GetSlabCount());
+  }
+  EXPECT_EQ(count, unique.size());
+  EXPECT_EQ(static_cast<int>(count), allocator->GetCount());
+
+  // Writing a block did not overwrite its neighbors.
+  for (size_t i = 0; i < count; ++i)
+    EXPECT_TRUE(VerifyBlock(blocks[i], kBlockSize, i));
+
+  // Free the blocks on each side of the first slab boundary and reallocate
+  // them. Freed blocks are reused before the partially used slab.
+  void* last_in_first = blocks[per_slab - 1];
+  void* first_in_second = blocks[per_slab];
+  CefTrackSlabAllocator::Free(last_in_first);
+  CefTrackSlabAllocator::Free(first_in_second);
+  std::set<void*> reused;
+  reused.insert(allocator->Allocate());
+  reused.insert(allocator->Allocate());
+  EXPECT_EQ(1U, reused.count(last_in_first));
+  EXPECT_EQ(1U, reused.count(first_in_second));
+  EXPECT_EQ(3, allocator->GetSlabCount());
+
+  // Free every other block, then the rest. Only the spare slab remains.
+  for (size_t i = 0; i < count; i += 2)
+    CefTrackSlabAllocator::Free(blocks[i]);
+  for (size_t i = 1; i < count; i += 2)
+    CefTrackSlabAllocator::Free(blocks[i]);
+  EXPECT_EQ(0, allocator->GetCount());
+  EXPECT_EQ(1, allocator->GetSlabCount());
+}
+
+// Verify that the spare slab is reused when a single block is repeatedly
+// allocated and freed.
+TEST(TrackerTest, SlabAllocatorSpareReuse) {
+  scoped_refptr<CefTrackSlabAllocator> allocator =
+      new CefTrackSlabAllocator(kBlockSize);
+
+  void* block = allocator->Allocate();
+  EXPECT_EQ(1, allocator->GetSlabCount());
+  CefTrackSlabAllocator::Free(block);
+  EXPECT_EQ(0, allocator->GetCount());
+  EXPECT_EQ(1, allocator->GetSlabCount());
+
+  // The spare slab is used again and its blocks are handed out from the
+  // start.
+  for (int i = 0; i < 10; ++i) {
+    void* new_block = allocator->Allocate();
+    EXPECT_EQ(block, new_block);
+    EXPECT_EQ(1, allocator->GetSlabCount());
+    CefTrackSlabAllocator::Free(new_block);
+    EXPECT_EQ(1, allocator->GetSlabCount());
+  }
+
+  // Only one empty slab is kept.
+  const size_t count = allocator->blocks_per_slab() * 3;
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < count; ++i)
+    blocks.push_back(allocator->Allocate());
+  EXPECT_EQ(3, allocator->GetSlabCount());
+  for (size_t i = 0; i < count; ++i)
+    CefTrackSlabAllocator::Free(blocks[i]);
+  EXPECT_EQ(1, allocator->GetSlabCount());
+}
+
+// Verify that blocks can be freed after the owner releases the allocator.
+TEST(TrackerTest, SlabAllocatorOutlivesOwner) {
+  scoped_refptr<CefTrackSlabAllocator> allocator =
+      new CefTrackSlabAllocator(kBlockSize);
+  void* block1 = allocator->Allocate();
+  void* block2 = allocator->Allocate();
+  FillBlock(block2, kBlockSize, 2);
+
+  allocator = NULL;
+
+  CefTrackSlabAllocator::Free(block1);
+  EXPECT_TRUE(VerifyBlock(block2, kBlockSize, 2));
+  // Deletes the allocator.
+  CefTrackSlabAllocator::Free(block2);
+}
+
+// Verify that DeleteAll() releases all objects, including when destructors
+// delete or add other objects.
+TEST(TrackerTest, ManagerDeleteAll) {
+  CefRefPtr<CefTrackManager> manager =
+      new CefTrackManager(CefTrackManager::SINGLE_THREADED);
+  int destroy_count = 0;
+
+  const int kCount = 100;
+  std::vector<TestNode*> nodes;
+  for (int i = 0; i < kCount; ++i) {
+    TestNode* node = new TestNode(&destroy_count);
+    manager->Add(node);
+    nodes.push_back(node);
+  }
+  EXPECT_EQ(kCount, manager->GetCount());
+
+  // Objects are added at the front so |nodes[kCount - 1]| is deleted first.
+  // It deletes an object that has not been deleted yet.
+  nodes[kCount - 1]->set_delete_object(manager, nodes[0]);
+
+  // Another object adds a new object while being deleted.
+  int added_destroy_count = 0;
+  TestNode* added = new TestNode(&added_destroy_count);
+  nodes[kCount / 2]->set_add_object(manager, added);
+
+  manager->DeleteAll();
+  EXPECT_EQ(kCount, destroy_count);
+  EXPECT_EQ(1, manager->GetCount());
+  EXPECT_EQ(0, added_destroy_count);
+
+  EXPECT_TRUE(manager->Delete(added));
+  EXPECT_EQ(1, added_destroy_count);
+  EXPECT_EQ(0, manager->GetCount());
+}
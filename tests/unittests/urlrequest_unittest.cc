@@ -2,6 +2,7 @@
 // reserved. Use of this source code is governed by a BSD-style license that
 // can be found in the LICENSE file.
 
+#include <algorithm>
 #include <map>
 #include <sstream>
 
@@ -47,12 +48,79 @@ enum RequestTestMode {
   REQTEST_GET_NODATA,
   REQTEST_GET_ALLOWCOOKIES,
   REQTEST_GET_REDIRECT,
+  REQTEST_GET_LARGE,
+  REQTEST_GET_LARGE_NOWINDOW,
+  REQTEST_GET_FILE,
   REQTEST_POST,
   REQTEST_POST_FILE,
   REQTEST_POST_WITHPROGRESS,
   REQTEST_HEAD,
 };
 
+// Counts the response bytes returned by the scheme handler on the IO thread
+// while the request client stalls in its first OnDownloadData call. Nothing is
+// delivered during the stall so reading should pause once |window_size| bytes
+// have been read. The client is signaled at that point instead of polling.
+class ResponseProgress : public CefBase {
+ public:
+  explicit ResponseProgress(size_t window_size)
+    : window_size_(window_size),
+      window_full_(true, false),
+      bytes_read_(0),
+      max_read_size_(0),
+      stalled_(false) {
+  }
+
+  // Called by the scheme handler when it returns |bytes| of response data.
+  // |complete| is true if no more data remains.
+  void AddBytesRead(size_t bytes, bool complete) {
+    AutoLock lock_scope(this);
+    // The request should not read while the window is full.
+    if (stalled_)
+      EXPECT_LT(bytes_read_, window_size_);
+    bytes_read_ += bytes;
+    max_read_size_ = std::max(max_read_size_, bytes);
+    if (bytes_read_ >= window_size_ || complete)
+      window_full_.Signal();
+  }
+
+  // Called by the client to block until the window is full. Returns the
+  // number of bytes read at that time.
+  size_t StartStall() {
+    {
+      AutoLock lock_scope(this);
+      stalled_ = true;
+    }
+    window_full_.Wait();
+
+    AutoLock lock_scope(this);
+    return bytes_read_;
+  }
+
+  // Called by the client before it returns from the stalled OnDownloadData
+  // call.
+  void EndStall() {
+    AutoLock lock_scope(this);
+    stalled_ = false;
+  }
+
+  // Size of the largest ReadResponse result.
+  size_t max_read_size() {
+    AutoLock lock_scope(this);
+    return max_read_size_;
+  }
+
+ private:
+  const size_t window_size_;
+  base::WaitableEvent window_full_;
+  size_t bytes_read_;
+  size_t max_read_size_;
+  bool stalled_;
+
+  IMPLEMENT_REFCOUNTING(ResponseProgress);
+  IMPLEMENT_LOCKING(ResponseProgress);
+};
+
 struct RequestRunSettings {
   RequestRunSettings()
     : expect_upload_progress(false),
@@ -62,7 +130,9 @@ struct RequestRunSettings {
       expected_error_code(ERR_NONE),
       expect_send_cookie(false),
       expect_save_cookie(false),
-      expect_follow_redirect(true) {
+      expect_follow_redirect(true),
+      download_window_size(0),
+      stall_download_data(false) {
   }
 
   // Request that will be sent.
@@ -101,6 +171,20 @@ struct RequestRunSettings {
 
   // If true the redirect is expected to be followed.
   bool expect_follow_redirect;
+
+  // Value returned from CefURLRequestClient::GetDownloadWindowSize.
+  size_t download_window_size;
+
+  // If true the client stalls in the first OnDownloadData call until reading
+  // from the network pauses so that the download window and chunk aggregation
+  // can be verified. Requires |response_progress|.
+  bool stall_download_data;
+
+  // If specified the scheme handler reports the response bytes it returns.
+  CefRefPtr<ResponseProgress> response_progress;
+
+  // If specified the response data will be written to this file.
+  base::FilePath download_file_path;
 };
 
 void SetUploadData(CefRefPtr<CefRequest> request,
@@ -273,6 +357,11 @@ class RequestSchemeHandler : public CefResourceHandler {
 
       bytes_read = transfer_size;
       has_data = true;
+
+      if (settings_.response_progress.get()) {
+        settings_.response_progress->AddBytesRead(transfer_size,
+                                                  offset_ == size);
+      }
     }
 
     return has_data;
@@ -426,8 +515,9 @@ class RequestClient : public CefURLRequestClient {
   };
 
   static CefRefPtr<RequestClient> Create(Delegate* delegate,
-                                         CefRefPtr<CefRequest> request) {
-    CefRefPtr<RequestClient> client = new RequestClient(delegate);
+                                         CefRefPtr<CefRequest> request,
+                                         const RequestRunSettings& settings) {
+    CefRefPtr<RequestClient> client = new RequestClient(delegate, settings);
     CefURLRequest::Create(request, client.get());
     return client;
   }
@@ -471,6 +561,18 @@ class RequestClient : public CefURLRequestClient {
     EXPECT_TRUE(response_->IsReadOnly());
     download_data_ct_++;
     download_data_ += std::string(static_cast<const char*>(data), data_length);
+    download_data_max_size_ = std::max(download_data_max_size_, data_length);
+
+    if (stall_download_data_ && download_data_ct_ == 1)
+      StallDownloadData();
+  }
+
+  virtual size_t GetDownloadWindowSize() OVERRIDE {
+    return download_window_size_;
+  }
+
+  virtual CefString GetDownloadFilePath() OVERRIDE {
+    return download_file_path_.value();
   }
 
    virtual bool GetAuthCredentials(bool isProxy,
@@ -483,17 +585,34 @@ class RequestClient : public CefURLRequestClient {
    }
 
  private:
-  explicit RequestClient(Delegate* delegate)
+  RequestClient(Delegate* delegate, const RequestRunSettings& settings)
     : delegate_(delegate),
+      download_window_size_(settings.download_window_size),
+      stall_download_data_(settings.stall_download_data),
+      response_progress_(settings.response_progress),
+      download_file_path_(settings.download_file_path),
       request_complete_ct_(0),
       upload_progress_ct_(0),
       download_progress_ct_(0),
       download_data_ct_(0),
       upload_total_(0),
-      download_total_(0) {
+      download_total_(0),
+      download_data_max_size_(0),
+      stall_bytes_read_(0) {
+  }
+
+  // Block until the download window is full and record how much data had
+  // been read at that time.
+  void StallDownloadData() {
+    stall_bytes_read_ = response_progress_->StartStall();
+    response_progress_->EndStall();
   }
 
   Delegate* delegate_;
+  size_t download_window_size_;
+  bool stall_download_data_;
+  CefRefPtr<ResponseProgress> response_progress_;
+  base::FilePath download_file_path_;
 
  public:
   int request_complete_ct_;
@@ -504,6 +623,12 @@ class RequestClient : public CefURLRequestClient {
   uint64 upload_total_;
   uint64 download_total_;
   std::string download_data_;
+
+  // Size of the largest OnDownloadData chunk.
+  size_t download_data_max_size_;
+  // Set when |stall_download_data_| is true. Number of bytes that had been
+  // read when the download window was full.
+  size_t stall_bytes_read_;
   CefRefPtr<CefRequest> request_;
   CefURLRequest::Status status_;
   CefURLRequest::ErrorCode error_code_;
@@ -544,6 +669,10 @@ class RequestTestRunner {
     REGISTER_TEST(REQTEST_GET_ALLOWCOOKIES, SetupGetAllowCookiesTest,
                   GenericRunTest);
     REGISTER_TEST(REQTEST_GET_REDIRECT, SetupGetRedirectTest, GenericRunTest);
+    REGISTER_TEST(REQTEST_GET_LARGE, SetupGetLargeTest, GenericRunTest);
+    REGISTER_TEST(REQTEST_GET_LARGE_NOWINDOW, SetupGetLargeNoWindowTest,
+                  GenericRunTest);
+    REGISTER_TEST(REQTEST_GET_FILE, SetupGetFileTest, GenericRunTest);
     REGISTER_TEST(REQTEST_POST, SetupPostTest, GenericRunTest);
     REGISTER_TEST(REQTEST_POST_FILE, SetupPostFileTest, GenericRunTest);
     REGISTER_TEST(REQTEST_POST_WITHPROGRESS, SetupPostWithProgressTest,
@@ -630,6 +759,50 @@ class RequestTestRunner {
     settings_.redirect_response->SetHeaderMap(headerMap);
   }
 
+  void SetupGetLargeTest() {
+    // Start with the normal get test.
+    SetupGetTest();
+
+    // Return 4MB of data so that the download window fills up.
+    const size_t kDataSize = 4 * 1024 * 1024;
+    settings_.response_data.reserve(kDataSize);
+    for (int i = 0; settings_.response_data.size() < kDataSize; ++i)
+      settings_.response_data += base::StringPrintf("%08d\n", i);
+
+    // Verify the download window and chunk aggregation.
+    SetupDownloadWindow(256 * 1024);
+  }
+
+  void SetupGetLargeNoWindowTest() {
+    // Start with the large get test.
+    SetupGetLargeTest();
+
+    // Deliver each chunk of data before reading the next chunk.
+    SetupDownloadWindow(1);
+  }
+
+  // Stall the client in the first OnDownloadData call with an explicit
+  // download window of |window_size| bytes.
+  void SetupDownloadWindow(size_t window_size) {
+    settings_.download_window_size = window_size;
+    settings_.stall_download_data = true;
+    settings_.response_progress = new ResponseProgress(window_size);
+  }
+
+  void SetupGetFileTest() {
+    // Start with the large get test.
+    SetupGetLargeTest();
+
+    // Write the response data to a file.
+    settings_.stall_download_data = false;
+    settings_.response_progress = NULL;
+    EXPECT_TRUE(download_file_tmpdir_.CreateUniqueTempDir());
+    settings_.download_file_path =
+        download_file_tmpdir_.path().Append(FILE_PATH_LITERAL("download.txt"));
+
+    settings_.expect_download_data = false;
+  }
+
   void SetupPostTest() {
     settings_.request = CefRequest::Create();
     settings_.request->SetURL(MakeSchemeURL("PostTest.html"));
@@ -756,10 +929,43 @@ class RequestTestRunner {
           EXPECT_TRUE(client->download_data_.empty());
         }
 
+        if (settings_.stall_download_data && settings_.expect_download_data)
+          VerifyDownloadWindow(client);
+
+        if (!settings_.download_file_path.empty()) {
+          // The response data should have been written to the file.
+          std::string file_data;
+          EXPECT_TRUE(base::ReadFileToString(settings_.download_file_path,
+                                             &file_data));
+          EXPECT_EQ(runner_->settings_.response_data.size(), file_data.size());
+          EXPECT_TRUE(runner_->settings_.response_data == file_data);
+        }
+
         runner_->DestroyTest();
       }
 
      private:
+      // Verify that response data was read ahead of delivery up to the
+      // download window and combined into larger chunks.
+      void VerifyDownloadWindow(CefRefPtr<RequestClient> client) {
+        const size_t window = settings_.download_window_size;
+        const size_t max_read_size =
+            settings_.response_progress->max_read_size();
+        EXPECT_LT(0U, max_read_size);
+
+        // Reading paused with the read that filled the window.
+        EXPECT_LE(window, client->stall_bytes_read_);
+        EXPECT_GT(window + max_read_size, client->stall_bytes_read_);
+
+        if (window > 1) {
+          // Data read while the client was stalled was combined.
+          EXPECT_LT(max_read_size, client->download_data_max_size_);
+        } else {
+          // Each chunk is delivered before the next chunk is read.
+          EXPECT_GE(max_read_size, client->download_data_max_size_);
+        }
+      }
+
       RequestTestRunner* runner_;
       RequestRunSettings settings_;
     };
@@ -771,7 +977,7 @@ class RequestTestRunner {
       request = settings_.request;
     EXPECT_TRUE(request.get());
 
-    RequestClient::Create(new Test(this, settings_), request);
+    RequestClient::Create(new Test(this, settings_), request, settings_);
   }
 
   // Register a test. Called in the constructor.
@@ -792,6 +998,8 @@ class RequestTestRunner {
 
     if (post_file_tmpdir_.IsValid())
       EXPECT_TRUE(post_file_tmpdir_.Delete());
+    if (download_file_tmpdir_.IsValid())
+      EXPECT_TRUE(download_file_tmpdir_.Delete());
 
     delegate_->DestroyTest(settings_);
   }
@@ -839,6 +1047,7 @@ class RequestTestRunner {
   CefRefPtr<RequestSchemeHandlerFactory> scheme_factory_;
 
   base::ScopedTempDir post_file_tmpdir_;
+  base::ScopedTempDir download_file_tmpdir_;
 
  public:
   RequestRunSettings settings_;
@@ -1083,6 +1292,9 @@ REQ_TEST(BrowserGET, REQTEST_GET, true);
 REQ_TEST(BrowserGETNoData, REQTEST_GET_NODATA, true);
 REQ_TEST(BrowserGETAllowCookies, REQTEST_GET_ALLOWCOOKIES, true);
 REQ_TEST(BrowserGETRedirect, REQTEST_GET_REDIRECT, true);
+REQ_TEST(BrowserGETLarge, REQTEST_GET_LARGE, true);
+REQ_TEST(BrowserGETLargeNoWindow, REQTEST_GET_LARGE_NOWINDOW, true);
+REQ_TEST(BrowserGETFile, REQTEST_GET_FILE, true);
 REQ_TEST(BrowserPOST, REQTEST_POST, true);
 REQ_TEST(BrowserPOSTFile, REQTEST_POST_FILE, true);
 REQ_TEST(BrowserPOSTWithProgress, REQTEST_POST_WITHPROGRESS, true);
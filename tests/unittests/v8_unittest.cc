@@ -43,6 +43,9 @@ enum V8TestMode {
   V8TEST_EMPTY_STRING_CREATE,
   V8TEST_ARRAY_CREATE,
   V8TEST_ARRAY_VALUE,
+  V8TEST_ARRAY_BUFFER,
+  V8TEST_VALUE_CONVERSION,
+  V8TEST_PACKED_VALUE_CONVERSION,
   V8TEST_OBJECT_CREATE,
   V8TEST_OBJECT_USERDATA,
   V8TEST_OBJECT_ACCESSOR,
@@ -63,8 +66,11 @@ enum V8TestMode {
   V8TEST_FUNCTION_HANDLER_NO_OBJECT,
   V8TEST_FUNCTION_HANDLER_WITH_CONTEXT,
   V8TEST_FUNCTION_HANDLER_EMPTY_STRING,
+  V8TEST_FAST_FUNCTION_HANDLER,
   V8TEST_CONTEXT_EVAL,
   V8TEST_CONTEXT_EVAL_EXCEPTION,
+  V8TEST_CONTEXT_PRECOMPILE,
+  V8TEST_CONTEXT_STATISTICS,
   V8TEST_CONTEXT_ENTERED,
   V8TEST_CONTEXT_INVALID,
   V8TEST_BINDING,
@@ -100,6 +106,22 @@ class V8BrowserTest : public ClientApp::BrowserDelegate {
 };
 
 
+// Fill |args| with the values used by V8TEST_PACKED_VALUE_CONVERSION.
+void SetPackedTestArgs(CefRefPtr<CefListValue> args) {
+  EXPECT_TRUE(args->SetInt(0, 5));
+  EXPECT_TRUE(args->SetString(1, "str"));
+
+  CefRefPtr<CefListValue> list = CefListValue::Create();
+  EXPECT_TRUE(list->SetDouble(0, 1.5));
+  EXPECT_TRUE(list->SetNull(1));
+  const char binary_data[] = {1, 2, 3};
+  CefRefPtr<CefDictionaryValue> dictionary = CefDictionaryValue::Create();
+  EXPECT_TRUE(dictionary->SetList("l", list));
+  EXPECT_TRUE(dictionary->SetBinary("bin",
+      CefBinaryValue::Create(binary_data, sizeof(binary_data))));
+  EXPECT_TRUE(args->SetDictionary(2, dictionary));
+}
+
 // Renderer side.
 class V8RendererTest : public ClientApp::RenderDelegate,
                        public CefLoadHandler {
@@ -141,6 +163,15 @@ class V8RendererTest : public ClientApp::RenderDelegate,
       case V8TEST_ARRAY_VALUE:
         RunArrayValueTest();
         break;
+      case V8TEST_ARRAY_BUFFER:
+        RunArrayBufferTest();
+        break;
+      case V8TEST_VALUE_CONVERSION:
+        RunValueConversionTest();
+        break;
+      case V8TEST_PACKED_VALUE_CONVERSION:
+        RunPackedValueConversionTest();
+        break;
       case V8TEST_OBJECT_CREATE:
         RunObjectCreateTest();
         break;
@@ -201,12 +232,21 @@ class V8RendererTest : public ClientApp::RenderDelegate,
       case V8TEST_FUNCTION_HANDLER_EMPTY_STRING:
         RunFunctionHandlerEmptyStringTest();
         break;
+      case V8TEST_FAST_FUNCTION_HANDLER:
+        RunFastFunctionHandlerTest();
+        break;
       case V8TEST_CONTEXT_EVAL:
         RunContextEvalTest();
         break;
       case V8TEST_CONTEXT_EVAL_EXCEPTION:
         RunContextEvalExceptionTest();
         break;
+      case V8TEST_CONTEXT_PRECOMPILE:
+        RunContextPrecompileTest();
+        break;
+      case V8TEST_CONTEXT_STATISTICS:
+        RunContextStatisticsTest();
+        break;
       case V8TEST_CONTEXT_ENTERED:
         RunContextEnteredTest();
         break;
@@ -505,6 +545,271 @@ class V8RendererTest : public ClientApp::RenderDelegate,
     DestroyTest();
   }
 
+  void RunArrayBufferTest() {
+    CefRefPtr<CefV8Context> context = GetContext();
+
+    static const size_t kBufferSize = 16;
+
+    // Enter the V8 context.
+    EXPECT_TRUE(context->Enter());
+
+    // The contents are allocated zero-filled.
+    CefRefPtr<CefV8Value> value = CefV8Value::CreateArrayBuffer(kBufferSize);
+    EXPECT_TRUE(value.get());
+    EXPECT_TRUE(value->IsObject());
+    EXPECT_TRUE(value->IsArrayBuffer());
+    EXPECT_FALSE(value->IsTypedArray());
+    EXPECT_FALSE(value->IsArray());
+    EXPECT_EQ(kBufferSize, value->GetArrayBufferByteLength());
+    char* contents = static_cast<char*>(value->GetArrayBufferData());
+    EXPECT_TRUE(contents);
+    for (size_t i = 0; i < kBufferSize; ++i) {
+      EXPECT_EQ(0, contents[i]);
+      contents[i] = static_cast<char>(i);
+    }
+
+    // The contents are filled in place.
+    EXPECT_EQ(contents, value->GetArrayBufferData());
+
+    CefRefPtr<CefV8Value> global = context->GetGlobal();
+    EXPECT_TRUE(global->SetValue("buf", value, V8_PROPERTY_ATTRIBUTE_NONE));
+
+    // The contents are shared with JavaScript without further copying.
+    CefRefPtr<CefV8Value> retval;
+    CefRefPtr<CefV8Exception> exception;
+    EXPECT_TRUE(context->Eval(
+        "var arr = new Uint8Array(buf, 4, 8); arr[1] = 42; arr[0]",
+        retval, exception));
+    EXPECT_TRUE(retval.get());
+    EXPECT_EQ(4, retval->GetIntValue());
+    EXPECT_EQ(42, contents[5]);
+
+    // The contents are owned by WebKit so DOM methods accept the buffer.
+    EXPECT_TRUE(context->Eval(
+        "new Blob([buf]).size + new Uint8Array(buf.slice(4, 6))[1]",
+        retval, exception));
+    EXPECT_TRUE(retval.get());
+    EXPECT_EQ(static_cast<int>(kBufferSize) + 42, retval->GetIntValue());
+
+    // Typed arrays return the data of their view.
+    CefRefPtr<CefV8Value> array = global->GetValue("arr");
+    EXPECT_TRUE(array.get());
+    EXPECT_TRUE(array->IsTypedArray());
+    EXPECT_FALSE(array->IsArrayBuffer());
+    EXPECT_EQ(contents + 4, array->GetArrayBufferData());
+    EXPECT_EQ((size_t)8, array->GetArrayBufferByteLength());
+
+    // ArrayBuffers created by JavaScript can also be accessed directly.
+    EXPECT_TRUE(context->Eval(
+        "var buf2 = new ArrayBuffer(8); new Uint8Array(buf2)[2] = 7; buf2",
+        retval, exception));
+    EXPECT_TRUE(retval.get());
+    EXPECT_TRUE(retval->IsArrayBuffer());
+    EXPECT_EQ((size_t)8, retval->GetArrayBufferByteLength());
+    char* data = static_cast<char*>(retval->GetArrayBufferData());
+    EXPECT_TRUE(data);
+    EXPECT_EQ(7, data[2]);
+    data[3] = 9;
+    EXPECT_TRUE(context->Eval("new Uint8Array(buf2)[3]", retval, exception));
+    EXPECT_TRUE(retval.get());
+    EXPECT_EQ(9, retval->GetIntValue());
+
+    // Exit the V8 context.
+    EXPECT_TRUE(context->Exit());
+
+    DestroyTest();
+  }
+
+  void RunValueConversionTest() {
+    CefRefPtr<CefV8Context> context = GetContext();
+
+    // Enter the V8 context.
+    EXPECT_TRUE(context->Enter());
+
+    CefRefPtr<CefV8Value> retval;
+    CefRefPtr<CefV8Exception> exception;
+    EXPECT_TRUE(context->Eval(
+        "var obj = {b: true, i: 5, d: 1.5, s: 'str', n: null, u: undefined,"
+        "           f: function() {}, l: [1, undefined, 'x'],"
+        "           bin: new Uint8Array([1, 2, 3]), date: new Date(1000),"
+        "           child: {v: 'child'}};"
+        "obj.child.parent = obj; obj",
+        retval, exception));
+    EXPECT_TRUE(retval.get());
+
+    // Arrays cannot be converted to dictionaries and vice versa.
+    EXPECT_FALSE(retval->ToList().get());
+
+    CefRefPtr<CefDictionaryValue> dict = retval->ToDictionary();
+    EXPECT_TRUE(dict.get());
+    EXPECT_TRUE(dict->IsValid());
+    EXPECT_FALSE(dict->IsReadOnly());
+
+    // Functions and undefined values are skipped.
+    EXPECT_EQ((size_t)9, dict->GetSize());
+    EXPECT_FALSE(dict->HasKey("u"));
+    EXPECT_FALSE(dict->HasKey("f"));
+
+    EXPECT_EQ(VTYPE_BOOL, dict->GetType("b"));
+    EXPECT_TRUE(dict->GetBool("b"));
+    EXPECT_EQ(VTYPE_INT, dict->GetType("i"));
+    EXPECT_EQ(5, dict->GetInt("i"));
+    EXPECT_EQ(VTYPE_DOUBLE, dict->GetType("d"));
+    EXPECT_EQ(1.5, dict->GetDouble("d"));
+    EXPECT_EQ(VTYPE_STRING, dict->GetType("s"));
+    EXPECT_STREQ("str", dict->GetString("s").ToString().c_str());
+    EXPECT_EQ(VTYPE_NULL, dict->GetType("n"));
+    EXPECT_EQ(VTYPE_DOUBLE, dict->GetType("date"));
+    EXPECT_EQ(1000, dict->GetDouble("date"));
+
+    // Undefined list elements are converted to null.
+    CefRefPtr<CefListValue> list = dict->GetList("l");
+    EXPECT_TRUE(list.get());
+    EXPECT_EQ((size_t)3, list->GetSize());
+    EXPECT_EQ(1, list->GetInt(0));
+    EXPECT_EQ(VTYPE_NULL, list->GetType(1));
+    EXPECT_STREQ("x", list->GetString(2).ToString().c_str());
+
+    // Typed array contents are copied.
+    CefRefPtr<CefBinaryValue> binary = dict->GetBinary("bin");
+    EXPECT_TRUE(binary.get());
+    EXPECT_EQ((size_t)3, binary->GetSize());
+    char data[3];
+    EXPECT_EQ((size_t)3, binary->GetData(data, sizeof(data), 0));
+    EXPECT_EQ(1, data[0]);
+    EXPECT_EQ(3, data[2]);
+
+    // Cycles are converted to null.
+    CefRefPtr<CefDictionaryValue> child = dict->GetDictionary("child");
+    EXPECT_TRUE(child.get());
+    EXPECT_STREQ("child", child->GetString("v").ToString().c_str());
+    EXPECT_EQ(VTYPE_NULL, child->GetType("parent"));
+
+    // Objects nested too deeply are converted to null.
+    EXPECT_TRUE(context->Eval(
+        "var deep = []; var cur = deep;"
+        "for (var i = 0; i < 200; ++i) { var next = []; cur.push(next);"
+        "                                 cur = next; }"
+        "deep",
+        retval, exception));
+    EXPECT_TRUE(retval.get());
+    list = retval->ToList();
+    EXPECT_TRUE(list.get());
+    EXPECT_FALSE(retval->ToDictionary().get());
+    int depth = 1;
+    while (list->GetType(0) == VTYPE_LIST) {
+      list = list->GetList(0);
+      ++depth;
+    }
+    EXPECT_EQ(100, depth);
+    EXPECT_EQ(VTYPE_NULL, list->GetType(0));
+
+    // Conversion fails if a property getter throws.
+    EXPECT_TRUE(context->Eval(
+        "var thrower = {a: 1}; Object.defineProperty(thrower, 'b',"
+        "    {enumerable: true, get: function() { throw 'oops'; }}); thrower",
+        retval, exception));
+    EXPECT_TRUE(retval.get());
+    EXPECT_FALSE(retval->ToDictionary().get());
+    EXPECT_TRUE(retval->HasException());
+
+    // Convert back to V8 values.
+    CefRefPtr<CefV8Value> value = CefV8Value::CreateFromDictionary(dict);
+    EXPECT_TRUE(value.get());
+    EXPECT_TRUE(value->IsObject());
+    EXPECT_FALSE(value->IsArray());
+    EXPECT_EQ(5, value->GetValue("i")->GetIntValue());
+    EXPECT_STREQ("str",
+                 value->GetValue("s")->GetStringValue().ToString().c_str());
+    EXPECT_TRUE(value->GetValue("n")->IsNull());
+    EXPECT_TRUE(value->GetValue("bin")->IsArrayBuffer());
+    EXPECT_EQ((size_t)3, value->GetValue("bin")->GetArrayBufferByteLength());
+
+    CefRefPtr<CefV8Value> array = value->GetValue("l");
+    EXPECT_TRUE(array->IsArray());
+    EXPECT_EQ(3, array->GetArrayLength());
+    EXPECT_TRUE(array->GetValue(1)->IsNull());
+
+    // The round trip is lossless for supported types.
+    CefRefPtr<CefDictionaryValue> dict2 = value->ToDictionary();
+    EXPECT_TRUE(dict2.get());
+    EXPECT_EQ(dict->GetSize(), dict2->GetSize());
+    EXPECT_EQ(1.5, dict2->GetDouble("d"));
+    EXPECT_EQ(VTYPE_BINARY, dict2->GetType("bin"));
+
+    value = CefV8Value::CreateFromList(dict->GetList("l"));
+    EXPECT_TRUE(value.get());
+    EXPECT_TRUE(value->IsArray());
+    EXPECT_EQ(3, value->GetArrayLength());
+
+    // Exit the V8 context.
+    EXPECT_TRUE(context->Exit());
+
+    DestroyTest();
+  }
+
+  // Verify the contents of a V8 array created from the list that
+  // SetPackedTestArgs() fills.
+  void TestPackedTestArray(CefRefPtr<CefV8Value> value) {
+    EXPECT_TRUE(value.get());
+    EXPECT_TRUE(value->IsArray());
+    EXPECT_EQ(3, value->GetArrayLength());
+    EXPECT_EQ(5, value->GetValue(0)->GetIntValue());
+    EXPECT_STREQ("str",
+                 value->GetValue(1)->GetStringValue().ToString().c_str());
+    TestPackedTestObject(value->GetValue(2));
+  }
+
+  // Verify the contents of a V8 object created from the dictionary that
+  // SetPackedTestArgs() adds.
+  void TestPackedTestObject(CefRefPtr<CefV8Value> value) {
+    EXPECT_TRUE(value.get());
+    EXPECT_TRUE(value->IsObject());
+    EXPECT_FALSE(value->IsArray());
+
+    CefRefPtr<CefV8Value> list = value->GetValue("l");
+    EXPECT_TRUE(list->IsArray());
+    EXPECT_EQ(2, list->GetArrayLength());
+    EXPECT_EQ(1.5, list->GetValue(0)->GetDoubleValue());
+    EXPECT_TRUE(list->GetValue(1)->IsNull());
+
+    CefRefPtr<CefV8Value> binary = value->GetValue("bin");
+    EXPECT_TRUE(binary->IsArrayBuffer());
+    EXPECT_EQ((size_t)3, binary->GetArrayBufferByteLength());
+    const char* data = static_cast<char*>(binary->GetArrayBufferData());
+    EXPECT_TRUE(data);
+    if (data) {
+      EXPECT_EQ(1, data[0]);
+      EXPECT_EQ(3, data[2]);
+    }
+  }
+
+  void RunPackedValueConversionTest() {
+    CefRefPtr<CefV8Context> context = GetContext();
+
+    // Enter the V8 context.
+    EXPECT_TRUE(context->Enter());
+
+    // Packed argument lists of received messages are converted.
+    EXPECT_TRUE(run_test_args_.get());
+    EXPECT_TRUE(run_test_args_->IsReadOnly());
+    TestPackedTestArray(CefV8Value::CreateFromList(run_test_args_));
+    TestPackedTestObject(
+        CefV8Value::CreateFromDictionary(run_test_args_->GetDictionary(2)));
+
+    // Snapshots are converted.
+    CefRefPtr<CefListValue> args = CefListValue::Create();
+    SetPackedTestArgs(args);
+    TestPackedTestArray(CefV8Value::CreateFromList(args->CreateSnapshot()));
+    TestPackedTestObject(CefV8Value::CreateFromDictionary(
+        args->GetDictionary(2)->CreateSnapshot()));
+
+    // Exit the V8 context.
+    EXPECT_TRUE(context->Exit());
+
+    DestroyTest();
+  }
+
   void RunObjectCreateTest() {
     CefRefPtr<CefV8Context> context = GetContext();
 
@@ -1502,6 +1807,113 @@ class V8RendererTest : public ClientApp::RenderDelegate,
     DestroyTest();
   }
 
+  void RunFastFunctionHandlerTest() {
+    CefRefPtr<CefV8Context> context = GetContext();
+
+    static const char* kFuncName = "myfastfunc";
+    static const int kIntVal = 32;
+    static const double kDoubleVal = 4.5;
+    static const char* kStringVal = "my string";
+    static const char* kException = "My error";
+    static const char* kExceptionMsg = "Uncaught Error: My error";
+
+    class Handler : public CefV8FastHandler {
+     public:
+      Handler() : execute_count_(0) {}
+      virtual int GetArgumentCount() OVERRIDE { return 4; }
+      virtual Type GetArgumentType(int index) OVERRIDE {
+        static const Type kTypes[] = {
+          V8_FAST_TYPE_BOOL,
+          V8_FAST_TYPE_STRING,
+          V8_FAST_TYPE_INT,
+          V8_FAST_TYPE_DOUBLE,
+        };
+        return kTypes[index];
+      }
+      virtual Type GetReturnType() OVERRIDE { return V8_FAST_TYPE_STRING; }
+      virtual bool Execute(const CefString& name,
+                           const std::vector<double>& numbers,
+                           const std::vector<CefString>& strings,
+                           double& number_retval,
+                           CefString& string_retval,
+                           CefString& exception) OVERRIDE {
+        EXPECT_STREQ(kFuncName, name.ToString().c_str());
+        EXPECT_EQ((size_t)3, numbers.size());
+        EXPECT_EQ((size_t)1, strings.size());
+        EXPECT_TRUE(exception.empty());
+
+        execute_count_++;
+        if (numbers[0] == 0) {
+          exception = kException;
+          return true;
+        }
+
+        EXPECT_DOUBLE_EQ(1, numbers[0]);
+        EXPECT_DOUBLE_EQ(kIntVal, numbers[1]);
+        EXPECT_DOUBLE_EQ(kDoubleVal, numbers[2]);
+        string_retval = strings[0];
+        return true;
+      }
+
+      int execute_count_;
+
+      IMPLEMENT_REFCOUNTING(Handler);
+    };
+
+    // Enter the V8 context.
+    EXPECT_TRUE(context->Enter());
+
+    Handler* handler = new Handler;
+    CefRefPtr<CefV8FastHandler> handlerPtr(handler);
+
+    CefRefPtr<CefV8Value> func =
+        CefV8Value::CreateFastFunction(kFuncName, handler);
+    EXPECT_TRUE(func.get());
+    EXPECT_TRUE(func->IsFunction());
+    EXPECT_STREQ(kFuncName, func->GetFunctionName().ToString().c_str());
+    EXPECT_FALSE(func->GetFunctionHandler().get());
+
+    // Arguments are converted to the declared types.
+    CefV8ValueList args;
+    args.push_back(CefV8Value::CreateBool(true));
+    args.push_back(CefV8Value::CreateString(kStringVal));
+    args.push_back(CefV8Value::CreateDouble(kIntVal + 0.7));
+    args.push_back(CefV8Value::CreateDouble(kDoubleVal));
+
+    CefRefPtr<CefV8Value> retval = func->ExecuteFunction(NULL, args);
+    EXPECT_EQ(1, handler->execute_count_);
+    EXPECT_TRUE(retval.get());
+    EXPECT_FALSE(func->HasException());
+    EXPECT_TRUE(retval->IsString());
+    EXPECT_STREQ(kStringVal, retval->GetStringValue().ToString().c_str());
+
+    // Missing arguments are passed as 0 which causes the handler to throw.
+    args.clear();
+    retval = func->ExecuteFunction(NULL, args);
+    EXPECT_EQ(2, handler->execute_count_);
+    EXPECT_FALSE(retval.get());
+    EXPECT_TRUE(func->HasException());
+    CefRefPtr<CefV8Exception> exception = func->GetException();
+    EXPECT_TRUE(exception.get());
+    EXPECT_STREQ(kExceptionMsg, exception->GetMessage().ToString().c_str());
+    EXPECT_TRUE(func->ClearException());
+
+    // Call the function from script.
+    CefRefPtr<CefV8Value> global = context->GetGlobal();
+    EXPECT_TRUE(global->SetValue(kFuncName, func, V8_PROPERTY_ATTRIBUTE_NONE));
+    EXPECT_TRUE(context->Eval(
+        "myfastfunc(1, 'abc', 32, 4.5) + myfastfunc(true, 'def', '32', 4.5)",
+        retval, exception));
+    EXPECT_EQ(4, handler->execute_count_);
+    EXPECT_TRUE(retval.get());
+    EXPECT_STREQ("abcdef", retval->GetStringValue().ToString().c_str());
+
+    // Exit the V8 context.
+    EXPECT_TRUE(context->Exit());
+
+    DestroyTest();
+  }
+
   void RunContextEvalTest() {
     CefRefPtr<CefV8Context> context = GetContext();
 
@@ -1530,6 +1942,120 @@ class V8RendererTest : public ClientApp::RenderDelegate,
     DestroyTest();
   }
 
+  void RunContextPrecompileTest() {
+    CefRefPtr<CefV8Context> context = GetContext();
+
+    static const char kCode[] = "window.precompiled = 5;";
+    static const char kUrl[] = "http://tests/precompile.js";
+
+    // Pre-parse data does not require a context.
+    EXPECT_FALSE(CefV8Context::GetScriptCacheData("1+").get());
+    CefRefPtr<CefBinaryValue> data = CefV8Context::GetScriptCacheData(kCode);
+    EXPECT_TRUE(data.get());
+    EXPECT_GT(data->GetSize(), (size_t)0);
+
+    // Enter the V8 context.
+    EXPECT_TRUE(context->Enter());
+
+    // Invalid code is not cached.
+    EXPECT_FALSE(CefV8Context::PrecompileScript("1+", kUrl, 1, NULL));
+
+    EXPECT_TRUE(CefV8Context::PrecompileScript(kCode, kUrl, 1, data));
+
+    CefRefPtr<CefDictionaryValue> stats =
+        context->GetStatistics()->GetDictionary("isolate");
+    const int scripts = stats->GetInt("precompiled_scripts");
+    const int runs = stats->GetInt("precompiled_script_runs");
+    EXPECT_GT(scripts, 0);
+
+    // Compiling the same script again does not add another entry.
+    EXPECT_TRUE(CefV8Context::PrecompileScript(kCode, kUrl, 1, NULL));
+    stats = context->GetStatistics()->GetDictionary("isolate");
+    EXPECT_EQ(scripts, stats->GetInt("precompiled_scripts"));
+
+    // Executing the script in a frame runs the precompiled script.
+    CefRefPtr<CefFrame> frame = browser_->GetMainFrame();
+    frame->ExecuteJavaScript(kCode, kUrl, 1);
+    stats = context->GetStatistics()->GetDictionary("isolate");
+    EXPECT_EQ(runs + 1, stats->GetInt("precompiled_script_runs"));
+
+    CefRefPtr<CefV8Value> retval;
+    CefRefPtr<CefV8Exception> exception;
+    EXPECT_TRUE(context->Eval("window.precompiled", retval, exception));
+    EXPECT_TRUE(retval.get());
+    EXPECT_EQ(5, retval->GetIntValue());
+
+    // The cache is keyed by the script origin as well as the code.
+    frame->ExecuteJavaScript(kCode, kUrl, 2);
+    stats = context->GetStatistics()->GetDictionary("isolate");
+    EXPECT_EQ(runs + 1, stats->GetInt("precompiled_script_runs"));
+
+    // Eval() does not use the cache.
+    EXPECT_TRUE(context->Eval(kCode, retval, exception));
+    stats = context->GetStatistics()->GetDictionary("isolate");
+    EXPECT_EQ(runs + 1, stats->GetInt("precompiled_script_runs"));
+
+    // Exit the V8 context.
+    EXPECT_TRUE(context->Exit());
+
+    DestroyTest();
+  }
+
+  void RunContextStatisticsTest() {
+    CefRefPtr<CefV8Context> context = GetContext();
+
+    EXPECT_TRUE(context->Enter());
+
+    CefRefPtr<CefDictionaryValue> stats = context->GetStatistics();
+    EXPECT_TRUE(stats.get());
+    CefRefPtr<CefDictionaryValue> context_stats =
+        stats->GetDictionary("context");
+    CefRefPtr<CefDictionaryValue> isolate_stats =
+        stats->GetDictionary("isolate");
+    CefRefPtr<CefDictionaryValue> heap_stats = stats->GetDictionary("heap");
+    EXPECT_TRUE(context_stats.get());
+    EXPECT_TRUE(isolate_stats.get());
+    EXPECT_TRUE(heap_stats.get());
+    EXPECT_GT(context_stats->GetInt("contexts"), 0);
+    EXPECT_GE(isolate_stats->GetInt("values"),
+              context_stats->GetInt("values"));
+    EXPECT_GT(heap_stats->GetDouble("used_heap_size"), 0.0);
+    EXPECT_LE(heap_stats->GetDouble("used_heap_size"),
+              heap_stats->GetDouble("total_heap_size"));
+
+    const int value_count = context_stats->GetInt("values");
+    const double tracked_bytes = isolate_stats->GetDouble("tracked_bytes");
+
+    // Live values are counted for the context and the thread.
+    static const int kValueCount = 10;
+    CefV8ValueList values;
+    for (int i = 0; i < kValueCount; ++i)
+      values.push_back(CefV8Value::CreateObject(NULL));
+    EXPECT_EQ(1024, values[0]->AdjustExternallyAllocatedMemory(1024));
+
+    stats = context->GetStatistics();
+    context_stats = stats->GetDictionary("context");
+    isolate_stats = stats->GetDictionary("isolate");
+    EXPECT_EQ(value_count + kValueCount, context_stats->GetInt("values"));
+    EXPECT_EQ(tracked_bytes + 1024, isolate_stats->GetDouble("tracked_bytes"));
+
+    EXPECT_EQ(0, values[0]->AdjustExternallyAllocatedMemory(-1024));
+    values.clear();
+
+    stats = context->GetStatistics();
+    EXPECT_EQ(value_count, stats->GetDictionary("context")->GetInt("values"));
+    EXPECT_EQ(tracked_bytes,
+              stats->GetDictionary("isolate")->GetDouble("tracked_bytes"));
+
+    // Setting and disabling a budget must not affect the statistics.
+    CefV8Context::SetWrapperBudget(1, 1);
+    CefV8Context::SetWrapperBudget(0, 0);
+
+    EXPECT_TRUE(context->Exit());
+
+    DestroyTest();
+  }
+
   void RunContextEnteredTest() {
     CefRefPtr<CefV8Context> context = GetContext();
 
@@ -1856,6 +2382,8 @@ class V8RendererTest : public ClientApp::RenderDelegate,
 
     const std::string& message_name = message->GetName();
     if (message_name == kV8RunTestMsg) {
+      run_test_args_ = message->GetArgumentList();
+
       // Run the test asynchronously.
       CefPostTask(TID_RENDERER,
                   NewCefRunnableMethod(this, &V8RendererTest::RunTest));
@@ -1963,6 +2491,7 @@ class V8RendererTest : public ClientApp::RenderDelegate,
     browser_ = NULL;
     test_context_ = NULL;
     test_object_ = NULL;
+    run_test_args_ = NULL;
   }
 
   // Return the V8 context.
@@ -1979,6 +2508,9 @@ class V8RendererTest : public ClientApp::RenderDelegate,
   CefRefPtr<CefV8Context> test_context_;
   CefRefPtr<CefV8Value> test_object_;
 
+  // Argument list of the message that started the test.
+  CefRefPtr<CefListValue> run_test_args_;
+
   // Used by startup tests to indicate success.
   TrackCallback startup_test_success_;
 
@@ -2059,6 +2591,11 @@ class V8TestHandler : public TestHandler {
       // Run the test.
       CefRefPtr<CefProcessMessage> return_msg =
             CefProcessMessage::Create(kV8RunTestMsg);
+      if (test_mode_ == V8TEST_PACKED_VALUE_CONVERSION) {
+        // The renderer converts the packed arguments to V8 values.
+        SetPackedTestArgs(return_msg->GetArgumentList());
+        return_msg->SetArgumentListPacked(true);
+      }
       EXPECT_TRUE(browser->SendProcessMessage(PID_RENDERER, return_msg));
     }
   }
@@ -2135,6 +2672,9 @@ V8_TEST(StringCreate, V8TEST_STRING_CREATE);
 V8_TEST(EmptyStringCreate, V8TEST_EMPTY_STRING_CREATE);
 V8_TEST(ArrayCreate, V8TEST_ARRAY_CREATE);
 V8_TEST(ArrayValue, V8TEST_ARRAY_VALUE);
+V8_TEST(ArrayBuffer, V8TEST_ARRAY_BUFFER);
+V8_TEST(ValueConversion, V8TEST_VALUE_CONVERSION);
+V8_TEST(PackedValueConversion, V8TEST_PACKED_VALUE_CONVERSION);
 V8_TEST(ObjectCreate, V8TEST_OBJECT_CREATE);
 V8_TEST(ObjectUserData, V8TEST_OBJECT_USERDATA);
 V8_TEST(ObjectAccessor, V8TEST_OBJECT_ACCESSOR);
@@ -2155,8 +2695,11 @@ V8_TEST(FunctionHandlerFail, V8TEST_FUNCTION_HANDLER_FAIL);
 V8_TEST(FunctionHandlerNoObject, V8TEST_FUNCTION_HANDLER_NO_OBJECT);
 V8_TEST(FunctionHandlerWithContext, V8TEST_FUNCTION_HANDLER_WITH_CONTEXT);
 V8_TEST(FunctionHandlerEmptyString, V8TEST_FUNCTION_HANDLER_EMPTY_STRING);
+V8_TEST(FastFunctionHandler, V8TEST_FAST_FUNCTION_HANDLER);
 V8_TEST(ContextEval, V8TEST_CONTEXT_EVAL);
 V8_TEST(ContextEvalException, V8TEST_CONTEXT_EVAL_EXCEPTION);
+V8_TEST(ContextPrecompile, V8TEST_CONTEXT_PRECOMPILE);
+V8_TEST(ContextStatistics, V8TEST_CONTEXT_STATISTICS);
 V8_TEST_EX(ContextEntered, V8TEST_CONTEXT_ENTERED, NULL);
 V8_TEST(ContextInvalid, V8TEST_CONTEXT_INVALID);
 V8_TEST_EX(Binding, V8TEST_BINDING, kV8BindingTestUrl);
@@ -2,6 +2,10 @@
 // reserved. Use of this source code is governed by a BSD-style license that
 // can be found in the LICENSE file.
 
+#include <stdio.h>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "include/cef_task.h"
 #include "include/cef_values.h"
 #include "tests/unittests/test_handler.h"
@@ -566,6 +570,87 @@ class ListTask : public CefTask {
   IMPLEMENT_REFCOUNTING(ListTask);
 };
 
+
+// SNAPSHOT BENCHMARK HELPERS
+
+const int kBenchmarkSize = 10000;
+const int kBenchmarkIterations = 20;
+
+// Returns the sum of all values read by a benchmark task.
+int64 BenchmarkSum() {
+  return static_cast<int64>(kBenchmarkSize) * (kBenchmarkSize - 1) / 2 *
+         kBenchmarkIterations;
+}
+
+// Creates a dictionary with |kBenchmarkSize| integer values.
+CefRefPtr<CefDictionaryValue> CreateBenchmarkDictionary() {
+  CefRefPtr<CefDictionaryValue> value = CefDictionaryValue::Create();
+  for (int i = 0; i < kBenchmarkSize; ++i)
+    value->SetInt(base::StringPrintf("key%d", i), i);
+  return value;
+}
+
+// Creates a list with |kBenchmarkSize| dictionary values.
+CefRefPtr<CefListValue> CreateBenchmarkList() {
+  CefRefPtr<CefListValue> value = CefListValue::Create();
+  for (int i = 0; i < kBenchmarkSize; ++i) {
+    CefRefPtr<CefDictionaryValue> item = CefDictionaryValue::Create();
+    item->SetInt(kIntKey, i);
+    value->SetDictionary(i, item);
+  }
+  return value;
+}
+
+// Used to time reads of benchmark values on a different thread.
+class BenchmarkTask : public CefTask {
+ public:
+  BenchmarkTask(CefRefPtr<CefDictionaryValue> dictionary_value,
+                CefRefPtr<CefListValue> list_value,
+                const char* name)
+    : dictionary_value_(dictionary_value),
+      list_value_(list_value),
+      name_(name) {}
+
+  virtual void Execute() OVERRIDE {
+    CefDictionaryValue::KeyList keys;
+    dictionary_value_->GetKeys(keys);
+    EXPECT_EQ(static_cast<size_t>(kBenchmarkSize), keys.size());
+
+    // Keyed reads.
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    int64 sum = 0;
+    for (int i = 0; i < kBenchmarkIterations; ++i) {
+      for (size_t j = 0; j < keys.size(); ++j)
+        sum += dictionary_value_->GetInt(keys[j]);
+    }
+    const double dictionary_ms =
+        (base::TimeTicks::HighResNow() - start).InMillisecondsF();
+    EXPECT_EQ(BenchmarkSum(), sum);
+
+    // Nested reads.
+    start = base::TimeTicks::HighResNow();
+    sum = 0;
+    for (int i = 0; i < kBenchmarkIterations; ++i) {
+      for (int j = 0; j < kBenchmarkSize; ++j)
+        sum += list_value_->GetDictionary(j)->GetInt(kIntKey);
+    }
+    const double list_ms =
+        (base::TimeTicks::HighResNow() - start).InMillisecondsF();
+    EXPECT_EQ(BenchmarkSum(), sum);
+
+    printf("%s: %d dictionary reads in %.1f ms, %d nested list reads in "
+           "%.1f ms\n", name_, kBenchmarkSize * kBenchmarkIterations,
+           dictionary_ms, kBenchmarkSize * kBenchmarkIterations, list_ms);
+  }
+
+ private:
+  CefRefPtr<CefDictionaryValue> dictionary_value_;
+  CefRefPtr<CefListValue> list_value_;
+  const char* name_;
+
+  IMPLEMENT_REFCOUNTING(BenchmarkTask);
+};
+
 }  // namespace
 
 
@@ -667,6 +752,142 @@ TEST(ValuesTest, DictionaryDetachment) {
   EXPECT_FALSE(dictionary_value3->IsValid());
 }
 
+// Test that owned dictionary values are moved without copying.
+TEST(ValuesTest, DictionaryMove) {
+  CefRefPtr<CefDictionaryValue> value = CefDictionaryValue::Create();
+  CefRefPtr<CefDictionaryValue> dictionary_value = CefDictionaryValue::Create();
+  CefRefPtr<CefDictionaryValue> dictionary_value2 =
+      CefDictionaryValue::Create();
+
+  EXPECT_TRUE(dictionary_value->SetDictionary(kDictionaryKey,
+                                              dictionary_value2));
+  dictionary_value2 = dictionary_value->GetDictionary(kDictionaryKey);
+  EXPECT_TRUE(dictionary_value2->IsValid());
+
+  // Moving the owner invalidates it but not references to its children.
+  EXPECT_TRUE(value->SetDictionary(kDictionaryKey, dictionary_value));
+  EXPECT_FALSE(dictionary_value->IsValid());
+  EXPECT_TRUE(dictionary_value2->IsValid());
+
+  // The reference now refers to the moved value.
+  EXPECT_TRUE(dictionary_value2->SetInt(kIntKey, kIntValue));
+  dictionary_value = value->GetDictionary(kDictionaryKey);
+  EXPECT_EQ(kIntValue,
+      dictionary_value->GetDictionary(kDictionaryKey)->GetInt(kIntKey));
+
+  // References to the moved value follow the new owner.
+  EXPECT_TRUE(value->Remove(kDictionaryKey));
+  EXPECT_FALSE(dictionary_value->IsValid());
+  EXPECT_FALSE(dictionary_value2->IsValid());
+}
+
+// Test detaching values from a dictionary.
+TEST(ValuesTest, DictionaryDetach) {
+  CefRefPtr<CefDictionaryValue> value = CefDictionaryValue::Create();
+  char binary_data[] = "This is my test data";
+  CefRefPtr<CefBinaryValue> binary_value;
+  CefRefPtr<CefDictionaryValue> dictionary_value;
+  CefRefPtr<CefListValue> list_value;
+  TestDictionaryInt(value);
+  TestDictionaryBinary(value, binary_data, sizeof(binary_data)-1,
+                       binary_value);
+  TestDictionaryDictionary(value, dictionary_value);
+  TestDictionaryList(value, list_value);
+
+  // Values of the wrong type are not detached.
+  EXPECT_FALSE(value->DetachDictionary(kIntKey).get());
+  EXPECT_FALSE(value->DetachList(kDictionaryKey).get());
+  EXPECT_FALSE(value->DetachBinary("unknown_key").get());
+  EXPECT_EQ((size_t)4, value->GetSize());
+
+  // References to detached values are invalidated.
+  CefRefPtr<CefDictionaryValue> dictionary_ref =
+      value->GetDictionary(kDictionaryKey);
+  CefRefPtr<CefDictionaryValue> detached_dictionary =
+      value->DetachDictionary(kDictionaryKey);
+  EXPECT_TRUE(detached_dictionary.get());
+  EXPECT_FALSE(dictionary_ref->IsValid());
+  EXPECT_FALSE(value->HasKey(kDictionaryKey));
+  EXPECT_TRUE(detached_dictionary->IsValid());
+  EXPECT_FALSE(detached_dictionary->IsOwned());
+  EXPECT_FALSE(detached_dictionary->IsReadOnly());
+  EXPECT_EQ(kIntValue, detached_dictionary->GetInt(kIntKey));
+
+  CefRefPtr<CefListValue> list_ref = value->GetList(kListKey);
+  CefRefPtr<CefListValue> detached_list = value->DetachList(kListKey);
+  EXPECT_TRUE(detached_list.get());
+  EXPECT_FALSE(list_ref->IsValid());
+  EXPECT_FALSE(value->HasKey(kListKey));
+  EXPECT_FALSE(detached_list->IsOwned());
+  EXPECT_FALSE(detached_list->IsReadOnly());
+  EXPECT_EQ(kIntValue, detached_list->GetInt(0));
+
+  CefRefPtr<CefBinaryValue> binary_ref = value->GetBinary(kBinaryKey);
+  CefRefPtr<CefBinaryValue> detached_binary = value->DetachBinary(kBinaryKey);
+  EXPECT_TRUE(detached_binary.get());
+  EXPECT_FALSE(binary_ref->IsValid());
+  EXPECT_FALSE(value->HasKey(kBinaryKey));
+  TestBinary(detached_binary, binary_data, sizeof(binary_data)-1);
+
+  // Detached values can be moved into another value.
+  CefRefPtr<CefListValue> list = CefListValue::Create();
+  EXPECT_TRUE(list->SetDictionary(0, detached_dictionary));
+  EXPECT_FALSE(detached_dictionary->IsValid());
+  EXPECT_EQ(kIntValue, list->GetDictionary(0)->GetInt(kIntKey));
+
+  // Detaching is not supported for read-only values.
+  EXPECT_TRUE(value->SetList(kListKey, detached_list));
+  CefRefPtr<CefDictionaryValue> snapshot = value->CreateSnapshot();
+  EXPECT_FALSE(snapshot->DetachList(kListKey).get());
+  EXPECT_TRUE(snapshot->HasKey(kListKey));
+}
+
+// Test dictionary value snapshots.
+TEST(ValuesTest, DictionarySnapshot) {
+  CefRefPtr<CefDictionaryValue> value = CefDictionaryValue::Create();
+  char binary_data[] = "This is my test data";
+  CefRefPtr<CefBinaryValue> binary_value;
+  CefRefPtr<CefDictionaryValue> dictionary_value;
+  CefRefPtr<CefListValue> list_value;
+  TestDictionaryNull(value);
+  TestDictionaryBool(value);
+  TestDictionaryInt(value);
+  TestDictionaryDouble(value);
+  TestDictionaryString(value);
+  TestDictionaryBinary(value, binary_data, sizeof(binary_data)-1,
+                       binary_value);
+  TestDictionaryDictionary(value, dictionary_value);
+  TestDictionaryList(value, list_value);
+
+  CefRefPtr<CefDictionaryValue> snapshot = value->CreateSnapshot();
+  EXPECT_TRUE(snapshot.get());
+  EXPECT_TRUE(snapshot->IsValid());
+  EXPECT_FALSE(snapshot->IsOwned());
+  EXPECT_TRUE(snapshot->IsReadOnly());
+  TestDictionaryEqual(value, snapshot);
+
+  // Snapshots are immutable.
+  EXPECT_FALSE(snapshot->SetInt(kIntKey, kIntValue + 1));
+  EXPECT_FALSE(snapshot->Remove(kIntKey));
+  EXPECT_FALSE(snapshot->Clear());
+  EXPECT_TRUE(snapshot->GetDictionary(kDictionaryKey)->IsReadOnly());
+  EXPECT_TRUE(snapshot->GetList(kListKey)->IsReadOnly());
+
+  // Snapshots are not affected by changes to the original value.
+  EXPECT_TRUE(value->SetInt(kIntKey, kIntValue + 1));
+  EXPECT_EQ(kIntValue, snapshot->GetInt(kIntKey));
+
+  // Copies are writable.
+  CefRefPtr<CefDictionaryValue> copy = snapshot->Copy(false);
+  EXPECT_FALSE(copy->IsReadOnly());
+  TestDictionaryEqual(snapshot, copy);
+
+  // Snapshots remain valid when set into other values.
+  EXPECT_TRUE(value->SetDictionary(kDictionaryKey, snapshot));
+  EXPECT_TRUE(snapshot->IsValid());
+  TestDictionaryEqual(snapshot, value->GetDictionary(kDictionaryKey));
+}
+
 // Test list value access.
 TEST(ValuesTest, ListAccess) {
   CefRefPtr<CefListValue> value = CefListValue::Create();
@@ -732,3 +953,194 @@ TEST(ValuesTest, ListDetachment) {
   EXPECT_FALSE(list_value2->IsValid());
   EXPECT_FALSE(list_value3->IsValid());
 }
+
+// Test that owned list values are moved without copying.
+TEST(ValuesTest, ListMove) {
+  CefRefPtr<CefListValue> value = CefListValue::Create();
+  CefRefPtr<CefListValue> list_value = CefListValue::Create();
+  CefRefPtr<CefListValue> list_value2 = CefListValue::Create();
+
+  EXPECT_TRUE(list_value->SetList(0, list_value2));
+  list_value2 = list_value->GetList(0);
+  EXPECT_TRUE(list_value2->IsValid());
+
+  // Moving the owner invalidates it but not references to its children.
+  EXPECT_TRUE(value->SetList(0, list_value));
+  EXPECT_FALSE(list_value->IsValid());
+  EXPECT_TRUE(list_value2->IsValid());
+
+  // The reference now refers to the moved value.
+  EXPECT_TRUE(list_value2->SetInt(0, kIntValue));
+  list_value = value->GetList(0);
+  EXPECT_EQ(kIntValue, list_value->GetList(0)->GetInt(0));
+
+  // References to the moved value follow the new owner.
+  EXPECT_TRUE(value->Remove(0));
+  EXPECT_FALSE(list_value->IsValid());
+  EXPECT_FALSE(list_value2->IsValid());
+}
+
+// Test detaching values from a list.
+TEST(ValuesTest, ListDetach) {
+  CefRefPtr<CefListValue> value = CefListValue::Create();
+  char binary_data[] = "This is my test data";
+  CefRefPtr<CefBinaryValue> binary_value;
+  CefRefPtr<CefDictionaryValue> dictionary_value;
+  CefRefPtr<CefListValue> list_value;
+  TestListInt(value, 0);
+  TestListBinary(value, 1, binary_data, sizeof(binary_data)-1, binary_value);
+  TestListDictionary(value, 2, dictionary_value);
+  TestListList(value, 3, list_value);
+
+  // Values of the wrong type are not detached.
+  EXPECT_FALSE(value->DetachDictionary(0).get());
+  EXPECT_FALSE(value->DetachList(2).get());
+  EXPECT_FALSE(value->DetachBinary(10).get());
+  EXPECT_EQ((size_t)4, value->GetSize());
+
+  // References to detached values are invalidated. Later values shift down.
+  CefRefPtr<CefListValue> list_ref = value->GetList(3);
+  CefRefPtr<CefListValue> detached_list = value->DetachList(3);
+  EXPECT_TRUE(detached_list.get());
+  EXPECT_FALSE(list_ref->IsValid());
+  EXPECT_EQ((size_t)3, value->GetSize());
+  EXPECT_TRUE(detached_list->IsValid());
+  EXPECT_FALSE(detached_list->IsOwned());
+  EXPECT_FALSE(detached_list->IsReadOnly());
+  EXPECT_EQ(kIntValue, detached_list->GetInt(0));
+
+  CefRefPtr<CefDictionaryValue> dictionary_ref = value->GetDictionary(2);
+  CefRefPtr<CefDictionaryValue> detached_dictionary =
+      value->DetachDictionary(2);
+  EXPECT_TRUE(detached_dictionary.get());
+  EXPECT_FALSE(dictionary_ref->IsValid());
+  EXPECT_EQ((size_t)2, value->GetSize());
+  EXPECT_FALSE(detached_dictionary->IsOwned());
+  EXPECT_FALSE(detached_dictionary->IsReadOnly());
+  EXPECT_EQ(kIntValue, detached_dictionary->GetInt(kIntKey));
+
+  CefRefPtr<CefBinaryValue> binary_ref = value->GetBinary(1);
+  CefRefPtr<CefBinaryValue> detached_binary = value->DetachBinary(1);
+  EXPECT_TRUE(detached_binary.get());
+  EXPECT_FALSE(binary_ref->IsValid());
+  EXPECT_EQ((size_t)1, value->GetSize());
+  TestBinary(detached_binary, binary_data, sizeof(binary_data)-1);
+
+  // Detached values can be moved into another value.
+  CefRefPtr<CefDictionaryValue> dictionary = CefDictionaryValue::Create();
+  EXPECT_TRUE(dictionary->SetList(kListKey, detached_list));
+  EXPECT_FALSE(detached_list->IsValid());
+  EXPECT_EQ(kIntValue, dictionary->GetList(kListKey)->GetInt(0));
+
+  // Detaching is not supported for read-only values.
+  EXPECT_TRUE(value->SetDictionary(1, detached_dictionary));
+  CefRefPtr<CefListValue> snapshot = value->CreateSnapshot();
+  EXPECT_FALSE(snapshot->DetachDictionary(1).get());
+  EXPECT_EQ((size_t)2, snapshot->GetSize());
+}
+
+// Test list value snapshots.
+TEST(ValuesTest, ListSnapshot) {
+  CefRefPtr<CefListValue> value = CefListValue::Create();
+  char binary_data[] = "This is my test data";
+  CefRefPtr<CefBinaryValue> binary_value;
+  CefRefPtr<CefDictionaryValue> dictionary_value;
+  CefRefPtr<CefListValue> list_value;
+  TestListNull(value, kNullIndex);
+  TestListBool(value, kBoolIndex);
+  TestListInt(value, kIntIndex);
+  TestListDouble(value, kDoubleIndex);
+  TestListString(value, kStringIndex);
+  TestListBinary(value, kBinaryIndex, binary_data, sizeof(binary_data)-1,
+                 binary_value);
+  TestListDictionary(value, kDictionaryIndex, dictionary_value);
+  TestListList(value, kListIndex, list_value);
+
+  CefRefPtr<CefListValue> snapshot = value->CreateSnapshot();
+  EXPECT_TRUE(snapshot.get());
+  EXPECT_TRUE(snapshot->IsValid());
+  EXPECT_FALSE(snapshot->IsOwned());
+  EXPECT_TRUE(snapshot->IsReadOnly());
+  TestListEqual(value, snapshot);
+
+  // Snapshots are immutable.
+  EXPECT_FALSE(snapshot->SetInt(kIntIndex, kIntValue + 1));
+  EXPECT_FALSE(snapshot->SetSize(0));
+  EXPECT_FALSE(snapshot->Remove(kIntIndex));
+  EXPECT_EQ(VTYPE_INVALID, snapshot->GetType(-1));
+  EXPECT_EQ(VTYPE_INVALID, snapshot->GetType(100));
+
+  // Snapshots are not affected by changes to the original value.
+  EXPECT_TRUE(value->SetInt(kIntIndex, kIntValue + 1));
+  EXPECT_EQ(kIntValue, snapshot->GetInt(kIntIndex));
+
+  // Copies are writable.
+  CefRefPtr<CefListValue> copy = snapshot->Copy();
+  EXPECT_FALSE(copy->IsReadOnly());
+  TestListEqual(snapshot, copy);
+}
+
+// Test nested values of snapshots.
+TEST(ValuesTest, SnapshotNestedValues) {
+  CefRefPtr<CefListValue> inner_list = CefListValue::Create();
+  EXPECT_TRUE(inner_list->SetInt(0, kIntValue));
+  CefRefPtr<CefDictionaryValue> inner_dictionary =
+      CefDictionaryValue::Create();
+  EXPECT_TRUE(inner_dictionary->SetList(kListKey, inner_list->Copy()));
+  CefRefPtr<CefListValue> value = CefListValue::Create();
+  EXPECT_TRUE(value->SetDictionary(0, inner_dictionary->Copy(false)));
+
+  CefRefPtr<CefListValue> snapshot = value->CreateSnapshot();
+  CefRefPtr<CefDictionaryValue> nested_dictionary =
+      snapshot->GetDictionary(0);
+  CefRefPtr<CefListValue> nested_list =
+      nested_dictionary->GetList(kListKey);
+
+  // Nested values remain valid after the snapshot is released.
+  snapshot = NULL;
+  value = NULL;
+  EXPECT_TRUE(nested_dictionary->IsValid());
+  EXPECT_TRUE(nested_dictionary->IsReadOnly());
+  EXPECT_FALSE(nested_dictionary->IsOwned());
+  EXPECT_EQ(1U, nested_dictionary->GetSize());
+  TestListEqual(inner_list, nested_list);
+
+  // Nested values are copied when set into other values and the copies
+  // contain the nested contents.
+  CefRefPtr<CefListValue> target = CefListValue::Create();
+  EXPECT_TRUE(target->SetDictionary(0, nested_dictionary));
+  EXPECT_TRUE(target->SetList(1, nested_list));
+  EXPECT_TRUE(nested_dictionary->IsValid());
+  EXPECT_TRUE(nested_list->IsValid());
+  TestDictionaryEqual(inner_dictionary, target->GetDictionary(0));
+  TestListEqual(inner_list, target->GetList(1));
+
+  CefRefPtr<CefDictionaryValue> target_dictionary =
+      CefDictionaryValue::Create();
+  EXPECT_TRUE(target_dictionary->SetList(kListKey, nested_list));
+  EXPECT_EQ(kIntValue, target_dictionary->GetList(kListKey)->GetInt(0));
+
+  // Copies of nested values are writable.
+  CefRefPtr<CefDictionaryValue> copy = nested_dictionary->Copy(false);
+  EXPECT_FALSE(copy->IsReadOnly());
+  TestDictionaryEqual(inner_dictionary, copy);
+  EXPECT_TRUE(copy->GetList(kListKey)->SetInt(1, kIntValue));
+  EXPECT_EQ(1U, nested_list->GetSize());
+}
+
+// Compare read performance of locked values and snapshots on a different
+// thread. Only reports timings so it is disabled by default. Run it with
+// --gtest_also_run_disabled_tests.
+TEST(ValuesTest, DISABLED_SnapshotBenchmark) {
+  CefRefPtr<CefDictionaryValue> dictionary_value = CreateBenchmarkDictionary();
+  CefRefPtr<CefListValue> list_value = CreateBenchmarkList();
+
+  CefPostTask(TID_FILE,
+      new BenchmarkTask(dictionary_value, list_value, "Locked"));
+  WaitForThread(TID_FILE);
+
+  CefPostTask(TID_FILE,
+      new BenchmarkTask(dictionary_value->CreateSnapshot(),
+                        list_value->CreateSnapshot(), "Snapshot"));
+  WaitForThread(TID_FILE);
+}